@@ -0,0 +1,258 @@
+/*
+ * nheko Copyright (C) 2017  Konstantinos Sideris <siderisk@auth.gr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//! Microbenchmarks for the Cache hot paths.
+//!
+//! Build with -DBUILD_BENCHMARKS=ON and run e.g
+//!
+//!   ./nheko_bench --benchmark_filter=SaveState
+//!
+//! The fixtures generate synthetic accounts with 10/100/1000 rooms, so
+//! the impact of a storage change can be measured instead of eyeballed.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QStandardPaths>
+
+#include <benchmark/benchmark.h>
+#include <json.hpp>
+#include <mtx/responses.hpp>
+
+#include "Cache.h"
+#include "Logging.h"
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr uint64_t BASE_TIMESTAMP = 1533967300000;
+
+std::string
+userId(int user)
+{
+        return "@bench_user_" + std::to_string(user) + ":bench.local";
+}
+
+std::string
+roomId(int room)
+{
+        return "!bench_room_" + std::to_string(room) + ":bench.local";
+}
+
+std::string
+eventId(int room, int event)
+{
+        return "$bench_" + std::to_string(room) + "_" + std::to_string(event) + ":bench.local";
+}
+
+json
+memberEvent(int room, int user)
+{
+        return json{{"type", "m.room.member"},
+                    {"event_id", eventId(room, 10'000 + user)},
+                    {"sender", userId(user)},
+                    {"state_key", userId(user)},
+                    {"origin_server_ts", BASE_TIMESTAMP + user},
+                    {"content",
+                     {{"membership", "join"},
+                      {"displayname", "Bench User " + std::to_string(user)}}}};
+}
+
+json
+messageEvent(int room, int event)
+{
+        return json{{"type", "m.room.message"},
+                    {"event_id", eventId(room, event)},
+                    {"sender", userId(event % 10)},
+                    {"origin_server_ts", BASE_TIMESTAMP + event},
+                    {"content",
+                     {{"msgtype", "m.text"},
+                      {"body", "the quick brown fox jumps over the lazy dog"}}}};
+}
+
+//! A read receipt from every member for the last message of the room.
+json
+receiptEvent(int room, int members, int messages)
+{
+        json users;
+        for (int user = 0; user < members; user++)
+                users[userId(user)] = json{{"ts", BASE_TIMESTAMP + messages}};
+
+        return json{{"type", "m.receipt"},
+                    {"content", {{eventId(room, messages - 1), {{"m.read", users}}}}}};
+}
+
+//! Synthetic /sync response for an account with the given number of
+//! rooms. Each room carries membership state, a timeline chunk and a
+//! set of read receipts.
+mtx::responses::Sync
+syncPayload(int rooms, int members, int messages)
+{
+        json sync;
+        sync["next_batch"] = "bench_batch_token";
+
+        for (int room = 0; room < rooms; room++) {
+                json obj;
+
+                obj["state"]["events"].push_back(
+                  json{{"type", "m.room.name"},
+                       {"event_id", eventId(room, 20'000)},
+                       {"sender", userId(0)},
+                       {"state_key", ""},
+                       {"origin_server_ts", BASE_TIMESTAMP},
+                       {"content", {{"name", "Bench Room " + std::to_string(room)}}}});
+
+                for (int user = 0; user < members; user++)
+                        obj["state"]["events"].push_back(memberEvent(room, user));
+
+                obj["timeline"]["prev_batch"] = "bench_prev_token";
+                obj["timeline"]["limited"]    = false;
+                for (int event = 0; event < messages; event++)
+                        obj["timeline"]["events"].push_back(messageEvent(room, event));
+
+                obj["ephemeral"]["events"].push_back(receiptEvent(room, members, messages));
+
+                obj["unread_notifications"]["notification_count"] = 0;
+
+                sync["rooms"]["join"][roomId(room)] = obj;
+        }
+
+        mtx::responses::Sync res;
+        from_json(sync, res);
+
+        return res;
+}
+
+//! Provides an empty cache in a scratch location and a synthetic sync
+//! payload sized by the benchmark argument (number of rooms).
+class CacheBench : public benchmark::Fixture
+{
+public:
+        void SetUp(const benchmark::State &state) override
+        {
+                const int rooms = static_cast<int>(state.range(0));
+
+                const auto user = QString("@bench_%1:bench.local").arg(rooms);
+
+                // Start from scratch so previous runs don't skew the numbers.
+                cache_ = std::make_unique<Cache>(user);
+                cache_->deleteData();
+                cache_ = std::make_unique<Cache>(user);
+
+                payload_ = syncPayload(rooms, MEMBERS_PER_ROOM, MESSAGES_PER_ROOM);
+
+                roomIds_.clear();
+                for (int room = 0; room < rooms; room++)
+                        roomIds_.push_back(roomId(room));
+        }
+
+        void TearDown(const benchmark::State &) override
+        {
+                cache_->deleteData();
+                cache_.reset();
+        }
+
+protected:
+        static constexpr int MEMBERS_PER_ROOM  = 20;
+        static constexpr int MESSAGES_PER_ROOM = 30;
+
+        std::unique_ptr<Cache> cache_;
+        mtx::responses::Sync payload_;
+        std::vector<std::string> roomIds_;
+};
+
+BENCHMARK_DEFINE_F(CacheBench, SaveState)(benchmark::State &state)
+{
+        for (auto _ : state)
+                cache_->saveState(payload_);
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(CacheBench, SaveState)->Arg(10)->Arg(100)->Arg(1000);
+
+BENCHMARK_DEFINE_F(CacheBench, GetRoomInfo)(benchmark::State &state)
+{
+        cache_->saveState(payload_);
+
+        for (auto _ : state)
+                benchmark::DoNotOptimize(cache_->getRoomInfo(roomIds_));
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(CacheBench, GetRoomInfo)->Arg(10)->Arg(100)->Arg(1000);
+
+BENCHMARK_DEFINE_F(CacheBench, ReadReceipts)(benchmark::State &state)
+{
+        cache_->saveState(payload_);
+
+        const auto room  = QString::fromStdString(roomId(0));
+        const auto event = QString::fromStdString(eventId(0, MESSAGES_PER_ROOM - 1));
+
+        for (auto _ : state)
+                benchmark::DoNotOptimize(cache_->readReceipts(event, room));
+
+        state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_REGISTER_F(CacheBench, ReadReceipts)->Arg(10);
+
+BENCHMARK_DEFINE_F(CacheBench, SaveImage)(benchmark::State &state)
+{
+        const std::string data(64 * 1024, 'x');
+
+        int i = 0;
+        for (auto _ : state)
+                cache_->saveImage("mxc://bench.local/image" + std::to_string(i++), data);
+
+        state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK_REGISTER_F(CacheBench, SaveImage)->Arg(10);
+
+BENCHMARK_DEFINE_F(CacheBench, Image)(benchmark::State &state)
+{
+        const std::string data(64 * 1024, 'x');
+        cache_->saveImage("mxc://bench.local/image", data);
+
+        for (auto _ : state)
+                benchmark::DoNotOptimize(cache_->image("mxc://bench.local/image"));
+
+        state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK_REGISTER_F(CacheBench, Image)->Arg(10);
+
+} // namespace
+
+int
+main(int argc, char *argv[])
+{
+        // The cache derives its location from QStandardPaths, so keep the
+        // scratch databases away from a real account's data.
+        QCoreApplication app(argc, argv);
+        QCoreApplication::setApplicationName("nheko-bench");
+        QStandardPaths::setTestModeEnabled(true);
+
+        nhlog::init(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+                      .toStdString() +
+                    "/nheko-bench.log");
+
+        benchmark::Initialize(&argc, argv);
+        benchmark::RunSpecifiedBenchmarks();
+
+        return 0;
+}
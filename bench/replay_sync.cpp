@@ -0,0 +1,193 @@
+/*
+ * nheko Copyright (C) 2017  Konstantinos Sideris <siderisk@auth.gr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//! Deterministic replay of captured /sync streams.
+//!
+//! Feeds recorded sync responses through the ingest pipeline the client
+//! runs when a response arrives — parse, Cache::saveState, delta
+//! assembly — against a scratch cache, and reports per-stage timings.
+//! Build with -DBUILD_BENCHMARKS=ON and run e.g
+//!
+//!   ./nheko_replay capture.jsonl --speed 0
+//!
+//! The capture is one JSON object per line, either a bare sync response
+//! or {"offset_ms": <ms since capture start>, "response": {...}}.
+//! --speed scales the recorded gaps between responses: 1 replays in
+//! real time, 2 twice as fast, 0 (the default) back to back.
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <QCoreApplication>
+#include <QStandardPaths>
+
+#include <json.hpp>
+#include <mtx/responses.hpp>
+
+#include "Cache.h"
+#include "Logging.h"
+
+using json = nlohmann::json;
+
+namespace {
+
+//! Running aggregate of one pipeline stage.
+struct StageStats
+{
+        uint64_t total_us = 0;
+        uint64_t max_us   = 0;
+        size_t samples    = 0;
+
+        void add(uint64_t us)
+        {
+                total_us += us;
+                max_us = std::max(max_us, us);
+                samples += 1;
+        }
+
+        void report(const char *name) const
+        {
+                if (samples == 0)
+                        return;
+
+                std::printf("%-14s %8zu samples  avg %8.1f us  max %8llu us  total %8.1f ms\n",
+                            name,
+                            samples,
+                            static_cast<double>(total_us) / samples,
+                            static_cast<unsigned long long>(max_us),
+                            total_us / 1000.0);
+        }
+};
+
+uint64_t
+usSince(const std::chrono::steady_clock::time_point &start)
+{
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                 std::chrono::steady_clock::now() - start)
+          .count();
+}
+}
+
+int
+main(int argc, char *argv[])
+{
+        // The cache derives its location from QStandardPaths, so keep the
+        // scratch databases away from a real account's data.
+        QCoreApplication app(argc, argv);
+        QCoreApplication::setApplicationName("nheko-replay");
+        QStandardPaths::setTestModeEnabled(true);
+
+        nhlog::init(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+                      .toStdString() +
+                    "/nheko-replay.log");
+
+        const char *path = nullptr;
+        double speed     = 0;
+
+        for (int i = 1; i < argc; i++) {
+                if (std::string(argv[i]) == "--speed" && i + 1 < argc)
+                        speed = std::stod(argv[++i]);
+                else
+                        path = argv[i];
+        }
+
+        if (path == nullptr) {
+                std::fprintf(stderr, "usage: %s <capture.jsonl> [--speed N]\n", argv[0]);
+                return 1;
+        }
+
+        std::ifstream capture(path);
+        if (!capture) {
+                std::fprintf(stderr, "failed to open %s\n", path);
+                return 1;
+        }
+
+        // Start from scratch so previous runs don't skew the numbers.
+        auto cache = std::make_unique<Cache>("@replay:bench.local");
+        cache->deleteData();
+        cache = std::make_unique<Cache>("@replay:bench.local");
+
+        StageStats parse, save, diff;
+
+        uint64_t prevOffset = 0;
+        size_t responses    = 0;
+
+        const auto wallStart = std::chrono::steady_clock::now();
+
+        std::string line;
+        while (std::getline(capture, line)) {
+                if (line.empty())
+                        continue;
+
+                json obj;
+                try {
+                        obj = json::parse(line);
+                } catch (const json::exception &e) {
+                        std::fprintf(stderr, "skipping malformed line: %s\n", e.what());
+                        continue;
+                }
+
+                uint64_t offset = prevOffset;
+                json body;
+
+                if (obj.count("response") != 0) {
+                        body   = obj.at("response");
+                        offset = obj.value("offset_ms", prevOffset);
+                } else {
+                        body = std::move(obj);
+                }
+
+                if (speed > 0 && offset > prevOffset)
+                        std::this_thread::sleep_for(std::chrono::milliseconds(
+                          static_cast<int64_t>((offset - prevOffset) / speed)));
+                prevOffset = offset;
+
+                try {
+                        auto begin = std::chrono::steady_clock::now();
+                        mtx::responses::Sync res;
+                        from_json(body, res);
+                        parse.add(usSince(begin));
+
+                        begin = std::chrono::steady_clock::now();
+                        cache->saveState(res);
+                        save.add(usSince(begin));
+
+                        begin = std::chrono::steady_clock::now();
+                        cache->roomUpdates(res);
+                        diff.add(usSince(begin));
+
+                        responses += 1;
+                } catch (const std::exception &e) {
+                        std::fprintf(stderr, "response %zu: %s\n", responses, e.what());
+                }
+        }
+
+        std::printf("replayed %zu response(s) in %.1f ms\n\n",
+                    responses,
+                    usSince(wallStart) / 1000.0);
+        parse.report("parse");
+        save.report("saveState");
+        diff.report("roomUpdates");
+
+        cache->deleteData();
+
+        return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ * nheko Copyright (C) 2017  Konstantinos Sideris <siderisk@auth.gr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace util {
+
+//! A view into bytes owned by an Arena. Valid for as long as the arena
+//! that produced it is alive.
+struct StringRef
+{
+        const char *data = nullptr;
+        std::size_t size = 0;
+
+        bool empty() const { return size == 0; }
+
+        std::string toString() const { return std::string(data, size); }
+};
+
+//! Bump allocator for batches of short-lived byte buffers.
+//!
+//! Memory is carved out of large blocks with a pointer bump per
+//! allocation and released all at once when the arena is destroyed, so
+//! storing thousands of small records doesn't make a round trip through
+//! the allocator for each of them. Individual allocations can not be
+//! freed.
+class Arena
+{
+public:
+        Arena() = default;
+        Arena(const Arena &) = delete;
+        Arena &operator=(const Arena &) = delete;
+
+        char *allocate(std::size_t size)
+        {
+                if (size > remaining_) {
+                        // The unused tail of the previous block is wasted;
+                        // it's bounded by one block per oversized request.
+                        const auto block_size = size > BLOCK_SIZE ? size : BLOCK_SIZE;
+
+                        blocks_.emplace_back(new char[block_size]);
+
+                        cursor_    = blocks_.back().get();
+                        remaining_ = block_size;
+                }
+
+                const auto ptr = cursor_;
+                cursor_ += size;
+                remaining_ -= size;
+
+                return ptr;
+        }
+
+        //! Copy the given bytes into the arena.
+        StringRef store(const char *data, std::size_t size)
+        {
+                const auto ptr = allocate(size);
+                std::memcpy(ptr, data, size);
+
+                return StringRef{ptr, size};
+        }
+
+        StringRef store(const std::string &value) { return store(value.data(), value.size()); }
+
+private:
+        static constexpr std::size_t BLOCK_SIZE = 64 * 1024;
+
+        std::vector<std::unique_ptr<char[]>> blocks_;
+        char *cursor_          = nullptr;
+        std::size_t remaining_ = 0;
+};
+}
@@ -16,7 +16,13 @@
  */
 
 #include <QBuffer>
-#include <memory>
+#include <QHash>
+#include <QPointer>
+#include <QSet>
+#include <QTimer>
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 #include "AvatarProvider.h"
 #include "Cache.h"
@@ -25,50 +31,259 @@
 
 namespace AvatarProvider {
 
-void
-resolve(const QString &room_id, const QString &user_id, QObject *receiver, AvatarCallback callback)
+//! Decoded avatars shared by all widgets. QImage is implicitly shared
+//! so the callbacks only receive cheap copies.
+static QHash<QString, QImage> avatars_;
+
+//! The display sites interested in each avatar url, held through weak
+//! handles. Updates are pushed to every live subscriber; dead ones are
+//! pruned on delivery.
+static QHash<QString, std::vector<std::pair<QPointer<QObject>, AvatarCallback>>> subscribers_;
+
+//! Urls with a download currently in flight, so concurrent resolves
+//! for the same avatar are coalesced into a single request.
+static QSet<QString> pending_;
+
+//! A resolve request waiting for the next flush of the queue.
+struct QueuedResolve
 {
-        const auto key       = QString("%1 %2").arg(room_id).arg(user_id);
-        const auto avatarUrl = Cache::avatarUrl(room_id, user_id);
+        QString avatarUrl;
+        QPointer<QObject> receiver;
+        AvatarCallback callback;
+};
 
-        if (!Cache::AvatarUrls.contains(key) || !cache::client())
-                return;
+//! Requests accumulated during the current iteration of the event loop,
+//! so the membership churn of a sync is answered from the cache with a
+//! single read transaction instead of one per avatar.
+static std::vector<QueuedResolve> queue_;
+static bool isFlushScheduled_ = false;
 
-        if (avatarUrl.isEmpty())
+//! Receiver for the notifier connections and the flush timer.
+static QObject context_;
+
+//! Push the decoded avatar to every live subscriber of the url and
+//! prune the handles whose receiver died.
+static void
+deliver(const QString &avatarUrl, const QImage &img)
+{
+        auto it = subscribers_.find(avatarUrl);
+        if (it == subscribers_.end())
                 return;
 
-        auto data = cache::client()->image(avatarUrl);
-        if (!data.isNull()) {
-                callback(QImage::fromData(data));
+        auto &subs = it.value();
+        subs.erase(std::remove_if(subs.begin(),
+                                  subs.end(),
+                                  [](const auto &s) { return s.first.isNull(); }),
+                   subs.end());
+
+        if (subs.empty()) {
+                subscribers_.erase(it);
                 return;
         }
 
-        auto proxy = std::make_shared<AvatarProxy>();
-        QObject::connect(proxy.get(),
-                         &AvatarProxy::avatarDownloaded,
-                         receiver,
-                         [callback](const QByteArray &data) { callback(QImage::fromData(data)); });
+        for (const auto &s : subs)
+                s.second(img);
+}
+
+//! The shared notifier, connected once. Downloads finish on a worker
+//! thread; the queued signals hop back to the GUI thread.
+static AvatarNotifier &
+notifier()
+{
+        static AvatarNotifier instance;
+        static bool connected = false;
+
+        if (!connected) {
+                connected = true;
+
+                QObject::connect(&instance,
+                                 &AvatarNotifier::downloaded,
+                                 &context_,
+                                 [](const QString &url, const QByteArray &data) {
+                                         auto img = QImage::fromData(data);
+                                         avatars_.insert(url, img);
+
+                                         pending_.remove(url);
+                                         deliver(url, img);
+                                 });
+
+                // Drop the in-flight entry on failure so the next resolve
+                // retries.
+                QObject::connect(&instance,
+                                 &AvatarNotifier::failed,
+                                 &context_,
+                                 [](const QString &url) { pending_.remove(url); });
+        }
+
+        return instance;
+}
+
+//! Request the avatar from the homeserver and push it to the url's
+//! subscribers.
+static void
+startDownload(const QString &avatarUrl)
+{
+        pending_.insert(avatarUrl);
 
         mtx::http::ThumbOpts opts;
         opts.width   = 256;
         opts.height  = 256;
         opts.mxc_url = avatarUrl.toStdString();
 
-        http::client()->get_thumbnail(
+        auto &notify = notifier();
+
+        http::get_thumbnail(
           opts,
-          [opts, proxy = std::move(proxy)](const std::string &res, mtx::http::RequestErr err) {
+          http::DownloadPriority::Avatar,
+          &notify,
+          [opts, avatarUrl, &notify](const std::string &res, mtx::http::RequestErr err) {
                   if (err) {
                           nhlog::net()->warn("failed to download avatar: {} - ({} {})",
                                              opts.mxc_url,
                                              mtx::errors::to_string(err->matrix_error.errcode),
                                              err->matrix_error.error);
+                          emit notify.failed(avatarUrl);
                           return;
                   }
 
                   cache::client()->saveImage(opts.mxc_url, res);
 
                   auto data = QByteArray(res.data(), res.size());
-                  emit proxy->avatarDownloaded(data);
+                  emit notify.downloaded(avatarUrl, data);
           });
 }
+
+//! Last url each receiver subscribed to, so a recycled widget that
+//! switches to another avatar drops its old subscription instead of
+//! leaving it behind to push stale images. The keys are only compared,
+//! never dereferenced.
+static QHash<QObject *, QString> subscribedUrl_;
+
+//! Register the receiver's interest in the url, replacing any previous
+//! subscription of the same receiver.
+static void
+subscribe(const QString &avatarUrl, const QPointer<QObject> &receiver, const AvatarCallback &cb)
+{
+        if (receiver.isNull())
+                return;
+
+        const auto prev = subscribedUrl_.value(receiver.data());
+        if (!prev.isEmpty() && prev != avatarUrl) {
+                auto it = subscribers_.find(prev);
+                if (it != subscribers_.end()) {
+                        auto &subs = it.value();
+                        subs.erase(std::remove_if(subs.begin(),
+                                                  subs.end(),
+                                                  [&receiver](const auto &s) {
+                                                          return s.first == receiver;
+                                                  }),
+                                   subs.end());
+
+                        if (subs.empty())
+                                subscribers_.erase(it);
+                }
+        }
+
+        subscribedUrl_.insert(receiver.data(), avatarUrl);
+
+        auto &subs = subscribers_[avatarUrl];
+        for (auto &s : subs) {
+                if (s.first == receiver) {
+                        s.second = cb;
+                        return;
+                }
+        }
+
+        subs.emplace_back(receiver, cb);
+}
+
+//! Rebuild the reverse index from the live subscriptions once the
+//! entries of dead receivers dominate it.
+static void
+compactIndex()
+{
+        int live = 0;
+        for (const auto &subs : subscribers_)
+                live += static_cast<int>(subs.size());
+
+        if (subscribedUrl_.size() < 64 || subscribedUrl_.size() < 4 * live)
+                return;
+
+        subscribedUrl_.clear();
+        for (auto it = subscribers_.begin(); it != subscribers_.end(); ++it) {
+                for (const auto &s : it.value()) {
+                        if (!s.first.isNull())
+                                subscribedUrl_.insert(s.first.data(), it.key());
+                }
+        }
+}
+
+//! Serve the accumulated requests. Misses are downloaded through the
+//! avatar tier of the scheduler, which bounds their concurrency.
+static void
+flushQueue()
+{
+        isFlushScheduled_ = false;
+
+        auto requests = std::move(queue_);
+        queue_.clear();
+
+        if (!cache::client())
+                return;
+
+        // Urls that have to be looked up in the cache, deduplicated.
+        std::vector<QString> urls;
+        for (const auto &req : requests) {
+                if (avatars_.contains(req.avatarUrl) || pending_.contains(req.avatarUrl))
+                        continue;
+
+                if (std::find(urls.begin(), urls.end(), req.avatarUrl) == urls.end())
+                        urls.push_back(req.avatarUrl);
+        }
+
+        const auto cached = cache::client()->images(urls);
+        for (auto it = cached.constBegin(); it != cached.constEnd(); ++it)
+                avatars_.insert(it.key(), it.value());
+
+        for (const auto &req : requests) {
+                subscribe(req.avatarUrl, req.receiver, req.callback);
+
+                if (avatars_.contains(req.avatarUrl)) {
+                        if (!req.receiver.isNull())
+                                req.callback(avatars_.value(req.avatarUrl));
+                        continue;
+                }
+
+                // A download for this avatar is already in flight; the
+                // subscription above receives its result.
+                if (!pending_.contains(req.avatarUrl))
+                        startDownload(req.avatarUrl);
+        }
+
+        compactIndex();
+}
+
+void
+resolve(const QString &room_id, const QString &user_id, QObject *receiver, AvatarCallback callback)
+{
+        const auto avatarUrl = Cache::avatarUrl(room_id, user_id);
+
+        if (avatarUrl.isEmpty() || !cache::client())
+                return;
+
+        // Serve the decoded avatar without hitting the database. The
+        // subscription keeps the receiver on later refreshes of the url.
+        if (avatars_.contains(avatarUrl)) {
+                subscribe(avatarUrl, receiver, callback);
+                callback(avatars_.value(avatarUrl));
+                return;
+        }
+
+        queue_.push_back({avatarUrl, receiver, callback});
+
+        if (!isFlushScheduled_) {
+                isFlushScheduled_ = true;
+                QTimer::singleShot(0, &context_, flushQueue);
+        }
+}
 }
@@ -20,17 +20,24 @@
 #include <QImage>
 #include <functional>
 
-class AvatarProxy : public QObject
+//! A single notifier shared by all avatar downloads; the url carried by
+//! the signals routes the result, so no per-request objects or
+//! connections are created.
+class AvatarNotifier : public QObject
 {
         Q_OBJECT
 
 signals:
-        void avatarDownloaded(const QByteArray &data);
+        void downloaded(const QString &url, const QByteArray &data);
+        void failed(const QString &url);
 };
 
 using AvatarCallback = std::function<void(QImage)>;
 
 namespace AvatarProvider {
+//! Subscribe the receiver to the user's avatar. The callback runs as
+//! soon as the image is available and again whenever the provider
+//! refreshes it; the subscription is dropped when the receiver dies.
 void
 resolve(const QString &room_id, const QString &user_id, QObject *receiver, AvatarCallback cb);
 }
@@ -15,35 +15,81 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
 #include <limits>
+#include <map>
+#include <set>
 #include <stdexcept>
 
+#include <QBuffer>
 #include <QByteArray>
+#include <QDataStream>
 #include <QFile>
 #include <QHash>
 #include <QSettings>
 #include <QStandardPaths>
+#include <QtConcurrent>
 
 #include <boost/variant.hpp>
 #include <mtx/responses/common.hpp>
 
 #include "Cache.h"
+#include "Perf.h"
 #include "Utils.h"
 
 //! Should be changed when a breaking change occurs in the cache format.
 //! This will reset client's data.
-static const std::string CURRENT_CACHE_FORMAT_VERSION("2018.06.10");
+static const std::string CURRENT_CACHE_FORMAT_VERSION("2018.09.21");
 static const std::string SECRET("secret");
 
 static const lmdb::val NEXT_BATCH_KEY("next_batch");
 static const lmdb::val OLM_ACCOUNT_KEY("olm_account");
 static const lmdb::val CACHE_FORMAT_VERSION_KEY("cache_format_version");
+//! Progress marker of a partially applied format migration.
+//! Format: db name 0x1f last rewritten key.
+static const lmdb::val MIGRATION_CHECKPOINT_KEY("migration_checkpoint");
+
+//! Records rewritten per transaction during a format migration. Small
+//! enough to keep the write lock short, large enough to amortize the
+//! commit over many records.
+constexpr size_t MIGRATION_BATCH_SIZE = 1024;
 
 constexpr size_t MAX_RESTORED_MESSAGES = 30;
 
+//! How often the background maintenance (cold-tier migration & media
+//! eviction) is allowed to run.
+constexpr auto MAINTENANCE_INTERVAL = std::chrono::minutes(10);
+//! Number of rooms whose timeline is migrated on each maintenance run.
+constexpr size_t ROOMS_PER_MAINTENANCE_SLICE = 5;
+//! How often the database is compacted into a fresh file, returning the
+//! pages freed by maintenance to the filesystem.
+constexpr int COMPACTION_INTERVAL_DAYS = 7;
+
 constexpr auto DB_SIZE = 512UL * 1024UL * 1024UL; // 512 MB
 constexpr auto MAX_DBS = 1024UL;
 
+//! Size budget for the downloaded media. When it's exceeded the least
+//! recently used entries are evicted.
+constexpr auto MAX_MEDIA_SIZE = 256UL * 1024UL * 1024UL; // 256 MB
+
+//! Media entries up to this size are treated as placeholders (e.g. the
+//! tiny blurred image previews) and are evicted only after all the
+//! heavyweight entries; keeping them all costs close to nothing.
+constexpr size_t PLACEHOLDER_MEDIA_SIZE = 4096;
+
+//! Maximum number of sent-notification ids to remember. The server only
+//! reports recent notifications, so a bounded window is enough to
+//! suppress the duplicates across responses.
+constexpr size_t MAX_SENT_NOTIFICATIONS = 1024;
+
+//! The metadata fsync is deferred so consecutive commits are group
+//! committed by the OS. On a crash the cache falls back at most one
+//! commit, which the next sync will fill in again. MDB_NOTLS unties
+//! read transactions from threads so they can be pooled.
+constexpr auto ENV_FLAGS = MDB_NOMETASYNC | MDB_NOTLS;
+
 //! Cache databases and their format.
 //!
 //! Contains UI information for the joined rooms. (i.e name, topic, avatar url etc).
@@ -53,11 +99,35 @@ constexpr auto INVITES_DB("invites");
 //! Keeps already downloaded media for reuse.
 //! Format: matrix_url -> binary data.
 constexpr auto MEDIA_DB("media");
+//! Derived display-size variants of cached media, generated on first
+//! scale and served on later displays instead of the original.
+//! Format: matrix_url 0x1f WxH -> encoded thumbnail.
+constexpr auto MEDIA_THUMBNAILS_DB("media_thumbnails");
+//! Tracks when each media entry was last used, so eviction can be LRU.
+//! Format: matrix_url -> big endian timestamp.
+constexpr auto MEDIA_ACCESS_DB("media_access");
 //! Information that  must be kept between sync requests.
 constexpr auto SYNC_STATE_DB("sync_state");
+//! Journaled UI session state (active room, composer drafts). Each
+//! update is one tiny write, so the context survives a crash.
+//! Format: item key -> value.
+constexpr auto SESSION_STATE_DB("session_state");
+//! Sampled storage statistics (hit rates, txn latencies), persisted by
+//! the maintenance pass so they can be inspected across sessions.
+constexpr auto STATS_DB("stats");
+//! Profiles of the joined communities.
+//! Format: group_id -> {name, avatar_url}
+constexpr auto GROUPS_DB("groups");
 //! Read receipts per room/event.
+//! Format: room_id 0x00 event_id -> {user_id -> timestamp}
 constexpr auto READ_RECEIPTS_DB("read_receipts");
+//! Event ids a desktop notification was shown for. Mirrored by an
+//! in-memory index for constant time duplicate checks; the oldest
+//! entries are pruned once MAX_SENT_NOTIFICATIONS is reached.
 constexpr auto NOTIFICATIONS_DB("sent_notifications");
+//! Secondary index for finding an event without walking a room's timeline.
+//! Format: event_id -> room_id 0x1f timeline key.
+constexpr auto EVENT_INDEX_DB("event_index");
 
 //! Encryption related databases.
 
@@ -76,8 +146,24 @@ constexpr auto OUTBOUND_MEGOLM_SESSIONS_DB("outbound_megolm_sessions");
 using CachedReceipts = std::multimap<uint64_t, std::string, std::greater<uint64_t>>;
 using Receipts       = std::map<std::string, std::map<std::string, uint64_t>>;
 
+//! Hit accounting of the sender overlay; a miss falls back to the raw
+//! matrix id.
+static std::atomic<uint64_t> senderLookups_{0};
+static std::atomic<uint64_t> senderHits_{0};
+
+//! Key of a receipt summary in the in-memory overlay.
+static QString
+receiptOverlayKey(const QString &room_id, const QString &event_id)
+{
+        return room_id + QChar('\x1f') + event_id;
+}
+
 namespace {
-std::unique_ptr<Cache> instance_ = nullptr;
+//! Cache environments per account. Each account's environment lives in
+//! its own directory, so several logins can share the process.
+std::map<QString, std::unique_ptr<Cache>> instances_;
+//! The account whose cache is served by cache::client().
+Cache *active_ = nullptr;
 }
 
 namespace cache {
@@ -93,13 +179,30 @@ init(const QString &user_id)
         qRegisterMetaType<std::map<QString, RoomInfo>>();
         qRegisterMetaType<std::map<QString, mtx::responses::Timeline>>();
 
-        instance_ = std::make_unique<Cache>(user_id);
+        auto it = instances_.find(user_id);
+        if (it == instances_.end())
+                it = instances_.emplace(user_id, std::make_unique<Cache>(user_id)).first;
+
+        active_ = it->second.get();
+}
+
+void
+drop(const QString &user_id)
+{
+        auto it = instances_.find(user_id);
+        if (it == instances_.end())
+                return;
+
+        if (active_ == it->second.get())
+                active_ = nullptr;
+
+        instances_.erase(it);
 }
 
 Cache *
 client()
 {
-        return instance_.get();
+        return active_;
 }
 } // namespace cache
 
@@ -107,11 +210,17 @@ Cache::Cache(const QString &userId, QObject *parent)
   : QObject{parent}
   , env_{nullptr}
   , syncStateDb_{0}
+  , sessionStateDb_{0}
+  , statsDb_{0}
+  , groupsDb_{0}
   , roomsDb_{0}
   , invitesDb_{0}
   , mediaDb_{0}
+  , mediaThumbnailsDb_{0}
+  , mediaAccessDb_{0}
   , readReceiptsDb_{0}
   , notificationsDb_{0}
+  , eventIndexDb_{0}
   , devicesDb_{0}
   , deviceKeysDb_{0}
   , inboundMegolmSessionDb_{0}
@@ -150,7 +259,7 @@ Cache::setup()
         }
 
         try {
-                env_.open(statePath.toStdString().c_str());
+                env_.open(statePath.toStdString().c_str(), ENV_FLAGS);
         } catch (const lmdb::error &e) {
                 if (e.code() != MDB_VERSION_MISMATCH && e.code() != MDB_INVALID) {
                         throw std::runtime_error("LMDB initialization failed" +
@@ -167,16 +276,27 @@ Cache::setup()
                                   ("Unable to delete file " + file).toStdString().c_str());
                 }
 
-                env_.open(statePath.toStdString().c_str());
+                env_.open(statePath.toStdString().c_str(), ENV_FLAGS);
         }
 
-        auto txn         = lmdb::txn::begin(env_);
-        syncStateDb_     = lmdb::dbi::open(txn, SYNC_STATE_DB, MDB_CREATE);
-        roomsDb_         = lmdb::dbi::open(txn, ROOMS_DB, MDB_CREATE);
-        invitesDb_       = lmdb::dbi::open(txn, INVITES_DB, MDB_CREATE);
-        mediaDb_         = lmdb::dbi::open(txn, MEDIA_DB, MDB_CREATE);
-        readReceiptsDb_  = lmdb::dbi::open(txn, READ_RECEIPTS_DB, MDB_CREATE);
-        notificationsDb_ = lmdb::dbi::open(txn, NOTIFICATIONS_DB, MDB_CREATE);
+        // The environment has no other users yet, so the data file can be
+        // safely swapped for a compacted copy.
+        if (!isInitial)
+                compactDatabase(statePath);
+
+        auto txn           = lmdb::txn::begin(env_);
+        syncStateDb_       = lmdb::dbi::open(txn, SYNC_STATE_DB, MDB_CREATE);
+        sessionStateDb_    = lmdb::dbi::open(txn, SESSION_STATE_DB, MDB_CREATE);
+        statsDb_           = lmdb::dbi::open(txn, STATS_DB, MDB_CREATE);
+        groupsDb_          = lmdb::dbi::open(txn, GROUPS_DB, MDB_CREATE);
+        roomsDb_           = lmdb::dbi::open(txn, ROOMS_DB, MDB_CREATE);
+        invitesDb_         = lmdb::dbi::open(txn, INVITES_DB, MDB_CREATE);
+        mediaDb_           = lmdb::dbi::open(txn, MEDIA_DB, MDB_CREATE);
+        mediaThumbnailsDb_ = lmdb::dbi::open(txn, MEDIA_THUMBNAILS_DB, MDB_CREATE);
+        mediaAccessDb_     = lmdb::dbi::open(txn, MEDIA_ACCESS_DB, MDB_CREATE);
+        readReceiptsDb_    = lmdb::dbi::open(txn, READ_RECEIPTS_DB, MDB_CREATE);
+        notificationsDb_   = lmdb::dbi::open(txn, NOTIFICATIONS_DB, MDB_CREATE);
+        eventIndexDb_      = lmdb::dbi::open(txn, EVENT_INDEX_DB, MDB_CREATE);
 
         // Device management
         devicesDb_    = lmdb::dbi::open(txn, DEVICES_DB, MDB_CREATE);
@@ -189,6 +309,91 @@ Cache::setup()
         txn.commit();
 }
 
+void
+Cache::compactDatabase(const QString &statePath)
+{
+        QSettings settings;
+        const auto key = QString("cache/last_compaction/%1")
+                           .arg(QString::fromUtf8(localUserId_.toUtf8().toHex()));
+
+        const auto last = settings.value(key).toDateTime();
+        const auto now  = QDateTime::currentDateTime();
+
+        if (!last.isValid()) {
+                settings.setValue(key, now);
+                return;
+        }
+
+        if (last.daysTo(now) < COMPACTION_INTERVAL_DAYS)
+                return;
+
+        nhlog::db()->info("starting database compaction");
+
+        const auto dataPath   = statePath + "/data.mdb";
+        const auto tmpPath    = statePath + "/compacted.mdb";
+        const auto backupPath = dataPath + ".old";
+
+        QFile::remove(tmpPath);
+
+        try {
+                lmdb::env_copy(env_, tmpPath.toStdString().c_str(), MDB_CP_COMPACT);
+        } catch (const lmdb::error &e) {
+                nhlog::db()->warn("database compaction failed: {}", e.what());
+                QFile::remove(tmpPath);
+                return;
+        }
+
+        env_.close();
+
+        // Keep the old data file around until the compacted copy is in
+        // place, so a failure in between doesn't lose the cache.
+        QFile::remove(backupPath);
+
+        if (!QFile::rename(dataPath, backupPath)) {
+                nhlog::db()->error("could not move aside the old data file");
+                QFile::remove(tmpPath);
+        } else if (!QFile::rename(tmpPath, dataPath)) {
+                nhlog::db()->error("could not move the compacted data file in place");
+                QFile::rename(backupPath, dataPath);
+                QFile::remove(tmpPath);
+        } else {
+                QFile::remove(backupPath);
+                settings.setValue(key, now);
+                nhlog::db()->info("database compaction finished");
+        }
+
+        env_ = lmdb::env::create();
+        env_.set_mapsize(DB_SIZE);
+        env_.set_max_dbs(MAX_DBS);
+        env_.open(statePath.toStdString().c_str(), ENV_FLAGS);
+}
+
+lmdb::txn
+Cache::acquireReadTxn() const
+{
+        {
+                std::lock_guard<std::mutex> lock(readTxnMutex_);
+
+                if (!readTxnPool_.empty()) {
+                        auto txn = std::move(readTxnPool_.back());
+                        readTxnPool_.pop_back();
+                        txn.renew();
+                        return txn;
+                }
+        }
+
+        return lmdb::txn::begin(env_, nullptr, MDB_RDONLY);
+}
+
+void
+Cache::releaseReadTxn(lmdb::txn &&txn) const
+{
+        txn.reset();
+
+        std::lock_guard<std::mutex> lock(readTxnMutex_);
+        readTxnPool_.push_back(std::move(txn));
+}
+
 void
 Cache::setEncryptedRoom(lmdb::txn &txn, const std::string &room_id)
 {
@@ -215,6 +420,75 @@ Cache::isRoomEncrypted(const std::string &room_id)
 // Device Management
 //
 
+std::vector<std::string>
+Cache::updateDeviceLists(const std::map<std::string, std::vector<std::string>> &lists)
+{
+        std::vector<std::string> changed;
+
+        auto txn = lmdb::txn::begin(env_);
+
+        for (const auto &user : lists) {
+                auto devices = user.second;
+                std::sort(devices.begin(), devices.end());
+
+                uint64_t version = 0;
+
+                lmdb::val value;
+                if (lmdb::dbi_get(txn, devicesDb_, lmdb::val(user.first), value)) {
+                        try {
+                                const auto record =
+                                  json::parse(std::string(value.data(), value.size()));
+
+                                version = record.at("version").get<uint64_t>();
+
+                                // Change notifications regularly precede any
+                                // actual difference; an identical list keeps
+                                // its version and skips the write.
+                                if (record.at("devices").get<std::vector<std::string>>() ==
+                                    devices)
+                                        continue;
+                        } catch (const json::exception &e) {
+                                nhlog::db()->warn(
+                                  "corrupt device list record for {}: {}", user.first, e.what());
+                        }
+                }
+
+                const json record = {{"version", version + 1}, {"devices", devices}};
+
+                lmdb::dbi_put(
+                  txn, devicesDb_, lmdb::val(user.first), lmdb::val(record.dump()));
+                changed.push_back(user.first);
+        }
+
+        txn.commit();
+
+        return changed;
+}
+
+void
+Cache::setDeviceList(const std::string &user_id, const std::vector<std::string> &devices)
+{
+        updateDeviceLists({{user_id, devices}});
+}
+
+std::vector<std::string>
+Cache::getDeviceList(const std::string &user_id)
+{
+        ReadTxn txn(*this);
+
+        lmdb::val value;
+        if (!lmdb::dbi_get(txn, devicesDb_, lmdb::val(user_id), value))
+                return {};
+
+        try {
+                const auto record = json::parse(std::string(value.data(), value.size()));
+                return record.at("devices").get<std::vector<std::string>>();
+        } catch (const json::exception &e) {
+                nhlog::db()->warn("corrupt device list record for {}: {}", user_id, e.what());
+                return {};
+        }
+}
+
 //
 // Session Management
 //
@@ -233,23 +507,74 @@ Cache::saveInboundMegolmSession(const MegolmSessionIndex &index,
 
         {
                 std::unique_lock<std::mutex> lock(session_storage.group_inbound_mtx);
-                session_storage.group_inbound_sessions[key] = std::move(session);
+
+                auto &entry = session_storage.group_inbound_sessions[key];
+                if (!entry.mutex)
+                        entry.mutex = std::make_shared<std::mutex>();
+
+                // In-flight decrypts hold their own reference; replacing
+                // the stored session must not free it under them.
+                entry.session = std::shared_ptr<OlmInboundGroupSession>(std::move(session));
         }
 }
 
-OlmInboundGroupSession *
+InboundGroupSessionRef
 Cache::getInboundMegolmSession(const MegolmSessionIndex &index)
 {
+        const auto key = index.to_hash();
+
         std::unique_lock<std::mutex> lock(session_storage.group_inbound_mtx);
-        return session_storage.group_inbound_sessions[index.to_hash()].get();
+
+        if (session_storage.group_inbound_sessions.find(key) ==
+            session_storage.group_inbound_sessions.end())
+                restoreInboundMegolmSession(key);
+
+        auto &entry = session_storage.group_inbound_sessions[key];
+        if (!entry.mutex)
+                entry.mutex = std::make_shared<std::mutex>();
+
+        return entry;
 }
 
 bool
 Cache::inboundMegolmSessionExists(const MegolmSessionIndex &index) noexcept
 {
+        const auto key = index.to_hash();
+
         std::unique_lock<std::mutex> lock(session_storage.group_inbound_mtx);
-        return session_storage.group_inbound_sessions.find(index.to_hash()) !=
-               session_storage.group_inbound_sessions.end();
+
+        if (session_storage.group_inbound_sessions.find(key) !=
+            session_storage.group_inbound_sessions.end())
+                return true;
+
+        return restoreInboundMegolmSession(key);
+}
+
+bool
+Cache::restoreInboundMegolmSession(const std::string &key)
+{
+        using namespace mtx::crypto;
+
+        try {
+                ReadTxn txn(*this);
+
+                lmdb::val pickled;
+                if (!lmdb::dbi_get(txn, inboundMegolmSessionDb_, lmdb::val(key), pickled))
+                        return false;
+
+                auto session = unpickle<InboundSessionObject>(
+                  std::string(pickled.data(), pickled.size()), SECRET);
+
+                auto &entry = session_storage.group_inbound_sessions[key];
+                if (!entry.mutex)
+                        entry.mutex = std::make_shared<std::mutex>();
+                entry.session = std::shared_ptr<OlmInboundGroupSession>(std::move(session));
+
+                return true;
+        } catch (const std::exception &e) {
+                nhlog::db()->critical("failed to restore inbound megolm session: {}", e.what());
+                return false;
+        }
 }
 
 void
@@ -309,20 +634,55 @@ bool
 Cache::outboundMegolmSessionExists(const std::string &room_id) noexcept
 {
         std::unique_lock<std::mutex> lock(session_storage.group_outbound_mtx);
-        return (session_storage.group_outbound_sessions.find(room_id) !=
-                session_storage.group_outbound_sessions.end()) &&
-               (session_storage.group_outbound_session_data.find(room_id) !=
-                session_storage.group_outbound_session_data.end());
+
+        if ((session_storage.group_outbound_sessions.find(room_id) !=
+             session_storage.group_outbound_sessions.end()) &&
+            (session_storage.group_outbound_session_data.find(room_id) !=
+             session_storage.group_outbound_session_data.end()))
+                return true;
+
+        return restoreOutboundMegolmSession(room_id);
 }
 
 OutboundGroupSessionDataRef
 Cache::getOutboundMegolmSession(const std::string &room_id)
 {
         std::unique_lock<std::mutex> lock(session_storage.group_outbound_mtx);
+
+        if (session_storage.group_outbound_sessions.find(room_id) ==
+            session_storage.group_outbound_sessions.end())
+                restoreOutboundMegolmSession(room_id);
+
         return OutboundGroupSessionDataRef{session_storage.group_outbound_sessions[room_id].get(),
                                            session_storage.group_outbound_session_data[room_id]};
 }
 
+bool
+Cache::restoreOutboundMegolmSession(const std::string &room_id)
+{
+        using namespace mtx::crypto;
+
+        try {
+                ReadTxn txn(*this);
+
+                lmdb::val value;
+                if (!lmdb::dbi_get(txn, outboundMegolmSessionDb_, lmdb::val(room_id), value))
+                        return false;
+
+                auto obj = json::parse(std::string(value.data(), value.size()));
+
+                session_storage.group_outbound_session_data[room_id] =
+                  obj.at("data").get<OutboundGroupSessionData>();
+                session_storage.group_outbound_sessions[room_id] =
+                  unpickle<OutboundSessionObject>(obj.at("session"), SECRET);
+
+                return true;
+        } catch (const std::exception &e) {
+                nhlog::db()->critical("failed to restore outbound megolm session: {}", e.what());
+                return false;
+        }
+}
+
 //
 // OLM sessions.
 //
@@ -395,65 +755,145 @@ Cache::saveOlmAccount(const std::string &data)
 
 void
 Cache::restoreSessions()
+{
+        // Sessions are unpickled on first use, so login doesn't block on
+        // the accumulated history; the warming below only hides the first
+        // use latency.
+        QtConcurrent::run([this]() { warmSessionCache(); });
+}
+
+void
+Cache::warmSessionCache() noexcept
 {
         using namespace mtx::crypto;
 
-        auto txn = lmdb::txn::begin(env_, nullptr, MDB_RDONLY);
-        std::string key, value;
+        std::size_t restored = 0;
 
-        //
-        // Inbound Megolm Sessions
-        //
-        {
-                auto cursor = lmdb::cursor::open(txn, inboundMegolmSessionDb_);
-                while (cursor.get(key, value, MDB_NEXT)) {
-                        auto session = unpickle<InboundSessionObject>(value, SECRET);
-                        session_storage.group_inbound_sessions[key] = std::move(session);
+        try {
+                ReadTxn txn(*this);
+                std::string key, value;
+
+                // The outbound sessions come first since they gate sending;
+                // there is at most one per encrypted room.
+                {
+                        auto cursor = lmdb::cursor::open(txn, outboundMegolmSessionDb_);
+                        while (cursor.get(key, value, MDB_NEXT)) {
+                                std::unique_lock<std::mutex> lock(
+                                  session_storage.group_outbound_mtx);
+
+                                if (session_storage.group_outbound_sessions.find(key) !=
+                                    session_storage.group_outbound_sessions.end())
+                                        continue;
+
+                                try {
+                                        auto obj = json::parse(value);
+
+                                        session_storage.group_outbound_session_data[key] =
+                                          obj.at("data").get<OutboundGroupSessionData>();
+                                        session_storage.group_outbound_sessions[key] =
+                                          unpickle<OutboundSessionObject>(obj.at("session"),
+                                                                          SECRET);
+
+                                        restored += 1;
+                                } catch (const nlohmann::json::exception &e) {
+                                        nhlog::db()->critical(
+                                          "failed to parse outbound megolm session data: {}",
+                                          e.what());
+                                }
+                        }
+                        cursor.close();
                 }
-                cursor.close();
-        }
 
-        //
-        // Outbound Megolm Sessions
-        //
-        {
-                auto cursor = lmdb::cursor::open(txn, outboundMegolmSessionDb_);
-                while (cursor.get(key, value, MDB_NEXT)) {
-                        json obj;
+                {
+                        auto cursor = lmdb::cursor::open(txn, inboundMegolmSessionDb_);
+                        while (cursor.get(key, value, MDB_NEXT)) {
+                                std::unique_lock<std::mutex> lock(
+                                  session_storage.group_inbound_mtx);
 
-                        try {
-                                obj = json::parse(value);
+                                if (session_storage.group_inbound_sessions.find(key) !=
+                                    session_storage.group_inbound_sessions.end())
+                                        continue;
+
+                                auto &entry = session_storage.group_inbound_sessions[key];
 
-                                session_storage.group_outbound_session_data[key] =
-                                  obj.at("data").get<OutboundGroupSessionData>();
+                                entry.mutex   = std::make_shared<std::mutex>();
+                                entry.session = std::shared_ptr<OlmInboundGroupSession>(
+                                  unpickle<InboundSessionObject>(value, SECRET));
 
-                                auto session =
-                                  unpickle<OutboundSessionObject>(obj.at("session"), SECRET);
-                                session_storage.group_outbound_sessions[key] = std::move(session);
-                        } catch (const nlohmann::json::exception &e) {
-                                nhlog::db()->critical(
-                                  "failed to parse outbound megolm session data: {}", e.what());
+                                restored += 1;
                         }
+                        cursor.close();
                 }
-                cursor.close();
+        } catch (const std::exception &e) {
+                nhlog::db()->critical("failed to warm the session cache: {}", e.what());
         }
 
-        txn.commit();
-
-        nhlog::db()->info("sessions restored");
+        nhlog::db()->info("warmed {} megolm sessions", restored);
 }
 
 std::string
 Cache::restoreOlmAccount()
 {
-        auto txn = lmdb::txn::begin(env_, nullptr, MDB_RDONLY);
+        ReadTxn txn(*this);
         lmdb::val pickled;
         lmdb::dbi_get(txn, syncStateDb_, OLM_ACCOUNT_KEY, pickled);
-        txn.commit();
 
         return std::string(pickled.data(), pickled.size());
 }
 
+void
+Cache::saveDecryptedEvent(const std::string &room_id,
+                          const std::string &event_id,
+                          const std::string &payload)
+{
+        auto txn = lmdb::txn::begin(env_);
+        auto db  = getDecryptedEventsDb(txn, room_id);
+
+        lmdb::dbi_put(txn, db, lmdb::val(event_id), lmdb::val(payload));
+
+        txn.commit();
+}
+
+boost::optional<std::string>
+Cache::getDecryptedEvent(const std::string &room_id, const std::string &event_id)
+{
+        try {
+                ReadTxn txn(*this);
+                auto db = getDecryptedEventsDb(txn, room_id);
+
+                lmdb::val payload;
+                if (!lmdb::dbi_get(txn, db, lmdb::val(event_id), payload))
+                        return boost::none;
+
+                return std::string(payload.data(), payload.size());
+        } catch (const lmdb::error &) {
+                // The room hasn't stored any decrypted events yet.
+                return boost::none;
+        }
+}
+
+std::map<std::string, std::string>
+Cache::getDecryptedEvents(const std::string &room_id, const std::vector<std::string> &event_ids)
+{
+        std::map<std::string, std::string> payloads;
+
+        try {
+                ReadTxn txn(*this);
+                auto db = getDecryptedEventsDb(txn, room_id);
+
+                for (const auto &event_id : event_ids) {
+                        lmdb::val payload;
+                        if (lmdb::dbi_get(txn, db, lmdb::val(event_id), payload))
+                                payloads.emplace(event_id,
+                                                 std::string(payload.data(), payload.size()));
+                }
+        } catch (const lmdb::error &) {
+                // The room hasn't stored any decrypted events yet.
+        }
+
+        return payloads;
+}
+
 //
 // Media Management
 //
@@ -472,101 +912,278 @@ Cache::saveImage(const std::string &url, const std::string &img_data)
                               lmdb::val(url.data(), url.size()),
                               lmdb::val(img_data.data(), img_data.size()));
 
+                markMediaAccessed(txn, url);
+
                 txn.commit();
         } catch (const lmdb::error &e) {
                 nhlog::db()->critical("saveImage: {}", e.what());
         }
 }
 
+void
+Cache::markMediaAccessed(lmdb::txn &txn, const std::string &url) const
+{
+        const auto ts =
+          timestampKey(static_cast<uint64_t>(QDateTime::currentMSecsSinceEpoch()));
+
+        lmdb::dbi_put(
+          txn, mediaAccessDb_, lmdb::val(url.data(), url.size()), lmdb::val(ts.data(), ts.size()));
+}
+
 void
 Cache::saveImage(const QString &url, const QByteArray &image)
 {
         saveImage(url.toStdString(), std::string(image.constData(), image.length()));
 }
 
-QByteArray
+//! Decode an image straight from the database's memory map. The view is
+//! only valid while the transaction is open, but the decode finishes
+//! inside it and the resulting QImage owns its pixels.
+static QImage
+decodeMapped(const lmdb::val &image)
+{
+        return QImage::fromData(
+          QByteArray::fromRawData(image.data(), static_cast<int>(image.size())));
+}
+
+QImage
 Cache::image(lmdb::txn &txn, const std::string &url) const
 {
         if (url.empty())
-                return QByteArray();
+                return QImage();
 
         try {
                 lmdb::val image;
                 bool res = lmdb::dbi_get(txn, mediaDb_, lmdb::val(url), image);
 
+                perf::accountCacheOp(res ? perf::CacheOp::ImageHit : perf::CacheOp::ImageMiss);
+
                 if (!res)
-                        return QByteArray();
+                        return QImage();
 
-                return QByteArray(image.data(), image.size());
+                return decodeMapped(image);
         } catch (const lmdb::error &e) {
                 nhlog::db()->critical("image: {}, {}", e.what(), url);
         }
 
-        return QByteArray();
+        return QImage();
 }
 
-QByteArray
+QImage
 Cache::image(const QString &url) const
 {
         if (url.isEmpty())
-                return QByteArray();
+                return QImage();
 
         auto key = url.toUtf8();
 
         try {
-                auto txn = lmdb::txn::begin(env_, nullptr, MDB_RDONLY);
+                QImage decoded;
 
-                lmdb::val image;
+                {
+                        ReadTxn txn(*this);
 
-                bool res = lmdb::dbi_get(txn, mediaDb_, lmdb::val(key.data(), key.size()), image);
+                        lmdb::val image;
 
-                txn.commit();
+                        bool res =
+                          lmdb::dbi_get(txn, mediaDb_, lmdb::val(key.data(), key.size()), image);
 
-                if (!res)
-                        return QByteArray();
+                        perf::accountCacheOp(res ? perf::CacheOp::ImageHit
+                                                 : perf::CacheOp::ImageMiss);
+
+                        if (!res)
+                                return QImage();
+
+                        decoded = decodeMapped(image);
+                }
 
-                return QByteArray(image.data(), image.size());
+                // Touch the entry so the eviction pass treats it as recently used.
+                auto accessTxn = lmdb::txn::begin(env_);
+                markMediaAccessed(accessTxn, key.toStdString());
+                accessTxn.commit();
+
+                return decoded;
         } catch (const lmdb::error &e) {
                 nhlog::db()->critical("image: {} {}", e.what(), url.toStdString());
         }
 
-        return QByteArray();
+        return QImage();
 }
 
-void
-Cache::removeInvite(lmdb::txn &txn, const std::string &room_id)
+QImage
+Cache::imageThumbnail(const QString &url, const QSize &box) const
 {
-        lmdb::dbi_del(txn, invitesDb_, lmdb::val(room_id), nullptr);
-        lmdb::dbi_drop(txn, getInviteStatesDb(txn, room_id), true);
-        lmdb::dbi_drop(txn, getInviteMembersDb(txn, room_id), true);
-}
+        if (url.isEmpty() || box.isEmpty())
+                return QImage();
 
-void
-Cache::removeInvite(const std::string &room_id)
-{
-        auto txn = lmdb::txn::begin(env_);
-        removeInvite(txn, room_id);
-        txn.commit();
-}
+        const auto key = thumbnailKey(url.toStdString(), box);
 
-void
-Cache::removeRoom(lmdb::txn &txn, const std::string &roomid)
-{
-        lmdb::dbi_del(txn, roomsDb_, lmdb::val(roomid), nullptr);
-        lmdb::dbi_drop(txn, getStatesDb(txn, roomid), true);
-        lmdb::dbi_drop(txn, getMembersDb(txn, roomid), true);
+        try {
+                QImage decoded;
+
+                {
+                        ReadTxn txn(*this);
+
+                        lmdb::val image;
+
+                        if (!lmdb::dbi_get(
+                              txn, mediaThumbnailsDb_, lmdb::val(key.data(), key.size()), image))
+                                return QImage();
+
+                        decoded = decodeMapped(image);
+                }
+
+                // Touch the entry so the eviction pass treats it as recently used.
+                auto accessTxn = lmdb::txn::begin(env_);
+                markMediaAccessed(accessTxn, key);
+                accessTxn.commit();
+
+                return decoded;
+        } catch (const lmdb::error &e) {
+                nhlog::db()->critical("imageThumbnail: {} {}", e.what(), url.toStdString());
+        }
+
+        return QImage();
 }
 
-void
-Cache::removeRoom(const std::string &roomid)
+QImage
+Cache::scaledImage(const QString &url, int pixelSize)
 {
-        auto txn = lmdb::txn::begin(env_, nullptr, 0);
-        lmdb::dbi_del(txn, roomsDb_, lmdb::val(roomid), nullptr);
-        txn.commit();
+        if (url.isEmpty() || pixelSize <= 0)
+                return QImage();
+
+        const QSize box(pixelSize, pixelSize);
+
+        auto scaled = imageThumbnail(url, box);
+        if (!scaled.isNull())
+                return scaled;
+
+        const auto original = image(url);
+        if (original.isNull())
+                return QImage();
+
+        scaled = original.scaled(box, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+        QByteArray encoded;
+        QBuffer buffer(&encoded);
+        buffer.open(QIODevice::WriteOnly);
+        scaled.save(&buffer, "PNG");
+
+        saveImageThumbnail(url, box, encoded);
+
+        return scaled;
 }
 
 void
-Cache::setNextBatchToken(lmdb::txn &txn, const std::string &token)
+Cache::saveImageThumbnail(const QString &url, const QSize &box, const QByteArray &data)
+{
+        if (url.isEmpty() || box.isEmpty() || data.isEmpty())
+                return;
+
+        const auto key = thumbnailKey(url.toStdString(), box);
+
+        try {
+                auto txn = lmdb::txn::begin(env_);
+
+                lmdb::dbi_put(txn,
+                              mediaThumbnailsDb_,
+                              lmdb::val(key.data(), key.size()),
+                              lmdb::val(data.constData(), data.size()));
+
+                markMediaAccessed(txn, key);
+
+                txn.commit();
+        } catch (const lmdb::error &e) {
+                nhlog::db()->critical("saveImageThumbnail: {}", e.what());
+        }
+}
+
+QHash<QString, QImage>
+Cache::images(const std::vector<QString> &urls) const
+{
+        QHash<QString, QImage> images;
+
+        if (urls.empty())
+                return images;
+
+        try {
+                ReadTxn txn(*this);
+
+                for (const auto &url : urls) {
+                        if (url.isEmpty())
+                                continue;
+
+                        const auto key = url.toUtf8();
+
+                        lmdb::val image;
+                        if (lmdb::dbi_get(
+                              txn, mediaDb_, lmdb::val(key.data(), key.size()), image))
+                                images.insert(url, decodeMapped(image));
+                }
+        } catch (const lmdb::error &e) {
+                nhlog::db()->critical("images: {}", e.what());
+                return images;
+        }
+
+        if (images.isEmpty())
+                return images;
+
+        try {
+                // Touch the entries so the eviction pass treats them as
+                // recently used.
+                auto accessTxn = lmdb::txn::begin(env_);
+                for (auto it = images.constBegin(); it != images.constEnd(); ++it)
+                        markMediaAccessed(accessTxn, it.key().toStdString());
+                accessTxn.commit();
+        } catch (const lmdb::error &e) {
+                nhlog::db()->critical("images: {}", e.what());
+        }
+
+        return images;
+}
+
+bool
+Cache::removeInvite(lmdb::txn &txn, const std::string &room_id)
+{
+        const bool removed = lmdb::dbi_del(txn, invitesDb_, lmdb::val(room_id), nullptr);
+
+        lmdb::dbi_drop(txn, getInviteStatesDb(txn, room_id), true);
+        lmdb::dbi_drop(txn, getInviteMembersDb(txn, room_id), true);
+
+        return removed;
+}
+
+void
+Cache::removeInvite(const std::string &room_id)
+{
+        auto txn = lmdb::txn::begin(env_);
+        removeInvite(txn, room_id);
+        txn.commit();
+}
+
+void
+Cache::removeRoom(lmdb::txn &txn, const std::string &roomid)
+{
+        lmdb::dbi_del(txn, roomsDb_, lmdb::val(roomid), nullptr);
+        lmdb::dbi_drop(txn, getStatesDb(txn, roomid), true);
+        lmdb::dbi_drop(txn, getMembersDb(txn, roomid), true);
+
+        dropRoomSearchEntry(roomid);
+        invalidateMembershipFilter(roomid);
+}
+
+void
+Cache::removeRoom(const std::string &roomid)
+{
+        auto txn = lmdb::txn::begin(env_, nullptr, 0);
+        lmdb::dbi_del(txn, roomsDb_, lmdb::val(roomid), nullptr);
+        txn.commit();
+
+        dropRoomSearchEntry(roomid);
+}
+
+void
+Cache::setNextBatchToken(lmdb::txn &txn, const std::string &token)
 {
         lmdb::dbi_put(txn, syncStateDb_, NEXT_BATCH_KEY, lmdb::val(token.data(), token.size()));
 }
@@ -580,26 +1197,22 @@ Cache::setNextBatchToken(lmdb::txn &txn, const QString &token)
 bool
 Cache::isInitialized() const
 {
-        auto txn = lmdb::txn::begin(env_, nullptr, MDB_RDONLY);
+        ReadTxn txn(*this);
         lmdb::val token;
 
         bool res = lmdb::dbi_get(txn, syncStateDb_, NEXT_BATCH_KEY, token);
 
-        txn.commit();
-
         return res;
 }
 
 std::string
 Cache::nextBatchToken() const
 {
-        auto txn = lmdb::txn::begin(env_, nullptr, MDB_RDONLY);
+        ReadTxn txn(*this);
         lmdb::val token;
 
         lmdb::dbi_get(txn, syncStateDb_, NEXT_BATCH_KEY, token);
 
-        txn.commit();
-
         return std::string(token.data(), token.size());
 }
 
@@ -616,13 +1229,11 @@ Cache::deleteData()
 bool
 Cache::isFormatValid()
 {
-        auto txn = lmdb::txn::begin(env_, nullptr, MDB_RDONLY);
+        ReadTxn txn(*this);
 
         lmdb::val current_version;
         bool res = lmdb::dbi_get(txn, syncStateDb_, CACHE_FORMAT_VERSION_KEY, current_version);
 
-        txn.commit();
-
         if (!res)
                 return true;
 
@@ -652,6 +1263,280 @@ Cache::setCurrentFormat()
         txn.commit();
 }
 
+std::string
+Cache::cacheFormatVersion()
+{
+        ReadTxn txn(*this);
+
+        lmdb::val version;
+        if (!lmdb::dbi_get(txn, syncStateDb_, CACHE_FORMAT_VERSION_KEY, version))
+                return CURRENT_CACHE_FORMAT_VERSION;
+
+        return std::string(version.data(), version.size());
+}
+
+void
+Cache::migrateValues(
+  const std::string &dbName,
+  std::function<std::string(const std::string &key, const std::string &value)> transform)
+{
+        // An interrupted run left the key it stopped at; start past it.
+        std::string resumeKey;
+        {
+                ReadTxn txn(*this);
+
+                lmdb::val checkpoint;
+                if (lmdb::dbi_get(txn, syncStateDb_, MIGRATION_CHECKPOINT_KEY, checkpoint)) {
+                        const std::string stored(checkpoint.data(), checkpoint.size());
+                        const auto sep = stored.find('\x1f');
+
+                        if (sep != std::string::npos && stored.substr(0, sep) == dbName) {
+                                resumeKey = stored.substr(sep + 1);
+                                nhlog::db()->info(
+                                  "resuming migration of {} after {}", dbName, resumeKey);
+                        }
+                }
+        }
+
+        while (true) {
+                auto txn    = lmdb::txn::begin(env_);
+                auto db     = lmdb::dbi::open(txn, dbName.c_str(), MDB_CREATE);
+                auto cursor = lmdb::cursor::open(txn, db);
+
+                std::string key = resumeKey;
+                std::string value;
+
+                bool ok;
+                if (resumeKey.empty()) {
+                        ok = cursor.get(key, value, MDB_FIRST);
+                } else {
+                        ok = cursor.get(key, value, MDB_SET_RANGE);
+                        if (ok && key == resumeKey)
+                                ok = cursor.get(key, value, MDB_NEXT);
+                }
+
+                // Rewrites are collected first; writing through the dbi
+                // while the cursor walks it would invalidate the cursor.
+                std::vector<std::pair<std::string, std::string>> rewrites;
+
+                while (ok && rewrites.size() < MIGRATION_BATCH_SIZE) {
+                        auto rewritten = transform(key, value);
+                        if (rewritten != value)
+                                rewrites.emplace_back(key, std::move(rewritten));
+
+                        resumeKey = key;
+
+                        ok = cursor.get(key, value, MDB_NEXT);
+                }
+
+                cursor.close();
+
+                for (const auto &record : rewrites)
+                        lmdb::dbi_put(
+                          txn, db, lmdb::val(record.first), lmdb::val(record.second));
+
+                if (ok) {
+                        // More records follow; make the progress durable
+                        // together with the batch itself.
+                        const auto checkpoint = dbName + '\x1f' + resumeKey;
+                        lmdb::dbi_put(
+                          txn, syncStateDb_, MIGRATION_CHECKPOINT_KEY, lmdb::val(checkpoint));
+                        txn.commit();
+
+                        continue;
+                }
+
+                lmdb::dbi_del(txn, syncStateDb_, MIGRATION_CHECKPOINT_KEY, nullptr);
+                txn.commit();
+
+                return;
+        }
+}
+
+std::vector<std::string>
+Cache::databaseNames()
+{
+        std::vector<std::string> names;
+
+        ReadTxn txn(*this);
+
+        // The keys of the unnamed root database are the names of every
+        // named database in the environment.
+        auto main   = lmdb::dbi::open(txn, nullptr);
+        auto cursor = lmdb::cursor::open(txn, main);
+
+        std::string name, ignored;
+        while (cursor.get(name, ignored, MDB_NEXT))
+                names.push_back(name);
+
+        cursor.close();
+
+        return names;
+}
+
+void
+Cache::migrateMessagesDb(const std::string &room_id)
+{
+        auto txn = lmdb::txn::begin(env_);
+        auto db  = lmdb::dbi::open(txn, std::string(room_id + "/messages").c_str());
+
+        std::string key, value;
+
+        auto cursor = lmdb::cursor::open(txn, db);
+
+        // The rewrite below is atomic, so a fixed-width first key means an
+        // earlier run already converted the whole database.
+        if (!cursor.get(key, value, MDB_FIRST) || key.size() == sizeof(uint64_t)) {
+                cursor.close();
+                txn.abort();
+                return;
+        }
+
+        std::vector<std::pair<std::string, std::string>> messages;
+        std::vector<std::pair<std::string, std::string>> eventIndex;
+        std::vector<SearchIndexEntry> searchEntries;
+
+        do {
+                try {
+                        const auto obj    = json::parse(value);
+                        const auto ts     = std::stoull(key);
+                        const auto &event = obj.at("event");
+
+                        auto timelineKey = timestampKey(ts);
+
+                        const auto event_id = event.value("event_id", std::string{});
+                        if (!event_id.empty()) {
+                                eventIndex.emplace_back(event_id, timelineKey);
+
+                                const auto body = event.value("content", json::object())
+                                                    .value("body", std::string{});
+                                if (!body.empty())
+                                        searchEntries.push_back(
+                                          SearchIndexEntry{room_id, event_id, ts, body});
+                        }
+
+                        messages.emplace_back(std::move(timelineKey), compressRecord(value));
+                } catch (const std::exception &e) {
+                        nhlog::db()->warn(
+                          "[{}] dropping unconvertible timeline record: {}", room_id, e.what());
+                }
+        } while (cursor.get(key, value, MDB_NEXT));
+
+        cursor.close();
+
+        // The emptied tree can adopt the binary key comparator safely.
+        lmdb::dbi_drop(txn, db, false);
+
+        auto messagesdb = getMessagesDb(txn, room_id);
+
+        // Newest-first, matching the reversed comparator.
+        std::stable_sort(messages.begin(), messages.end(), [](const auto &a, const auto &b) {
+                return b.first < a.first;
+        });
+
+        for (const auto &entry : messages)
+                lmdb::dbi_put(txn, messagesdb, lmdb::val(entry.first), lmdb::val(entry.second));
+
+        for (const auto &entry : eventIndex) {
+                const auto location = room_id + "\x1f" + entry.second;
+                lmdb::dbi_put(txn, eventIndexDb_, lmdb::val(entry.first), lmdb::val(location));
+        }
+
+        txn.commit();
+
+        writeSearchIndex(searchEntries);
+}
+
+bool
+Cache::migrateTo20180921()
+{
+        // 2018.09.21 changed the on-disk encodings wholesale: state,
+        // member & room records became CBOR, message values gained
+        // compression and message keys turned into fixed-width binary
+        // timestamps. Rewriting everything in place is what makes the
+        // upgrade a pass over the cache instead of a full re-sync.
+        auto toBinary = [](const std::string &, const std::string &value) {
+                try {
+                        return serializeRecord(json::parse(value));
+                } catch (const json::parse_error &) {
+                        // Already CBOR, from an interrupted earlier run.
+                        return value;
+                }
+        };
+
+        migrateValues(ROOMS_DB, toBinary);
+        migrateValues(INVITES_DB, toBinary);
+
+        const auto hasSuffix = [](const std::string &name, const std::string &suffix) {
+                return name.size() > suffix.size() &&
+                       name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+        };
+
+        for (const auto &name : databaseNames()) {
+                if (hasSuffix(name, "/state") || hasSuffix(name, "/invite_state") ||
+                    hasSuffix(name, "/members") || hasSuffix(name, "/invite_members"))
+                        migrateValues(name, toBinary);
+                else if (hasSuffix(name, "/messages"))
+                        migrateMessagesDb(
+                          name.substr(0, name.size() - std::string("/messages").size()));
+        }
+
+        return true;
+}
+
+bool
+Cache::runMigrations()
+{
+        // Each entry upgrades one known format to its successor;
+        // chained they bring any supported version up to date.
+        struct Migration
+        {
+                std::string from;
+                std::string to;
+                bool (Cache::*apply)();
+        };
+
+        static const std::vector<Migration> migrations{
+          {"2018.06.10", "2018.09.21", &Cache::migrateTo20180921},
+        };
+
+        auto version = cacheFormatVersion();
+
+        while (version != CURRENT_CACHE_FORMAT_VERSION) {
+                const auto step =
+                  std::find_if(migrations.cbegin(), migrations.cend(), [&version](const auto &m) {
+                          return m.from == version;
+                  });
+
+                if (step == migrations.cend()) {
+                        nhlog::db()->warn("no migration path for cache format {}", version);
+                        return false;
+                }
+
+                nhlog::db()->info("migrating cache format {} -> {}", step->from, step->to);
+
+                try {
+                        if (!(this->*step->apply)())
+                                return false;
+                } catch (const std::exception &e) {
+                        nhlog::db()->error(
+                          "cache migration to {} failed: {}", step->to, e.what());
+                        return false;
+                }
+
+                // The version advances only after the whole step is
+                // durable; an interrupted run repeats it and the batch
+                // checkpoints make the repeat cheap.
+                auto txn = lmdb::txn::begin(env_);
+                lmdb::dbi_put(txn, syncStateDb_, CACHE_FORMAT_VERSION_KEY, lmdb::val(step->to));
+                txn.commit();
+
+                version = step->to;
+        }
+
+        return true;
+}
+
 std::vector<QString>
 Cache::pendingReceiptsEvents(lmdb::txn &txn, const std::string &room_id)
 {
@@ -716,82 +1601,258 @@ Cache::addPendingReceipt(const QString &room_id, const QString &event_id)
         txn.commit();
 }
 
-CachedReceipts
-Cache::readReceipts(const QString &event_id, const QString &room_id)
+void
+Cache::addPendingReceipts(const std::vector<std::pair<QString, QString>> &entries)
 {
-        CachedReceipts receipts;
-
-        ReadReceiptKey receipt_key{event_id.toStdString(), room_id.toStdString()};
-        nlohmann::json json_key = receipt_key;
+        auto txn = lmdb::txn::begin(env_);
+        auto db  = getPendingReceiptsDb(txn);
 
-        try {
-                auto txn = lmdb::txn::begin(env_, nullptr, MDB_RDONLY);
-                auto key = json_key.dump();
+        std::string empty;
 
-                lmdb::val value;
+        for (const auto &entry : entries) {
+                ReadReceiptKey receipt_key{entry.second.toStdString(), entry.first.toStdString()};
+                auto key = json(receipt_key).dump();
 
-                bool res =
-                  lmdb::dbi_get(txn, readReceiptsDb_, lmdb::val(key.data(), key.size()), value);
+                try {
+                        lmdb::dbi_put(txn,
+                                      db,
+                                      lmdb::val(key.data(), key.size()),
+                                      lmdb::val(empty.data(), empty.size()));
+                } catch (const lmdb::error &e) {
+                        nhlog::db()->critical("addPendingReceipts: {}", e.what());
+                }
+        }
 
-                txn.commit();
+        txn.commit();
+}
 
-                if (res) {
-                        auto json_response = json::parse(std::string(value.data(), value.size()));
-                        auto values        = json_response.get<std::map<std::string, uint64_t>>();
+void
+Cache::savePendingMessage(const std::string &room_id,
+                          const std::string &txn_id,
+                          const std::string &msg)
+{
+        auto txn = lmdb::txn::begin(env_);
+        auto db  = getPendingMessagesDb(txn, room_id);
 
-                        for (const auto &v : values)
-                                // timestamp, user_id
-                                receipts.emplace(v.second, v.first);
-                }
+        // Keys sort chronologically so the queue order survives a restart.
+        const auto key = QString("%1\x1f%2")
+                           .arg(QString::number(QDateTime::currentMSecsSinceEpoch())
+                                  .rightJustified(20, QChar('0')))
+                           .arg(QString::fromStdString(txn_id))
+                           .toStdString();
 
+        try {
+                lmdb::dbi_put(txn,
+                              db,
+                              lmdb::val(key.data(), key.size()),
+                              lmdb::val(msg.data(), msg.size()));
         } catch (const lmdb::error &e) {
-                nhlog::db()->critical("readReceipts: {}", e.what());
+                nhlog::db()->critical("savePendingMessage: {}", e.what());
         }
 
-        return receipts;
+        txn.commit();
 }
 
-std::vector<QString>
-Cache::filterReadEvents(const QString &room_id,
-                        const std::vector<QString> &event_ids,
-                        const std::string &excluded_user)
+void
+Cache::removePendingMessage(const std::string &room_id, const std::string &txn_id)
 {
-        std::vector<QString> read_events;
-
-        for (const auto &event : event_ids) {
-                auto receipts = readReceipts(event, room_id);
+        if (txn_id.empty())
+                return;
 
-                if (receipts.size() == 0)
-                        continue;
+        auto txn    = lmdb::txn::begin(env_);
+        auto db     = getPendingMessagesDb(txn, room_id);
+        auto cursor = lmdb::cursor::open(txn, db);
 
-                if (receipts.size() == 1) {
-                        if (receipts.begin()->second == excluded_user)
-                                continue;
+        std::string key, val;
+        while (cursor.get(key, val, MDB_NEXT)) {
+                if (key.size() > txn_id.size() &&
+                    key.compare(key.size() - txn_id.size(), txn_id.size(), txn_id) == 0) {
+                        cursor.del();
+                        break;
                 }
-
-                read_events.emplace_back(event);
         }
 
-        return read_events;
+        cursor.close();
+        txn.commit();
 }
 
-void
-Cache::updateReadReceipt(lmdb::txn &txn, const std::string &room_id, const Receipts &receipts)
+std::vector<std::string>
+Cache::pendingMessages(const std::string &room_id)
 {
-        for (const auto &receipt : receipts) {
-                const auto event_id = receipt.first;
-                auto event_receipts = receipt.second;
+        auto txn    = lmdb::txn::begin(env_);
+        auto db     = getPendingMessagesDb(txn, room_id);
+        auto cursor = lmdb::cursor::open(txn, db);
 
-                ReadReceiptKey receipt_key{event_id, room_id};
-                nlohmann::json json_key = receipt_key;
+        std::vector<std::string> messages;
 
-                try {
-                        const auto key = json_key.dump();
+        std::string key, val;
+        while (cursor.get(key, val, MDB_NEXT))
+                messages.push_back(val);
 
-                        lmdb::val prev_value;
+        cursor.close();
+        txn.commit();
 
-                        bool exists = lmdb::dbi_get(
-                          txn, readReceiptsDb_, lmdb::val(key.data(), key.size()), prev_value);
+        return messages;
+}
+
+//! Receipts are keyed with the room id first so all of a room's entries
+//! are contiguous and a batch of events can be resolved with a forward
+//! scan instead of a point query per event.
+static std::string
+readReceiptKey(const std::string &room_id, const std::string &event_id)
+{
+        return room_id + '\0' + event_id;
+}
+
+//! Bound of the receipt snapshot. On overflow the snapshot starts over
+//! instead of tracking recency; it refills from the reads that matter.
+constexpr int RECEIPT_SHARD_MAX_ENTRIES = 1024;
+
+void
+Cache::publishReceipts(const std::vector<std::pair<QString, UserReceipts>> &adds,
+                       const std::vector<QString> &removes)
+{
+        std::lock_guard<std::mutex> lock(receiptShardMutex_);
+
+        auto next = std::make_shared<ReceiptShard>(*std::atomic_load(&receiptShard_));
+
+        for (const auto &key : removes)
+                next->remove(key);
+
+        if (next->size() + static_cast<int>(adds.size()) > RECEIPT_SHARD_MAX_ENTRIES)
+                next->clear();
+
+        for (const auto &entry : adds)
+                next->insert(entry.first, entry.second);
+
+        std::atomic_store(&receiptShard_,
+                          std::shared_ptr<const ReceiptShard>(std::move(next)));
+}
+
+CachedReceipts
+Cache::readReceipts(const QString &event_id, const QString &room_id)
+{
+        ReadTxn txn(*this);
+        return readReceipts(txn, event_id, room_id);
+}
+
+CachedReceipts
+Cache::readReceipts(lmdb::txn &txn, const QString &event_id, const QString &room_id)
+{
+        const auto overlayKey = receiptOverlayKey(room_id, event_id);
+
+        {
+                // Readers only load the current snapshot; they never
+                // contend with the sync writer.
+                const auto shard = std::atomic_load(&receiptShard_);
+
+                receiptOverlayLookups_ += 1;
+
+                auto it = shard->find(overlayKey);
+                if (it != shard->end()) {
+                        receiptOverlayHits_ += 1;
+                        return it.value();
+                }
+        }
+
+        CachedReceipts receipts;
+
+        try {
+                auto key = readReceiptKey(room_id.toStdString(), event_id.toStdString());
+
+                lmdb::val value;
+
+                bool res =
+                  lmdb::dbi_get(txn, readReceiptsDb_, lmdb::val(key.data(), key.size()), value);
+
+                if (res) {
+                        auto json_response = json::parse(std::string(value.data(), value.size()));
+                        auto values        = json_response.get<std::map<std::string, uint64_t>>();
+
+                        for (const auto &v : values)
+                                // timestamp, user_id
+                                receipts.emplace(v.second, v.first);
+                }
+
+        } catch (const lmdb::error &e) {
+                nhlog::db()->critical("readReceipts: {}", e.what());
+        }
+
+        publishReceipts({{overlayKey, receipts}}, {});
+
+        return receipts;
+}
+
+std::vector<QString>
+Cache::filterReadEvents(const QString &room_id,
+                        const std::vector<QString> &event_ids,
+                        const std::string &excluded_user)
+{
+        std::vector<QString> read_events;
+
+        if (event_ids.empty())
+                return read_events;
+
+        // The receipt keys share the room prefix, so with the queried ids
+        // in key order the whole batch becomes one forward merge of the
+        // cursor against the list; the cursor never moves backwards.
+        std::vector<std::string> sorted_ids;
+        sorted_ids.reserve(event_ids.size());
+        for (const auto &event : event_ids)
+                sorted_ids.push_back(event.toStdString());
+        std::sort(sorted_ids.begin(), sorted_ids.end());
+
+        ReadTxn txn(*this);
+
+        try {
+                const auto room = room_id.toStdString();
+                auto cursor     = lmdb::cursor::open(txn, readReceiptsDb_);
+
+                for (const auto &event : sorted_ids) {
+                        const auto key = readReceiptKey(room, event);
+
+                        lmdb::val db_key(key.data(), key.size());
+                        lmdb::val value;
+
+                        if (!cursor.get(db_key, value, MDB_SET_KEY))
+                                continue;
+
+                        auto receipts = json::parse(std::string(value.data(), value.size()))
+                                          .get<std::map<std::string, uint64_t>>();
+
+                        if (receipts.empty())
+                                continue;
+
+                        if (receipts.size() == 1 && receipts.begin()->first == excluded_user)
+                                continue;
+
+                        read_events.emplace_back(QString::fromStdString(event));
+                }
+
+                cursor.close();
+        } catch (const std::exception &e) {
+                nhlog::db()->critical("filterReadEvents: {}", e.what());
+        }
+
+        return read_events;
+}
+
+void
+Cache::updateReadReceipt(lmdb::txn &txn, const std::string &room_id, const Receipts &receipts)
+{
+        std::vector<QString> invalidated;
+
+        for (const auto &receipt : receipts) {
+                const auto event_id = receipt.first;
+                auto event_receipts = receipt.second;
+
+                try {
+                        const auto key = readReceiptKey(room_id, event_id);
+
+                        lmdb::val prev_value;
+
+                        bool exists = lmdb::dbi_get(
+                          txn, readReceiptsDb_, lmdb::val(key.data(), key.size()), prev_value);
 
                         std::map<std::string, uint64_t> saved_receipts;
 
@@ -818,10 +1879,18 @@ Cache::updateReadReceipt(lmdb::txn &txn, const std::string &room_id, const Recei
                                       lmdb::val(key.data(), key.size()),
                                       lmdb::val(merged_receipts.data(), merged_receipts.size()));
 
+                        invalidated.push_back(receiptOverlayKey(
+                          QString::fromStdString(room_id), QString::fromStdString(event_id)));
+
                 } catch (const lmdb::error &e) {
                         nhlog::db()->critical("updateReadReceipts: {}", e.what());
                 }
         }
+
+        // Drop the overlay entries of the whole batch with one snapshot
+        // swap; the next read repopulates them from the merged records.
+        if (!invalidated.empty())
+                publishReceipts({}, invalidated);
 }
 
 void
@@ -841,50 +1910,151 @@ Cache::notifyForReadReceipts(lmdb::txn &txn, const std::string &room_id)
                 emit newReadReceipts(QString::fromStdString(room_id), matches);
 }
 
-void
+std::vector<QString>
 Cache::saveState(const mtx::responses::Sync &res)
 {
+        nhlog_trace(nhlog::db(), "saveState: {} joined room(s)", res.rooms.join.size());
+
+        // Rooms are independent until the final merge, so their batches are
+        // serialized concurrently on the thread pool. On the initial sync
+        // this is where almost all of the time goes.
+        std::vector<QFuture<PreparedRoom>> prepared;
+        prepared.reserve(res.rooms.join.size());
+
+        for (const auto &room : res.rooms.join)
+                prepared.push_back(QtConcurrent::run([this, &room]() {
+                        perf::RoomSpan span(room.first, perf::RoomMetric::SaveState);
+                        perf::accountRoomEvents(room.first,
+                                                room.second.timeline.events.size() +
+                                                  room.second.state.events.size());
+
+                        return prepareRoom(room.first, room.second);
+                }));
+
+        perf::Span txnSpan("db.syncWriteTxn");
+
         auto txn = lmdb::txn::begin(env_);
 
         setNextBatchToken(txn, res.next_batch);
 
+        std::vector<SearchIndexEntry> searchEntries;
+        // The transaction knows exactly which invite entries it deletes,
+        // so the UI gets an explicit delta instead of re-scanning the
+        // whole invite database to detect removals.
+        std::vector<QString> removedInvites;
+
         // Save joined rooms
+        std::size_t roomIndex = 0;
         for (const auto &room : res.rooms.join) {
+                auto batch = prepared.at(roomIndex++).result();
+
+                applyPreparedRoom(txn, batch);
+
+                searchEntries.insert(searchEntries.end(),
+                                     std::make_move_iterator(batch.searchEntries.begin()),
+                                     std::make_move_iterator(batch.searchEntries.end()));
+
                 auto statesdb  = getStatesDb(txn, room.first);
                 auto membersdb = getMembersDb(txn, room.first);
 
-                saveStateEvents(txn, statesdb, membersdb, room.first, room.second.state.events);
-                saveStateEvents(txn, statesdb, membersdb, room.first, room.second.timeline.events);
+                // Resolve the display metadata only when the state feeding
+                // it actually changed in this sync; otherwise the values of
+                // the previous head record are carried over. The name and
+                // avatar fallbacks for DMs walk the members db with a
+                // cursor, which used to run per room on every sync.
+                const bool membersChanged  = !batch.members.empty();
+                const bool timelineTouched = !room.second.timeline.events.empty();
+
+                auto stateTouched = [&batch](mtx::events::EventType type) {
+                        const std::string key = to_string(type);
 
-                saveTimelineMessages(txn, room.first, room.second.timeline);
+                        for (const auto &entry : batch.state)
+                                if (entry.first == key)
+                                        return true;
+
+                        return false;
+                };
+
+                RoomInfo previous;
+                bool hasPrevious = false;
+
+                lmdb::val stored;
+                if (lmdb::dbi_get(txn, roomsDb_, lmdb::val(room.first), stored)) {
+                        try {
+                                previous    = parseRecord(stored.data(), stored.size());
+                                hasPrevious = true;
+                        } catch (const json::exception &e) {
+                                nhlog::db()->warn("failed to parse previous room record: {}",
+                                                  e.what());
+                        }
+                }
 
                 RoomInfo updatedInfo;
-                updatedInfo.name  = getRoomName(txn, statesdb, membersdb).toStdString();
-                updatedInfo.topic = getRoomTopic(txn, statesdb).toStdString();
-                updatedInfo.avatar_url =
-                  getRoomAvatarUrl(txn, statesdb, membersdb, QString::fromStdString(room.first))
-                    .toStdString();
+
+                if (!hasPrevious || membersChanged ||
+                    stateTouched(mtx::events::EventType::RoomName) ||
+                    stateTouched(mtx::events::EventType::RoomCanonicalAlias))
+                        updatedInfo.name = getRoomName(txn, statesdb, membersdb).toStdString();
+                else
+                        updatedInfo.name = previous.name;
+
+                if (!hasPrevious || stateTouched(mtx::events::EventType::RoomTopic))
+                        updatedInfo.topic = getRoomTopic(txn, statesdb).toStdString();
+                else
+                        updatedInfo.topic = previous.topic;
+
+                if (!hasPrevious || membersChanged ||
+                    stateTouched(mtx::events::EventType::RoomAvatar))
+                        updatedInfo.avatar_url =
+                          getRoomAvatarUrl(
+                            txn, statesdb, membersdb, QString::fromStdString(room.first))
+                            .toStdString();
+                else
+                        updatedInfo.avatar_url = previous.avatar_url;
+
+                // Snapshot the values that roomInfo() would otherwise have
+                // to recompute with per-room walks on startup.
+                updatedInfo.member_count =
+                  (!hasPrevious || membersChanged) ? membersdb.size(txn)
+                                                   : previous.member_count;
+                updatedInfo.msgInfo = (!hasPrevious || timelineTouched)
+                                        ? getLastMessageInfo(txn, room.first)
+                                        : previous.msgInfo;
+                updatedInfo.notification_count =
+                  room.second.unread_notifications.notification_count;
 
                 lmdb::dbi_put(
-                  txn, roomsDb_, lmdb::val(room.first), lmdb::val(json(updatedInfo).dump()));
+                  txn, roomsDb_, lmdb::val(room.first), lmdb::val(serializeRecord(json(updatedInfo))));
+
+                updateRoomSearchEntry(room.first, updatedInfo.name, updatedInfo.topic);
 
                 updateReadReceipt(txn, room.first, room.second.ephemeral.receipts);
 
                 // Clean up non-valid invites.
-                removeInvite(txn, room.first);
+                if (removeInvite(txn, room.first))
+                        removedInvites.push_back(QString::fromStdString(room.first));
         }
 
         saveInvites(txn, res.rooms.invite);
 
-        removeLeftRooms(txn, res.rooms.leave);
+        removeLeftRooms(txn, res.rooms.leave, removedInvites);
+
+        // Match the pending receipts within the same transaction, so the
+        // whole sync response is persisted with a single commit instead of
+        // one commit per room.
+        for (const auto &room : res.rooms.join)
+                notifyForReadReceipts(txn, room.first);
 
         txn.commit();
 
-        for (const auto &room : res.rooms.join) {
-                auto tmpTxn = lmdb::txn::begin(env_);
-                notifyForReadReceipts(tmpTxn, room.first);
-                tmpTxn.commit();
-        }
+        // Tokenizing & writing the search index happens on the thread
+        // pool so it doesn't affect the sync throughput.
+        if (!searchEntries.empty())
+                QtConcurrent::run([this, entries = std::move(searchEntries)]() {
+                        writeSearchIndex(entries);
+                });
+
+        return removedInvites;
 }
 
 void
@@ -901,10 +2071,11 @@ Cache::saveInvites(lmdb::txn &txn, const std::map<std::string, mtx::responses::I
                 updatedInfo.topic = getInviteRoomTopic(txn, statesdb).toStdString();
                 updatedInfo.avatar_url =
                   getInviteRoomAvatarUrl(txn, statesdb, membersdb).toStdString();
-                updatedInfo.is_invite = true;
+                updatedInfo.is_invite    = true;
+                updatedInfo.member_count = membersdb.size(txn);
 
                 lmdb::dbi_put(
-                  txn, invitesDb_, lmdb::val(room.first), lmdb::val(json(updatedInfo).dump()));
+                  txn, invitesDb_, lmdb::val(room.first), lmdb::val(serializeRecord(json(updatedInfo))));
         }
 }
 
@@ -928,14 +2099,15 @@ Cache::saveInvite(lmdb::txn &txn,
                         MemberInfo tmp{display_name, msg.content.avatar_url};
 
                         lmdb::dbi_put(
-                          txn, membersdb, lmdb::val(msg.state_key), lmdb::val(json(tmp).dump()));
+                          txn, membersdb, lmdb::val(msg.state_key), lmdb::val(serializeRecord(json(tmp))));
                 } else {
                         boost::apply_visitor(
                           [&txn, &statesdb](auto msg) {
-                                  bool res = lmdb::dbi_put(txn,
-                                                           statesdb,
-                                                           lmdb::val(to_string(msg.type)),
-                                                           lmdb::val(json(msg).dump()));
+                                  bool res =
+                                    lmdb::dbi_put(txn,
+                                                  statesdb,
+                                                  lmdb::val(to_string(msg.type)),
+                                                  lmdb::val(serializeRecord(json(msg))));
 
                                   if (!res)
                                           std::cout << "couldn't save data" << json(msg).dump()
@@ -946,46 +2118,104 @@ Cache::saveInvite(lmdb::txn &txn,
         }
 }
 
-std::vector<std::string>
-Cache::roomsWithStateUpdates(const mtx::responses::Sync &res)
+std::map<QString, RoomUpdate>
+Cache::roomUpdates(const mtx::responses::Sync &res)
 {
-        std::vector<std::string> rooms;
+        std::map<QString, RoomUpdate> updates;
+
+        // Classification pass; which fields could have changed is derived
+        // from the state events alone, without touching the database.
         for (const auto &room : res.rooms.join) {
-                bool hasUpdates = false;
-                for (const auto &s : room.second.state.events) {
-                        if (containsStateUpdates(s)) {
-                                hasUpdates = true;
-                                break;
-                        }
-                }
+                RoomUpdate update;
 
-                for (const auto &s : room.second.timeline.events) {
-                        if (containsStateUpdates(s)) {
-                                hasUpdates = true;
-                                break;
-                        }
-                }
+                for (const auto &s : room.second.state.events)
+                        classifyStateUpdates(s, update);
+                for (const auto &s : room.second.timeline.events)
+                        classifyStateUpdates(s, update);
 
-                if (hasUpdates)
-                        rooms.emplace_back(room.first);
+                if (update.nameChanged || update.avatarChanged || update.topicChanged ||
+                    update.membersChanged)
+                        updates.emplace(QString::fromStdString(room.first), update);
         }
 
         for (const auto &room : res.rooms.invite) {
-                for (const auto &s : room.second.invite_state) {
-                        if (containsStateUpdates(s)) {
-                                rooms.emplace_back(room.first);
-                                break;
+                RoomUpdate update;
+                update.is_invite = true;
+
+                for (const auto &s : room.second.invite_state)
+                        classifyStateUpdates(s, update);
+
+                if (update.nameChanged || update.avatarChanged || update.topicChanged ||
+                    update.membersChanged)
+                        updates.emplace(QString::fromStdString(room.first), update);
+        }
+
+        if (updates.empty())
+                return updates;
+
+        // Fill in only the fields that were marked as changed. The sync has
+        // already been saved at this point, so the calculated values can be
+        // read straight from the room records.
+        auto txn = lmdb::txn::begin(env_);
+
+        for (auto &entry : updates) {
+                const auto room_id = entry.first.toStdString();
+                auto &update       = entry.second;
+
+                lmdb::val data;
+
+                if (!update.is_invite && lmdb::dbi_get(txn, roomsDb_, lmdb::val(room_id), data)) {
+                        try {
+                                RoomInfo tmp = parseRecord(data.data(), data.size());
+
+                                if (update.nameChanged)
+                                        update.name = tmp.name;
+                                if (update.avatarChanged)
+                                        update.avatar_url = tmp.avatar_url;
+                                if (update.topicChanged)
+                                        update.topic = tmp.topic;
+                        } catch (const json::exception &e) {
+                                nhlog::db()->warn("failed to parse room info: room_id ({}), {}",
+                                                  room_id,
+                                                  e.what());
+                        }
+
+                        if (update.membersChanged)
+                                update.member_count = getMembersDb(txn, room_id).size(txn);
+                } else if (update.is_invite &&
+                           lmdb::dbi_get(txn, invitesDb_, lmdb::val(room_id), data)) {
+                        try {
+                                RoomInfo tmp = parseRecord(data.data(), data.size());
+
+                                update.name       = tmp.name;
+                                update.avatar_url = tmp.avatar_url;
+                                update.topic      = tmp.topic;
+                        } catch (const json::exception &e) {
+                                nhlog::db()->warn(
+                                  "failed to parse room info for invite: room_id ({}), {}",
+                                  room_id,
+                                  e.what());
                         }
+
+                        update.member_count = getInviteMembersDb(txn, room_id).size(txn);
                 }
         }
 
-        return rooms;
+        txn.commit();
+
+        return updates;
 }
 
 RoomInfo
 Cache::singleRoomInfo(const std::string &room_id)
 {
-        auto txn      = lmdb::txn::begin(env_, nullptr, MDB_RDONLY);
+        ReadTxn txn(*this);
+        return singleRoomInfo(txn, room_id);
+}
+
+RoomInfo
+Cache::singleRoomInfo(lmdb::txn &txn, const std::string &room_id)
+{
         auto statesdb = getStatesDb(txn, room_id);
 
         lmdb::val data;
@@ -993,13 +2223,11 @@ Cache::singleRoomInfo(const std::string &room_id)
         // Check if the room is joined.
         if (lmdb::dbi_get(txn, roomsDb_, lmdb::val(room_id), data)) {
                 try {
-                        RoomInfo tmp     = json::parse(std::string(data.data(), data.size()));
+                        RoomInfo tmp     = parseRecord(data.data(), data.size());
                         tmp.member_count = getMembersDb(txn, room_id).size(txn);
                         tmp.join_rule    = getRoomJoinRule(txn, statesdb);
                         tmp.guest_access = getRoomGuestAccess(txn, statesdb);
 
-                        txn.commit();
-
                         return tmp;
                 } catch (const json::exception &e) {
                         nhlog::db()->warn("failed to parse room info: room_id ({}), {}",
@@ -1008,11 +2236,108 @@ Cache::singleRoomInfo(const std::string &room_id)
                 }
         }
 
-        txn.commit();
+        // Check if the room is an invite.
+        if (lmdb::dbi_get(txn, invitesDb_, lmdb::val(room_id), data)) {
+                try {
+                        RoomInfo tmp     = parseRecord(data.data(), data.size());
+                        tmp.member_count = getInviteMembersDb(txn, room_id).size(txn);
+
+                        return tmp;
+                } catch (const json::exception &e) {
+                        nhlog::db()->warn("failed to parse room info for invite: room_id ({}), {}",
+                                          room_id,
+                                          std::string(data.data(), data.size()));
+                }
+        }
 
         return RoomInfo();
 }
 
+RoomStateSnapshot
+Cache::roomStateSnapshot(const std::string &room_id, const std::string &user_id)
+{
+        using namespace mtx::events;
+        using namespace mtx::events::state;
+
+        RoomStateSnapshot snapshot;
+
+        {
+                ReadTxn txn(*this);
+
+                snapshot.info   = singleRoomInfo(txn, room_id);
+                snapshot.avatar = image(txn, snapshot.info.avatar_url);
+
+                try {
+                        lmdb::val unused;
+                        auto encryptedDb = lmdb::dbi::open(txn, ENCRYPTED_ROOMS_DB);
+                        snapshot.is_encrypted =
+                          lmdb::dbi_get(txn, encryptedDb, lmdb::val(room_id), unused);
+                } catch (const lmdb::error &) {
+                        // The database is created when the first room turns
+                        // on encryption; without it no room is encrypted.
+                }
+
+                // All the permission checks come from one parse of the same
+                // power levels event, mirroring hasEnoughPowerLevel.
+                uint16_t user_level = std::numeric_limits<uint16_t>::min();
+                boost::optional<PowerLevels> levels;
+
+                try {
+                        auto statesdb = getStatesDb(txn, room_id);
+
+                        lmdb::val event;
+                        if (lmdb::dbi_get(txn,
+                                          statesdb,
+                                          lmdb::val(to_string(EventType::RoomPowerLevels)),
+                                          event)) {
+                                StateEvent<PowerLevels> msg =
+                                  parseRecord(event.data(), event.size());
+
+                                levels     = msg.content;
+                                user_level = msg.content.user_level(user_id);
+                        }
+                } catch (const json::exception &e) {
+                        nhlog::db()->warn("failed to parse m.room.power_levels event: {}",
+                                          e.what());
+                }
+
+                auto canSendAny = [&levels,
+                                   user_level](std::initializer_list<EventType> eventTypes) {
+                        if (!levels)
+                                return false;
+
+                        uint16_t min_event_level = std::numeric_limits<uint16_t>::max();
+                        for (const auto &ty : eventTypes)
+                                min_event_level =
+                                  std::min(min_event_level,
+                                           (uint16_t)levels->state_level(to_string(ty)));
+
+                        return user_level >= min_event_level;
+                };
+
+                snapshot.can_change_join_rules = canSendAny({EventType::RoomJoinRules});
+                snapshot.can_change_name_topic =
+                  canSendAny({EventType::RoomName, EventType::RoomTopic});
+                snapshot.can_change_avatar = canSendAny({EventType::RoomAvatar});
+                snapshot.can_kick_members  = canSendAny({EventType::RoomMember});
+        }
+
+        // The access stamp is a write and can't go through the pooled read
+        // transaction; touching the avatar afterwards only feeds the LRU
+        // eviction, so it doesn't need the snapshot's consistency.
+        if (!snapshot.avatar.isNull()) {
+                try {
+                        auto accessTxn = lmdb::txn::begin(env_);
+                        markMediaAccessed(accessTxn, snapshot.info.avatar_url);
+                        accessTxn.commit();
+                } catch (const lmdb::error &e) {
+                        nhlog::db()->warn("failed to mark avatar as accessed: {}", e.what());
+                }
+        }
+
+        return snapshot;
+}
+
 std::map<QString, RoomInfo>
 Cache::getRoomInfo(const std::vector<std::string> &rooms)
 {
@@ -1027,9 +2352,14 @@ Cache::getRoomInfo(const std::vector<std::string> &rooms)
 
                 // Check if the room is joined.
                 if (lmdb::dbi_get(txn, roomsDb_, lmdb::val(room), data)) {
+                        perf::accountCacheOp(perf::CacheOp::RoomInfoHit);
+
                         try {
-                                RoomInfo tmp = json::parse(std::string(data.data(), data.size()));
-                                tmp.member_count = getMembersDb(txn, room).size(txn);
+                                RoomInfo tmp = parseRecord(data.data(), data.size());
+
+                                if (tmp.member_count == 0)
+                                        tmp.member_count = getMembersDb(txn, room).size(txn);
+
                                 tmp.join_rule    = getRoomJoinRule(txn, statesdb);
                                 tmp.guest_access = getRoomGuestAccess(txn, statesdb);
 
@@ -1042,9 +2372,11 @@ Cache::getRoomInfo(const std::vector<std::string> &rooms)
                 } else {
                         // Check if the room is an invite.
                         if (lmdb::dbi_get(txn, invitesDb_, lmdb::val(room), data)) {
+                                perf::accountCacheOp(perf::CacheOp::RoomInfoHit);
+
                                 try {
                                         RoomInfo tmp =
-                                          json::parse(std::string(data.data(), data.size()));
+                                          parseRecord(data.data(), data.size());
                                         tmp.member_count = getInviteMembersDb(txn, room).size(txn);
 
                                         room_info.emplace(QString::fromStdString(room),
@@ -1055,6 +2387,8 @@ Cache::getRoomInfo(const std::vector<std::string> &rooms)
                                           room,
                                           std::string(data.data(), data.size()));
                                 }
+                        } else {
+                                perf::accountCacheOp(perf::CacheOp::RoomInfoMiss);
                         }
                 }
         }
@@ -1067,7 +2401,7 @@ Cache::getRoomInfo(const std::vector<std::string> &rooms)
 std::map<QString, mtx::responses::Timeline>
 Cache::roomMessages()
 {
-        auto txn = lmdb::txn::begin(env_, nullptr, MDB_RDONLY);
+        ReadTxn txn(*this);
 
         std::map<QString, mtx::responses::Timeline> msgs;
         std::string room_id, unused;
@@ -1077,11 +2411,69 @@ Cache::roomMessages()
                 msgs.emplace(QString::fromStdString(room_id), mtx::responses::Timeline());
 
         roomsCursor.close();
-        txn.commit();
 
         return msgs;
 }
 
+void
+Cache::prefetchState()
+{
+        try {
+                const auto start = std::chrono::steady_clock::now();
+
+                ReadTxn txn(*this);
+
+                std::vector<std::string> rooms;
+                std::string room_id, room_data;
+                std::size_t bytes = 0;
+
+                auto roomsCursor = lmdb::cursor::open(txn, roomsDb_);
+                while (roomsCursor.get(room_id, room_data, MDB_NEXT)) {
+                        bytes += room_data.size();
+                        rooms.push_back(room_id);
+                }
+                roomsCursor.close();
+
+                for (const auto &room : rooms) {
+                        std::string key, value;
+
+                        {
+                                auto membersDb = getMembersDb(txn, room);
+                                auto cursor    = lmdb::cursor::open(txn, membersDb);
+                                while (cursor.get(key, value, MDB_NEXT))
+                                        bytes += value.size();
+                                cursor.close();
+                        }
+
+                        {
+                                auto messagesDb = getMessagesDb(txn, room);
+                                auto cursor     = lmdb::cursor::open(txn, messagesDb);
+
+                                size_t index = 0;
+                                while (cursor.get(key, value, MDB_NEXT) &&
+                                       index < MAX_RESTORED_MESSAGES) {
+                                        bytes += value.size();
+                                        index += 1;
+                                }
+                                cursor.close();
+                        }
+                }
+
+                const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                       std::chrono::steady_clock::now() - start)
+                                       .count();
+
+                nhlog::db()->info("prefetched {} for {} room(s) in {} ms",
+                                  utils::humanReadableFileSize(bytes).toStdString(),
+                                  rooms.size(),
+                                  elapsed);
+        } catch (const lmdb::error &e) {
+                // Purely advisory; the restore pass reads the same data
+                // itself either way.
+                nhlog::db()->warn("prefetchState: {}", e.what());
+        }
+}
+
 mtx::responses::Timeline
 Cache::getTimelineMessages(lmdb::txn &txn, const std::string &room_id)
 {
@@ -1095,7 +2487,7 @@ Cache::getTimelineMessages(lmdb::txn &txn, const std::string &room_id)
         size_t index = 0;
 
         while (cursor.get(timestamp, msg, MDB_NEXT) && index < MAX_RESTORED_MESSAGES) {
-                auto obj = json::parse(msg);
+                auto obj = json::parse(decompressRecord(msg));
 
                 if (obj.count("event") == 0 || obj.count("token") == 0)
                         continue;
@@ -1120,35 +2512,47 @@ Cache::roomInfo(bool withInvites)
 {
         QMap<QString, RoomInfo> result;
 
-        auto txn = lmdb::txn::begin(env_, nullptr, MDB_RDONLY);
+        ReadTxn txn(*this);
 
         std::string room_id;
         std::string room_data;
 
-        // Gather info about the joined rooms.
-        auto roomsCursor = lmdb::cursor::open(txn, roomsDb_);
-        while (roomsCursor.get(room_id, room_data, MDB_NEXT)) {
-                RoomInfo tmp     = json::parse(std::move(room_data));
-                tmp.member_count = getMembersDb(txn, room_id).size(txn);
-                tmp.msgInfo      = getLastMessageInfo(txn, room_id);
+        // Gather info about the joined rooms. The records carry a snapshot
+        // of the member count and the last message, so no per-room walks
+        // are needed and startup stays a single cursor scan.
+        forEachRoom(txn, [&, this](const lmdb::val &id, const lmdb::val &record) {
+                const std::string room(id.data(), id.size());
 
-                result.insert(QString::fromStdString(std::move(room_id)), std::move(tmp));
-        }
-        roomsCursor.close();
+                RoomInfo tmp = parseRecord(record.data(), record.size());
+
+                if (tmp.member_count == 0)
+                        tmp.member_count = getMembersDb(txn, room).size(txn);
+
+                if (tmp.msgInfo.userid.isEmpty())
+                        tmp.msgInfo = getLastMessageInfo(txn, room);
+                else
+                        // The stored relative timestamp might be outdated.
+                        tmp.msgInfo.timestamp = utils::descriptiveTime(tmp.msgInfo.datetime);
+
+                result.insert(QString::fromStdString(room), std::move(tmp));
+
+                return true;
+        });
 
         if (withInvites) {
                 // Gather info about the invites.
                 auto invitesCursor = lmdb::cursor::open(txn, invitesDb_);
                 while (invitesCursor.get(room_id, room_data, MDB_NEXT)) {
-                        RoomInfo tmp     = json::parse(room_data);
-                        tmp.member_count = getInviteMembersDb(txn, room_id).size(txn);
+                        RoomInfo tmp = parseRecord(room_data);
+
+                        if (tmp.member_count == 0)
+                                tmp.member_count = getInviteMembersDb(txn, room_id).size(txn);
+
                         result.insert(QString::fromStdString(std::move(room_id)), std::move(tmp));
                 }
                 invitesCursor.close();
         }
 
-        txn.commit();
-
         return result;
 }
 
@@ -1167,7 +2571,7 @@ Cache::getLastMessageInfo(lmdb::txn &txn, const std::string &room_id)
 
         auto cursor = lmdb::cursor::open(txn, db);
         while (cursor.get(timestamp, msg, MDB_NEXT)) {
-                auto obj = json::parse(msg);
+                auto obj = json::parse(decompressRecord(msg));
 
                 if (obj.count("event") == 0)
                         continue;
@@ -1184,33 +2588,14 @@ Cache::getLastMessageInfo(lmdb::txn &txn, const std::string &room_id)
         return DescInfo{};
 }
 
-std::map<QString, bool>
-Cache::invites()
+QString
+Cache::getRoomAvatarUrl(lmdb::txn &txn,
+                        lmdb::dbi &statesdb,
+                        lmdb::dbi &membersdb,
+                        const QString &room_id)
 {
-        std::map<QString, bool> result;
-
-        auto txn    = lmdb::txn::begin(env_, nullptr, MDB_RDONLY);
-        auto cursor = lmdb::cursor::open(txn, invitesDb_);
-
-        std::string room_id, unused;
-
-        while (cursor.get(room_id, unused, MDB_NEXT))
-                result.emplace(QString::fromStdString(std::move(room_id)), true);
-
-        cursor.close();
-        txn.commit();
-
-        return result;
-}
-
-QString
-Cache::getRoomAvatarUrl(lmdb::txn &txn,
-                        lmdb::dbi &statesdb,
-                        lmdb::dbi &membersdb,
-                        const QString &room_id)
-{
-        using namespace mtx::events;
-        using namespace mtx::events::state;
+        using namespace mtx::events;
+        using namespace mtx::events::state;
 
         lmdb::val event;
         bool res = lmdb::dbi_get(
@@ -1219,7 +2604,7 @@ Cache::getRoomAvatarUrl(lmdb::txn &txn,
         if (res) {
                 try {
                         StateEvent<Avatar> msg =
-                          json::parse(std::string(event.data(), event.size()));
+                          parseRecord(event.data(), event.size());
 
                         return QString::fromStdString(msg.content.url);
                 } catch (const json::exception &e) {
@@ -1241,7 +2626,7 @@ Cache::getRoomAvatarUrl(lmdb::txn &txn,
                         continue;
 
                 try {
-                        MemberInfo m = json::parse(member_data);
+                        MemberInfo m = parseRecord(member_data);
 
                         cursor.close();
                         return QString::fromStdString(m.avatar_url);
@@ -1268,7 +2653,7 @@ Cache::getRoomName(lmdb::txn &txn, lmdb::dbi &statesdb, lmdb::dbi &membersdb)
 
         if (res) {
                 try {
-                        StateEvent<Name> msg = json::parse(std::string(event.data(), event.size()));
+                        StateEvent<Name> msg = parseRecord(event.data(), event.size());
 
                         if (!msg.content.name.empty())
                                 return QString::fromStdString(msg.content.name);
@@ -1283,7 +2668,7 @@ Cache::getRoomName(lmdb::txn &txn, lmdb::dbi &statesdb, lmdb::dbi &membersdb)
         if (res) {
                 try {
                         StateEvent<CanonicalAlias> msg =
-                          json::parse(std::string(event.data(), event.size()));
+                          parseRecord(event.data(), event.size());
 
                         if (!msg.content.alias.empty())
                                 return QString::fromStdString(msg.content.alias);
@@ -1303,7 +2688,7 @@ Cache::getRoomName(lmdb::txn &txn, lmdb::dbi &statesdb, lmdb::dbi &membersdb)
 
         while (cursor.get(user_id, member_data, MDB_NEXT) && ii < 3) {
                 try {
-                        members.emplace(user_id, json::parse(member_data));
+                        members.emplace(user_id, parseRecord(member_data));
                 } catch (const json::exception &e) {
                         nhlog::db()->warn("failed to parse member info: {}", e.what());
                 }
@@ -1346,7 +2731,7 @@ Cache::getRoomJoinRule(lmdb::txn &txn, lmdb::dbi &statesdb)
         if (res) {
                 try {
                         StateEvent<JoinRules> msg =
-                          json::parse(std::string(event.data(), event.size()));
+                          parseRecord(event.data(), event.size());
                         return msg.content.join_rule;
                 } catch (const json::exception &e) {
                         nhlog::db()->warn("failed to parse m.room.join_rule event: {}", e.what());
@@ -1368,7 +2753,7 @@ Cache::getRoomGuestAccess(lmdb::txn &txn, lmdb::dbi &statesdb)
         if (res) {
                 try {
                         StateEvent<GuestAccess> msg =
-                          json::parse(std::string(event.data(), event.size()));
+                          parseRecord(event.data(), event.size());
                         return msg.content.guest_access == AccessState::CanJoin;
                 } catch (const json::exception &e) {
                         nhlog::db()->warn("failed to parse m.room.guest_access event: {}",
@@ -1391,7 +2776,7 @@ Cache::getRoomTopic(lmdb::txn &txn, lmdb::dbi &statesdb)
         if (res) {
                 try {
                         StateEvent<Topic> msg =
-                          json::parse(std::string(event.data(), event.size()));
+                          parseRecord(event.data(), event.size());
 
                         if (!msg.content.topic.empty())
                                 return QString::fromStdString(msg.content.topic);
@@ -1416,7 +2801,7 @@ Cache::getInviteRoomName(lmdb::txn &txn, lmdb::dbi &statesdb, lmdb::dbi &members
         if (res) {
                 try {
                         StrippedEvent<state::Name> msg =
-                          json::parse(std::string(event.data(), event.size()));
+                          parseRecord(event.data(), event.size());
                         return QString::fromStdString(msg.content.name);
                 } catch (const json::exception &e) {
                         nhlog::db()->warn("failed to parse m.room.name event: {}", e.what());
@@ -1431,7 +2816,7 @@ Cache::getInviteRoomName(lmdb::txn &txn, lmdb::dbi &statesdb, lmdb::dbi &members
                         continue;
 
                 try {
-                        MemberInfo tmp = json::parse(member_data);
+                        MemberInfo tmp = parseRecord(member_data);
                         cursor.close();
 
                         return QString::fromStdString(tmp.name);
@@ -1458,7 +2843,7 @@ Cache::getInviteRoomAvatarUrl(lmdb::txn &txn, lmdb::dbi &statesdb, lmdb::dbi &me
         if (res) {
                 try {
                         StrippedEvent<state::Avatar> msg =
-                          json::parse(std::string(event.data(), event.size()));
+                          parseRecord(event.data(), event.size());
                         return QString::fromStdString(msg.content.url);
                 } catch (const json::exception &e) {
                         nhlog::db()->warn("failed to parse m.room.avatar event: {}", e.what());
@@ -1473,7 +2858,7 @@ Cache::getInviteRoomAvatarUrl(lmdb::txn &txn, lmdb::dbi &statesdb, lmdb::dbi &me
                         continue;
 
                 try {
-                        MemberInfo tmp = json::parse(member_data);
+                        MemberInfo tmp = parseRecord(member_data);
                         cursor.close();
 
                         return QString::fromStdString(tmp.avatar_url);
@@ -1500,7 +2885,7 @@ Cache::getInviteRoomTopic(lmdb::txn &txn, lmdb::dbi &db)
         if (res) {
                 try {
                         StrippedEvent<Topic> msg =
-                          json::parse(std::string(event.data(), event.size()));
+                          parseRecord(event.data(), event.size());
                         return QString::fromStdString(msg.content.topic);
                 } catch (const json::exception &e) {
                         nhlog::db()->warn("failed to parse m.room.topic event: {}", e.what());
@@ -1519,335 +2904,1440 @@ Cache::getRoomAvatar(const QString &room_id)
 QImage
 Cache::getRoomAvatar(const std::string &room_id)
 {
-        auto txn = lmdb::txn::begin(env_, nullptr, MDB_RDONLY);
+        ReadTxn txn(*this);
 
         lmdb::val response;
 
         if (!lmdb::dbi_get(txn, roomsDb_, lmdb::val(room_id), response)) {
-                txn.commit();
                 return QImage();
         }
 
         std::string media_url;
 
-        try {
-                RoomInfo info = json::parse(std::string(response.data(), response.size()));
-                media_url     = std::move(info.avatar_url);
+        try {
+                RoomInfo info = parseRecord(response.data(), response.size());
+                media_url     = std::move(info.avatar_url);
+
+                if (media_url.empty()) {
+                        return QImage();
+                }
+        } catch (const json::exception &e) {
+                nhlog::db()->warn("failed to parse room info: {}, {}",
+                                  e.what(),
+                                  std::string(response.data(), response.size()));
+        }
+
+        if (!lmdb::dbi_get(txn, mediaDb_, lmdb::val(media_url), response)) {
+                return QImage();
+        }
+
+        return QImage::fromData(QByteArray(response.data(), response.size()));
+}
+
+std::vector<std::string>
+Cache::joinedRooms()
+{
+        ReadTxn txn(*this);
+
+        return getRoomIds(txn);
+}
+
+void
+Cache::populateMembers()
+{
+        auto txn = lmdb::txn::begin(env_);
+
+        std::size_t nrooms = 0;
+
+        // One pass over the room records; the member walk of each room
+        // happens inside the same transaction, so the whole load is a
+        // single sequential sweep.
+        forEachRoom(txn, [this, &txn, &nrooms](const lmdb::val &id, const lmdb::val &) {
+                const std::string room(id.data(), id.size());
+                const auto roomid = QString::fromStdString(room);
+
+                auto membersdb = getMembersDb(txn, room);
+                auto cursor    = lmdb::cursor::open(txn, membersdb);
+
+                std::string user_id, info;
+                while (cursor.get(user_id, info, MDB_NEXT)) {
+                        MemberInfo m = parseRecord(info);
+
+                        const auto userid = QString::fromStdString(user_id);
+
+                        insertDisplayName(roomid, userid, QString::fromStdString(m.name));
+                        insertAvatarUrl(roomid, userid, QString::fromStdString(m.avatar_url));
+                }
+
+                cursor.close();
+                nrooms += 1;
+
+                return true;
+        });
+
+        nhlog::db()->info("loaded the members of {} rooms", nrooms);
+
+        txn.commit();
+}
+
+//! Normalize a term of the member index for case-insensitive matching.
+static std::string
+normalizeTerm(const std::string &input)
+{
+        // The overwhelming majority of user ids & display names are plain
+        // ASCII, which can be lowered byte-by-byte without decoding.
+        const bool isAscii =
+          std::none_of(input.begin(), input.end(), [](unsigned char c) { return c >= 0x80; });
+
+        if (isAscii) {
+                std::string term(input);
+
+                std::transform(term.begin(), term.end(), term.begin(), [](unsigned char c) {
+                        return static_cast<char>(std::tolower(c));
+                });
+
+                return term;
+        }
+
+        // Byte-wise tolower is a no-op on multi-byte sequences, so names
+        // with e.g. cyrillic or accented capitals need real case folding.
+        return QString::fromStdString(input).toCaseFolded().toStdString();
+}
+
+void
+Cache::indexMember(lmdb::txn &txn,
+                   const std::string &room_id,
+                   const std::string &user_id,
+                   const std::string &display_name,
+                   bool removed)
+{
+        auto membersdb = getMembersDb(txn, room_id);
+        auto indexdb   = getMemberIndexDb(txn, room_id);
+
+        const std::string suffix = std::string(1, '\0') + user_id;
+
+        // Drop the entries of the previously stored display name, if any.
+        lmdb::val value;
+        if (lmdb::dbi_get(txn, membersdb, lmdb::val(user_id), value)) {
+                try {
+                        MemberInfo tmp = parseRecord(std::string(value.data(), value.size()));
+
+                        lmdb::dbi_del(
+                          txn, indexdb, lmdb::val(normalizeTerm(tmp.name) + suffix), nullptr);
+                        lmdb::dbi_del(
+                          txn, indexdb, lmdb::val(normalizeTerm(user_id) + suffix), nullptr);
+                } catch (const json::exception &e) {
+                        nhlog::db()->warn("indexMember: {}", e.what());
+                }
+        }
+
+        if (removed)
+                return;
+
+        const std::string empty;
+
+        lmdb::dbi_put(txn,
+                      indexdb,
+                      lmdb::val(normalizeTerm(display_name) + suffix),
+                      lmdb::val(empty.data(), empty.size()));
+        lmdb::dbi_put(txn,
+                      indexdb,
+                      lmdb::val(normalizeTerm(user_id) + suffix),
+                      lmdb::val(empty.data(), empty.size()));
+}
+
+//! Bitmask with one bit per letter or digit appearing in the name. A
+//! query can only match a name whose mask contains the query's mask.
+static uint64_t
+searchMask(const std::string &name)
+{
+        uint64_t mask = 0;
+
+        for (const unsigned char c : name) {
+                if (std::isalpha(c))
+                        mask |= UINT64_C(1) << (std::tolower(c) - 'a');
+                else if (std::isdigit(c))
+                        mask |= UINT64_C(1) << (26 + (c - '0'));
+        }
+
+        return mask;
+}
+
+void
+Cache::updateRoomSearchEntry(const std::string &room_id,
+                             const std::string &name,
+                             const std::string &topic)
+{
+        std::lock_guard<std::mutex> lock(roomSearchMutex_);
+
+        if (!roomSearchIndexReady_)
+                return;
+
+        const auto loweredName  = QString::fromStdString(name).toLower().toStdString();
+        const auto loweredTopic = QString::fromStdString(topic).toLower().toStdString();
+
+        roomSearchIndex_[room_id] = RoomSearchEntry{
+          room_id, loweredName, loweredTopic, searchMask(loweredName) | searchMask(loweredTopic)};
+}
+
+void
+Cache::dropRoomSearchEntry(const std::string &room_id)
+{
+        std::lock_guard<std::mutex> lock(roomSearchMutex_);
+        roomSearchIndex_.erase(room_id);
+}
+
+std::vector<RoomSearchResult>
+Cache::searchRooms(const std::string &query, std::uint8_t max_items)
+{
+        ReadTxn txn(*this);
+
+        std::lock_guard<std::mutex> lock(roomSearchMutex_);
+
+        if (!roomSearchIndexReady_) {
+                auto cursor = lmdb::cursor::open(txn, roomsDb_);
+
+                std::string room_id, room_data;
+                while (cursor.get(room_id, room_data, MDB_NEXT)) {
+                        RoomInfo tmp = parseRecord(room_data);
+
+                        const auto name =
+                          QString::fromStdString(tmp.name).toLower().toStdString();
+                        const auto topic =
+                          QString::fromStdString(tmp.topic).toLower().toStdString();
+                        roomSearchIndex_[room_id] = RoomSearchEntry{
+                          room_id, name, topic, searchMask(name) | searchMask(topic)};
+                }
+
+                cursor.close();
+
+                roomSearchIndexReady_ = true;
+        }
+
+        // Skip rooms whose names can't contain all of the query's
+        // characters; only the plausible candidates are scored.
+        const auto queryMask = searchMask(query);
+
+        // Only the best max_items scores are kept; once the set is full its
+        // worst score becomes the budget of the remaining candidates, which
+        // then bail out of the scoring early.
+        std::multimap<int, const RoomSearchEntry *> items;
+        for (const auto &entry : roomSearchIndex_) {
+                if ((entry.second.mask & queryMask) != queryMask)
+                        continue;
+
+                const auto budget = items.size() < max_items
+                                      ? std::numeric_limits<int>::max()
+                                      : items.rbegin()->first;
+
+                // A room matches through either its name or its topic;
+                // the better of the two scores ranks it.
+                auto score = utils::levenshtein_distance(query, entry.second.name, budget);
+                if (!entry.second.topic.empty())
+                        score = std::min(
+                          score,
+                          utils::levenshtein_distance(query, entry.second.topic, budget));
+                if (score > budget)
+                        continue;
+
+                items.emplace(score, &entry.second);
+
+                if (items.size() > max_items)
+                        items.erase(std::prev(items.end()));
+        }
+
+        // Only the returned items are parsed from their room records.
+        std::vector<RoomSearchResult> results;
+        for (auto it = items.begin(); it != items.end(); it++) {
+                lmdb::val data;
+
+                if (!lmdb::dbi_get(txn, roomsDb_, lmdb::val(it->second->room_id), data))
+                        continue;
+
+                RoomInfo tmp = parseRecord(std::string(data.data(), data.size()));
+
+                results.push_back(
+                  RoomSearchResult{it->second->room_id, tmp, image(txn, tmp.avatar_url)});
+        }
+
+        return results;
+}
+
+boost::optional<std::string>
+Cache::roomIdFromAlias(const std::string &alias)
+{
+        using namespace mtx::events;
+        using namespace mtx::events::state;
+
+        ReadTxn txn(*this);
+
+        boost::optional<std::string> result;
+
+        forEachRoom(txn, [&, this](const lmdb::val &id, const lmdb::val &) {
+                const std::string room_id(id.data(), id.size());
+
+                try {
+                        auto statesdb = getStatesDb(txn, room_id);
+
+                        lmdb::val event;
+                        if (!lmdb::dbi_get(txn,
+                                           statesdb,
+                                           lmdb::val(to_string(EventType::RoomCanonicalAlias)),
+                                           event))
+                                return true;
+
+                        StateEvent<CanonicalAlias> msg =
+                          parseRecord(event.data(), event.size());
+
+                        if (msg.content.alias == alias) {
+                                result = room_id;
+                                return false;
+                        }
+                } catch (const json::exception &e) {
+                        nhlog::db()->warn("roomIdFromAlias: {}", e.what());
+                }
+
+                return true;
+        });
+
+        return result;
+}
+
+QVector<SearchResult>
+Cache::searchUsers(const std::string &room_id, const std::string &query, std::uint8_t max_items)
+{
+        QVector<SearchResult> results;
+
+        const auto prefix = normalizeTerm(query);
+
+        if (prefix.empty())
+                return results;
+
+        try {
+                ReadTxn txn(*this);
+                auto membersdb = getMembersDb(txn, room_id);
+                auto indexdb   = getMemberIndexDb(txn, room_id);
+
+                auto cursor = lmdb::cursor::open(txn, indexdb);
+
+                // A user can be matched through both the display name and
+                // the user id entries.
+                std::set<std::string> seen;
+
+                std::string key(prefix), unused;
+
+                // The keys are sorted, so all the matches follow the first
+                // key that starts with the prefix.
+                bool ok = cursor.get(key, unused, MDB_SET_RANGE);
+                while (ok && key.compare(0, prefix.size(), prefix) == 0) {
+                        const auto pos = key.find('\0');
+
+                        if (pos != std::string::npos) {
+                                const auto user_id = key.substr(pos + 1);
+
+                                if (seen.emplace(user_id).second) {
+                                        QString display_name;
+
+                                        lmdb::val data;
+                                        if (lmdb::dbi_get(
+                                              txn, membersdb, lmdb::val(user_id), data)) {
+                                                try {
+                                                        MemberInfo tmp = parseRecord(
+                                                          std::string(data.data(), data.size()));
+                                                        display_name =
+                                                          QString::fromStdString(tmp.name);
+                                                } catch (const json::exception &e) {
+                                                        nhlog::db()->warn("searchUsers: {}",
+                                                                          e.what());
+                                                }
+                                        }
+
+                                        results.push_back(SearchResult{
+                                          QString::fromStdString(user_id), display_name});
+
+                                        if (results.size() == max_items)
+                                                break;
+                                }
+                        }
+
+                        ok = cursor.get(key, unused, MDB_NEXT);
+                }
+
+                cursor.close();
+        } catch (const lmdb::error &e) {
+                nhlog::db()->warn("searchUsers: {}", e.what());
+        }
+
+        return results;
+}
+
+std::vector<RoomMember>
+Cache::getMembersAfter(const std::string &room_id, const std::string &after, std::size_t len)
+{
+        ReadTxn txn(*this);
+        auto db     = getMembersDb(txn, room_id);
+        auto cursor = lmdb::cursor::open(txn, db);
+
+        std::vector<RoomMember> members;
+
+        std::string user_id = after;
+        std::string user_data;
+
+        // Position the cursor directly on the next member instead of
+        // skip-counting every entry from the beginning of the database.
+        bool ok;
+        if (after.empty()) {
+                ok = cursor.get(user_id, user_data, MDB_FIRST);
+        } else {
+                ok = cursor.get(user_id, user_data, MDB_SET_RANGE);
+                if (ok && user_id == after)
+                        ok = cursor.get(user_id, user_data, MDB_NEXT);
+        }
+
+        while (ok && members.size() < len) {
+                try {
+                        MemberInfo tmp = parseRecord(user_data);
+                        members.emplace_back(RoomMember{QString::fromStdString(user_id),
+                                                        QString::fromStdString(tmp.name),
+                                                        image(txn, tmp.avatar_url)});
+                } catch (const json::exception &e) {
+                        nhlog::db()->warn("{}", e.what());
+                }
+
+                ok = cursor.get(user_id, user_data, MDB_NEXT);
+        }
+
+        cursor.close();
+
+        return members;
+}
+
+//! The two probe positions of an id in a membership bloom filter.
+static std::pair<uint64_t, uint64_t>
+membershipFilterHashes(const std::string &user_id)
+{
+        uint64_t h = std::hash<std::string>{}(user_id);
+
+        // splitmix64 finalizer; decorrelates the second probe from the
+        // first on hash implementations with weak high bits.
+        uint64_t h2 = h + UINT64_C(0x9e3779b97f4a7c15);
+        h2          = (h2 ^ (h2 >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+        h2          = (h2 ^ (h2 >> 27)) * UINT64_C(0x94d049bb133111eb);
+        h2 ^= h2 >> 31;
+
+        return {h, h2};
+}
+
+static void
+membershipFilterSet(std::vector<uint64_t> &bits, uint64_t h)
+{
+        const auto bit = h % (bits.size() * 64);
+        bits[bit / 64] |= UINT64_C(1) << (bit % 64);
+}
+
+static bool
+membershipFilterTest(const std::vector<uint64_t> &bits, uint64_t h)
+{
+        const auto bit = h % (bits.size() * 64);
+        return bits[bit / 64] & (UINT64_C(1) << (bit % 64));
+}
+
+void
+Cache::membershipFilterInsert(const std::string &room_id, const std::string &user_id)
+{
+        std::lock_guard<std::mutex> lock(membershipFilterMutex_);
+
+        auto it = membershipFilters_.find(room_id);
+        if (it == membershipFilters_.end())
+                return;
+
+        auto &filter = it->second;
+
+        // Growing past the sizing assumption would raise the false
+        // positive rate; rebuild on the next check instead.
+        if (++filter.count * 10 > filter.bits.size() * 64) {
+                membershipFilters_.erase(it);
+                return;
+        }
+
+        const auto h = membershipFilterHashes(user_id);
+        membershipFilterSet(filter.bits, h.first);
+        membershipFilterSet(filter.bits, h.second);
+}
+
+void
+Cache::invalidateMembershipFilter(const std::string &room_id)
+{
+        std::lock_guard<std::mutex> lock(membershipFilterMutex_);
+        membershipFilters_.erase(room_id);
+}
+
+bool
+Cache::isRoomMember(const std::string &user_id, const std::string &room_id)
+{
+        auto txn = lmdb::txn::begin(env_);
+        auto db  = getMembersDb(txn, room_id);
+
+        {
+                std::lock_guard<std::mutex> lock(membershipFilterMutex_);
+
+                auto &filter = membershipFilters_[room_id];
+
+                if (filter.bits.empty()) {
+                        // ~10 bits per member keep the false positive rate
+                        // around 1%; those just fall through to lmdb.
+                        const auto members = db.size(txn);
+
+                        filter.bits.assign(
+                          std::max<std::size_t>(16, (members * 10 + 63) / 64), 0);
+                        filter.count = members;
+
+                        auto cursor = lmdb::cursor::open(txn, db);
+
+                        std::string key, value;
+                        while (cursor.get(key, value, MDB_NEXT)) {
+                                const auto h = membershipFilterHashes(key);
+                                membershipFilterSet(filter.bits, h.first);
+                                membershipFilterSet(filter.bits, h.second);
+                        }
+
+                        cursor.close();
+                }
+
+                const auto h = membershipFilterHashes(user_id);
+                if (!membershipFilterTest(filter.bits, h.first) ||
+                    !membershipFilterTest(filter.bits, h.second)) {
+                        txn.commit();
+                        return false;
+                }
+        }
+
+        lmdb::val value;
+        bool res = lmdb::dbi_get(txn, db, lmdb::val(user_id), value);
+        txn.commit();
+
+        return res;
+}
+
+void
+Cache::saveSessionState(const std::string &key, const std::string &value)
+{
+        auto txn = lmdb::txn::begin(env_);
+
+        if (value.empty())
+                lmdb::dbi_del(txn, sessionStateDb_, lmdb::val(key), nullptr);
+        else
+                lmdb::dbi_put(txn, sessionStateDb_, lmdb::val(key), lmdb::val(value));
+
+        txn.commit();
+}
+
+boost::optional<std::string>
+Cache::restoreSessionState(const std::string &key)
+{
+        ReadTxn txn(*this);
+
+        lmdb::val value;
+        if (!lmdb::dbi_get(txn, sessionStateDb_, lmdb::val(key), value))
+                return boost::none;
+
+        return std::string(value.data(), value.size());
+}
+
+bool
+Cache::saveGroupProfile(const std::string &group_id, const GroupInfo &profile)
+{
+        const auto serialized = json(profile).dump();
+
+        auto txn = lmdb::txn::begin(env_);
+
+        lmdb::val stored;
+        if (lmdb::dbi_get(txn, groupsDb_, lmdb::val(group_id), stored) &&
+            std::string(stored.data(), stored.size()) == serialized) {
+                txn.abort();
+                return false;
+        }
+
+        lmdb::dbi_put(txn, groupsDb_, lmdb::val(group_id), lmdb::val(serialized));
+        txn.commit();
+
+        return true;
+}
+
+boost::optional<GroupInfo>
+Cache::getGroupProfile(const std::string &group_id)
+{
+        ReadTxn txn(*this);
+
+        lmdb::val value;
+        if (!lmdb::dbi_get(txn, groupsDb_, lmdb::val(group_id), value))
+                return boost::none;
+
+        try {
+                return json::parse(std::string(value.data(), value.size())).get<GroupInfo>();
+        } catch (const json::exception &e) {
+                nhlog::db()->warn("failed to parse group profile ({}): {}", group_id, e.what());
+                return boost::none;
+        }
+}
+
+Cache::PreparedRoom
+Cache::prepareRoom(const std::string &room_id, const mtx::responses::JoinedRoom &room)
+{
+        using namespace mtx::events;
+
+        PreparedRoom batch;
+        batch.room_id = room_id;
+
+        for (const auto &e : room.state.events)
+                prepareStateEvent(batch, e);
+        for (const auto &e : room.timeline.events)
+                prepareStateEvent(batch, e);
+
+        for (const auto &e : room.timeline.events) {
+                if (isStateEvent(e))
+                        continue;
+
+                if (boost::get<RedactionEvent<msg::Redaction>>(&e) != nullptr)
+                        continue;
+
+                json obj = json::object();
+
+                obj["event"] = utils::serialize_event(e);
+                obj["token"] = room.timeline.prev_batch;
+
+                auto key = timestampKey(utils::event_timestamp(e));
+
+                batch.eventIndex.emplace_back(utils::event_id(e), key);
+
+                // Compression happens here so its cost lands in the parallel
+                // prepare phase instead of the write transaction.
+                batch.messages.emplace_back(std::move(key),
+                                            compressRecord(obj.dump(), *batch.arena));
+        }
+
+        // LMDB inserts are fastest in key order: sequential puts land on
+        // adjacent pages and sync batches can be appended at the end of the
+        // tree. The sorts are stable so that multiple updates of the same
+        // key keep their last-write-wins order.
+        std::stable_sort(
+          batch.members.begin(), batch.members.end(), [](const auto &a, const auto &b) {
+                  return a.state_key < b.state_key;
+          });
+        std::stable_sort(batch.state.begin(), batch.state.end(), [](const auto &a, const auto &b) {
+                return a.first < b.first;
+        });
+        // The messages db is ordered newest-first by its reversed key
+        // comparator, so its batch is sorted the same way.
+        std::stable_sort(
+          batch.messages.begin(), batch.messages.end(), [](const auto &a, const auto &b) {
+                  return b.first < a.first;
+          });
+        std::stable_sort(
+          batch.eventIndex.begin(), batch.eventIndex.end(), [](const auto &a, const auto &b) {
+                  return a.first < b.first;
+          });
+
+        collectSearchIndexEntries(room_id, room.timeline, batch.searchEntries);
+
+        return batch;
+}
+
+void
+Cache::applyPreparedRoom(lmdb::txn &txn, const PreparedRoom &room)
+{
+        auto statesdb  = getStatesDb(txn, room.room_id);
+        auto membersdb = getMembersDb(txn, room.room_id);
+
+        for (const auto &member : room.members) {
+                if (member.record.empty()) {
+                        indexMember(txn, room.room_id, member.state_key, "", true);
+                        invalidateMembershipFilter(room.room_id);
+
+                        lmdb::dbi_del(
+                          txn, membersdb, lmdb::val(member.state_key), lmdb::val(""));
+
+                        removeDisplayName(QString::fromStdString(room.room_id),
+                                          QString::fromStdString(member.state_key));
+                        removeAvatarUrl(QString::fromStdString(room.room_id),
+                                        QString::fromStdString(member.state_key));
+
+                        continue;
+                }
+
+                // Update the typeahead index before the member record,
+                // which holds the previous display name.
+                indexMember(txn, room.room_id, member.state_key, member.display_name);
+                membershipFilterInsert(room.room_id, member.state_key);
+
+                lmdb::dbi_put(txn,
+                              membersdb,
+                              lmdb::val(member.state_key),
+                              lmdb::val(member.record.data, member.record.size));
+
+                insertDisplayName(QString::fromStdString(room.room_id),
+                                  QString::fromStdString(member.state_key),
+                                  QString::fromStdString(member.display_name));
+
+                insertAvatarUrl(QString::fromStdString(room.room_id),
+                                QString::fromStdString(member.state_key),
+                                QString::fromStdString(member.avatar_url));
+        }
+
+        for (const auto &entry : room.state)
+                lmdb::dbi_put(txn,
+                              statesdb,
+                              lmdb::val(entry.first),
+                              lmdb::val(entry.second.data, entry.second.size));
+
+        if (room.isEncryptionEnabled)
+                setEncryptedRoom(txn, room.room_id);
+
+        if (room.messages.empty())
+                return;
+
+        auto messagesdb = getMessagesDb(txn, room.room_id);
+
+        // The batch arrives in the database's key order, so inserting
+        // through a cursor keeps it positioned at the insertion point and
+        // each put only walks forward instead of descending the tree from
+        // the root.
+        auto cursor = lmdb::cursor::open(txn, messagesdb);
+
+        for (const auto &entry : room.messages) {
+                lmdb::val key(entry.first);
+                lmdb::val value(entry.second.data, entry.second.size);
+
+                lmdb::cursor_put(cursor.handle(), key, value);
+        }
+
+        cursor.close();
+
+        for (const auto &entry : room.eventIndex) {
+                const auto value = room.room_id + "\x1f" + entry.second;
+                lmdb::dbi_put(txn, eventIndexDb_, lmdb::val(entry.first), lmdb::val(value));
+        }
+
+        enforceRetention(txn, room.room_id);
+}
+
+void
+Cache::enforceRetention(lmdb::txn &txn, const std::string &room_id)
+{
+        const auto policy = utils::roomRetentionPolicy(QString::fromStdString(room_id));
+
+        if (policy.maxEvents <= 0 && policy.maxAgeDays <= 0)
+                return;
+
+        const uint64_t cutoff =
+          policy.maxAgeDays <= 0
+            ? 0
+            : static_cast<uint64_t>(QDateTime::currentMSecsSinceEpoch()) -
+                uint64_t(policy.maxAgeDays) * 24 * 60 * 60 * 1000;
+
+        auto db = getMessagesDb(txn, room_id);
+
+        std::vector<std::string> removed_ids;
+
+        std::string key, record;
+        uint64_t idx = 0;
+
+        // The db is ordered newest-first, so everything past the limits is
+        // a contiguous tail of the walk. Earlier enforcements already kept
+        // the db within the limits, which bounds the walk itself.
+        auto cursor = lmdb::cursor::open(txn, db);
+        while (cursor.get(key, record, MDB_NEXT)) {
+                idx += 1;
+
+                const bool overCount =
+                  policy.maxEvents > 0 && idx > static_cast<uint64_t>(policy.maxEvents);
+                const bool tooOld = cutoff > 0 && timestampFromKey(key) < cutoff;
+
+                if (!overCount && !tooOld)
+                        continue;
+
+                lmdb::cursor_del(cursor);
+
+                try {
+                        const auto obj = json::parse(decompressRecord(record));
+
+                        if (obj.count("event") != 0 && obj.at("event").count("event_id") != 0)
+                                removed_ids.push_back(
+                                  obj.at("event").at("event_id").get<std::string>());
+                } catch (const nlohmann::json::exception &) {
+                        // Without an event id there is nothing else to
+                        // clean up.
+                }
+        }
+        cursor.close();
+
+        if (removed_ids.empty())
+                return;
+
+        // Unlike the cold migration the records are gone for good, so
+        // their receipts and event index entries go with them.
+        deleteReadReceipts(txn, room_id, removed_ids);
+
+        for (const auto &event_id : removed_ids)
+                lmdb::dbi_del(txn, eventIndexDb_, lmdb::val(event_id), nullptr);
+
+        nhlog::db()->debug("[{}] retention dropped {} event(s)", room_id, removed_ids.size());
+}
+
+//! Split a message body into the lowercase tokens used by the search index.
+static std::set<std::string>
+tokenizeBody(const std::string &body)
+{
+        constexpr std::size_t MIN_TOKEN_SIZE = 2;
+        constexpr std::size_t MAX_TOKEN_SIZE = 64;
+
+        std::set<std::string> tokens;
+        std::string current;
+
+        auto flush = [&tokens, &current]() {
+                if (current.size() >= MIN_TOKEN_SIZE && current.size() <= MAX_TOKEN_SIZE)
+                        tokens.emplace(current);
+                current.clear();
+        };
+
+        for (const unsigned char c : body) {
+                // Multi-byte UTF-8 sequences are kept as they are.
+                if (std::isalnum(c) || c >= 0x80)
+                        current.push_back(static_cast<char>(std::tolower(c)));
+                else
+                        flush();
+        }
+
+        flush();
+
+        return tokens;
+}
+
+void
+Cache::collectSearchIndexEntries(const std::string &room_id,
+                                 const mtx::responses::Timeline &res,
+                                 std::vector<SearchIndexEntry> &entries)
+{
+        for (const auto &e : res.events) {
+                const auto body = utils::event_body(e);
+
+                if (body.isEmpty())
+                        continue;
+
+                entries.push_back(SearchIndexEntry{
+                  room_id, utils::event_id(e), utils::event_timestamp(e), body.toStdString()});
+        }
+}
+
+void
+Cache::writeSearchIndex(const std::vector<SearchIndexEntry> &entries)
+{
+        try {
+                auto txn = lmdb::txn::begin(env_);
+
+                for (const auto &entry : entries) {
+                        auto db = getSearchIndexDb(txn, entry.room_id);
+
+                        // The timestamp prefix allows ranking by recency
+                        // without fetching the event itself.
+                        const auto value = timestampKey(entry.timestamp) + entry.event_id;
+
+                        for (const auto &token : tokenizeBody(entry.body))
+                                lmdb::dbi_put(txn,
+                                              db,
+                                              lmdb::val(token),
+                                              lmdb::val(value),
+                                              MDB_NODUPDATA);
+                }
+
+                txn.commit();
+        } catch (const lmdb::error &e) {
+                nhlog::db()->critical("writeSearchIndex: {}", e.what());
+        }
+}
+
+std::vector<QString>
+Cache::searchMessages(const QString &room_id, const QString &query, std::size_t max_results)
+{
+        const auto tokens = tokenizeBody(query.toStdString());
+
+        if (tokens.empty())
+                return {};
+
+        // The events that contain every token, with their timestamps.
+        std::map<std::string, uint64_t> matches;
+
+        try {
+                ReadTxn txn(*this);
+                auto db = getSearchIndexDb(txn, room_id.toStdString());
+
+                bool isFirstToken = true;
+                for (const auto &token : tokens) {
+                        std::map<std::string, uint64_t> found;
+
+                        auto cursor = lmdb::cursor::open(txn, db);
+
+                        std::string key(token), value;
+                        if (cursor.get(key, value, MDB_SET_KEY)) {
+                                do {
+                                        if (value.size() <= sizeof(uint64_t))
+                                                continue;
+
+                                        found.emplace(value.substr(sizeof(uint64_t)),
+                                                      timestampFromKey(value));
+                                } while (cursor.get(key, value, MDB_NEXT_DUP));
+                        }
+
+                        cursor.close();
+
+                        if (isFirstToken) {
+                                matches      = std::move(found);
+                                isFirstToken = false;
+                        } else {
+                                // Keep the events that also contain this token.
+                                for (auto it = matches.begin(); it != matches.end();) {
+                                        if (found.find(it->first) == found.end())
+                                                it = matches.erase(it);
+                                        else
+                                                ++it;
+                                }
+                        }
+
+                        if (matches.empty())
+                                return {};
+                }
+        } catch (const lmdb::error &e) {
+                // The room hasn't received any indexable message yet.
+                nhlog::db()->warn("searchMessages: {}", e.what());
+                return {};
+        }
+
+        // Rank by recency.
+        std::vector<std::pair<uint64_t, std::string>> ranked;
+        ranked.reserve(matches.size());
+
+        for (const auto &m : matches)
+                ranked.emplace_back(m.second, m.first);
+
+        std::sort(ranked.begin(), ranked.end(), std::greater<std::pair<uint64_t, std::string>>());
+
+        std::vector<QString> results;
+        for (const auto &r : ranked) {
+                if (results.size() == max_results)
+                        break;
+
+                results.emplace_back(QString::fromStdString(r.second));
+        }
+
+        return results;
+}
+
+boost::optional<EventLocation>
+Cache::locateEvent(const std::string &event_id)
+{
+        ReadTxn txn(*this);
+
+        lmdb::val value;
+        if (!lmdb::dbi_get(txn, eventIndexDb_, lmdb::val(event_id), value))
+                return boost::none;
+
+        const std::string data(value.data(), value.size());
+
+        const auto pos = data.find('\x1f');
+        if (pos == std::string::npos)
+                return boost::none;
+
+        return EventLocation{data.substr(0, pos), data.substr(pos + 1)};
+}
+
+void
+Cache::ensureSentNotificationsLoaded()
+{
+        if (sentNotificationsLoaded_)
+                return;
+
+        sentNotificationsLoaded_ = true;
+
+        ReadTxn txn(*this);
+
+        auto cursor = lmdb::cursor::open(txn, notificationsDb_);
+
+        std::string event_id, unused;
+        while (cursor.get(event_id, unused, MDB_NEXT)) {
+                sentNotificationIds_.insert(event_id);
+                sentNotificationRing_.push_back(event_id);
+        }
+
+        cursor.close();
+}
+
+void
+Cache::markSentNotification(const std::string &event_id)
+{
+        ensureSentNotificationsLoaded();
+
+        if (!sentNotificationIds_.insert(event_id).second)
+                return;
+
+        sentNotificationRing_.push_back(event_id);
+
+        auto txn = lmdb::txn::begin(env_);
+        lmdb::dbi_put(txn, notificationsDb_, lmdb::val(event_id), lmdb::val(std::string("")));
+
+        // Prune the oldest entries so the index & the backing db stay
+        // bounded. Ids already acknowledged through removeReadNotification
+        // are no longer part of the index and are simply skipped over.
+        while (sentNotificationRing_.size() > MAX_SENT_NOTIFICATIONS) {
+                const auto oldest = sentNotificationRing_.front();
+                sentNotificationRing_.pop_front();
+
+                if (sentNotificationIds_.erase(oldest) > 0)
+                        lmdb::dbi_del(txn, notificationsDb_, lmdb::val(oldest), nullptr);
+        }
+
+        txn.commit();
+}
+
+void
+Cache::removeReadNotification(const std::string &event_id)
+{
+        ensureSentNotificationsLoaded();
+
+        // Already acknowledged; don't pay for a write transaction. The ring
+        // entry, if any, is left in place and skipped during pruning.
+        if (sentNotificationIds_.erase(event_id) == 0)
+                return;
+
+        auto txn = lmdb::txn::begin(env_);
+
+        lmdb::dbi_del(txn, notificationsDb_, lmdb::val(event_id), nullptr);
+
+        txn.commit();
+}
+
+bool
+Cache::isNotificationSent(const std::string &event_id)
+{
+        ensureSentNotificationsLoaded();
+
+        return sentNotificationIds_.count(event_id) > 0;
+}
 
-                if (media_url.empty()) {
-                        txn.commit();
-                        return QImage();
-                }
-        } catch (const json::exception &e) {
-                nhlog::db()->warn("failed to parse room info: {}, {}",
-                                  e.what(),
-                                  std::string(response.data(), response.size()));
-        }
+void
+Cache::forEachRoom(lmdb::txn &txn,
+                   const std::function<bool(const lmdb::val &, const lmdb::val &)> &visitor)
+{
+        auto cursor = lmdb::cursor::open(txn, roomsDb_);
 
-        if (!lmdb::dbi_get(txn, mediaDb_, lmdb::val(media_url), response)) {
-                txn.commit();
-                return QImage();
+        // A single sequential pass; the views are only valid during the
+        // visitor call, so consumers copy what they keep.
+        lmdb::val room_id, record;
+        while (cursor.get(room_id, record, MDB_NEXT)) {
+                if (!visitor(room_id, record))
+                        break;
         }
 
-        txn.commit();
-
-        return QImage::fromData(QByteArray(response.data(), response.size()));
+        cursor.close();
 }
 
 std::vector<std::string>
-Cache::joinedRooms()
+Cache::getRoomIds(lmdb::txn &txn)
 {
-        auto txn         = lmdb::txn::begin(env_, nullptr, MDB_RDONLY);
-        auto roomsCursor = lmdb::cursor::open(txn, roomsDb_);
+        std::vector<std::string> rooms;
 
-        std::string id, data;
-        std::vector<std::string> room_ids;
+        forEachRoom(txn, [&rooms](const lmdb::val &room_id, const lmdb::val &) {
+                rooms.emplace_back(room_id.data(), room_id.size());
+                return true;
+        });
 
-        // Gather the room ids for the joined rooms.
-        while (roomsCursor.get(id, data, MDB_NEXT))
-                room_ids.emplace_back(id);
+        return rooms;
+}
 
-        roomsCursor.close();
-        txn.commit();
+QString
+Cache::coldSegmentPath(const std::string &room_id) const
+{
+        // Room ids contain characters that are invalid in file names, so
+        // the segment is named by the hex form of the id, like the cache
+        // directory itself.
+        const auto hex =
+          QByteArray(room_id.data(), static_cast<int>(room_id.size())).toHex();
 
-        return room_ids;
+        return QString("%1/%2.cold").arg(cacheDirectory_).arg(QString::fromUtf8(hex));
 }
 
 void
-Cache::populateMembers()
+Cache::migrateOldMessages()
 {
-        auto rooms = joinedRooms();
-        nhlog::db()->info("loading {} rooms", rooms.size());
+        std::vector<std::string> room_ids;
 
-        auto txn = lmdb::txn::begin(env_);
+        {
+                ReadTxn txn(*this);
+                room_ids = getRoomIds(txn);
+        }
 
-        for (const auto &room : rooms) {
-                const auto roomid = QString::fromStdString(room);
+        if (room_ids.empty())
+                return;
 
-                auto membersdb = getMembersDb(txn, room);
-                auto cursor    = lmdb::cursor::open(txn, membersdb);
+        // A few rooms per slice and a short write transaction per room, so
+        // syncs are never blocked behind a full sweep of every timeline.
+        const auto total = std::min(room_ids.size(), ROOMS_PER_MAINTENANCE_SLICE);
 
-                std::string user_id, info;
-                while (cursor.get(user_id, info, MDB_NEXT)) {
-                        MemberInfo m = json::parse(info);
+        for (std::size_t i = 0; i < total; i++) {
+                maintenanceIndex_ = (maintenanceIndex_ + 1) % room_ids.size();
+                const auto &id    = room_ids.at(maintenanceIndex_);
 
-                        const auto userid = QString::fromStdString(user_id);
+                auto txn    = lmdb::txn::begin(env_);
+                auto msg_db = getMessagesDb(txn, id);
 
-                        insertDisplayName(roomid, userid, QString::fromStdString(m.name));
-                        insertAvatarUrl(roomid, userid, QString::fromStdString(m.avatar_url));
+                const auto db_size = msg_db.size(txn);
+                if (db_size <= 3 * MAX_RESTORED_MESSAGES) {
+                        txn.commit();
+                        continue;
                 }
 
-                cursor.close();
-        }
+                QFile segment(coldSegmentPath(id));
+                if (!segment.open(QIODevice::WriteOnly | QIODevice::Append)) {
+                        nhlog::db()->warn("[{}] failed to open cold segment", id);
+                        txn.commit();
+                        continue;
+                }
 
-        txn.commit();
-}
+                QDataStream stream(&segment);
+                stream.setVersion(QDataStream::Qt_5_6);
 
-std::vector<RoomSearchResult>
-Cache::searchRooms(const std::string &query, std::uint8_t max_items)
-{
-        std::multimap<int, std::pair<std::string, RoomInfo>> items;
+                nhlog::db()->info("[{}] message count: {}", id, db_size);
 
-        auto txn    = lmdb::txn::begin(env_, nullptr, MDB_RDONLY);
-        auto cursor = lmdb::cursor::open(txn, roomsDb_);
+                std::string ts, event;
+                uint64_t idx = 0;
 
-        std::string room_id, room_data;
-        while (cursor.get(room_id, room_data, MDB_NEXT)) {
-                RoomInfo tmp = json::parse(std::move(room_data));
+                std::vector<std::string> migrated_ids;
 
-                const int score = utils::levenshtein_distance(
-                  query, QString::fromStdString(tmp.name).toLower().toStdString());
-                items.emplace(score, std::make_pair(room_id, tmp));
-        }
+                auto cursor = lmdb::cursor::open(txn, msg_db);
+                while (cursor.get(ts, event, MDB_NEXT)) {
+                        idx += 1;
 
-        cursor.close();
+                        if (idx > MAX_RESTORED_MESSAGES) {
+                                // The record is appended before the hot copy
+                                // is deleted and the file is flushed before
+                                // the transaction commits, so a crash can at
+                                // worst duplicate a frame, never lose one.
+                                stream << QByteArray(ts.data(), static_cast<int>(ts.size()))
+                                       << QByteArray(event.data(),
+                                                     static_cast<int>(event.size()));
+                                lmdb::cursor_del(cursor);
 
-        auto end = items.begin();
+                                try {
+                                        const auto obj =
+                                          json::parse(decompressRecord(event));
+
+                                        if (obj.count("event") != 0 &&
+                                            obj.at("event").count("event_id") != 0)
+                                                migrated_ids.push_back(obj.at("event")
+                                                                         .at("event_id")
+                                                                         .get<std::string>());
+                                } catch (const nlohmann::json::exception &) {
+                                        // A malformed record has no receipts
+                                        // worth keeping either.
+                                }
+                        }
+                }
 
-        if (items.size() >= max_items)
-                std::advance(end, max_items);
-        else if (items.size() > 0)
-                std::advance(end, items.size());
+                cursor.close();
+                segment.close();
 
-        std::vector<RoomSearchResult> results;
-        for (auto it = items.begin(); it != end; it++) {
-                results.push_back(
-                  RoomSearchResult{it->second.first,
-                                   it->second.second,
-                                   QImage::fromData(image(txn, it->second.second.avatar_url))});
-        }
+                // Nothing queries receipts of events that left the hot tier,
+                // so they are dropped in the same transaction.
+                deleteReadReceipts(txn, id, migrated_ids);
 
-        txn.commit();
+                nhlog::db()->info("[{}] hot message count: {}", id, msg_db.size(txn));
 
-        return results;
+                txn.commit();
+        }
 }
 
-QVector<SearchResult>
-Cache::searchUsers(const std::string &room_id, const std::string &query, std::uint8_t max_items)
+void
+Cache::deleteReadReceipts(lmdb::txn &txn,
+                          const std::string &room_id,
+                          const std::vector<std::string> &event_ids)
 {
-        std::multimap<int, std::pair<std::string, std::string>> items;
+        std::vector<QString> invalidated;
 
-        auto txn    = lmdb::txn::begin(env_, nullptr, MDB_RDONLY);
-        auto cursor = lmdb::cursor::open(txn, getMembersDb(txn, room_id));
+        for (const auto &event_id : event_ids) {
+                const auto key = readReceiptKey(room_id, event_id);
 
-        std::string user_id, user_data;
-        while (cursor.get(user_id, user_data, MDB_NEXT)) {
-                const auto display_name = displayName(room_id, user_id);
-                const int score         = utils::levenshtein_distance(query, display_name);
+                try {
+                        lmdb::dbi_del(
+                          txn, readReceiptsDb_, lmdb::val(key.data(), key.size()), nullptr);
 
-                items.emplace(score, std::make_pair(user_id, display_name));
+                        invalidated.push_back(receiptOverlayKey(
+                          QString::fromStdString(room_id), QString::fromStdString(event_id)));
+                } catch (const lmdb::error &e) {
+                        nhlog::db()->warn("deleteReadReceipts: {}", e.what());
+                }
         }
 
-        auto end = items.begin();
+        if (!invalidated.empty())
+                publishReceipts({}, invalidated);
 
-        if (items.size() >= max_items)
-                std::advance(end, max_items);
-        else if (items.size() > 0)
-                std::advance(end, items.size());
+        if (!event_ids.empty())
+                nhlog::db()->debug(
+                  "[{}] pruned receipts of {} migrated event(s)", room_id, event_ids.size());
+}
 
-        QVector<SearchResult> results;
-        for (auto it = items.begin(); it != end; it++) {
-                const auto user = it->second;
-                results.push_back(SearchResult{QString::fromStdString(user.first),
-                                               QString::fromStdString(user.second)});
+boost::optional<std::string>
+Cache::getMessageRecord(const std::string &room_id, const std::string &timeline_key)
+{
+        try {
+                ReadTxn txn(*this);
+                auto db = getMessagesDb(txn, room_id);
+
+                lmdb::val value;
+                if (lmdb::dbi_get(txn, db, lmdb::val(timeline_key), value))
+                        return std::string(value.data(), value.size());
+        } catch (const lmdb::error &) {
+                // The room has no messages db; check the cold tier anyway.
         }
 
-        return results;
+        return readColdRecord(room_id, timeline_key);
 }
 
-std::vector<RoomMember>
-Cache::getMembers(const std::string &room_id, std::size_t startIndex, std::size_t len)
+boost::optional<std::string>
+Cache::readColdRecord(const std::string &room_id, const std::string &timeline_key)
 {
-        auto txn    = lmdb::txn::begin(env_, nullptr, MDB_RDONLY);
-        auto db     = getMembersDb(txn, room_id);
-        auto cursor = lmdb::cursor::open(txn, db);
-
-        std::size_t currentIndex = 0;
+        QFile segment(coldSegmentPath(room_id));
+        if (!segment.open(QIODevice::ReadOnly))
+                return boost::none;
 
-        const auto endIndex = std::min(startIndex + len, db.size(txn));
+        // Cold reads are rare (search hits & deep scrollback), so the
+        // segment is scanned linearly instead of carrying an index.
+        QDataStream stream(&segment);
+        stream.setVersion(QDataStream::Qt_5_6);
 
-        std::vector<RoomMember> members;
+        const auto needle =
+          QByteArray(timeline_key.data(), static_cast<int>(timeline_key.size()));
 
-        std::string user_id, user_data;
-        while (cursor.get(user_id, user_data, MDB_NEXT)) {
-                if (currentIndex < startIndex) {
-                        currentIndex += 1;
-                        continue;
-                }
+        QByteArray key, value;
+        while (!stream.atEnd()) {
+                stream >> key >> value;
 
-                if (currentIndex >= endIndex)
+                if (stream.status() != QDataStream::Ok)
                         break;
 
-                try {
-                        MemberInfo tmp = json::parse(user_data);
-                        members.emplace_back(
-                          RoomMember{QString::fromStdString(user_id),
-                                     QString::fromStdString(tmp.name),
-                                     QImage::fromData(image(txn, tmp.avatar_url))});
-                } catch (const json::exception &e) {
-                        nhlog::db()->warn("{}", e.what());
-                }
-
-                currentIndex += 1;
+                if (key == needle)
+                        return std::string(value.constData(), value.size());
         }
 
-        cursor.close();
-        txn.commit();
-
-        return members;
+        return boost::none;
 }
 
-bool
-Cache::isRoomMember(const std::string &user_id, const std::string &room_id)
+boost::optional<std::size_t>
+Cache::exportRoomHistory(const std::string &room_id, const QString &path)
 {
-        auto txn = lmdb::txn::begin(env_);
-        auto db  = getMembersDb(txn, room_id);
+        QFile out(path);
+        if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+                nhlog::db()->warn("[{}] failed to open export file {}",
+                                  room_id,
+                                  path.toStdString());
+                return boost::none;
+        }
 
-        lmdb::val value;
-        bool res = lmdb::dbi_get(txn, db, lmdb::val(user_id), value);
-        txn.commit();
+        std::size_t exported = 0;
 
-        return res;
-}
+        const auto writeRecord = [&out, &exported](const std::string &record) {
+                try {
+                        const auto obj = json::parse(decompressRecord(record));
 
-void
-Cache::saveTimelineMessages(lmdb::txn &txn,
-                            const std::string &room_id,
-                            const mtx::responses::Timeline &res)
-{
-        auto db = getMessagesDb(txn, room_id);
+                        if (obj.count("event") == 0)
+                                return;
 
-        using namespace mtx::events;
-        using namespace mtx::events::state;
+                        const auto line = obj.at("event").dump();
+                        out.write(line.data(), static_cast<qint64>(line.size()));
+                        out.write("\n", 1);
 
-        for (const auto &e : res.events) {
-                if (isStateEvent(e))
-                        continue;
+                        exported += 1;
+                } catch (const nlohmann::json::exception &e) {
+                        nhlog::db()->warn("export: malformed record: {}", e.what());
+                }
+        };
 
-                if (boost::get<RedactionEvent<msg::Redaction>>(&e) != nullptr)
-                        continue;
+        // The cold segment holds the older part of the timeline; its frames
+        // are streamed in migration order, one frame in memory at a time.
+        QFile segment(coldSegmentPath(room_id));
+        if (segment.open(QIODevice::ReadOnly)) {
+                QDataStream stream(&segment);
+                stream.setVersion(QDataStream::Qt_5_6);
 
-                json obj = json::object();
+                QByteArray key, value;
+                while (!stream.atEnd()) {
+                        stream >> key >> value;
 
-                obj["event"] = utils::serialize_event(e);
-                obj["token"] = res.prev_batch;
+                        if (stream.status() != QDataStream::Ok)
+                                break;
 
-                lmdb::dbi_put(txn,
-                              db,
-                              lmdb::val(std::to_string(utils::event_timestamp(e))),
-                              lmdb::val(obj.dump()));
+                        writeRecord(std::string(value.constData(), value.size()));
+                }
         }
-}
 
-void
-Cache::markSentNotification(const std::string &event_id)
-{
-        auto txn = lmdb::txn::begin(env_);
-        lmdb::dbi_put(txn, notificationsDb_, lmdb::val(event_id), lmdb::val(std::string("")));
-        txn.commit();
-}
+        // The hot db is sorted newest-first, so it is walked backwards to
+        // come out oldest-first, through a cursor on a read snapshot.
+        try {
+                ReadTxn txn(*this);
+                auto db     = getMessagesDb(txn, room_id);
+                auto cursor = lmdb::cursor::open(txn, db);
+
+                std::string key, value;
+                bool ok = cursor.get(key, value, MDB_LAST);
+                while (ok) {
+                        writeRecord(value);
+                        ok = cursor.get(key, value, MDB_PREV);
+                }
 
-void
-Cache::removeReadNotification(const std::string &event_id)
-{
-        auto txn = lmdb::txn::begin(env_);
+                cursor.close();
+        } catch (const lmdb::error &e) {
+                nhlog::db()->warn("[{}] export: {}", room_id, e.what());
+        }
 
-        lmdb::dbi_del(txn, notificationsDb_, lmdb::val(event_id), nullptr);
+        nhlog::db()->info(
+          "[{}] exported {} event(s) to {}", room_id, exported, path.toStdString());
 
-        txn.commit();
+        return exported;
 }
 
-bool
-Cache::isNotificationSent(const std::string &event_id)
+void
+Cache::evictMedia()
 {
-        auto txn = lmdb::txn::begin(env_, nullptr, MDB_RDONLY);
-
-        lmdb::val value;
-        bool res = lmdb::dbi_get(txn, notificationsDb_, lmdb::val(event_id), value);
-        txn.commit();
+        struct MediaEntry
+        {
+                std::string last_access;
+                std::string url;
+                size_t size;
+                bool is_thumbnail;
+        };
 
-        return res;
-}
+        auto txn = lmdb::txn::begin(env_);
 
-std::vector<std::string>
-Cache::getRoomIds(lmdb::txn &txn)
-{
-        auto db     = lmdb::dbi::open(txn, ROOMS_DB, MDB_CREATE);
-        auto cursor = lmdb::cursor::open(txn, db);
+        std::vector<MediaEntry> entries;
+        size_t total_size = 0;
 
-        std::vector<std::string> rooms;
+        // Thumbnail variants are tracked like any other media entry; they
+        // have their own access stamps and are evicted independently.
+        for (auto db : {&mediaDb_, &mediaThumbnailsDb_}) {
+                auto cursor = lmdb::cursor::open(txn, *db);
 
-        std::string room_id, _unused;
-        while (cursor.get(room_id, _unused, MDB_NEXT))
-                rooms.emplace_back(room_id);
+                std::string url, data;
+                while (cursor.get(url, data, MDB_NEXT)) {
+                        lmdb::val last_access;
+                        std::string access_key;
 
-        cursor.close();
+                        // Entries without access info are the first to go.
+                        if (lmdb::dbi_get(txn, mediaAccessDb_, lmdb::val(url), last_access))
+                                access_key =
+                                  std::string(last_access.data(), last_access.size());
 
-        return rooms;
-}
+                        total_size += data.size();
+                        entries.push_back(
+                          {std::move(access_key), url, data.size(), db == &mediaThumbnailsDb_});
+                }
 
-void
-Cache::deleteOldMessages()
-{
-        auto txn      = lmdb::txn::begin(env_);
-        auto room_ids = getRoomIds(txn);
+                cursor.close();
+        }
 
-        for (const auto &id : room_ids) {
-                auto msg_db = getMessagesDb(txn, id);
+        if (total_size <= MAX_MEDIA_SIZE) {
+                txn.commit();
+                return;
+        }
 
-                std::string ts, event;
-                uint64_t idx = 0;
+        nhlog::db()->info("media cache is over budget: {} bytes", total_size);
 
-                const auto db_size = msg_db.size(txn);
-                if (db_size <= 3 * MAX_RESTORED_MESSAGES)
-                        continue;
+        std::sort(entries.begin(), entries.end(), [](const MediaEntry &a, const MediaEntry &b) {
+                const bool a_tiny = a.size <= PLACEHOLDER_MEDIA_SIZE;
+                const bool b_tiny = b.size <= PLACEHOLDER_MEDIA_SIZE;
 
-                nhlog::db()->info("[{}] message count: {}", id, db_size);
+                // Heavyweight entries go first, oldest to newest; an image
+                // evicted long ago still paints a placeholder instantly.
+                if (a_tiny != b_tiny)
+                        return b_tiny;
 
-                auto cursor = lmdb::cursor::open(txn, msg_db);
-                while (cursor.get(ts, event, MDB_NEXT)) {
-                        idx += 1;
+                return a.last_access < b.last_access;
+        });
 
-                        if (idx > MAX_RESTORED_MESSAGES)
-                                lmdb::cursor_del(cursor);
-                }
+        for (const auto &entry : entries) {
+                if (total_size <= MAX_MEDIA_SIZE)
+                        break;
 
-                cursor.close();
+                lmdb::dbi_del(txn,
+                              entry.is_thumbnail ? mediaThumbnailsDb_ : mediaDb_,
+                              lmdb::val(entry.url),
+                              nullptr);
+                lmdb::dbi_del(txn, mediaAccessDb_, lmdb::val(entry.url), nullptr);
 
-                nhlog::db()->info("[{}] updated message count: {}", id, msg_db.size(txn));
+                total_size -= entry.size;
         }
 
         txn.commit();
+
+        nhlog::db()->info("media cache size after eviction: {} bytes", total_size);
 }
 
 void
 Cache::deleteOldData() noexcept
 {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - lastMaintenance_ < MAINTENANCE_INTERVAL)
+                return;
+        lastMaintenance_ = now;
+
         try {
-                deleteOldMessages();
+                migrateOldMessages();
         } catch (const lmdb::error &e) {
                 nhlog::db()->error("failed to delete old messages: {}", e.what());
         }
+
+        try {
+                evictMedia();
+        } catch (const lmdb::error &e) {
+                nhlog::db()->error("failed to evict old media: {}", e.what());
+        }
+
+        // Overlay hit rates, for sizing the in-memory caches.
+        if (receiptOverlayLookups_ > 0)
+                nhlog::db()->debug("receipt overlay: {}/{} lookups served in memory",
+                                   receiptOverlayHits_.load(),
+                                   receiptOverlayLookups_.load());
+
+        if (senderLookups_ > 0)
+                nhlog::db()->debug("sender overlay: {}/{} lookups had a cached profile",
+                                   senderHits_.load(),
+                                   senderLookups_.load());
+
+        // Persist the sampled storage statistics, so hit rates and txn
+        // latencies can be inspected across sessions.
+        try {
+                const auto stats = perf::cacheStats();
+                if (stats.txnCount > 0) {
+                        const json j{{"image_hits", stats.imageHits},
+                                     {"image_misses", stats.imageMisses},
+                                     {"room_info_hits", stats.roomInfoHits},
+                                     {"room_info_misses", stats.roomInfoMisses},
+                                     {"txn_count", stats.txnCount},
+                                     {"txn_total_us", stats.txnTotalUs}};
+
+                        auto txn = lmdb::txn::begin(env_);
+                        lmdb::dbi_put(txn, statsDb_, lmdb::val("cache"), lmdb::val(j.dump()));
+                        txn.commit();
+
+                        nhlog::db()->debug(
+                          "cache stats (sampled): image {}/{} hits, room info {}/{} hits, "
+                          "mean read txn {}us",
+                          stats.imageHits,
+                          stats.imageHits + stats.imageMisses,
+                          stats.roomInfoHits,
+                          stats.roomInfoHits + stats.roomInfoMisses,
+                          stats.txnTotalUs / stats.txnCount);
+                }
+        } catch (const lmdb::error &e) {
+                nhlog::db()->warn("failed to persist cache stats: {}", e.what());
+        }
 }
 
 bool
@@ -1870,7 +4360,7 @@ Cache::hasEnoughPowerLevel(const std::vector<mtx::events::EventType> &eventTypes
         if (res) {
                 try {
                         StateEvent<PowerLevels> msg =
-                          json::parse(std::string(event.data(), event.size()));
+                          parseRecord(event.data(), event.size());
 
                         user_level = msg.content.user_level(user_id);
 
@@ -1892,7 +4382,7 @@ Cache::hasEnoughPowerLevel(const std::vector<mtx::events::EventType> &eventTypes
 std::vector<std::string>
 Cache::roomMembers(const std::string &room_id)
 {
-        auto txn = lmdb::txn::begin(env_, nullptr, MDB_RDONLY);
+        ReadTxn txn(*this);
 
         std::vector<std::string> members;
         std::string user_id, unused;
@@ -1904,20 +4394,69 @@ Cache::roomMembers(const std::string &room_id)
                 members.emplace_back(std::move(user_id));
         cursor.close();
 
-        txn.commit();
-
         return members;
 }
 
-QHash<QString, QString> Cache::DisplayNames;
-QHash<QString, QString> Cache::AvatarUrls;
+QHash<QString, QHash<QString, SenderInfo>> Cache::Senders;
+
+//! The sync path mutates the sender records from the http worker
+//! threads while the GUI thread reads them on every timeline item
+//! build.
+static std::mutex sendersMutex_;
+
+//! The name the timeline renders next to a message. Matrix ids have
+//! their server part stripped.
+static QString
+timelineName(const QString &displayname)
+{
+        if (!displayname.startsWith("@"))
+                return displayname;
+
+        // TODO: Fix this by using a UserId type.
+        if (displayname.split(":")[0].split("@").size() > 1)
+                return displayname.split(":")[0].split("@")[1];
+
+        return displayname;
+}
+
+SenderInfo
+Cache::senderInfo(const QString &room_id, const QString &user_id)
+{
+        senderLookups_ += 1;
+
+        std::lock_guard<std::mutex> lock(sendersMutex_);
+
+        auto room = Senders.constFind(room_id);
+        if (room != Senders.constEnd()) {
+                auto it = room->constFind(user_id);
+                if (it != room->constEnd() && !it->display_name.isEmpty()) {
+                        senderHits_ += 1;
+                        return *it;
+                }
+        }
+
+        SenderInfo fallback;
+        fallback.display_name  = user_id;
+        fallback.timeline_name = timelineName(user_id);
+
+        return fallback;
+}
 
 QString
 Cache::displayName(const QString &room_id, const QString &user_id)
 {
-        auto fmt = QString("%1 %2").arg(room_id).arg(user_id);
-        if (DisplayNames.contains(fmt))
-                return DisplayNames[fmt];
+        senderLookups_ += 1;
+
+        std::lock_guard<std::mutex> lock(sendersMutex_);
+
+        auto room = Senders.constFind(room_id);
+        if (room != Senders.constEnd()) {
+                auto it = room->constFind(user_id);
+                if (it != room->constEnd() && !it->display_name.isEmpty()) {
+                        senderHits_ += 1;
+                        return it->display_name;
+                }
+        }
 
         return user_id;
 }
@@ -1925,19 +4464,21 @@ Cache::displayName(const QString &room_id, const QString &user_id)
 std::string
 Cache::displayName(const std::string &room_id, const std::string &user_id)
 {
-        auto fmt = QString::fromStdString(room_id + " " + user_id);
-        if (DisplayNames.contains(fmt))
-                return DisplayNames[fmt].toStdString();
-
-        return user_id;
+        return displayName(QString::fromStdString(room_id), QString::fromStdString(user_id))
+          .toStdString();
 }
 
 QString
 Cache::avatarUrl(const QString &room_id, const QString &user_id)
 {
-        auto fmt = QString("%1 %2").arg(room_id).arg(user_id);
-        if (AvatarUrls.contains(fmt))
-                return AvatarUrls[fmt];
+        std::lock_guard<std::mutex> lock(sendersMutex_);
+
+        auto room = Senders.constFind(room_id);
+        if (room != Senders.constEnd()) {
+                auto it = room->constFind(user_id);
+                if (it != room->constEnd())
+                        return it->avatar_url;
+        }
 
         return QString();
 }
@@ -1947,27 +4488,53 @@ Cache::insertDisplayName(const QString &room_id,
                          const QString &user_id,
                          const QString &display_name)
 {
-        auto fmt = QString("%1 %2").arg(room_id).arg(user_id);
-        DisplayNames.insert(fmt, display_name);
+        // Identifiers repeat across every message of their room; storing
+        // the interned copies keeps one allocation per id.
+        std::lock_guard<std::mutex> lock(sendersMutex_);
+
+        auto &entry = Senders[utils::intern(room_id)][utils::intern(user_id)];
+
+        entry.display_name = display_name;
+        // The timeline shortening is precomputed here, once per member
+        // event, instead of on every item of the sender.
+        entry.timeline_name = timelineName(display_name);
 }
 
 void
 Cache::removeDisplayName(const QString &room_id, const QString &user_id)
 {
-        auto fmt = QString("%1 %2").arg(room_id).arg(user_id);
-        DisplayNames.remove(fmt);
+        std::lock_guard<std::mutex> lock(sendersMutex_);
+
+        auto room = Senders.find(room_id);
+        if (room == Senders.end())
+                return;
+
+        auto it = room->find(user_id);
+        if (it == room->end())
+                return;
+
+        it->display_name.clear();
+        it->timeline_name.clear();
 }
 
 void
 Cache::insertAvatarUrl(const QString &room_id, const QString &user_id, const QString &avatar_url)
 {
-        auto fmt = QString("%1 %2").arg(room_id).arg(user_id);
-        AvatarUrls.insert(fmt, avatar_url);
+        std::lock_guard<std::mutex> lock(sendersMutex_);
+
+        Senders[utils::intern(room_id)][utils::intern(user_id)].avatar_url = avatar_url;
 }
 
 void
 Cache::removeAvatarUrl(const QString &room_id, const QString &user_id)
 {
-        auto fmt = QString("%1 %2").arg(room_id).arg(user_id);
-        AvatarUrls.remove(fmt);
+        std::lock_guard<std::mutex> lock(sendersMutex_);
+
+        auto room = Senders.find(room_id);
+        if (room == Senders.end())
+                return;
+
+        auto it = room->find(user_id);
+        if (it != room->end())
+                it->avatar_url.clear();
 }
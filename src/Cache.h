@@ -19,11 +19,23 @@
 
 #include <boost/optional.hpp>
 
+#include <QByteArray>
+#include <QCache>
 #include <QDateTime>
 #include <QDir>
+#include <QHash>
 #include <QImage>
 #include <QString>
 
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <unordered_set>
+#include <utility>
+
 #include <json.hpp>
 #include <lmdb++.h>
 #include <mtx/events/join_rules.hpp>
@@ -31,7 +43,9 @@
 #include <mtxclient/crypto/client.hpp>
 #include <mutex>
 
+#include "Arena.h"
 #include "Logging.h"
+#include "Perf.h"
 
 using mtx::events::state::JoinRule;
 
@@ -48,18 +62,117 @@ struct SearchResult
         QString display_name;
 };
 
+//! Location of a stored event: the room it belongs to and its key in
+//! that room's messages db.
+struct EventLocation
+{
+        std::string room_id;
+        std::string timeline_key;
+};
+
+//! Encode a timestamp as a fixed-width big-endian key, so LMDB can order
+//! the message databases with a plain byte comparison.
+inline std::string
+timestampKey(uint64_t ts)
+{
+        std::string key(sizeof(ts), '\0');
+
+        for (std::size_t i = 0; i < sizeof(ts); i++)
+                key[i] = static_cast<char>(ts >> (8 * (sizeof(ts) - 1 - i)));
+
+        return key;
+}
+
+//! Decode a timestamp encoded by timestampKey.
+inline uint64_t
+timestampFromKey(const std::string &key)
+{
+        uint64_t ts = 0;
+
+        for (std::size_t i = 0; i < sizeof(ts) && i < key.size(); i++)
+                ts = (ts << 8) | static_cast<unsigned char>(key[i]);
+
+        return ts;
+}
+
+//! Keeps the message databases sorted with the newest events first.
 static int
 numeric_key_comparison(const MDB_val *a, const MDB_val *b)
 {
-        auto lhs = std::stoull(std::string((char *)a->mv_data, a->mv_size));
-        auto rhs = std::stoull(std::string((char *)b->mv_data, b->mv_size));
+        if (a->mv_size != b->mv_size)
+                return a->mv_size < b->mv_size ? 1 : -1;
+
+        return std::memcmp(b->mv_data, a->mv_data, a->mv_size);
+}
+
+//! Compact binary (CBOR) encoding used for the values of the state,
+//! member and room databases. Decoding binary records is an order of
+//! magnitude cheaper than parsing the equivalent JSON text.
+inline std::string
+serializeRecord(const json &j)
+{
+        const auto buffer = json::to_cbor(j);
+        return std::string(buffer.begin(), buffer.end());
+}
+
+//! Serialize straight into an arena. Encoding goes through a reused
+//! per-thread scratch buffer, so preparing a batch of records is one
+//! pointer bump per record instead of a malloc/free round trip.
+inline util::StringRef
+serializeRecord(const json &j, util::Arena &arena)
+{
+        thread_local std::string scratch;
+
+        scratch.clear();
+        json::to_cbor(j, scratch);
+
+        return arena.store(scratch);
+}
+
+inline json
+parseRecord(const char *data, std::size_t size)
+{
+        return json::from_cbor(std::vector<uint8_t>(data, data + size));
+}
+
+inline json
+parseRecord(const std::string &data)
+{
+        return parseRecord(data.data(), data.size());
+}
+
+//! Deflate-compressed encoding used for the values of the messages
+//! databases. Event bodies are repetitive JSON, so compression shrinks
+//! the map severalfold and with it the page-cache pressure and the
+//! cold-start I/O.
+inline std::string
+compressRecord(const std::string &data)
+{
+        const auto buffer =
+          qCompress(QByteArray::fromRawData(data.data(), static_cast<int>(data.size())));
+        return std::string(buffer.constData(), buffer.size());
+}
+
+inline util::StringRef
+compressRecord(const std::string &data, util::Arena &arena)
+{
+        const auto buffer =
+          qCompress(QByteArray::fromRawData(data.data(), static_cast<int>(data.size())));
+        return arena.store(buffer.constData(), static_cast<std::size_t>(buffer.size()));
+}
 
-        if (lhs < rhs)
-                return 1;
-        else if (lhs == rhs)
-                return 0;
+inline std::string
+decompressRecord(const char *data, std::size_t size)
+{
+        const auto buffer =
+          qUncompress(QByteArray::fromRawData(data, static_cast<int>(size)));
+        return std::string(buffer.constData(), buffer.size());
+}
 
-        return -1;
+inline std::string
+decompressRecord(const std::string &data)
+{
+        return decompressRecord(data.data(), data.size());
 }
 
 Q_DECLARE_METATYPE(SearchResult)
@@ -96,6 +209,26 @@ struct DescInfo
         QDateTime datetime;
 };
 
+inline void
+to_json(json &j, const DescInfo &info)
+{
+        j["username"]  = info.username.toStdString();
+        j["userid"]    = info.userid.toStdString();
+        j["body"]      = info.body.toStdString();
+        j["timestamp"] = info.timestamp.toStdString();
+        j["datetime"]  = info.datetime.toMSecsSinceEpoch();
+}
+
+inline void
+from_json(const json &j, DescInfo &info)
+{
+        info.username  = QString::fromStdString(j.at("username").get<std::string>());
+        info.userid    = QString::fromStdString(j.at("userid").get<std::string>());
+        info.body      = QString::fromStdString(j.at("body").get<std::string>());
+        info.timestamp = QString::fromStdString(j.at("timestamp").get<std::string>());
+        info.datetime  = QDateTime::fromMSecsSinceEpoch(j.at("datetime").get<qint64>());
+}
+
 //! UI info associated with a room.
 struct RoomInfo
 {
@@ -109,6 +242,8 @@ struct RoomInfo
         bool is_invite = false;
         //! Total number of members in the room.
         int16_t member_count = 0;
+        //! Number of unread notifications reported by the server.
+        uint16_t notification_count = 0;
         //! Who can access to the room.
         JoinRule join_rule = JoinRule::Public;
         bool guest_access  = false;
@@ -128,6 +263,12 @@ to_json(json &j, const RoomInfo &info)
 
         if (info.member_count != 0)
                 j["member_count"] = info.member_count;
+
+        if (info.notification_count != 0)
+                j["notification_count"] = info.notification_count;
+
+        if (!info.msgInfo.userid.isEmpty())
+                j["msg_info"] = info.msgInfo;
 }
 
 inline void
@@ -142,8 +283,74 @@ from_json(const json &j, RoomInfo &info)
 
         if (j.count("member_count"))
                 info.member_count = j.at("member_count");
+
+        if (j.count("notification_count"))
+                info.notification_count = j.at("notification_count");
+
+        if (j.count("msg_info"))
+                info.msgInfo = j.at("msg_info");
+}
+
+//! Cached profile of a community, so the sidebar paints without waiting
+//! for the network.
+struct GroupInfo
+{
+        //! The display name of the community.
+        std::string name;
+        //! The avatar url of the community.
+        std::string avatar_url;
+};
+
+inline void
+to_json(json &j, const GroupInfo &info)
+{
+        j["name"]       = info.name;
+        j["avatar_url"] = info.avatar_url;
+}
+
+inline void
+from_json(const json &j, GroupInfo &info)
+{
+        info.name       = j.at("name");
+        info.avatar_url = j.at("avatar_url");
 }
 
+//! Field-level changes of a room, classified from the state events of a
+//! sync. Only the fields whose flag is set have been recomputed; the
+//! rest should be ignored by the receiver.
+struct RoomUpdate
+{
+        bool nameChanged    = false;
+        bool avatarChanged  = false;
+        bool topicChanged   = false;
+        bool membersChanged = false;
+        bool is_invite      = false;
+
+        std::string name;
+        std::string avatar_url;
+        std::string topic;
+        int16_t member_count = 0;
+};
+
+//! Everything the room dialogs (settings, user profile) read from the
+//! cache, captured in one read transaction. Issuing the getters
+//! separately would open a transaction each and could observe
+//! different sync generations.
+struct RoomStateSnapshot
+{
+        RoomInfo info;
+        //! The room avatar, already decoded. Null if none is set.
+        QImage avatar;
+        bool is_encrypted = false;
+
+        //! Power level checks for the dialogs' controls, all evaluated
+        //! against the same m.room.power_levels event.
+        bool can_change_join_rules = false;
+        bool can_change_name_topic = false;
+        bool can_change_avatar     = false;
+        bool can_kick_members      = false;
+};
+
 //! Basic information per member;
 struct MemberInfo
 {
@@ -151,6 +358,18 @@ struct MemberInfo
         std::string avatar_url;
 };
 
+//! Interned identity of a sender, shared by all the timeline items of
+//! that sender in a room and invalidated only by member events.
+struct SenderInfo
+{
+        //! Resolved display name; empty when only the matrix id is known.
+        QString display_name;
+        //! The name rendered next to a message: the display name with the
+        //! server part stripped when it falls back to the matrix id.
+        QString timeline_name;
+        QString avatar_url;
+};
+
 inline void
 to_json(json &j, const MemberInfo &info)
 {
@@ -239,10 +458,21 @@ struct MegolmSessionIndex
         std::string to_hash() const { return room_id + session_id + sender_key; }
 };
 
+//! A checked-out inbound megolm session. libolm advances the session's
+//! ratchet state in place on every decryption, so the mutex must be
+//! held across the decrypt call; the shared_ptr keeps the session alive
+//! if a newer pickle replaces it in the store while a decrypt is still
+//! running.
+struct InboundGroupSessionRef
+{
+        std::shared_ptr<OlmInboundGroupSession> session;
+        std::shared_ptr<std::mutex> mutex;
+};
+
 struct OlmSessionStorage
 {
         // Megolm sessions
-        std::map<std::string, mtx::crypto::InboundGroupSessionPtr> group_inbound_sessions;
+        std::map<std::string, InboundGroupSessionRef> group_inbound_sessions;
         std::map<std::string, mtx::crypto::OutboundGroupSessionPtr> group_outbound_sessions;
         std::map<std::string, OutboundGroupSessionData> group_outbound_session_data;
 
@@ -258,8 +488,14 @@ class Cache : public QObject
 public:
         Cache(const QString &userId, QObject *parent = nullptr);
 
-        static QHash<QString, QString> DisplayNames;
-        static QHash<QString, QString> AvatarUrls;
+        //! Interned sender identities: room_id -> user_id -> record.
+        //! Written by the sync path off the GUI thread; every access goes
+        //! through the accessors below, which serialize on a mutex.
+        static QHash<QString, QHash<QString, SenderInfo>> Senders;
+
+        //! Retrieve the interned record of a sender, falling back to the
+        //! matrix id for unknown members.
+        static SenderInfo senderInfo(const QString &room_id, const QString &user_id);
 
         static std::string displayName(const std::string &room_id, const std::string &user_id);
         static QString displayName(const QString &room_id, const QString &user_id);
@@ -277,10 +513,15 @@ public:
 
         //! Load saved data for the display names & avatars.
         void populateMembers();
+        //! Touch the pages the restore pass is about to read (room records,
+        //! members, the restored slice of each timeline), so the page
+        //! faults of a cold OS cache overlap the session restore and the
+        //! widget construction instead of serializing with them. Runs on a
+        //! background thread; only reads.
+        void prefetchState();
         std::vector<std::string> joinedRooms();
 
         QMap<QString, RoomInfo> roomInfo(bool withInvites = true);
-        std::map<QString, bool> invites();
 
         //! Calculate & return the name of the room.
         QString getRoomName(lmdb::txn &txn, lmdb::dbi &statesdb, lmdb::dbi &membersdb);
@@ -295,19 +536,28 @@ public:
                                  lmdb::dbi &membersdb,
                                  const QString &room_id);
 
-        //! Retrieve member info from a room.
-        std::vector<RoomMember> getMembers(const std::string &room_id,
-                                           std::size_t startIndex = 0,
-                                           std::size_t len        = 30);
+        //! Variant that runs inside an already open transaction.
+        RoomInfo singleRoomInfo(lmdb::txn &txn, const std::string &room_id);
 
-        void saveState(const mtx::responses::Sync &res);
+        //! Retrieve a page of members from a room, starting after the given user id.
+        //! An empty id starts from the beginning of the member list.
+        std::vector<RoomMember> getMembersAfter(const std::string &room_id,
+                                                const std::string &after = "",
+                                                std::size_t len          = 30);
+
+        //! Persist a sync response. Returns the rooms whose invite entry
+        //! was removed, e.g because the invite was accepted or the room
+        //! was left, so the UI can drop exactly those items.
+        std::vector<QString> saveState(const mtx::responses::Sync &res);
         bool isInitialized() const;
 
         std::string nextBatchToken() const;
 
         void deleteData();
 
-        void removeInvite(lmdb::txn &txn, const std::string &room_id);
+        //! Drop the invite entry of a room, if one exists. Returns whether
+        //! an entry was actually deleted.
+        bool removeInvite(lmdb::txn &txn, const std::string &room_id);
         void removeInvite(const std::string &room_id);
         void removeRoom(lmdb::txn &txn, const std::string &roomid);
         void removeRoom(const std::string &roomid);
@@ -316,6 +566,10 @@ public:
 
         bool isFormatValid();
         void setCurrentFormat();
+        //! Upgrade an old cache format in place, resuming a previously
+        //! interrupted run from its checkpoint. Returns false when no
+        //! upgrade path to the current version exists.
+        bool runMigrations();
 
         std::map<QString, mtx::responses::Timeline> roomMessages();
 
@@ -346,6 +600,7 @@ public:
         //! Returns a map of user ids and the time of the read receipt in milliseconds.
         using UserReceipts = std::multimap<uint64_t, std::string, std::greater<uint64_t>>;
         UserReceipts readReceipts(const QString &event_id, const QString &room_id);
+        UserReceipts readReceipts(lmdb::txn &txn, const QString &event_id, const QString &room_id);
 
         //! Filter the events that have at least one read receipt.
         std::vector<QString> filterReadEvents(const QString &room_id,
@@ -353,46 +608,129 @@ public:
                                               const std::string &excluded_user);
         //! Add event for which we are expecting some read receipts.
         void addPendingReceipt(const QString &room_id, const QString &event_id);
+        //! Like addPendingReceipt for a batch of (room id, event id)
+        //! pairs, sharing one write transaction.
+        void addPendingReceipts(const std::vector<std::pair<QString, QString>> &entries);
         void removePendingReceipt(lmdb::txn &txn,
                                   const std::string &room_id,
                                   const std::string &event_id);
+
+        //! Add a serialized message to the room's persistent outbox.
+        void savePendingMessage(const std::string &room_id,
+                                const std::string &txn_id,
+                                const std::string &msg);
+        //! Remove a message from the outbox, after the server has acknowledged it.
+        void removePendingMessage(const std::string &room_id, const std::string &txn_id);
+        //! Retrieve the unsent messages of a room, in the order they were queued.
+        std::vector<std::string> pendingMessages(const std::string &room_id);
         void notifyForReadReceipts(lmdb::txn &txn, const std::string &room_id);
         std::vector<QString> pendingReceiptsEvents(lmdb::txn &txn, const std::string &room_id);
 
-        QByteArray image(const QString &url) const;
-        QByteArray image(lmdb::txn &txn, const std::string &url) const;
-        QByteArray image(const std::string &url) const
+        //! Retrieve and decode a stored image. The decoder reads straight
+        //! from the database's memory map, so no intermediate copy of the
+        //! encoded data is made.
+        QImage image(const QString &url) const;
+        QImage image(lmdb::txn &txn, const std::string &url) const;
+        //! Retrieve multiple images in a single read transaction. Urls that
+        //! are not cached are missing from the returned map.
+        QHash<QString, QImage> images(const std::vector<QString> &urls) const;
+        QImage image(const std::string &url) const
         {
                 return image(QString::fromStdString(url));
         }
         void saveImage(const std::string &url, const std::string &data);
         void saveImage(const QString &url, const QByteArray &data);
+        //! Retrieve the decoded thumbnail of an image for the given bounding
+        //! box, if one has been generated before.
+        QImage imageThumbnail(const QString &url, const QSize &box) const;
+        //! Retrieve an image scaled to a square of the given edge length in
+        //! device pixels, generating and persisting the scaled variant on
+        //! first use so later launches read prescaled bitmaps. The key
+        //! includes the url and the size, so a changed avatar url or pixel
+        //! ratio misses naturally and the stale variants age out through
+        //! the media eviction pass.
+        QImage scaledImage(const QString &url, int pixelSize);
+        //! Store an encoded thumbnail variant of an image, so later displays
+        //! of the same bounding box skip the full-size decode.
+        void saveImageThumbnail(const QString &url, const QSize &box, const QByteArray &data);
 
         RoomInfo singleRoomInfo(const std::string &room_id);
-        std::vector<std::string> roomsWithStateUpdates(const mtx::responses::Sync &res);
+        //! Capture all the state a room dialog needs in a single read
+        //! transaction, so the dialog opens with one consistent view of
+        //! the room instead of several reads racing with sync writes.
+        RoomStateSnapshot roomStateSnapshot(const std::string &room_id,
+                                            const std::string &user_id);
         std::map<QString, RoomInfo> getRoomInfo(const std::vector<std::string> &rooms);
-        std::map<QString, RoomInfo> roomUpdates(const mtx::responses::Sync &sync)
-        {
-                return getRoomInfo(roomsWithStateUpdates(sync));
-        }
+        //! Classify the state events of a sync into field-level deltas, so
+        //! unchanged room fields are never re-read from the database.
+        std::map<QString, RoomUpdate> roomUpdates(const mtx::responses::Sync &sync);
 
         QVector<SearchResult> searchUsers(const std::string &room_id,
                                           const std::string &query,
                                           std::uint8_t max_items = 5);
         std::vector<RoomSearchResult> searchRooms(const std::string &query,
                                                   std::uint8_t max_items = 5);
-
+        //! Resolve a canonical alias to the id of a joined room, without
+        //! a server round trip. Linear in the number of rooms.
+        boost::optional<std::string> roomIdFromAlias(const std::string &alias);
+        //! Full-text search in the indexed messages of a room. All the terms
+        //! of the query must match. Returns the matching event ids, newest first.
+        std::vector<QString> searchMessages(const QString &room_id,
+                                            const QString &query,
+                                            std::size_t max_results = 100);
+        //! Find an event by id through the event index, without iterating
+        //! any room's timeline db.
+        boost::optional<EventLocation> locateEvent(const std::string &event_id);
+        //! Fetch a stored message record by its timeline key. Looks in the
+        //! hot messages db first and falls back to the room's cold segment,
+        //! so callers don't care which tier holds the event.
+        boost::optional<std::string> getMessageRecord(const std::string &room_id,
+                                                      const std::string &timeline_key);
+        //! Stream every stored event of the room to the given file as one
+        //! JSON object per line: the cold segment in migration order, then
+        //! the hot tier oldest first. A single record is held in memory at
+        //! a time. Returns the number of exported events, or none if the
+        //! file couldn't be written.
+        boost::optional<std::size_t> exportRoomHistory(const std::string &room_id,
+                                                       const QString &path);
+
+        //! Journal a piece of UI session state (e.g. "active_room", or a
+        //! "draft/<room_id>" composer draft) with one tiny write, so the
+        //! context survives a crash. An empty value removes the entry.
+        void saveSessionState(const std::string &key, const std::string &value);
+        //! Read back a journaled session value.
+        boost::optional<std::string> restoreSessionState(const std::string &key);
+
+        //! Save a community profile. Returns whether the stored profile
+        //! actually changed, so callers can skip redundant UI updates.
+        bool saveGroupProfile(const std::string &group_id, const GroupInfo &profile);
+        //! Read back the cached profile of a community.
+        boost::optional<GroupInfo> getGroupProfile(const std::string &group_id);
+
+        //! Remember that a desktop notification was shown for the event.
+        //! The oldest remembered ids are pruned once the cap is reached.
         void markSentNotification(const std::string &event_id);
         //! Removes an event from the sent notifications.
         void removeReadNotification(const std::string &event_id);
         //! Check if we have sent a desktop notification for the given event id.
         bool isNotificationSent(const std::string &event_id);
 
-        //! Remove old unused data.
-        void deleteOldMessages();
+        //! Move the cold part of a few rooms' timelines into their segment
+        //! files, one short write transaction each.
+        void migrateOldMessages();
+        //! Run one incremental slice of the background maintenance, at most
+        //! once per interval. Called after every sync.
         void deleteOldData() noexcept;
+        //! Evict least recently used media entries until the store fits its size budget.
+        void evictMedia();
         //! Retrieve all saved room ids.
         std::vector<std::string> getRoomIds(lmdb::txn &txn);
+        //! Walk every joined room in one sequential cursor pass, handing
+        //! (room id, head record) views to the visitor. Return false from
+        //! the visitor to stop the walk early. Bulk consumers go through
+        //! this instead of re-querying per room id.
+        void forEachRoom(lmdb::txn &txn,
+                         const std::function<bool(const lmdb::val &, const lmdb::val &)> &visitor);
 
         //! Mark a room that uses e2e encryption.
         void setEncryptedRoom(lmdb::txn &txn, const std::string &room_id);
@@ -405,6 +743,12 @@ public:
         //! Save the device list for a user.
         void setDeviceList(const std::string &user_id, const std::vector<std::string> &devices);
         std::vector<std::string> getDeviceList(const std::string &user_id);
+        //! Apply a batch of refreshed device lists in a single transaction.
+        //! Each stored record carries a version that is bumped only when
+        //! the list actually differs; unchanged users are skipped. Returns
+        //! the users whose list changed.
+        std::vector<std::string> updateDeviceLists(
+          const std::map<std::string, std::vector<std::string>> &lists);
 
         //! Check if a user is a member of the room.
         bool isRoomMember(const std::string &user_id, const std::string &room_id);
@@ -424,7 +768,9 @@ public:
         //
         void saveInboundMegolmSession(const MegolmSessionIndex &index,
                                       mtx::crypto::InboundGroupSessionPtr session);
-        OlmInboundGroupSession *getInboundMegolmSession(const MegolmSessionIndex &index);
+        //! Check out the session for decryption. The returned session may
+        //! be empty when it couldn't be restored from the database.
+        InboundGroupSessionRef getInboundMegolmSession(const MegolmSessionIndex &index);
         bool inboundMegolmSessionExists(const MegolmSessionIndex &index) noexcept;
 
         //
@@ -438,8 +784,28 @@ public:
         void saveOlmAccount(const std::string &pickled);
         std::string restoreOlmAccount();
 
+        //! Kick off the background warming of the saved megolm sessions.
+        //! The sessions are unpickled on first use, so nothing blocks on
+        //! the accumulated history here.
         void restoreSessions();
 
+        //
+        // Decrypted events
+        //
+        //! Save the plaintext payload of a decrypted event.
+        void saveDecryptedEvent(const std::string &room_id,
+                                const std::string &event_id,
+                                const std::string &payload);
+        //! The payload stored by a previous decryption of the event, if any.
+        boost::optional<std::string> getDecryptedEvent(const std::string &room_id,
+                                                       const std::string &event_id);
+        //! The stored payloads for the given events, fetched with a single
+        //! read transaction. Events without a stored payload are absent
+        //! from the result.
+        std::map<std::string, std::string> getDecryptedEvents(
+          const std::string &room_id,
+          const std::vector<std::string> &event_ids);
+
         OlmSessionStorage session_storage;
 
 signals:
@@ -454,34 +820,155 @@ private:
 
         QString getInviteRoomName(lmdb::txn &txn, lmdb::dbi &statesdb, lmdb::dbi &membersdb);
         QString getInviteRoomTopic(lmdb::txn &txn, lmdb::dbi &statesdb);
+
+        //! The cache format version stored on disk.
+        std::string cacheFormatVersion();
+        //! Stream every record of a database through `transform`,
+        //! rewriting the values in bounded transactions. Progress is
+        //! checkpointed with each transaction, so an interrupted
+        //! migration resumes where it stopped instead of starting over.
+        void migrateValues(
+          const std::string &dbName,
+          std::function<std::string(const std::string &key, const std::string &value)> transform);
+        //! Names of every named database in the environment.
+        std::vector<std::string> databaseNames();
+        //! Rewrite a room's messages database to binary timestamp keys
+        //! and compressed values, rebuilding the event & search index
+        //! entries from the converted records. The rewrite is one atomic
+        //! transaction per room.
+        void migrateMessagesDb(const std::string &room_id);
+        //! 2018.09.21 turned the state, member & room records into CBOR,
+        //! compressed the message values and rekeyed the message
+        //! databases with fixed-width binary timestamps.
+        bool migrateTo20180921();
         QString getInviteRoomAvatarUrl(lmdb::txn &txn, lmdb::dbi &statesdb, lmdb::dbi &membersdb);
 
         DescInfo getLastMessageInfo(lmdb::txn &txn, const std::string &room_id);
-        void saveTimelineMessages(lmdb::txn &txn,
-                                  const std::string &room_id,
-                                  const mtx::responses::Timeline &res);
+
+        //! A message waiting to be added to the search index.
+        struct SearchIndexEntry
+        {
+                std::string room_id;
+                std::string event_id;
+                uint64_t timestamp;
+                std::string body;
+        };
+
+        //! Precomputed search key of a room for the quick switcher.
+        struct RoomSearchEntry
+        {
+                std::string room_id;
+                //! Lowercased room name.
+                std::string name;
+                //! Lowercased room topic.
+                std::string topic;
+                //! One bit per letter or digit appearing in the name or topic.
+                uint64_t mask = 0;
+        };
+
+        //! Refresh a room's entry in the quick switcher index. No-op until
+        //! the index has been built by the first search.
+        void updateRoomSearchEntry(const std::string &room_id,
+                                   const std::string &name,
+                                   const std::string &topic);
+        //! Drop a room from the quick switcher index.
+        void dropRoomSearchEntry(const std::string &room_id);
+
+        //! Collect the messages of a timeline that should be indexed.
+        void collectSearchIndexEntries(const std::string &room_id,
+                                       const mtx::responses::Timeline &res,
+                                       std::vector<SearchIndexEntry> &entries);
+        //! Tokenize the given messages and write them to the search
+        //! indexes of their rooms. Runs on the thread pool.
+        void writeSearchIndex(const std::vector<SearchIndexEntry> &entries);
+
+        //! File that holds the room's migrated timeline records as
+        //! length-prefixed, already-compressed frames, append only.
+        QString coldSegmentPath(const std::string &room_id) const;
+        //! Scan the room's cold segment for the given timeline key.
+        boost::optional<std::string> readColdRecord(const std::string &room_id,
+                                                    const std::string &timeline_key);
+        //! Drop the read receipt entries of the given events, e.g. after
+        //! the events themselves left the hot tier.
+        void deleteReadReceipts(lmdb::txn &txn,
+                                const std::string &room_id,
+                                const std::vector<std::string> &event_ids);
+        //! Apply the room's retention policy, if one is configured,
+        //! inside the transaction that ingested the new events. The
+        //! dropped records take their receipts and event index entries
+        //! with them.
+        void enforceRetention(lmdb::txn &txn, const std::string &room_id);
+
+        //! A membership update ready to be written.
+        struct PreparedMember
+        {
+                std::string state_key;
+                //! Serialized MemberInfo; empty when the membership was lost.
+                util::StringRef record;
+                std::string display_name;
+                std::string avatar_url;
+        };
+
+        //! The write batch of a single room.
+        //!
+        //! Serializing events to their stored form dominates the cost of
+        //! persisting a sync response and doesn't need database access, so
+        //! the batches of independent rooms are prepared in parallel on the
+        //! thread pool. Only the writes are serialized, since LMDB permits
+        //! a single write transaction.
+        struct PreparedRoom
+        {
+                std::string room_id;
+                //! Backs the bytes of every prepared record, so the batch is
+                //! filled with pointer bumps and released with one bulk free.
+                //! Shared because QFuture hands out copies of its result.
+                std::shared_ptr<util::Arena> arena = std::make_shared<util::Arena>();
+                //! Records for the states db, sorted by key.
+                std::vector<std::pair<std::string, util::StringRef>> state;
+                //! Membership updates, sorted by state key.
+                std::vector<PreparedMember> members;
+                //! Records for the messages db: timestamp key -> serialized
+                //! event, sorted in the db's newest-first key order.
+                std::vector<std::pair<std::string, util::StringRef>> messages;
+                //! Entries for the event index: event id -> timeline key,
+                //! sorted by event id.
+                std::vector<std::pair<std::string, std::string>> eventIndex;
+                std::vector<SearchIndexEntry> searchEntries;
+                bool isEncryptionEnabled = false;
+        };
+
+        //! Serialize a room of a sync response. Doesn't touch the database.
+        PreparedRoom prepareRoom(const std::string &room_id,
+                                 const mtx::responses::JoinedRoom &room);
+        //! Write a prepared batch under the given transaction.
+        void applyPreparedRoom(lmdb::txn &txn, const PreparedRoom &room);
+
+        //! Unpickle a saved inbound megolm session on first use. Expects
+        //! the inbound session mutex to be held.
+        bool restoreInboundMegolmSession(const std::string &key);
+        //! Unpickle a saved outbound megolm session on first use. Expects
+        //! the outbound session mutex to be held.
+        bool restoreOutboundMegolmSession(const std::string &room_id);
+        //! Unpickle every saved session that hasn't been used yet, so the
+        //! first messages of a room don't pay the cost. Runs on the thread
+        //! pool.
+        void warmSessionCache() noexcept;
+
+        //! Update the typeahead index of a room member. The entries of the
+        //! previously stored display name are dropped, so it must be called
+        //! before the member record is overwritten or deleted.
+        void indexMember(lmdb::txn &txn,
+                         const std::string &room_id,
+                         const std::string &user_id,
+                         const std::string &display_name,
+                         bool removed = false);
 
         mtx::responses::Timeline getTimelineMessages(lmdb::txn &txn, const std::string &room_id);
 
         //! Remove a room from the cache.
         // void removeLeftRoom(lmdb::txn &txn, const std::string &room_id);
         template<class T>
-        void saveStateEvents(lmdb::txn &txn,
-                             const lmdb::dbi &statesdb,
-                             const lmdb::dbi &membersdb,
-                             const std::string &room_id,
-                             const std::vector<T> &events)
-        {
-                for (const auto &e : events)
-                        saveStateEvent(txn, statesdb, membersdb, room_id, e);
-        }
-
-        template<class T>
-        void saveStateEvent(lmdb::txn &txn,
-                            const lmdb::dbi &statesdb,
-                            const lmdb::dbi &membersdb,
-                            const std::string &room_id,
-                            const T &event)
+        void prepareStateEvent(PreparedRoom &batch, const T &event)
         {
                 using namespace mtx::events;
                 using namespace mtx::events::state;
@@ -489,50 +976,34 @@ private:
                 if (boost::get<StateEvent<Member>>(&event) != nullptr) {
                         const auto e = boost::get<StateEvent<Member>>(event);
 
+                        PreparedMember member;
+                        member.state_key = e.state_key;
+
                         switch (e.content.membership) {
                         //
                         // We only keep users with invite or join membership.
                         //
                         case Membership::Invite:
                         case Membership::Join: {
-                                auto display_name = e.content.display_name.empty()
-                                                      ? e.state_key
-                                                      : e.content.display_name;
+                                member.display_name = e.content.display_name.empty()
+                                                        ? e.state_key
+                                                        : e.content.display_name;
+                                member.avatar_url   = e.content.avatar_url;
 
                                 // Lightweight representation of a member.
-                                MemberInfo tmp{display_name, e.content.avatar_url};
-
-                                lmdb::dbi_put(txn,
-                                              membersdb,
-                                              lmdb::val(e.state_key),
-                                              lmdb::val(json(tmp).dump()));
-
-                                insertDisplayName(QString::fromStdString(room_id),
-                                                  QString::fromStdString(e.state_key),
-                                                  QString::fromStdString(display_name));
-
-                                insertAvatarUrl(QString::fromStdString(room_id),
-                                                QString::fromStdString(e.state_key),
-                                                QString::fromStdString(e.content.avatar_url));
+                                MemberInfo tmp{member.display_name, member.avatar_url};
+                                member.record = serializeRecord(json(tmp), *batch.arena);
 
                                 break;
                         }
-                        default: {
-                                lmdb::dbi_del(
-                                  txn, membersdb, lmdb::val(e.state_key), lmdb::val(""));
-
-                                removeDisplayName(QString::fromStdString(room_id),
-                                                  QString::fromStdString(e.state_key));
-                                removeAvatarUrl(QString::fromStdString(room_id),
-                                                QString::fromStdString(e.state_key));
-
+                        default:
                                 break;
                         }
-                        }
 
+                        batch.members.emplace_back(std::move(member));
                         return;
                 } else if (boost::get<StateEvent<Encryption>>(&event) != nullptr) {
-                        setEncryptedRoom(txn, room_id);
+                        batch.isEncryptionEnabled = true;
                         return;
                 }
 
@@ -540,9 +1011,9 @@ private:
                         return;
 
                 boost::apply_visitor(
-                  [&txn, &statesdb](auto e) {
-                          lmdb::dbi_put(
-                            txn, statesdb, lmdb::val(to_string(e.type)), lmdb::val(json(e).dump()));
+                  [&batch](auto e) {
+                          batch.state.emplace_back(to_string(e.type),
+                                                   serializeRecord(json(e), *batch.arena));
                   },
                   event);
         }
@@ -567,42 +1038,62 @@ private:
         }
 
         template<class T>
-        bool containsStateUpdates(const T &e)
+        void classifyStateUpdates(const T &e, RoomUpdate &update)
         {
                 using namespace mtx::events;
                 using namespace mtx::events::state;
 
-                return boost::get<StateEvent<state::Avatar>>(&e) != nullptr ||
-                       boost::get<StateEvent<CanonicalAlias>>(&e) != nullptr ||
-                       boost::get<StateEvent<Name>>(&e) != nullptr ||
-                       boost::get<StateEvent<Member>>(&e) != nullptr ||
-                       boost::get<StateEvent<Topic>>(&e) != nullptr;
+                // The calculated name & avatar of 1:1 chats are derived from
+                // the other member, so member changes invalidate them too.
+                if (boost::get<StateEvent<Member>>(&e) != nullptr) {
+                        update.membersChanged = true;
+                        update.nameChanged    = true;
+                        update.avatarChanged  = true;
+                } else if (boost::get<StateEvent<Name>>(&e) != nullptr ||
+                           boost::get<StateEvent<CanonicalAlias>>(&e) != nullptr) {
+                        update.nameChanged = true;
+                } else if (boost::get<StateEvent<state::Avatar>>(&e) != nullptr) {
+                        update.avatarChanged = true;
+                } else if (boost::get<StateEvent<Topic>>(&e) != nullptr) {
+                        update.topicChanged = true;
+                }
         }
 
-        bool containsStateUpdates(const mtx::events::collections::StrippedEvents &e)
+        void classifyStateUpdates(const mtx::events::collections::StrippedEvents &e,
+                                  RoomUpdate &update)
         {
                 using namespace mtx::events;
                 using namespace mtx::events::state;
 
-                return boost::get<StrippedEvent<state::Avatar>>(&e) != nullptr ||
-                       boost::get<StrippedEvent<CanonicalAlias>>(&e) != nullptr ||
-                       boost::get<StrippedEvent<Name>>(&e) != nullptr ||
-                       boost::get<StrippedEvent<Member>>(&e) != nullptr ||
-                       boost::get<StrippedEvent<Topic>>(&e) != nullptr;
+                if (boost::get<StrippedEvent<Member>>(&e) != nullptr) {
+                        update.membersChanged = true;
+                        update.nameChanged    = true;
+                        update.avatarChanged  = true;
+                } else if (boost::get<StrippedEvent<Name>>(&e) != nullptr ||
+                           boost::get<StrippedEvent<CanonicalAlias>>(&e) != nullptr) {
+                        update.nameChanged = true;
+                } else if (boost::get<StrippedEvent<state::Avatar>>(&e) != nullptr) {
+                        update.avatarChanged = true;
+                } else if (boost::get<StrippedEvent<Topic>>(&e) != nullptr) {
+                        update.topicChanged = true;
+                }
         }
 
         void saveInvites(lmdb::txn &txn,
                          const std::map<std::string, mtx::responses::InvitedRoom> &rooms);
 
-        //! Sends signals for the rooms that are removed.
+        //! Sends signals for the rooms that are removed. Invites that were
+        //! deleted along the way are appended to @p removedInvites.
         void removeLeftRooms(lmdb::txn &txn,
-                             const std::map<std::string, mtx::responses::LeftRoom> &rooms)
+                             const std::map<std::string, mtx::responses::LeftRoom> &rooms,
+                             std::vector<QString> &removedInvites)
         {
                 for (const auto &room : rooms) {
                         removeRoom(txn, room.first);
 
                         // Clean up leftover invites.
-                        removeInvite(txn, room.first);
+                        if (removeInvite(txn, room.first))
+                                removedInvites.push_back(QString::fromStdString(room.first));
                 }
         }
 
@@ -620,6 +1111,14 @@ private:
                 return db;
         }
 
+        //! Inverted index of the room's messages. Maps each token to the
+        //! events that contain it, as timestamp-prefixed event ids.
+        lmdb::dbi getSearchIndexDb(lmdb::txn &txn, const std::string &room_id)
+        {
+                return lmdb::dbi::open(
+                  txn, std::string(room_id + "/search_index").c_str(), MDB_CREATE | MDB_DUPSORT);
+        }
+
         lmdb::dbi getInviteStatesDb(lmdb::txn &txn, const std::string &room_id)
         {
                 return lmdb::dbi::open(
@@ -642,6 +1141,28 @@ private:
                 return lmdb::dbi::open(txn, std::string(room_id + "/members").c_str(), MDB_CREATE);
         }
 
+        lmdb::dbi getPendingMessagesDb(lmdb::txn &txn, const std::string &room_id)
+        {
+                return lmdb::dbi::open(txn, std::string(room_id + "/pending").c_str(), MDB_CREATE);
+        }
+
+        //! Typeahead index of the room's members. The sorted keys are the
+        //! normalized display name or user id followed by a null byte and
+        //! the user id, so a prefix scan gives the completions directly.
+        lmdb::dbi getMemberIndexDb(lmdb::txn &txn, const std::string &room_id)
+        {
+                return lmdb::dbi::open(
+                  txn, std::string(room_id + "/member_index").c_str(), MDB_CREATE);
+        }
+
+        //! Plaintext of the room's decrypted events by event id, so a
+        //! restart doesn't repeat yesterday's megolm work.
+        lmdb::dbi getDecryptedEventsDb(lmdb::txn &txn, const std::string &room_id)
+        {
+                return lmdb::dbi::open(
+                  txn, std::string(room_id + "/decrypted").c_str(), MDB_CREATE);
+        }
+
         //! Retrieves or creates the database that stores the open OLM sessions between our device
         //! and the given curve25519 key which represents another device.
         //!
@@ -663,13 +1184,74 @@ private:
         void setNextBatchToken(lmdb::txn &txn, const std::string &token);
         void setNextBatchToken(lmdb::txn &txn, const QString &token);
 
+        //! Update the last access timestamp of a media entry.
+        void markMediaAccessed(lmdb::txn &txn, const std::string &url) const;
+
+        //! Key of a thumbnail variant: the url plus the bounding box it was
+        //! generated for.
+        static std::string thumbnailKey(const std::string &url, const QSize &box)
+        {
+                return url + "\x1f" + std::to_string(box.width()) + "x" +
+                       std::to_string(box.height());
+        }
+
+        //! Periodically copy the database into a fresh, compacted file and
+        //! swap it in, returning the pages freed by maintenance to the
+        //! filesystem. Must run while there are no other users of the
+        //! environment, i.e during setup.
+        void compactDatabase(const QString &statePath);
+
+        //! Load the sent-notification ids from the database, once.
+        void ensureSentNotificationsLoaded();
+
+        //! Sent-notification ids, mirroring the database for constant time
+        //! duplicate checks. The insertion-ordered ring bounds the index &
+        //! the backing db: when the cap is reached the oldest id is pruned
+        //! from both. Only touched from the GUI thread.
+        std::unordered_set<std::string> sentNotificationIds_;
+        std::deque<std::string> sentNotificationRing_;
+        bool sentNotificationsLoaded_ = false;
+
+        //! Bounded in-memory overlay for receipt summaries, the hottest
+        //! point lookup of the receipts db. Filled on read; an entry is
+        //! dropped when its backing record is rewritten, so the next read
+        //! repopulates it. Published as immutable snapshots: a writer
+        //! copies the map, applies its batch and swaps the pointer, so
+        //! the GUI thread's lookups during a receipt-heavy sync never
+        //! wait on a lock.
+        using ReceiptShard = QHash<QString, UserReceipts>;
+        std::shared_ptr<const ReceiptShard> receiptShard_ =
+          std::make_shared<const ReceiptShard>();
+        //! Serializes the writers; readers don't touch it.
+        std::mutex receiptShardMutex_;
+        //! Overlay accounting, used to size the cache.
+        std::atomic<uint64_t> receiptOverlayHits_{0};
+        std::atomic<uint64_t> receiptOverlayLookups_{0};
+
+        //! Swap in a new receipt snapshot with @p adds inserted and
+        //! @p removes dropped. In-flight readers keep the snapshot they
+        //! loaded.
+        void publishReceipts(const std::vector<std::pair<QString, UserReceipts>> &adds,
+                             const std::vector<QString> &removes);
+
+        //! Round-robin position of the incremental timeline trimming.
+        std::size_t maintenanceIndex_ = 0;
+        //! When the background maintenance last ran.
+        std::chrono::steady_clock::time_point lastMaintenance_;
+
         lmdb::env env_;
         lmdb::dbi syncStateDb_;
+        lmdb::dbi sessionStateDb_;
+        lmdb::dbi statsDb_;
+        lmdb::dbi groupsDb_;
         lmdb::dbi roomsDb_;
         lmdb::dbi invitesDb_;
         lmdb::dbi mediaDb_;
+        lmdb::dbi mediaThumbnailsDb_;
+        lmdb::dbi mediaAccessDb_;
         lmdb::dbi readReceiptsDb_;
         lmdb::dbi notificationsDb_;
+        lmdb::dbi eventIndexDb_;
 
         lmdb::dbi devicesDb_;
         lmdb::dbi deviceKeysDb_;
@@ -677,14 +1259,99 @@ private:
         lmdb::dbi inboundMegolmSessionDb_;
         lmdb::dbi outboundMegolmSessionDb_;
 
+        friend class ReadTxn;
+
+        //! Get a read-only transaction from the pool, or create one.
+        lmdb::txn acquireReadTxn() const;
+        //! Reset the transaction and return it to the pool.
+        void releaseReadTxn(lmdb::txn &&txn) const;
+
+        //! Reusable read-only transactions. The environment is opened with
+        //! MDB_NOTLS so they can be renewed from any thread.
+        mutable std::mutex readTxnMutex_;
+        mutable std::vector<lmdb::txn> readTxnPool_;
+
+        //! Quick switcher index, queried from the thread pool. Built
+        //! lazily by the first search and maintained on sync updates.
+        std::mutex roomSearchMutex_;
+        std::map<std::string, RoomSearchEntry> roomSearchIndex_;
+        bool roomSearchIndexReady_ = false;
+
+        //! Bloom filter fronting a room's members db: a miss is a
+        //! definite non-member and skips lmdb, only possible members hit
+        //! storage. Built lazily by the first check; removals drop the
+        //! whole filter, since a bloom filter can't forget.
+        struct MembershipFilter
+        {
+                std::vector<uint64_t> bits;
+                std::size_t count = 0;
+        };
+
+        //! Record a member addition in the room's filter, if one is built.
+        void membershipFilterInsert(const std::string &room_id, const std::string &user_id);
+        //! Drop the room's filter, e.g. after a member left.
+        void invalidateMembershipFilter(const std::string &room_id);
+
+        std::mutex membershipFilterMutex_;
+        std::map<std::string, MembershipFilter> membershipFilters_;
+
         QString localUserId_;
         QString cacheDirectory_;
 };
 
+//! RAII handle to a pooled read-only transaction.
+//!
+//! The getters run frequently on both the GUI and the worker threads.
+//! Renewing a pooled transaction skips the reader slot setup that
+//! lmdb::txn::begin pays on every call.
+class ReadTxn
+{
+public:
+        ReadTxn(const Cache &cache)
+          : cache_{cache}
+          , sampled_{perf::sampleCacheCall()}
+          , start_{sampled_ ? std::chrono::steady_clock::now()
+                            : std::chrono::steady_clock::time_point{}}
+          , txn_{cache.acquireReadTxn()}
+        {}
+        ~ReadTxn()
+        {
+                cache_.releaseReadTxn(std::move(txn_));
+
+                // Only the sampled transactions pay for the clock reads.
+                if (sampled_)
+                        perf::accountCacheTxn(std::chrono::steady_clock::now() - start_);
+        }
+
+        ReadTxn(const ReadTxn &) = delete;
+        ReadTxn &operator=(const ReadTxn &) = delete;
+
+        operator MDB_txn *() const noexcept { return txn_.handle(); }
+        operator lmdb::txn &() noexcept { return txn_; }
+
+private:
+        const Cache &cache_;
+        const bool sampled_;
+        const std::chrono::steady_clock::time_point start_;
+        lmdb::txn txn_;
+};
+
 namespace cache {
+//! Create or activate the cache environment of the given account.
+//!
+//! Each account keeps its own environment under a separate directory,
+//! so several logins can live in one process; activating an account
+//! that already has an instance only swaps the active pointer. The
+//! process-wide pixmap & text caches are shared between accounts.
 void
 init(const QString &user_id);
 
+//! Destroy an account's cache instance, e.g before its data directory
+//! is recreated after a format change.
+void
+drop(const QString &user_id);
+
+//! The active account's cache.
 Cache *
 client();
 }
@@ -15,8 +15,13 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include <QApplication>
-#include <QImageReader>
+#include <QBuffer>
+#include <QFile>
+#include <QMimeDatabase>
+#include <QNetworkConfigurationManager>
 #include <QSettings>
 #include <QtConcurrent>
 
@@ -26,17 +31,21 @@
 #include "Logging.h"
 #include "MainWindow.h"
 #include "MatrixClient.h"
+#include "MediaDownloader.h"
 #include "Olm.h"
+#include "Perf.h"
 #include "QuickSwitcher.h"
 #include "RoomList.h"
 #include "SideBarActions.h"
 #include "Splitter.h"
 #include "TextInputWidget.h"
+#include "TimerLifecycle.h"
 #include "TopRoomBar.h"
 #include "TypingDisplay.h"
 #include "UserInfoWidget.h"
 #include "UserSettingsPage.h"
 #include "Utils.h"
+#include "VideoThumbnailer.h"
 #include "ui/OverlayModal.h"
 #include "ui/Theme.h"
 
@@ -49,8 +58,86 @@
 static const std::string STORAGE_SECRET_KEY("secret");
 
 ChatPage *ChatPage::instance_             = nullptr;
-constexpr int CHECK_CONNECTIVITY_INTERVAL = 15'000;
 constexpr size_t MAX_ONETIME_KEYS         = 50;
+constexpr int SYNC_RETRY_BASE_TIMEOUT     = 1'000;
+constexpr int SYNC_RETRY_MAX_TIMEOUT      = 60'000;
+
+//! Long-poll timeout while the window is visible.
+constexpr int SYNC_TIMEOUT_ACTIVE = 30'000;
+//! Long-poll timeout while the window is hidden in the tray. The longer
+//! the server holds the request, the fewer times an idle client wakes up.
+constexpr int SYNC_TIMEOUT_HIDDEN = 120'000;
+//! How long sync diffs are held back while the window is hidden. Nothing
+//! can be seen anyway, and the delay coalesces bursts into one apply.
+constexpr int SYNC_APPLY_HIDDEN_DELAY = 5'000;
+
+namespace {
+//! A payload prepared for upload, with the metadata needed to build the
+//! event afterwards.
+struct UploadContent
+{
+        std::string payload;
+        QString mime;
+        QSize dimensions;
+        QString error;
+};
+
+//! Read an upload into memory and, for oversized images, scale it down &
+//! re-encode it. Runs on the thread pool so a large paste never blocks
+//! the UI or inflates the bytes on the wire.
+UploadContent
+prepareUpload(QSharedPointer<QIODevice> dev, bool isImage, int maxDimension, int quality)
+{
+        UploadContent content;
+
+        QMimeDatabase db;
+        content.mime = db.mimeTypeForData(dev.data()).name();
+
+        if (!dev->open(QIODevice::ReadOnly)) {
+                content.error = dev->errorString();
+                return content;
+        }
+
+        auto bin = dev->readAll();
+
+        // Leave the device reusable so a dropped transfer can be restarted.
+        dev->close();
+
+        if (isImage) {
+                auto img           = QImage::fromData(bin);
+                content.dimensions = img.size();
+
+                if (!img.isNull() && (img.width() > maxDimension || img.height() > maxDimension)) {
+                        img = img.scaled(maxDimension,
+                                         maxDimension,
+                                         Qt::KeepAspectRatio,
+                                         Qt::SmoothTransformation);
+
+                        // Transparency only survives through PNG.
+                        const bool hasAlpha = img.hasAlphaChannel();
+
+                        QByteArray reencoded;
+                        QBuffer buffer(&reencoded);
+                        buffer.open(QIODevice::WriteOnly);
+
+                        if (img.save(&buffer, hasAlpha ? "PNG" : "JPEG", quality) &&
+                            reencoded.size() < bin.size()) {
+                                nhlog::ui()->info("re-encoded image upload: {} -> {} bytes",
+                                                  bin.size(),
+                                                  reencoded.size());
+
+                                bin                = reencoded;
+                                content.mime       = hasAlpha ? "image/png" : "image/jpeg";
+                                content.dimensions = img.size();
+                        }
+                }
+        }
+
+        content.payload = std::string(bin.data(), bin.size());
+
+        return content;
+}
+}
 
 ChatPage::ChatPage(QSharedPointer<UserSettings> userSettings, QWidget *parent)
   : QWidget(parent)
@@ -108,6 +195,8 @@ ChatPage::ChatPage(QSharedPointer<UserSettings> userSettings, QWidget *parent)
 
         top_bar_      = new TopRoomBar(this);
         view_manager_ = new TimelineViewManager(this);
+        view_manager_->setRoomVisibleCheck(
+          [this](const QString &room_id) { return room_list_->isRoomVisible(room_id); });
 
         contentLayout_->addWidget(top_bar_);
         contentLayout_->addWidget(view_manager_);
@@ -132,6 +221,18 @@ ChatPage::ChatPage(QSharedPointer<UserSettings> userSettings, QWidget *parent)
 
         typingRefresher_ = new QTimer(this);
         typingRefresher_->setInterval(TYPING_REFRESH_TIMEOUT);
+        // No reason to keep refreshing the typing state from the tray.
+        timers::pauseWhenHidden(this, typingRefresher_);
+
+        typingStopDebouncer_ = new QTimer(this);
+        typingStopDebouncer_->setInterval(TYPING_STOP_DEBOUNCE);
+        typingStopDebouncer_->setSingleShot(true);
+        connect(typingStopDebouncer_, &QTimer::timeout, this, &ChatPage::stopTypingNotifications);
+
+        typingCoalesceTimer_ = new QTimer(this);
+        typingCoalesceTimer_->setInterval(TYPING_COALESCE_TIMEOUT);
+        typingCoalesceTimer_->setSingleShot(true);
+        connect(typingCoalesceTimer_, &QTimer::timeout, this, &ChatPage::flushTypingUpdates);
 
         connect(this, &ChatPage::connectionLost, this, [this]() {
                 nhlog::net()->info("connectivity lost");
@@ -147,26 +248,29 @@ ChatPage::ChatPage(QSharedPointer<UserSettings> userSettings, QWidget *parent)
                 // Drop all pending connections.
                 http::client()->shutdown();
                 trySync();
+                startQueuedUploads();
         });
 
-        connectivityTimer_.setInterval(CHECK_CONNECTIVITY_INTERVAL);
-        connect(&connectivityTimer_, &QTimer::timeout, this, [=]() {
-                if (http::client()->access_token().empty()) {
-                        connectivityTimer_.stop();
-                        return;
-                }
-
-                http::client()->versions(
-                  [this](const mtx::responses::Versions &, mtx::http::RequestErr err) {
-                          if (err) {
-                                  emit connectionLost();
-                                  return;
-                          }
+        // Connectivity is inferred from the requests we already make —
+        // sync failures flip the state and back off, responses clear it —
+        // so there is no periodic probe. The OS's own online notion covers
+        // the cases without traffic in flight, e.g. resume from suspend.
+        auto networkManager = new QNetworkConfigurationManager(this);
+        connect(networkManager,
+                &QNetworkConfigurationManager::onlineStateChanged,
+                this,
+                [this](bool online) {
+                        if (http::client()->access_token().empty())
+                                return;
 
-                          if (!isConnected_)
-                                  emit connectionRestored();
-                  });
-        });
+                        if (online && !isConnected_) {
+                                nhlog::net()->info("network is back online");
+                                emit connectionRestored();
+                        } else if (!online && isConnected_) {
+                                nhlog::net()->info("network went offline");
+                                emit connectionLost();
+                        }
+                });
 
         connect(this, &ChatPage::loggedOut, this, &ChatPage::logout);
 
@@ -175,7 +279,7 @@ ChatPage::ChatPage(QSharedPointer<UserSettings> userSettings, QWidget *parent)
                 const auto room_id = current_room_.toStdString();
 
                 for (int ii = 0; ii < users.size(); ++ii) {
-                        QTimer::singleShot(ii * 500, this, [this, room_id, ii, users]() {
+                        timers::schedule(ii * 500, this, [this, room_id, ii, users]() {
                                 const auto user = users.at(ii);
 
                                 http::client()->invite_user(
@@ -210,6 +314,8 @@ ChatPage::ChatPage(QSharedPointer<UserSettings> userSettings, QWidget *parent)
                 typingDisplay_->setUsers(users);
         });
         connect(room_list_, &RoomList::roomChanged, text_input_, &TextInputWidget::stopTyping);
+        // Flush the typing state before current_room_ changes underneath us.
+        connect(room_list_, &RoomList::roomChanged, this, &ChatPage::stopTypingNotifications);
         connect(room_list_, &RoomList::roomChanged, this, &ChatPage::changeTopRoomInfo);
         connect(room_list_, &RoomList::roomChanged, splitter, &Splitter::showChatView);
         connect(room_list_, &RoomList::roomChanged, text_input_, &TextInputWidget::focusLineEdit);
@@ -231,22 +337,31 @@ ChatPage::ChatPage(QSharedPointer<UserSettings> userSettings, QWidget *parent)
           text_input_, &TextInputWidget::startedTyping, this, &ChatPage::sendTypingNotifications);
         connect(typingRefresher_, &QTimer::timeout, this, &ChatPage::sendTypingNotifications);
         connect(text_input_, &TextInputWidget::stoppedTyping, this, [this]() {
-                if (!userSettings_->isTypingNotificationsEnabled())
-                        return;
-
                 typingRefresher_->stop();
 
-                if (current_room_.isEmpty())
-                        return;
-
-                http::client()->stop_typing(
-                  current_room_.toStdString(), [](mtx::http::RequestErr err) {
-                          if (err) {
-                                  nhlog::net()->warn("failed to stop typing notifications: {}",
-                                                     err->matrix_error.error);
-                          }
-                  });
+                // Defer the actual request; a quick resume will cancel it.
+                if (isTypingStateSent_)
+                        typingStopDebouncer_->start();
+
+                // Journal the draft while it's warm; one tiny write.
+                if (!currentRoom().isEmpty()) {
+                        try {
+                                cache::client()->saveSessionState(
+                                  "draft/" + currentRoom().toStdString(),
+                                  text_input_->inputText().toStdString());
+                        } catch (const lmdb::error &e) {
+                                nhlog::db()->warn("failed to journal draft: {}", e.what());
+                        }
+                }
         });
+        // A message send implies the end of typing; skip the debounce and
+        // clear the state right away.
+        connect(
+          text_input_, &TextInputWidget::sendTextMessage, this, &ChatPage::stopTypingNotifications);
+        connect(text_input_,
+                &TextInputWidget::sendEmoteMessage,
+                this,
+                &ChatPage::stopTypingNotifications);
 
         connect(view_manager_,
                 &TimelineViewManager::updateRoomsLastMessage,
@@ -271,182 +386,49 @@ ChatPage::ChatPage(QSharedPointer<UserSettings> userSettings, QWidget *parent)
         connect(text_input_, &TextInputWidget::sendJoinRoomRequest, this, &ChatPage::joinRoom);
 
         connect(
-          text_input_,
-          &TextInputWidget::uploadImage,
-          this,
-          [this](QSharedPointer<QIODevice> dev, const QString &fn) {
-                  QMimeDatabase db;
-                  QMimeType mime = db.mimeTypeForData(dev.data());
-
-                  if (!dev->open(QIODevice::ReadOnly)) {
-                          emit uploadFailed(
-                            QString("Error while reading media: %1").arg(dev->errorString()));
-                          return;
-                  }
-
-                  auto bin        = dev->peek(dev->size());
-                  auto payload    = std::string(bin.data(), bin.size());
-                  auto dimensions = QImageReader(dev.data()).size();
-
-                  http::client()->upload(
-                    payload,
-                    mime.name().toStdString(),
-                    QFileInfo(fn).fileName().toStdString(),
-                    [this,
-                     room_id  = current_room_,
-                     filename = fn,
-                     mime     = mime.name(),
-                     size     = payload.size(),
-                     dimensions](const mtx::responses::ContentURI &res, mtx::http::RequestErr err) {
-                            if (err) {
-                                    emit uploadFailed(
-                                      tr("Failed to upload image. Please try again."));
-                                    nhlog::net()->warn("failed to upload image: {} {} ({})",
-                                                       err->matrix_error.error,
-                                                       to_string(err->matrix_error.errcode),
-                                                       static_cast<int>(err->status_code));
-                                    return;
-                            }
-
-                            emit imageUploaded(room_id,
-                                               filename,
-                                               QString::fromStdString(res.content_uri),
-                                               mime,
-                                               size,
-                                               dimensions);
-                    });
+          text_input_, &TextInputWidget::exportHistoryRequest, this, [this](const QString &path) {
+                  // The export is a long cursor walk over both timeline
+                  // tiers; it runs on the thread pool so the UI never waits.
+                  QtConcurrent::run([room_id = currentRoom().toStdString(), path]() {
+                          cache::client()->exportRoomHistory(room_id, path);
+                  });
           });
 
+        connect(text_input_,
+                &TextInputWidget::uploadImage,
+                this,
+                [this](QSharedPointer<QIODevice> data, const QString &fn) {
+                        queueUpload(data, fn, "image");
+                });
         connect(text_input_,
                 &TextInputWidget::uploadFile,
                 this,
-                [this](QSharedPointer<QIODevice> dev, const QString &fn) {
-                        QMimeDatabase db;
-                        QMimeType mime = db.mimeTypeForData(dev.data());
-
-                        if (!dev->open(QIODevice::ReadOnly)) {
-                                emit uploadFailed(
-                                  QString("Error while reading media: %1").arg(dev->errorString()));
-                                return;
-                        }
-
-                        auto bin     = dev->readAll();
-                        auto payload = std::string(bin.data(), bin.size());
-
-                        http::client()->upload(
-                          payload,
-                          mime.name().toStdString(),
-                          QFileInfo(fn).fileName().toStdString(),
-                          [this,
-                           room_id  = current_room_,
-                           filename = fn,
-                           mime     = mime.name(),
-                           size     = payload.size()](const mtx::responses::ContentURI &res,
-                                                  mtx::http::RequestErr err) {
-                                  if (err) {
-                                          emit uploadFailed(
-                                            tr("Failed to upload file. Please try again."));
-                                          nhlog::net()->warn("failed to upload file: {} ({})",
-                                                             err->matrix_error.error,
-                                                             static_cast<int>(err->status_code));
-                                          return;
-                                  }
-
-                                  emit fileUploaded(room_id,
-                                                    filename,
-                                                    QString::fromStdString(res.content_uri),
-                                                    mime,
-                                                    size);
-                          });
+                [this](QSharedPointer<QIODevice> data, const QString &fn) {
+                        queueUpload(data, fn, "file");
                 });
-
         connect(text_input_,
                 &TextInputWidget::uploadAudio,
                 this,
-                [this](QSharedPointer<QIODevice> dev, const QString &fn) {
-                        QMimeDatabase db;
-                        QMimeType mime = db.mimeTypeForData(dev.data());
-
-                        if (!dev->open(QIODevice::ReadOnly)) {
-                                emit uploadFailed(
-                                  QString("Error while reading media: %1").arg(dev->errorString()));
-                                return;
-                        }
-
-                        auto bin     = dev->readAll();
-                        auto payload = std::string(bin.data(), bin.size());
-
-                        http::client()->upload(
-                          payload,
-                          mime.name().toStdString(),
-                          QFileInfo(fn).fileName().toStdString(),
-                          [this,
-                           room_id  = current_room_,
-                           filename = fn,
-                           mime     = mime.name(),
-                           size     = payload.size()](const mtx::responses::ContentURI &res,
-                                                  mtx::http::RequestErr err) {
-                                  if (err) {
-                                          emit uploadFailed(
-                                            tr("Failed to upload audio. Please try again."));
-                                          nhlog::net()->warn("failed to upload audio: {} ({})",
-                                                             err->matrix_error.error,
-                                                             static_cast<int>(err->status_code));
-                                          return;
-                                  }
-
-                                  emit audioUploaded(room_id,
-                                                     filename,
-                                                     QString::fromStdString(res.content_uri),
-                                                     mime,
-                                                     size);
-                          });
+                [this](QSharedPointer<QIODevice> data, const QString &fn) {
+                        queueUpload(data, fn, "audio");
                 });
         connect(text_input_,
                 &TextInputWidget::uploadVideo,
                 this,
-                [this](QSharedPointer<QIODevice> dev, const QString &fn) {
-                        QMimeDatabase db;
-                        QMimeType mime = db.mimeTypeForData(dev.data());
-
-                        if (!dev->open(QIODevice::ReadOnly)) {
-                                emit uploadFailed(
-                                  QString("Error while reading media: %1").arg(dev->errorString()));
-                                return;
-                        }
-
-                        auto bin     = dev->readAll();
-                        auto payload = std::string(bin.data(), bin.size());
-
-                        http::client()->upload(
-                          payload,
-                          mime.name().toStdString(),
-                          QFileInfo(fn).fileName().toStdString(),
-                          [this,
-                           room_id  = current_room_,
-                           filename = fn,
-                           mime     = mime.name(),
-                           size     = payload.size()](const mtx::responses::ContentURI &res,
-                                                  mtx::http::RequestErr err) {
-                                  if (err) {
-                                          emit uploadFailed(
-                                            tr("Failed to upload video. Please try again."));
-                                          nhlog::net()->warn("failed to upload video: {} ({})",
-                                                             err->matrix_error.error,
-                                                             static_cast<int>(err->status_code));
-                                          return;
-                                  }
-
-                                  emit videoUploaded(room_id,
-                                                     filename,
-                                                     QString::fromStdString(res.content_uri),
-                                                     mime,
-                                                     size);
-                          });
+                [this](QSharedPointer<QIODevice> data, const QString &fn) {
+                        queueUpload(data, fn, "video");
                 });
 
+        connect(this, &ChatPage::uploadRetryRequested, this, [this](QueuedUpload item) {
+                // The slot is freed and the attachment goes to the front of
+                // the queue, so it restarts as soon as the connection is back.
+                activeUploads_ -= 1;
+                uploadQueue_.push_front(std::move(item));
+                startQueuedUploads();
+        });
+
         connect(this, &ChatPage::uploadFailed, this, [this](const QString &msg) {
-                text_input_->hideUploadSpinner();
+                uploadFinished();
                 emit showNotification(msg);
         });
         connect(this,
@@ -458,7 +440,7 @@ ChatPage::ChatPage(QSharedPointer<UserSettings> userSettings, QWidget *parent)
                        QString mime,
                        qint64 dsize,
                        QSize dimensions) {
-                        text_input_->hideUploadSpinner();
+                        uploadFinished();
                         view_manager_->queueImageMessage(
                           roomid, filename, url, mime, dsize, dimensions);
                 });
@@ -466,21 +448,29 @@ ChatPage::ChatPage(QSharedPointer<UserSettings> userSettings, QWidget *parent)
                 &ChatPage::fileUploaded,
                 this,
                 [this](QString roomid, QString filename, QString url, QString mime, qint64 dsize) {
-                        text_input_->hideUploadSpinner();
+                        uploadFinished();
                         view_manager_->queueFileMessage(roomid, filename, url, mime, dsize);
                 });
         connect(this,
                 &ChatPage::audioUploaded,
                 this,
                 [this](QString roomid, QString filename, QString url, QString mime, qint64 dsize) {
-                        text_input_->hideUploadSpinner();
+                        uploadFinished();
                         view_manager_->queueAudioMessage(roomid, filename, url, mime, dsize);
                 });
         connect(this,
                 &ChatPage::videoUploaded,
                 this,
                 [this](QString roomid, QString filename, QString url, QString mime, qint64 dsize) {
-                        text_input_->hideUploadSpinner();
+                        uploadFinished();
+
+                        // Warm the poster cache from the local file, so the local
+                        // echo doesn't have to decode the uploaded copy.
+                        VideoThumbnailer::extract(QUrl::fromLocalFile(filename),
+                                                  url + "/thumbnail",
+                                                  this,
+                                                  [](QImage) {});
+
                         view_manager_->queueVideoMessage(roomid, filename, url, mime, dsize);
                 });
 
@@ -489,6 +479,18 @@ ChatPage::ChatPage(QSharedPointer<UserSettings> userSettings, QWidget *parent)
         connect(
           this, &ChatPage::updateGroupsInfo, communitiesList_, &CommunitiesList::setCommunities);
 
+        connect(communitiesList_,
+                &CommunitiesList::groupRoomsRetrieved,
+                this,
+                [this](const QString &groupId, const std::map<QString, bool> &rooms) {
+                        room_list_->setCommunityRooms(groupId, rooms);
+
+                        // The rooms of the community on display arrived after
+                        // it was selected.
+                        if (groupId == current_community_)
+                                room_list_->applyFilter(groupId);
+                });
+
         connect(this, &ChatPage::leftRoom, this, &ChatPage::removeRoom);
         connect(this, &ChatPage::notificationsRetrieved, this, &ChatPage::sendDesktopNotifications);
 
@@ -501,7 +503,7 @@ ChatPage::ChatPage(QSharedPointer<UserSettings> userSettings, QWidget *parent)
                         if (groupId == "world")
                                 room_list_->removeFilter();
                         else
-                                room_list_->applyFilter(communitiesList_->roomList(groupId));
+                                room_list_->applyFilter(groupId);
                 });
 
         connect(&notificationsManager,
@@ -529,50 +531,33 @@ ChatPage::ChatPage(QSharedPointer<UserSettings> userSettings, QWidget *parent)
                 &ChatPage::initializeEmptyViews,
                 view_manager_,
                 &TimelineViewManager::initWithMessages);
-        connect(this, &ChatPage::syncUI, this, [this](const mtx::responses::Rooms &rooms) {
-                try {
-                        room_list_->cleanupInvites(cache::client()->invites());
-                } catch (const lmdb::error &e) {
-                        nhlog::db()->error("failed to retrieve invites: {}", e.what());
-                }
+        qRegisterMetaType<SyncDiff>();
+        qRegisterMetaType<QueuedUpload>();
 
-                view_manager_->initialize(rooms);
-                removeLeftRooms(rooms.leave);
+        diffApplyTimer_ = new QTimer(this);
+        diffApplyTimer_->setSingleShot(true);
+        connect(diffApplyTimer_, &QTimer::timeout, this, &ChatPage::applyPendingDiffs);
 
-                bool hasNotifications = false;
-                for (const auto &room : rooms.join) {
-                        auto room_id = QString::fromStdString(room.first);
-
-                        updateTypingUsers(room_id, room.second.ephemeral.typing);
-                        updateRoomNotificationCount(
-                          room_id, room.second.unread_notifications.notification_count);
-
-                        if (room.second.unread_notifications.notification_count > 0)
-                                hasNotifications = true;
-                }
-
-                if (hasNotifications && userSettings_->hasDesktopNotifications())
-                        http::client()->notifications(
-                          5,
-                          [this](const mtx::responses::Notifications &res,
-                                 mtx::http::RequestErr err) {
-                                  if (err) {
-                                          nhlog::net()->warn(
-                                            "failed to retrieve notifications: {} ({})",
-                                            err->matrix_error.error,
-                                            static_cast<int>(err->status_code));
-                                          return;
-                                  }
+        connect(this, &ChatPage::syncCompleted, this, [this](const SyncDiff &diff) {
+                // The diff is queued instead of applied inline, so the
+                // keystrokes already waiting in the event queue are handled
+                // before the repaint it triggers.
+                pendingDiffs_.push_back(diff);
 
-                                  emit notificationsRetrieved(std::move(res));
-                          });
+                if (!diffApplyTimer_->isActive())
+                        diffApplyTimer_->start(isBackgrounded() ? SYNC_APPLY_HIDDEN_DELAY : 0);
         });
-        connect(this, &ChatPage::syncRoomlist, room_list_, &RoomList::sync);
-        connect(
-          this, &ChatPage::syncTopBar, this, [this](const std::map<QString, RoomInfo> &updates) {
-                  if (updates.find(currentRoom()) != updates.end())
-                          changeTopRoomInfo(currentRoom());
-          });
+
+        // When the window comes back, everything that piled up while it
+        // was hidden is applied right away instead of waiting out the
+        // lazy delay.
+        connect(qApp,
+                &QApplication::applicationStateChanged,
+                this,
+                [this](Qt::ApplicationState state) {
+                        if (state == Qt::ApplicationActive && !pendingDiffs_.empty())
+                                diffApplyTimer_->start(0);
+                });
 
         // Callbacks to update the user info (top left corner of the page).
         connect(this, &ChatPage::setUserAvatar, user_info_widget_, &UserInfoWidget::setAvatar);
@@ -585,7 +570,30 @@ ChatPage::ChatPage(QSharedPointer<UserSettings> userSettings, QWidget *parent)
         connect(this, &ChatPage::tryInitialSyncCb, this, &ChatPage::tryInitialSync);
         connect(this, &ChatPage::trySyncCb, this, &ChatPage::trySync);
         connect(this, &ChatPage::tryDelayedSyncCb, this, [this]() {
-                QTimer::singleShot(5000, this, &ChatPage::trySync);
+                // Exponential backoff with jitter, so the clients of a
+                // restarted homeserver don't reconnect in lockstep.
+                const int cap =
+                  std::min(SYNC_RETRY_BASE_TIMEOUT * (1 << std::min(syncFailures_, 6)),
+                           SYNC_RETRY_MAX_TIMEOUT);
+                const int jitter = static_cast<int>(rand_() % static_cast<uint32_t>(cap / 2 + 1));
+                const int delay  = cap / 2 + jitter;
+
+                syncFailures_ += 1;
+
+                nhlog::net()->info("retrying sync in {} ms", delay);
+
+                timers::schedule(delay, this, [this]() { trySync(); });
+        });
+        connect(this, &ChatPage::syncCompleted, this, [this]() {
+                syncFailures_ = 0;
+
+                // A response proves the link works; only the input state
+                // has to catch up, the sync loop is already running.
+                if (!isConnected_) {
+                        isConnected_ = true;
+                        text_input_->enableInput();
+                        startQueuedUploads();
+                }
         });
 
         connect(this, &ChatPage::dropToLoginPageCb, this, &ChatPage::dropToLoginPage);
@@ -594,6 +602,262 @@ ChatPage::ChatPage(QSharedPointer<UserSettings> userSettings, QWidget *parent)
         instance_ = this;
 }
 
+void
+ChatPage::queueUpload(QSharedPointer<QIODevice> data,
+                      const QString &filename,
+                      const QString &media)
+{
+        QueuedUpload item;
+        item.data     = data;
+        item.filename = filename;
+        item.room_id  = current_room_;
+        item.media    = media;
+
+        uploadQueue_.push_back(std::move(item));
+        startQueuedUploads();
+}
+
+void
+ChatPage::startQueuedUploads()
+{
+        if (activeUploads_ == 0 && uploadQueue_.empty()) {
+                text_input_->hideUploadSpinner();
+                return;
+        }
+
+        // While offline the queue is held back; connectionRestored drains it.
+        if (!isConnected_)
+                return;
+
+        while (activeUploads_ < MAX_CONCURRENT_UPLOADS && !uploadQueue_.empty()) {
+                auto item = uploadQueue_.front();
+                uploadQueue_.pop_front();
+
+                activeUploads_ += 1;
+                startUpload(std::move(item));
+        }
+}
+
+void
+ChatPage::uploadFinished()
+{
+        activeUploads_ -= 1;
+        startQueuedUploads();
+}
+
+void
+ChatPage::startUpload(QueuedUpload item)
+{
+        // Non-image attachments go on the wire untransformed; when the
+        // source is a file on disk, stream it from there instead of
+        // buffering it whole - a long video would otherwise occupy
+        // memory several times over.
+        if (item.media != "image" && qobject_cast<QFile *>(item.data.data())) {
+                const auto path = static_cast<QFile *>(item.data.data())->fileName();
+
+                QMimeDatabase db;
+                const auto mime = db.mimeTypeForFile(path, QMimeDatabase::MatchContent).name();
+                const auto size = QFileInfo(path).size();
+
+                media::upload(
+                  path,
+                  mime,
+                  QFileInfo(path).fileName(),
+                  this,
+                  [this, item, mime, size](QString content_uri, int status) mutable {
+                          if (content_uri.isEmpty()) {
+                                  // A transport failure leaves nothing usable
+                                  // on the server, so the transfer restarts
+                                  // from disk once the connection is back.
+                                  if ((status <= 0 || status >= 600) &&
+                                      item.attempts < MAX_UPLOAD_RETRIES) {
+                                          item.attempts += 1;
+                                          emit uploadRetryRequested(item);
+                                          return;
+                                  }
+
+                                  emit uploadFailed(
+                                    tr("Failed to upload media. Please try again."));
+                                  nhlog::net()->warn("failed to upload media ({})", status);
+                                  return;
+                          }
+
+                          http::metrics::recordTransfer(http::metrics::Endpoint::Upload,
+                                                        static_cast<uint64_t>(size));
+
+                          if (item.media == "audio")
+                                  emit audioUploaded(
+                                    item.room_id, item.filename, content_uri, mime, size);
+                          else if (item.media == "video")
+                                  emit videoUploaded(
+                                    item.room_id, item.filename, content_uri, mime, size);
+                          else
+                                  emit fileUploaded(
+                                    item.room_id, item.filename, content_uri, mime, size);
+                  },
+                  [path, lastQuarter = std::make_shared<int>(0)](qint64 sent, qint64 total) {
+                          if (total <= 0)
+                                  return;
+
+                          const auto quarter = static_cast<int>(sent * 4 / total);
+                          if (quarter > *lastQuarter) {
+                                  *lastQuarter = quarter;
+                                  nhlog::net()->info("uploading {}: {}%",
+                                                     QFileInfo(path).fileName().toStdString(),
+                                                     quarter * 25);
+                          }
+                  });
+
+                return;
+        }
+
+        QtConcurrent::run([this,
+                           item,
+                           maxDimension = userSettings_->uploadImageMaxDimension(),
+                           quality      = userSettings_->uploadImageQuality()]() {
+                const bool isImage = item.media == "image";
+                const auto content = prepareUpload(item.data, isImage, maxDimension, quality);
+
+                if (!content.error.isEmpty()) {
+                        emit uploadFailed(
+                          QString("Error while reading media: %1").arg(content.error));
+                        return;
+                }
+
+                http::client()->upload(
+                  content.payload,
+                  content.mime.toStdString(),
+                  QFileInfo(item.filename).fileName().toStdString(),
+                  [this,
+                   item,
+                   mime       = content.mime,
+                   size       = content.payload.size(),
+                   dimensions = content.dimensions](const mtx::responses::ContentURI &res,
+                                                    mtx::http::RequestErr err) mutable {
+                          if (err) {
+                                  const int status_code = static_cast<int>(err->status_code);
+
+                                  // A transport failure leaves nothing usable on the
+                                  // server, so the transfer is restarted from the local
+                                  // bytes once the connection is back.
+                                  if ((status_code <= 0 || status_code >= 600) &&
+                                      item.attempts < MAX_UPLOAD_RETRIES) {
+                                          item.attempts += 1;
+                                          emit uploadRetryRequested(item);
+                                          return;
+                                  }
+
+                                  emit uploadFailed(
+                                    tr("Failed to upload media. Please try again."));
+                                  nhlog::net()->warn("failed to upload media: {} {} ({})",
+                                                     err->matrix_error.error,
+                                                     to_string(err->matrix_error.errcode),
+                                                     status_code);
+                                  return;
+                          }
+
+                          http::metrics::recordTransfer(http::metrics::Endpoint::Upload, size);
+
+                          const auto url = QString::fromStdString(res.content_uri);
+
+                          if (item.media == "image")
+                                  emit imageUploaded(
+                                    item.room_id, item.filename, url, mime, size, dimensions);
+                          else if (item.media == "audio")
+                                  emit audioUploaded(item.room_id, item.filename, url, mime, size);
+                          else if (item.media == "video")
+                                  emit videoUploaded(item.room_id, item.filename, url, mime, size);
+                          else
+                                  emit fileUploaded(item.room_id, item.filename, url, mime, size);
+                  });
+        });
+}
+
+void
+ChatPage::applyPendingDiffs()
+{
+        // Repainting the room list & timelines can take tens of
+        // milliseconds; while the user is actively typing it's pushed to
+        // the next quiet gap so keystroke echo stays instant under sync
+        // load. The deferral is bounded so continuous typing can't starve
+        // the rest of the UI.
+        if (text_input_->msecsSinceLastTyped() < INPUT_QUIET_PERIOD &&
+            diffDeferMs_ < SYNC_APPLY_MAX_DELAY) {
+                diffDeferMs_ += SYNC_APPLY_RETRY_INTERVAL;
+                diffApplyTimer_->start(SYNC_APPLY_RETRY_INTERVAL);
+                return;
+        }
+
+        diffDeferMs_ = 0;
+
+        while (!pendingDiffs_.empty()) {
+                const auto diff = std::move(pendingDiffs_.front());
+                pendingDiffs_.pop_front();
+
+                applySyncDiff(diff);
+        }
+}
+
+void
+ChatPage::applySyncDiff(const SyncDiff &diff)
+{
+        perf::Span span("sync.uiDispatch");
+
+        room_list_->removeInvites(diff.removedInvites);
+
+        view_manager_->initialize(diff.rooms);
+        removeLeftRooms(diff.rooms.leave);
+
+        bool hasNotifications = false;
+        for (const auto &room : diff.rooms.join) {
+                auto room_id = QString::fromStdString(room.first);
+
+                updateTypingUsers(room_id, room.second.ephemeral.typing);
+                updateRoomNotificationCount(
+                  room_id, room.second.unread_notifications.notification_count);
+
+                if (room.second.unread_notifications.notification_count > 0)
+                        hasNotifications = true;
+        }
+
+        // One title/tray update for the whole batch of room changes.
+        room_list_->flushUnreadCount();
+
+        if (hasNotifications && userSettings_->hasDesktopNotifications()) {
+                // A small first page puts the most recent alerts on screen
+                // within one round trip; the rest of a deep backlog is
+                // drained page by page from sendDesktopNotifications, up
+                // to this budget.
+                notificationPagesLeft_ = 5;
+
+                http::client()->notifications(
+                  5,
+                  [this](const mtx::responses::Notifications &res, mtx::http::RequestErr err) {
+                          if (err) {
+                                  nhlog::net()->warn(
+                                    "failed to retrieve notifications: {} ({})",
+                                    err->matrix_error.error,
+                                    static_cast<int>(err->status_code));
+                                  return;
+                          }
+
+                          emit notificationsRetrieved(std::move(res));
+                  });
+        }
+
+        room_list_->sync(diff.roomUpdates);
+
+        // Refresh the header after the list items have applied the delta,
+        // since the top bar snapshots its fields from them.
+        if (diff.roomUpdates.find(currentRoom()) != diff.roomUpdates.end())
+                changeTopRoomInfo(currentRoom());
+
+        // Close the launch profile on the first sync that reaches the
+        // screen; later calls are no-ops.
+        perf::startupPhase("first.sync");
+        perf::finishStartup();
+}
+
 void
 ChatPage::logout()
 {
@@ -602,7 +866,6 @@ ChatPage::logout()
         resetUI();
 
         emit closing();
-        connectivityTimer_.stop();
 }
 
 void
@@ -614,7 +877,6 @@ ChatPage::dropToLoginPage(const QString &msg)
         resetUI();
 
         http::client()->shutdown();
-        connectivityTimer_.stop();
 
         emit showLoginPage(msg);
 }
@@ -622,6 +884,11 @@ ChatPage::dropToLoginPage(const QString &msg)
 void
 ChatPage::resetUI()
 {
+        diffApplyTimer_->stop();
+        pendingDiffs_.clear();
+        diffDeferMs_ = 0;
+        uploadQueue_.clear();
+
         room_list_->clear();
         top_bar_->reset();
         user_info_widget_->reset();
@@ -663,6 +930,13 @@ ChatPage::bootstrap(QString userid, QString homeserver, QString token)
         http::client()->set_server(homeserver.toStdString());
         http::client()->set_access_token(token.toStdString());
 
+        // The user id is known now; file the connection in the account
+        // registry.
+        http::registerAccount(userid.toStdString());
+
+        // Prime DNS & TLS before the first sync fires.
+        http::warmConnection();
+
         // The Olm client needs the user_id & device_id that will be included
         // in the generated payloads & keys.
         olm::client()->set_user_id(http::client()->user_id().to_string());
@@ -671,6 +945,8 @@ ChatPage::bootstrap(QString userid, QString homeserver, QString token)
         try {
                 cache::init(userid);
 
+                perf::startupPhase("cache.setup");
+
                 connect(cache::client(),
                         &Cache::newReadReceipts,
                         view_manager_,
@@ -680,11 +956,22 @@ ChatPage::bootstrap(QString userid, QString homeserver, QString token)
                 const bool isValid       = cache::client()->isFormatValid();
 
                 if (isInitialized && !isValid) {
+                        // An in-place upgrade beats abandoning the whole
+                        // cache & re-syncing from scratch by a long way.
+                        if (cache::client()->runMigrations()) {
+                                nhlog::db()->info("cache format migrated in place");
+                                loadStateFromCache();
+                                return;
+                        }
+
                         nhlog::db()->warn("breaking changes in cache");
                         // TODO: Deleting session data but keep using the
                         //	 same device doesn't work.
                         cache::client()->deleteData();
 
+                        // A fresh environment has to be opened over the
+                        // recreated data directory.
+                        cache::drop(userid);
                         cache::init(userid);
                         cache::client()->setCurrentFormat();
                 } else if (isInitialized) {
@@ -735,28 +1022,46 @@ ChatPage::changeTopRoomInfo(const QString &room_id)
                 return;
         }
 
-        try {
-                auto room_info = cache::client()->getRoomInfo({room_id.toStdString()});
-
-                if (room_info.find(room_id) == room_info.end())
-                        return;
-
-                const auto name       = QString::fromStdString(room_info[room_id].name);
-                const auto avatar_url = QString::fromStdString(room_info[room_id].avatar_url);
+        if (!room_list_->roomExists(room_id)) {
+                nhlog::ui()->warn("cannot switch to unknown room {}", room_id.toStdString());
+                return;
+        }
 
-                top_bar_->updateRoomName(name);
-                top_bar_->updateRoomTopic(QString::fromStdString(room_info[room_id].topic));
+        // Journal the switch and swap the composer drafts, so a crash
+        // loses neither the place nor the half-written messages.
+        if (current_room_ != room_id) {
+                try {
+                        if (!current_room_.isEmpty())
+                                cache::client()->saveSessionState(
+                                  "draft/" + current_room_.toStdString(),
+                                  text_input_->inputText().toStdString());
+
+                        cache::client()->saveSessionState("active_room",
+                                                          room_id.toStdString());
+
+                        const auto draft = cache::client()->restoreSessionState(
+                          "draft/" + room_id.toStdString());
+                        text_input_->setInputText(draft ? QString::fromStdString(*draft)
+                                                        : QString());
+                } catch (const lmdb::error &e) {
+                        nhlog::db()->warn("failed to journal session state: {}", e.what());
+                }
+        }
 
-                auto img = cache::client()->getRoomAvatar(room_id);
+        // The room list already carries the rendered name, topic & avatar
+        // of every room, so the header switch is a single struct handoff
+        // without any cache reads.
+        const auto header = room_list_->headerInfo(room_id);
 
-                if (img.isNull())
-                        top_bar_->updateRoomAvatarFromName(name);
-                else
-                        top_bar_->updateRoomAvatar(img);
+        top_bar_->updateRoomName(header.name);
+        top_bar_->updateRoomTopic(header.topic);
 
-        } catch (const lmdb::error &e) {
-                nhlog::ui()->error("failed to change top bar room info: {}", e.what());
-        }
+        if (!header.avatar.isNull())
+                top_bar_->updateRoomAvatar(header.avatar.toImage());
+        else
+                // The letter avatar stands in until the sidebar decodes the
+                // real one; roomAvatarChanged will replace it then.
+                top_bar_->updateRoomAvatarFromName(header.name);
 
         current_room_ = room_id;
 }
@@ -782,17 +1087,26 @@ ChatPage::loadStateFromCache()
 
         getProfileInfo();
 
+        // Warm the OS cache with the pages the restore below is about to
+        // read, overlapping the disk latency of a cold start with the
+        // session restore and the widget construction.
+        QtConcurrent::run([]() { cache::client()->prefetchState(); });
+
         QtConcurrent::run([this]() {
                 try {
                         cache::client()->restoreSessions();
                         olm::client()->load(cache::client()->restoreOlmAccount(),
                                             STORAGE_SECRET_KEY);
 
+                        perf::startupPhase("restore.sessions");
+
                         cache::client()->populateMembers();
 
                         emit initializeEmptyViews(cache::client()->roomMessages());
                         emit initializeRoomList(cache::client()->roomInfo());
 
+                        perf::startupPhase("cache.restore");
+
                 } catch (const mtx::crypto::olm_exception &e) {
                         nhlog::crypto()->critical("failed to restore olm account: {}", e.what());
                         emit dropToLoginPageCb(
@@ -850,10 +1164,40 @@ ChatPage::updateTypingUsers(const QString &roomid, const std::vector<std::string
         if (!userSettings_->isTypingNotificationsEnabled())
                 return;
 
-        typingUsers_[roomid] = generateTypingUsers(roomid, user_ids);
+        // High-churn rooms repeat the same typing set sync after sync.
+        // Dropping those on the raw ids keeps the steady state allocation
+        // free: no display name lookups, no list rebuilds, no widget
+        // updates.
+        auto last = lastTypingUserIds_.find(roomid);
+        if (last != lastTypingUserIds_.end() && last->second == user_ids)
+                return;
+
+        lastTypingUserIds_[roomid]    = user_ids;
+        pendingTypingUpdates_[roomid] = user_ids;
 
-        if (current_room_ == roomid)
-                typingDisplay_->setUsers(typingUsers_[roomid]);
+        if (!typingCoalesceTimer_->isActive())
+                typingCoalesceTimer_->start();
+}
+
+void
+ChatPage::flushTypingUpdates()
+{
+        for (const auto &update : pendingTypingUpdates_) {
+                auto users = generateTypingUsers(update.first, update.second);
+
+                // Diff against the rendered set before touching any widget;
+                // most syncs repeat the typing state of the previous one.
+                auto &current = typingUsers_[update.first];
+                if (current == users)
+                        continue;
+
+                current = users;
+
+                if (current_room_ == update.first)
+                        typingDisplay_->setUsers(users);
+        }
+
+        pendingTypingUpdates_.clear();
 }
 
 QStringList
@@ -907,7 +1251,18 @@ ChatPage::updateRoomNotificationCount(const QString &room_id, uint16_t notificat
 void
 ChatPage::sendDesktopNotifications(const mtx::responses::Notifications &res)
 {
-        for (const auto &item : res.notifications) {
+        // Most recent first, so the actionable alerts surface before the
+        // tail of an old backlog is even looked at.
+        auto notifications = res.notifications;
+        std::sort(notifications.begin(),
+                  notifications.end(),
+                  [](const mtx::responses::Notification &a, const mtx::responses::Notification &b) {
+                          return utils::event_timestamp(a.event) > utils::event_timestamp(b.event);
+                  });
+
+        std::size_t unseen = 0;
+
+        for (const auto &item : notifications) {
                 const auto event_id = utils::event_id(item.event);
 
                 try {
@@ -920,6 +1275,8 @@ ChatPage::sendDesktopNotifications(const mtx::responses::Notifications &res)
                                 const auto room_id = QString::fromStdString(item.room_id);
                                 const auto user_id = utils::event_sender(item.event);
 
+                                unseen += 1;
+
                                 // We should only sent one notification per event.
                                 cache::client()->markSentNotification(event_id);
 
@@ -940,6 +1297,26 @@ ChatPage::sendDesktopNotifications(const mtx::responses::Notifications &res)
                         nhlog::db()->warn("error while sending desktop notification: {}", e.what());
                 }
         }
+
+        // A page of nothing but already-handled items means the drain has
+        // caught up with what previous sessions delivered; stop early.
+        if (unseen == 0 || res.next_token.empty() || notificationPagesLeft_ <= 0)
+                return;
+
+        notificationPagesLeft_ -= 1;
+
+        http::fetchNotifications(
+          res.next_token,
+          20,
+          this,
+          [this](const mtx::responses::Notifications &page, int status) {
+                  if (status != 200) {
+                          nhlog::net()->warn("notifications paging stopped with status {}", status);
+                          return;
+                  }
+
+                  emit notificationsRetrieved(page);
+          });
 }
 
 void
@@ -994,13 +1371,22 @@ ChatPage::startInitialSync()
             &ChatPage::initialSyncHandler, this, std::placeholders::_1, std::placeholders::_2));
 }
 
+bool
+ChatPage::isBackgrounded() const
+{
+        const auto *top = window();
+        return top && (!top->isVisible() || top->isMinimized());
+}
+
 void
 ChatPage::trySync()
 {
         mtx::http::SyncOpts opts;
 
-        if (!connectivityTimer_.isActive())
-                connectivityTimer_.start();
+        // While hidden in the tray the server is asked to hold the poll
+        // for longer; the client then wakes up only when something
+        // actually happens instead of at the foreground cadence.
+        opts.timeout = isBackgrounded() ? SYNC_TIMEOUT_HIDDEN : SYNC_TIMEOUT_ACTIVE;
 
         try {
                 opts.since = cache::client()->nextBatchToken();
@@ -1021,6 +1407,12 @@ ChatPage::trySync()
                                   if (!http::is_logged_in())
                                           return;
 
+                                  // A transport-level failure doubles as the
+                                  // connectivity probe; the state flips once
+                                  // and the backoff retries keep probing.
+                                  if (isConnected_)
+                                          emit connectionLost();
+
                                   emit tryDelayedSyncCb();
                                   return;
                           }
@@ -1031,7 +1423,10 @@ ChatPage::trySync()
                           case 502:
                           case 504:
                           case 524: {
-                                  emit trySyncCb();
+                                  // Gateway errors usually mean the server is
+                                  // restarting; retrying immediately would only
+                                  // add to the reconnect storm.
+                                  emit tryDelayedSyncCb();
                                   return;
                           }
                           default: {
@@ -1054,17 +1449,30 @@ ChatPage::trySync()
                   // Ensure that we have enough one-time keys available.
                   ensureOneTimeKeyCount(res.device_one_time_keys_count);
 
+                  // The callback runs on one of the http client's worker
+                  // threads, so the parsing and the persistence of the
+                  // response don't block painting. Only the assembled diff
+                  // is posted to the GUI thread.
+                  //
                   // TODO: fine grained error handling
                   try {
-                          cache::client()->saveState(res);
-                          olm::handle_to_device_messages(res.to_device);
+                          SyncDiff diff;
+
+                          {
+                                  perf::Span span("sync.saveState");
+                                  diff.removedInvites = cache::client()->saveState(res);
+                          }
 
-                          emit syncUI(res.rooms);
+                          olm::handle_to_device_messages(res.to_device);
+                          olm::handle_device_list_changes(res.device_lists.changed);
 
-                          auto updates = cache::client()->roomUpdates(res);
+                          {
+                                  perf::Span span("sync.buildDiff");
+                                  diff.rooms       = res.rooms;
+                                  diff.roomUpdates = cache::client()->roomUpdates(res);
+                          }
 
-                          emit syncTopBar(updates);
-                          emit syncRoomlist(updates);
+                          emit syncCompleted(diff);
 
                           cache::client()->deleteOldData();
                   } catch (const lmdb::map_full_error &e) {
@@ -1149,15 +1557,58 @@ ChatPage::sendTypingNotifications()
         if (!userSettings_->isTypingNotificationsEnabled())
                 return;
 
+        // A resumed burst supersedes any pending stop request.
+        typingStopDebouncer_->stop();
+
+        if (!typingRefresher_->isActive())
+                typingRefresher_->start();
+
+        if (current_room_.isEmpty())
+                return;
+
+        // The refresher will re-send the state soon enough; a second
+        // in-flight request would only queue up behind message sends.
+        if (isTypingRequestInFlight_)
+                return;
+
+        isTypingRequestInFlight_ = true;
+
         http::client()->start_typing(
-          current_room_.toStdString(), 10'000, [](mtx::http::RequestErr err) {
+          current_room_.toStdString(), 10'000, [this](mtx::http::RequestErr err) {
+                  isTypingRequestInFlight_ = false;
+
                   if (err) {
                           nhlog::net()->warn("failed to send typing notification: {}",
                                              err->matrix_error.error);
+                          return;
                   }
+
+                  isTypingStateSent_ = true;
           });
 }
 
+void
+ChatPage::stopTypingNotifications()
+{
+        if (!userSettings_->isTypingNotificationsEnabled())
+                return;
+
+        typingStopDebouncer_->stop();
+        typingRefresher_->stop();
+
+        if (current_room_.isEmpty() || !isTypingStateSent_)
+                return;
+
+        isTypingStateSent_ = false;
+
+        http::client()->stop_typing(current_room_.toStdString(), [](mtx::http::RequestErr err) {
+                if (err) {
+                        nhlog::net()->warn("failed to stop typing notifications: {}",
+                                           err->matrix_error.error);
+                }
+        });
+}
+
 void
 ChatPage::initialSyncHandler(const mtx::responses::Sync &res, mtx::http::RequestErr err)
 {
@@ -1195,6 +1646,7 @@ ChatPage::initialSyncHandler(const mtx::responses::Sync &res, mtx::http::Request
                 cache::client()->saveState(res);
 
                 olm::handle_to_device_messages(res.to_device);
+                olm::handle_device_list_changes(res.device_lists.changed);
 
                 emit initializeViews(std::move(res.rooms));
                 emit initializeRoomList(cache::client()->roomInfo());
@@ -1250,9 +1702,9 @@ ChatPage::getProfileInfo()
                   emit setUserDisplayName(QString::fromStdString(res.display_name));
 
                   if (cache::client()) {
-                          auto data = cache::client()->image(res.avatar_url);
-                          if (!data.isNull()) {
-                                  emit setUserAvatar(QImage::fromData(data));
+                          auto img = cache::client()->image(res.avatar_url);
+                          if (!img.isNull()) {
+                                  emit setUserAvatar(img);
                                   return;
                           }
                   }
@@ -1260,8 +1712,10 @@ ChatPage::getProfileInfo()
                   if (res.avatar_url.empty())
                           return;
 
-                  http::client()->download(
+                  http::download(
                     res.avatar_url,
+                    http::DownloadPriority::Avatar,
+                    this,
                     [this, res](const std::string &data,
                                 const std::string &,
                                 const std::string &,
@@ -19,6 +19,8 @@
 
 #include <atomic>
 #include <boost/variant.hpp>
+#include <deque>
+#include <random>
 
 #include <QFrame>
 #include <QHBoxLayout>
@@ -33,6 +35,7 @@
 #include "notifications/Manager.h"
 
 class OverlayModal;
+class QIODevice;
 class QuickSwitcher;
 class RoomList;
 class SideBarActions;
@@ -45,9 +48,57 @@ class UserInfoWidget;
 class UserSettings;
 class NotificationsManager;
 
+//! Compact, ready-to-render description of a sync response.
+//!
+//! It is assembled on the worker thread that handles the sync response, so
+//! the GUI thread only has to apply the changes.
+struct SyncDiff
+{
+        //! Room payloads that have to be dispatched to the timelines.
+        mtx::responses::Rooms rooms;
+        //! Rooms whose invite was removed by this sync, e.g after a join.
+        std::vector<QString> removedInvites;
+        //! Field-level deltas for the rooms with state changes relevant to the UI.
+        std::map<QString, RoomUpdate> roomUpdates;
+};
+
+Q_DECLARE_METATYPE(SyncDiff)
+
+//! An attachment in the upload pipeline.
+struct QueuedUpload
+{
+        //! Source of the file's bytes.
+        QSharedPointer<QIODevice> data;
+        QString filename;
+        //! Room that was on display when the upload was requested.
+        QString room_id;
+        //! Top-level media category: "image", "audio", "video" or "file".
+        QString media;
+        //! Transfers attempted so far, driving the retry cap.
+        int attempts = 0;
+};
+
+Q_DECLARE_METATYPE(QueuedUpload)
+
 constexpr int CONSENSUS_TIMEOUT      = 1000;
 constexpr int SHOW_CONTENT_TIMEOUT   = 3000;
-constexpr int TYPING_REFRESH_TIMEOUT = 10000;
+constexpr int TYPING_REFRESH_TIMEOUT  = 10000;
+constexpr int TYPING_STOP_DEBOUNCE    = 1000;
+constexpr int TYPING_COALESCE_TIMEOUT = 300;
+
+//! Keystrokes within this window count as active typing; applying sync
+//! UI updates is deferred meanwhile.
+constexpr int INPUT_QUIET_PERIOD = 100;
+//! Re-check interval while a diff application is deferred.
+constexpr int SYNC_APPLY_RETRY_INTERVAL = 50;
+//! Upper bound of the deferral, so continuous typing can't starve the UI.
+constexpr int SYNC_APPLY_MAX_DELAY = 1000;
+
+//! Attachments transferring at the same time; the rest wait in a queue.
+constexpr int MAX_CONCURRENT_UPLOADS = 4;
+//! Times a transfer is restarted after a connection drop before it is
+//! reported as failed.
+constexpr int MAX_UPLOAD_RETRIES = 3;
 
 class ChatPage : public QWidget
 {
@@ -88,6 +139,8 @@ signals:
         void notificationsRetrieved(const mtx::responses::Notifications &);
 
         void uploadFailed(const QString &msg);
+        //! A transfer failed from a connection drop and should be restarted.
+        void uploadRetryRequested(const QueuedUpload &item);
         void imageUploaded(const QString &roomid,
                            const QString &filename,
                            const QString &url,
@@ -134,9 +187,7 @@ signals:
         void initializeRoomList(QMap<QString, RoomInfo>);
         void initializeViews(const mtx::responses::Rooms &rooms);
         void initializeEmptyViews(const std::map<QString, mtx::responses::Timeline> &msgs);
-        void syncUI(const mtx::responses::Rooms &rooms);
-        void syncRoomlist(const std::map<QString, RoomInfo> &updates);
-        void syncTopBar(const std::map<QString, RoomInfo> &updates);
+        void syncCompleted(const SyncDiff &diff);
         void dropToLoginPageCb(const QString &msg);
 
         void notifyMessage(const QString &roomid,
@@ -158,6 +209,7 @@ private slots:
 
         void joinRoom(const QString &room);
         void sendTypingNotifications();
+        void stopTypingNotifications();
 
 private:
         static ChatPage *instance_;
@@ -184,7 +236,33 @@ private:
         using LeftRooms = std::map<std::string, mtx::responses::LeftRoom>;
         void removeLeftRooms(const LeftRooms &rooms);
 
+        //! Queue an ephemeral typing update. The updates of consecutive
+        //! syncs are coalesced and applied in one pass per room.
         void updateTypingUsers(const QString &roomid, const std::vector<std::string> &user_ids);
+        //! Apply the typing updates collected during the coalescing window.
+        void flushTypingUpdates();
+
+        //! Enqueue an attachment and start it if the parallelism budget allows.
+        void queueUpload(QSharedPointer<QIODevice> data,
+                         const QString &filename,
+                         const QString &media);
+        //! Start queued attachments until MAX_CONCURRENT_UPLOADS are in flight.
+        void startQueuedUploads();
+        //! Run the prepare & transfer pipeline of a single attachment.
+        void startUpload(QueuedUpload item);
+        //! Account a finished transfer and schedule the next queued one.
+        void uploadFinished();
+
+        //! Whether the window is currently hidden in the tray or
+        //! minimized, i.e. nothing the sync produces can be seen.
+        bool isBackgrounded() const;
+
+        //! Apply the UI updates described by a sync diff.
+        void applySyncDiff(const SyncDiff &diff);
+        //! Apply the queued sync diffs, unless the user is actively typing,
+        //! in which case they're deferred to the next quiet gap so
+        //! keystroke echo never waits behind a repaint of half the UI.
+        void applyPendingDiffs();
 
         void loadStateFromCache();
         void resetUI();
@@ -223,9 +301,13 @@ private:
         TextInputWidget *text_input_;
         TypingDisplay *typingDisplay_;
 
-        QTimer connectivityTimer_;
         std::atomic_bool isConnected_;
 
+        //! Consecutive failed sync attempts, driving the retry backoff.
+        int syncFailures_ = 0;
+        //! Source of the jitter applied to sync retries.
+        std::mt19937 rand_{std::random_device{}()};
+
         QString current_room_;
         QString current_community_;
 
@@ -233,7 +315,39 @@ private:
 
         // Keeps track of the users currently typing on each room.
         std::map<QString, QList<QString>> typingUsers_;
+        //! Typing sets received since the last flush. Only the latest set
+        //! of each room is kept; the intermediate ones are never rendered.
+        std::map<QString, std::vector<std::string>> pendingTypingUpdates_;
+        //! The raw ids of the last queued typing set per room, so repeats
+        //! are dropped before any per-update work is done.
+        std::map<QString, std::vector<std::string>> lastTypingUserIds_;
+        //! Coalesces the ephemeral churn of consecutive syncs into a
+        //! single widget update per room.
+        QTimer *typingCoalesceTimer_;
         QTimer *typingRefresher_;
+        //! Delays the stop-typing request so that a quick resume or a
+        //! message send doesn't produce a redundant stop/start pair.
+        QTimer *typingStopDebouncer_;
+        //! Attachments waiting for a free transfer slot.
+        std::deque<QueuedUpload> uploadQueue_;
+        //! Transfers currently in flight.
+        int activeUploads_ = 0;
+        //! Sync diffs waiting for a quiet gap in the user's typing.
+        std::deque<SyncDiff> pendingDiffs_;
+        //! Schedules the application of the queued diffs.
+        QTimer *diffApplyTimer_;
+        //! How long the queued diffs have been deferred so far.
+        int diffDeferMs_ = 0;
+        //! The typing state the server currently knows about.
+        std::atomic_bool isTypingStateSent_{false};
+        //! Whether a typing request is on the wire. While one is pending
+        //! no other typing request is issued.
+        std::atomic_bool isTypingRequestInFlight_{false};
+
+        //! How many further /notifications pages the current drain of the
+        //! backlog may still fetch. Rearmed on every sync that reports
+        //! unread notifications.
+        int notificationPagesLeft_ = 0;
 
         // Global user settings.
         QSharedPointer<UserSettings> userSettings_;
@@ -2,9 +2,12 @@
 #include "Cache.h"
 #include "Logging.h"
 #include "MatrixClient.h"
+#include "Utils.h"
 
 #include <QLabel>
 
+#include <set>
+
 CommunitiesList::CommunitiesList(QWidget *parent)
   : QWidget(parent)
 {
@@ -42,20 +45,58 @@ CommunitiesList::CommunitiesList(QWidget *parent)
 
         connect(
           this, &CommunitiesList::avatarRetrieved, this, &CommunitiesList::updateCommunityAvatar);
+        connect(this,
+                &CommunitiesList::groupProfileRetrieved,
+                this,
+                [this](const QString &id, const mtx::responses::GroupProfile &profile) {
+                        if (communities_.find(id) == communities_.end())
+                                return;
+
+                        // Skip the repaint when the server echoed back the
+                        // profile we already show.
+                        if (!cache::client()->saveGroupProfile(
+                              id.toStdString(), GroupInfo{profile.name, profile.avatar_url}))
+                                return;
+
+                        communities_.at(id)->setName(QString::fromStdString(profile.name));
+
+                        if (!profile.avatar_url.empty())
+                                fetchCommunityAvatar(id,
+                                                     QString::fromStdString(profile.avatar_url));
+                });
 }
 
 void
 CommunitiesList::setCommunities(const mtx::responses::JoinedGroups &response)
 {
-        communities_.clear();
+        std::set<QString> incoming{"world"};
+        for (const auto &group : response.groups)
+                incoming.emplace(QString::fromStdString(group));
+
+        // Drop the communities the user has left. Deleting the widget
+        // detaches it from the layout.
+        bool selectionRemoved = false;
+        for (auto it = communities_.begin(); it != communities_.end();) {
+                if (incoming.find(it->first) == incoming.end()) {
+                        selectionRemoved |= it->second->isPressed();
+                        it = communities_.erase(it);
+                } else {
+                        ++it;
+                }
+        }
 
-        addGlobalItem();
+        const bool wasEmpty = communities_.size() <= 1;
 
         for (const auto &group : response.groups)
-                addCommunity(group);
-
-        communities_["world"]->setPressedState(true);
-        emit communityChanged("world");
+                if (!communityExists(QString::fromStdString(group)))
+                        addCommunity(group);
+
+        // The untouched items keep their state; only a first fill or a
+        // removed selection falls back to the global timeline.
+        if (wasEmpty || selectionRemoved) {
+                communities_.at("world")->setPressedState(true);
+                emit communityChanged("world");
+        }
 }
 
 void
@@ -67,28 +108,18 @@ CommunitiesList::addCommunity(const std::string &group_id)
         communities_.emplace(id, QSharedPointer<CommunitiesListItem>(list_item));
         contentsLayout_->insertWidget(contentsLayout_->count() - 1, list_item);
 
-        connect(this,
-                &CommunitiesList::groupProfileRetrieved,
-                this,
-                [this](const QString &id, const mtx::responses::GroupProfile &profile) {
-                        if (communities_.find(id) == communities_.end())
-                                return;
+        // Paint the cached profile right away; the network round-trip
+        // below only corrects it if it changed server-side.
+        if (cache::client()) {
+                if (auto profile = cache::client()->getGroupProfile(group_id)) {
+                        list_item->setName(QString::fromStdString(profile->name));
 
-                        communities_.at(id)->setName(QString::fromStdString(profile.name));
-
-                        if (!profile.avatar_url.empty())
+                        if (!profile->avatar_url.empty())
                                 fetchCommunityAvatar(id,
-                                                     QString::fromStdString(profile.avatar_url));
-                });
-        connect(this,
-                &CommunitiesList::groupRoomsRetrieved,
-                this,
-                [this](const QString &id, const std::map<QString, bool> &rooms) {
-                        if (communities_.find(id) == communities_.end())
-                                return;
+                                                     QString::fromStdString(profile->avatar_url));
+                }
+        }
 
-                        communities_.at(id)->setRooms(rooms);
-                });
         connect(list_item,
                 &CommunitiesListItem::clicked,
                 this,
@@ -151,11 +182,10 @@ CommunitiesList::highlightSelectedCommunity(const QString &community_id)
 void
 CommunitiesList::fetchCommunityAvatar(const QString &id, const QString &avatarUrl)
 {
-        auto savedImgData = cache::client()->image(avatarUrl);
-        if (!savedImgData.isNull()) {
-                QPixmap pix;
-                pix.loadFromData(savedImgData);
-                emit avatarRetrieved(id, pix);
+        auto savedImg = cache::client()->scaledImage(
+          avatarUrl, utils::devicePixels(CommunitiesListItem::IconSize));
+        if (!savedImg.isNull()) {
+                emit avatarRetrieved(id, QPixmap::fromImage(savedImg));
                 return;
         }
 
@@ -164,8 +194,11 @@ CommunitiesList::fetchCommunityAvatar(const QString &id, const QString &avatarUr
 
         mtx::http::ThumbOpts opts;
         opts.mxc_url = avatarUrl.toStdString();
-        http::client()->get_thumbnail(
-          opts, [this, opts, id](const std::string &res, mtx::http::RequestErr err) {
+        http::get_thumbnail(
+          opts,
+          http::DownloadPriority::Avatar,
+          this,
+          [this, opts, id](const std::string &res, mtx::http::RequestErr err) {
                   if (err) {
                           nhlog::net()->warn("failed to download avatar: {} - ({} {})",
                                              opts.mxc_url,
@@ -184,12 +217,3 @@ CommunitiesList::fetchCommunityAvatar(const QString &id, const QString &avatarUr
                   emit avatarRetrieved(id, pix);
           });
 }
-
-std::map<QString, bool>
-CommunitiesList::roomList(const QString &id) const
-{
-        if (communityExists(id))
-                return communities_.at(id)->rooms();
-
-        return {};
-}
@@ -18,7 +18,6 @@ public:
 
         void addCommunity(const std::string &id);
         void removeCommunity(const QString &id) { communities_.erase(id); };
-        std::map<QString, bool> roomList(const QString &id) const;
 
 signals:
         void communityChanged(const QString &id);
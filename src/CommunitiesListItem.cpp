@@ -89,7 +89,7 @@ CommunitiesListItem::paintEvent(QPaintEvent *)
 void
 CommunitiesListItem::setAvatar(const QImage &img)
 {
-        avatar_ = utils::scaleImageToPixmap(img, IconSize);
+        avatar_ = utils::scaleImageToPixmap(img, IconSize, utils::screenDpr(this));
         update();
 }
 
@@ -26,15 +26,15 @@ class CommunitiesListItem : public QWidget
         Q_PROPERTY(QColor avatarBgColor READ avatarBgColor WRITE setAvatarBgColor)
 
 public:
+        //! Edge length of the community avatar, in logical pixels.
+        static constexpr int IconSize = 36;
+
         CommunitiesListItem(QString group_id, QWidget *parent = nullptr);
 
         void setName(QString name) { name_ = name; }
         bool isPressed() const { return isPressed_; }
         void setAvatar(const QImage &img);
 
-        void setRooms(std::map<QString, bool> room_ids) { room_ids_ = std::move(room_ids); }
-        std::map<QString, bool> rooms() const { return room_ids_; }
-
         QColor highlightedBackgroundColor() const { return highlightedBackgroundColor_; }
         QColor hoverBackgroundColor() const { return hoverBackgroundColor_; }
         QColor backgroundColor() const { return backgroundColor_; }
@@ -65,12 +65,8 @@ protected:
         void paintEvent(QPaintEvent *event) override;
 
 private:
-        const int IconSize = 36;
-
         QString resolveName() const;
 
-        std::map<QString, bool> room_ids_;
-
         QString name_;
         QString groupId_;
         QPixmap avatar_;
@@ -0,0 +1,145 @@
+/*
+ * nheko Copyright (C) 2017  Konstantinos Sideris <siderisk@auth.gr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <deque>
+
+#include <QAbstractEventDispatcher>
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QPointer>
+#include <QTimer>
+
+#include "IdleScheduler.h"
+
+namespace idle {
+
+//! The loop only counts as idle if no input arrived within this window.
+constexpr int INPUT_QUIET_MS = 100;
+//! Time slice of jobs executed per idle period, so a deep queue can't
+//! make the next input event late.
+constexpr int RUN_BUDGET_MS = 5;
+
+namespace {
+
+//! A queued job and the object whose destruction cancels it.
+struct Job
+{
+        QPointer<QObject> owner;
+        std::function<void()> fn;
+};
+
+std::deque<Job> queue_;
+//! Stamp of the last user input event.
+QElapsedTimer lastInput_;
+//! A wake-up timer is pending, so the queue isn't forgotten when the
+//! loop blocks with no further events coming.
+bool wakeupScheduled_ = false;
+
+//! Receiver for the dispatcher connection and the wake-up timers.
+QObject context_;
+
+//! Records input activity, so jobs never run under the user's fingers.
+class InputProbe : public QObject
+{
+protected:
+        bool eventFilter(QObject *watched, QEvent *event) override
+        {
+                switch (event->type()) {
+                case QEvent::KeyPress:
+                case QEvent::MouseButtonPress:
+                case QEvent::MouseMove:
+                case QEvent::Wheel:
+                case QEvent::TouchBegin:
+                        lastInput_.restart();
+                        break;
+                default:
+                        break;
+                }
+
+                return QObject::eventFilter(watched, event);
+        }
+};
+
+InputProbe probe_;
+
+//! Arrange for the event loop to wake up, so the queue is looked at
+//! again even if no other event arrives.
+void
+scheduleWakeup(int delay)
+{
+        if (wakeupScheduled_)
+                return;
+
+        wakeupScheduled_ = true;
+        QTimer::singleShot(delay, &context_, []() { wakeupScheduled_ = false; });
+}
+
+void
+drain()
+{
+        if (queue_.empty())
+                return;
+
+        if (lastInput_.elapsed() < INPUT_QUIET_MS) {
+                // Re-check once the quiet window can have elapsed.
+                scheduleWakeup(INPUT_QUIET_MS);
+                return;
+        }
+
+        QElapsedTimer budget;
+        budget.start();
+
+        while (!queue_.empty() && budget.elapsed() < RUN_BUDGET_MS) {
+                auto job = std::move(queue_.front());
+                queue_.pop_front();
+
+                if (job.owner.isNull())
+                        continue;
+
+                job.fn();
+        }
+
+        if (!queue_.empty())
+                scheduleWakeup(0);
+}
+}
+
+void
+init()
+{
+        lastInput_.start();
+        qApp->installEventFilter(&probe_);
+
+        // aboutToBlock fires when the event queue has been drained and
+        // the loop is about to sleep: exactly the window for deferred
+        // work.
+        QObject::connect(QAbstractEventDispatcher::instance(),
+                         &QAbstractEventDispatcher::aboutToBlock,
+                         &context_,
+                         []() { drain(); });
+}
+
+void
+schedule(QObject *owner, std::function<void()> job)
+{
+        queue_.push_back({owner, std::move(job)});
+
+        // In case the loop is already blocked waiting for events.
+        scheduleWakeup(0);
+}
+}
@@ -0,0 +1,41 @@
+/*
+ * nheko Copyright (C) 2017  Konstantinos Sideris <siderisk@auth.gr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <functional>
+
+class QObject;
+
+//! Central queue for deferrable GUI-thread work.
+//!
+//! Jobs run only when the event loop has drained its queue and the
+//! user hasn't interacted for a moment, in small time slices, so
+//! expensive precomputation (sorting, avatar rendering, text metric
+//! warm-up) happens between the user's actions instead of inside them.
+namespace idle {
+
+//! Install the idle hooks. Called once after QApplication is up.
+void
+init();
+
+//! Queue a job to run on the GUI thread the next time the loop is
+//! idle. The job is dropped if the owner is destroyed first. Must be
+//! called from the GUI thread.
+void
+schedule(QObject *owner, std::function<void()> job);
+}
@@ -1,5 +1,6 @@
 #include "Logging.h"
 
+#include "spdlog/async.h"
 #include "spdlog/sinks/rotating_file_sink.h"
 #include "spdlog/sinks/stdout_sinks.h"
 #include <iostream>
@@ -12,12 +13,32 @@ std::shared_ptr<spdlog::logger> ui_logger     = nullptr;
 
 constexpr auto MAX_FILE_SIZE = 1024 * 1024 * 6;
 constexpr auto MAX_LOG_FILES = 3;
+
+//! Bounded size of the queue between the logging call sites and the
+//! logging thread. When it fills up the callers block.
+constexpr auto MAX_QUEUE_SIZE = 8192;
+
+std::shared_ptr<spdlog::logger>
+make_logger(const std::string &name, const std::vector<spdlog::sink_ptr> &sinks)
+{
+        auto logger = std::make_shared<spdlog::async_logger>(
+          name, std::begin(sinks), std::end(sinks), spdlog::thread_pool());
+
+        // Errors shouldn't sit in the sinks' buffers if we crash.
+        logger->flush_on(spdlog::level::err);
+
+        return logger;
+}
 }
 
 namespace nhlog {
 void
 init(const std::string &file_path)
 {
+        // Formatting and disk writes happen on a dedicated thread, off
+        // the threads that produce the messages.
+        spdlog::init_thread_pool(MAX_QUEUE_SIZE, 1);
+
         auto file_sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
           file_path, MAX_FILE_SIZE, MAX_LOG_FILES);
 
@@ -27,11 +48,10 @@ init(const std::string &file_path)
         sinks.push_back(file_sink);
         sinks.push_back(console_sink);
 
-        net_logger = std::make_shared<spdlog::logger>("net", std::begin(sinks), std::end(sinks));
-        ui_logger  = std::make_shared<spdlog::logger>("ui", std::begin(sinks), std::end(sinks));
-        db_logger  = std::make_shared<spdlog::logger>("db", std::begin(sinks), std::end(sinks));
-        crypto_logger =
-          std::make_shared<spdlog::logger>("crypto", std::begin(sinks), std::end(sinks));
+        net_logger    = make_logger("net", sinks);
+        ui_logger     = make_logger("ui", sinks);
+        db_logger     = make_logger("db", sinks);
+        crypto_logger = make_logger("crypto", sinks);
 }
 
 std::shared_ptr<spdlog::logger>
@@ -3,6 +3,14 @@
 #include <memory>
 #include <spdlog/spdlog.h>
 
+//! Trace statements for hot paths. In release builds they compile to
+//! nothing, so the arguments aren't even evaluated.
+#ifndef NDEBUG
+#define nhlog_trace(logger, ...) (logger)->trace(__VA_ARGS__)
+#else
+#define nhlog_trace(logger, ...) (void)0
+#endif
+
 namespace nhlog {
 void
 init(const std::string &file);
@@ -16,6 +16,7 @@
  */
 
 #include <QStyleOption>
+#include <QTimer>
 
 #include <mtx/identifiers.hpp>
 
@@ -194,8 +195,25 @@ LoginPage::onMatrixIdEntered()
 void
 LoginPage::checkHomeserverVersion()
 {
+        const auto server = QString::fromStdString(http::client()->server());
+
+        // Resolve from the memoized result, without a round trip. Deferred
+        // so the spinner setup in the callers isn't interleaved with the
+        // teardown done by versionOk().
+        if (verifiedServers_.contains(server)) {
+                QTimer::singleShot(0, this, [this, server]() { versionOk(server); });
+                return;
+        }
+
+        // A probe for this server is already in flight; its result will
+        // resolve this attempt as well.
+        if (probingServer_ == server)
+                return;
+
+        probingServer_ = server;
+
         http::client()->versions(
-          [this](const mtx::responses::Versions &, mtx::http::RequestErr err) {
+          [this, server](const mtx::responses::Versions &, mtx::http::RequestErr err) {
                   if (err) {
                           using namespace boost::beast::http;
 
@@ -216,7 +234,7 @@ LoginPage::checkHomeserverVersion()
                           return;
                   }
 
-                  emit versionOkCb();
+                  emit versionOkCb(server);
           });
 }
 
@@ -236,6 +254,8 @@ LoginPage::onServerAddressEntered()
 void
 LoginPage::versionError(const QString &error)
 {
+        probingServer_.clear();
+
         error_label_->setText(error);
         serverInput_->show();
 
@@ -247,8 +267,11 @@ LoginPage::versionError(const QString &error)
 }
 
 void
-LoginPage::versionOk()
+LoginPage::versionOk(const QString &server)
 {
+        verifiedServers_.insert(server);
+        probingServer_.clear();
+
         serverLayout_->removeWidget(spinner_);
         matrixidLayout_->removeWidget(spinner_);
         spinner_->stop();
@@ -306,6 +329,7 @@ LoginPage::reset()
         matrixidLayout_->removeWidget(spinner_);
 
         inferredServerAddress_.clear();
+        probingServer_.clear();
 }
 
 void
@@ -19,6 +19,7 @@
 
 #include <QLabel>
 #include <QLayout>
+#include <QSet>
 #include <QWidget>
 
 class FlatButton;
@@ -50,7 +51,7 @@ signals:
         //! Used to trigger the corresponding slot outside of the main thread.
         void versionErrorCb(const QString &err);
         void loginErrorCb(const QString &err);
-        void versionOkCb();
+        void versionOkCb(const QString &server);
 
         void loginOk(const mtx::responses::Login &res);
 
@@ -77,7 +78,7 @@ private slots:
         // Callback for errors produced during server probing
         void versionError(const QString &error_message);
         // Callback for successful server probing
-        void versionOk();
+        void versionOk(const QString &server);
 
 private:
         bool isMatrixIdValid();
@@ -111,6 +112,12 @@ private:
         LoadingIndicator *spinner_;
         QLabel *errorIcon_;
         QString inferredServerAddress_;
+        //! Servers whose /versions probe already succeeded. The probe is a
+        //! capability check, so one answer per server is valid for the whole
+        //! session and later attempts resolve without a round trip.
+        QSet<QString> verifiedServers_;
+        //! The server a probe is currently in flight for, if any.
+        QString probingServer_;
 
         FlatButton *back_button_;
         RaisedButton *login_button_;
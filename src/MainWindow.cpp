@@ -65,19 +65,22 @@ MainWindow::MainWindow(QWidget *parent)
         userSettings_ = QSharedPointer<UserSettings>(new UserSettings);
         trayIcon_     = new TrayIcon(":/logos/nheko-32.png", this);
 
-        welcome_page_     = new WelcomePage(this);
-        login_page_       = new LoginPage(this);
-        register_page_    = new RegisterPage(this);
-        chat_page_        = new ChatPage(userSettings_, this);
-        userSettingsPage_ = new UserSettingsPage(userSettings_, this);
+        geometrySaveTimer_ = new QTimer(this);
+        geometrySaveTimer_->setSingleShot(true);
+        geometrySaveTimer_->setInterval(1000);
+        connect(geometrySaveTimer_, &QTimer::timeout, this, &MainWindow::saveCurrentWindowSize);
+
+        // The chat page and the user settings page are built on first
+        // use, so the login path doesn't pay for their widget trees.
+        welcome_page_  = new WelcomePage(this);
+        login_page_    = new LoginPage(this);
+        register_page_ = new RegisterPage(this);
 
         // Initialize sliding widget manager.
         pageStack_ = new QStackedWidget(this);
         pageStack_->addWidget(welcome_page_);
         pageStack_->addWidget(login_page_);
         pageStack_->addWidget(register_page_);
-        pageStack_->addWidget(chat_page_);
-        pageStack_->addWidget(userSettingsPage_);
 
         setCentralWidget(pageStack_);
 
@@ -95,33 +98,11 @@ MainWindow::MainWindow(QWidget *parent)
         });
         connect(register_page_, SIGNAL(backButtonClicked()), this, SLOT(showWelcomePage()));
 
-        connect(chat_page_, &ChatPage::closing, this, &MainWindow::showWelcomePage);
-        connect(
-          chat_page_, &ChatPage::showOverlayProgressBar, this, &MainWindow::showOverlayProgressBar);
-        connect(
-          chat_page_, SIGNAL(changeWindowTitle(QString)), this, SLOT(setWindowTitle(QString)));
-        connect(chat_page_, SIGNAL(unreadMessages(int)), trayIcon_, SLOT(setUnreadCount(int)));
-        connect(chat_page_, &ChatPage::showLoginPage, this, [this](const QString &msg) {
-                login_page_->loginError(msg);
-                showLoginPage();
-        });
-
-        connect(userSettingsPage_, &UserSettingsPage::moveBack, this, [this]() {
-                pageStack_->setCurrentWidget(chat_page_);
-        });
-
-        connect(
-          userSettingsPage_, SIGNAL(trayOptionChanged(bool)), trayIcon_, SLOT(setVisible(bool)));
-
         connect(trayIcon_,
                 SIGNAL(activated(QSystemTrayIcon::ActivationReason)),
                 this,
                 SLOT(iconActivated(QSystemTrayIcon::ActivationReason)));
 
-        connect(chat_page_, SIGNAL(contentLoaded()), this, SLOT(removeOverlayProgressBar()));
-        connect(
-          chat_page_, &ChatPage::showUserSettingsPage, this, &MainWindow::showUserSettingsPage);
-
         connect(login_page_, &LoginPage::loginOk, this, [this](const mtx::responses::Login &res) {
                 http::client()->set_user(res.user_id);
                 showChatPage();
@@ -134,7 +115,7 @@ MainWindow::MainWindow(QWidget *parent)
 
         QShortcut *quickSwitchShortcut = new QShortcut(QKeySequence("Ctrl+K"), this);
         connect(quickSwitchShortcut, &QShortcut::activated, this, [this]() {
-                if (chat_page_->isVisible() && !hasActiveDialogs())
+                if (chat_page_ && chat_page_->isVisible() && !hasActiveDialogs())
                         chat_page_->showQuickSwitcher();
         });
 
@@ -164,6 +145,41 @@ MainWindow::MainWindow(QWidget *parent)
         }
 }
 
+void
+MainWindow::ensureChatPage()
+{
+        if (chat_page_)
+                return;
+
+        chat_page_        = new ChatPage(userSettings_, this);
+        userSettingsPage_ = new UserSettingsPage(userSettings_, this);
+
+        pageStack_->addWidget(chat_page_);
+        pageStack_->addWidget(userSettingsPage_);
+
+        connect(chat_page_, &ChatPage::closing, this, &MainWindow::showWelcomePage);
+        connect(
+          chat_page_, &ChatPage::showOverlayProgressBar, this, &MainWindow::showOverlayProgressBar);
+        connect(
+          chat_page_, SIGNAL(changeWindowTitle(QString)), this, SLOT(setWindowTitle(QString)));
+        connect(chat_page_, SIGNAL(unreadMessages(int)), trayIcon_, SLOT(setUnreadCount(int)));
+        connect(chat_page_, &ChatPage::showLoginPage, this, [this](const QString &msg) {
+                login_page_->loginError(msg);
+                showLoginPage();
+        });
+
+        connect(chat_page_, SIGNAL(contentLoaded()), this, SLOT(removeOverlayProgressBar()));
+        connect(
+          chat_page_, &ChatPage::showUserSettingsPage, this, &MainWindow::showUserSettingsPage);
+
+        connect(userSettingsPage_, &UserSettingsPage::moveBack, this, [this]() {
+                pageStack_->setCurrentWidget(chat_page_);
+        });
+
+        connect(
+          userSettingsPage_, SIGNAL(trayOptionChanged(bool)), trayIcon_, SLOT(setVisible(bool)));
+}
+
 void
 MainWindow::showEvent(QShowEvent *event)
 {
@@ -175,12 +191,20 @@ void
 MainWindow::resizeEvent(QResizeEvent *event)
 {
         adjustSideBars();
+
+        // Persist the geometry shortly after the user stops resizing,
+        // so it isn't lost when the process dies without a clean exit.
+        geometrySaveTimer_->start();
+
         QMainWindow::resizeEvent(event);
 }
 
 void
 MainWindow::adjustSideBars()
 {
+        if (!chat_page_)
+                return;
+
         const int timelineWidth = chat_page_->timelineWidth();
         const int minAvailableWidth =
           conf::sideBarCollapsePoint + ui::sidebar::CommunitiesSidebarSize;
@@ -233,6 +257,9 @@ MainWindow::removeOverlayProgressBar()
 
         // FIXME:  Snackbar doesn't work if it's initialized in the constructor.
         QTimer::singleShot(0, this, [this]() {
+                if (!chat_page_)
+                        return;
+
                 snackBar_ = new SnackBar(this);
                 connect(chat_page_, &ChatPage::showNotification, snackBar_, &SnackBar::showMessage);
         });
@@ -243,6 +270,8 @@ MainWindow::removeOverlayProgressBar()
 void
 MainWindow::showChatPage()
 {
+        ensureChatPage();
+
         auto userid     = QString::fromStdString(http::client()->user_id().to_string());
         auto device_id  = QString::fromStdString(http::client()->device_id());
         auto homeserver = QString::fromStdString(http::client()->server() + ":" +
@@ -307,10 +336,12 @@ MainWindow::hasActiveUser()
 void
 MainWindow::openUserProfile(const QString &user_id, const QString &room_id)
 {
-        auto dialog = new dialogs::UserProfile(this);
-        dialog->init(user_id, room_id);
+        if (!userProfileDialog_)
+                userProfileDialog_ = new dialogs::UserProfile(this);
 
-        showTransparentOverlayModal(dialog);
+        userProfileDialog_->init(user_id, room_id);
+
+        showTransparentOverlayModal(userProfileDialog_);
 }
 
 void
@@ -355,10 +386,13 @@ MainWindow::openLeaveRoomDialog(const QString &room_id)
 void
 MainWindow::showOverlayProgressBar()
 {
-        spinner_ = new LoadingIndicator(this);
-        spinner_->setFixedHeight(100);
-        spinner_->setFixedWidth(100);
-        spinner_->setObjectName("ChatPageLoadSpinner");
+        if (!spinner_) {
+                spinner_ = new LoadingIndicator(this);
+                spinner_->setFixedHeight(100);
+                spinner_->setFixedWidth(100);
+                spinner_->setObjectName("ChatPageLoadSpinner");
+        }
+
         spinner_->start();
 
         showSolidOverlayModal(spinner_);
@@ -421,6 +455,11 @@ MainWindow::openCreateRoomDialog(
 void
 MainWindow::showTransparentOverlayModal(QWidget *content, QFlags<Qt::AlignmentFlag> flags)
 {
+        // Pooled widgets are reused; detach them before the modal deletes
+        // its previous content.
+        if (isWidgetPooled(modal_->widget()))
+                modal_->releaseWidget();
+
         modal_->setWidget(content);
         modal_->setColor(QColor(30, 30, 30, 150));
         modal_->setDismissible(true);
@@ -432,6 +471,9 @@ MainWindow::showTransparentOverlayModal(QWidget *content, QFlags<Qt::AlignmentFl
 void
 MainWindow::showSolidOverlayModal(QWidget *content, QFlags<Qt::AlignmentFlag> flags)
 {
+        if (isWidgetPooled(modal_->widget()))
+                modal_->releaseWidget();
+
         modal_->setWidget(content);
         modal_->setColor(QColor(30, 30, 30));
         modal_->setDismissible(false);
@@ -465,22 +507,30 @@ MainWindow::openLogoutDialog()
 void
 MainWindow::openReadReceiptsDialog(const QString &event_id)
 {
-        auto dialog = new dialogs::ReadReceipts(this);
+        if (!readReceiptsDialog_)
+                readReceiptsDialog_ = new dialogs::ReadReceipts(this);
 
         const auto room_id = chat_page_->currentRoom();
 
         try {
-                dialog->addUsers(cache::client()->readReceipts(event_id, room_id));
+                readReceiptsDialog_->addUsers(cache::client()->readReceipts(event_id, room_id));
         } catch (const lmdb::error &e) {
                 nhlog::db()->warn("failed to retrieve read receipts for {} {}",
                                   event_id.toStdString(),
                                   chat_page_->currentRoom().toStdString());
-                dialog->deleteLater();
 
                 return;
         }
 
-        showTransparentOverlayModal(dialog);
+        showTransparentOverlayModal(readReceiptsDialog_);
+}
+
+bool
+MainWindow::isWidgetPooled(QWidget *widget) const
+{
+        return widget != nullptr &&
+               (widget == spinner_ || widget == userProfileDialog_ ||
+                widget == readReceiptsDialog_);
 }
 
 bool
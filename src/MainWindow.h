@@ -23,6 +23,7 @@
 #include <QSharedPointer>
 #include <QStackedWidget>
 #include <QSystemTrayIcon>
+#include <QTimer>
 
 #include "LoginPage.h"
 #include "RegisterPage.h"
@@ -52,6 +53,7 @@ class LeaveRoom;
 class Logout;
 class MemberList;
 class ReCaptcha;
+class ReadReceipts;
 class RoomSettings;
 }
 
@@ -131,10 +133,15 @@ private slots:
 private:
         bool hasActiveUser();
         void restoreWindowSize();
+        //! Build the chat & settings pages on first use, so the
+        //! login/welcome path doesn't pay for their widget trees.
+        void ensureChatPage();
         //! Check if there is an open dialog.
         bool hasActiveDialogs() const;
         //! Check if the current page supports the "minimize to tray" functionality.
         bool pageSupportsTray() const;
+        //! Whether the widget is built once and kept for reuse.
+        bool isWidgetPooled(QWidget *widget) const;
 
         static MainWindow *instance_;
 
@@ -146,9 +153,9 @@ private:
         RegisterPage *register_page_;
         //! A stacked widget that handles the transitions between widgets.
         QStackedWidget *pageStack_;
-        //! The main chat area.
-        ChatPage *chat_page_;
-        UserSettingsPage *userSettingsPage_;
+        //! The main chat area; constructed on first use.
+        ChatPage *chat_page_ = nullptr;
+        UserSettingsPage *userSettingsPage_ = nullptr;
         QSharedPointer<UserSettings> userSettings_;
         //! Tray icon that shows the unread message count.
         TrayIcon *trayIcon_;
@@ -157,4 +164,12 @@ private:
         //! Overlay modal used to project other widgets.
         OverlayModal *modal_       = nullptr;
         LoadingIndicator *spinner_ = nullptr;
+
+        //! Dialogs built on first open and reused afterwards.
+        dialogs::UserProfile *userProfileDialog_   = nullptr;
+        dialogs::ReadReceipts *readReceiptsDialog_ = nullptr;
+
+        //! Debounce for saving the window geometry while resizing, so the
+        //! saved size survives a crash instead of only a clean shutdown.
+        QTimer *geometrySaveTimer_;
 };
@@ -1,9 +1,251 @@
 #include "MatrixClient.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <map>
 #include <memory>
+#include <mutex>
+
+#include <QCoreApplication>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QPointer>
+#include <QTimer>
+#include <QUrl>
+#include <QUrlQuery>
+#include <QWidget>
+
+#include <json.hpp>
+
+#include "Logging.h"
+#include "Utils.h"
+
+using json = nlohmann::json;
 
 namespace {
 auto client_ = std::make_shared<mtx::http::Client>();
+
+//! Connections per account. The login flow talks to the active
+//! connection until the user id is known; registerAccount then files
+//! the connection under the account, so several logins can share the
+//! process.
+std::map<std::string, std::shared_ptr<mtx::http::Client>> clients_;
+
+//! For the few endpoints the client library doesn't cover. Owned by the
+//! application object, so it is destroyed together with the event loop
+//! it depends on.
+QNetworkAccessManager *
+network()
+{
+        static auto instance = new QNetworkAccessManager(QCoreApplication::instance());
+
+        return instance;
+}
+
+//! All media comes from the user's homeserver, so a single global cap
+//! doubles as the per-host concurrency cap.
+constexpr int MAX_CONCURRENT_DOWNLOADS = 4;
+
+//! A media download waiting for a free transfer slot.
+struct ScheduledDownload
+{
+        std::string mxc_url;
+        mtx::http::ThumbOpts thumbOpts;
+        bool isThumbnail = false;
+
+        QPointer<QObject> owner;
+
+        http::DownloadCallback callback;
+        http::ThumbnailCallback thumbnailCallback;
+};
+
+std::mutex downloadsMutex_;
+//! One queue per DownloadPriority tier.
+std::array<std::deque<ScheduledDownload>, 3> downloadQueues_;
+int activeDownloads_ = 0;
+
+//! How long a URL stays bad after its first failure. The window doubles
+//! with every further failure up to the cap.
+constexpr std::chrono::seconds NEGATIVE_TTL_BASE{30};
+constexpr std::chrono::seconds NEGATIVE_TTL_MAX = std::chrono::minutes{30};
+
+//! A URL whose last fetch failed. All display sites of the URL share
+//! the entry, so one widget's failure back-off covers the others too.
+struct FailedFetch
+{
+        std::chrono::steady_clock::time_point retryAfter;
+        int failures = 0;
+        //! The original failure, replayed to short-circuited callbacks.
+        mtx::http::ClientError error;
+};
+
+//! Guarded by downloadsMutex_.
+std::map<std::string, FailedFetch> failedFetches_;
+
+std::chrono::seconds
+negativeTtl(int failures)
+{
+        auto ttl = NEGATIVE_TTL_BASE;
+
+        for (int i = 1; i < failures; i++) {
+                ttl *= 2;
+
+                if (ttl >= NEGATIVE_TTL_MAX)
+                        return NEGATIVE_TTL_MAX;
+        }
+
+        return ttl;
+}
+
+//! The failure to replay if the URL is still inside its back-off
+//! window, otherwise nothing.
+boost::optional<mtx::http::ClientError>
+negativeCacheHit(const std::string &mxc_url)
+{
+        std::lock_guard<std::mutex> lock(downloadsMutex_);
+
+        auto entry = failedFetches_.find(mxc_url);
+
+        if (entry == failedFetches_.end())
+                return boost::none;
+
+        if (std::chrono::steady_clock::now() >= entry->second.retryAfter)
+                return boost::none;
+
+        return entry->second.error;
+}
+
+//! Update the negative cache after a fetch: successes clear the URL's
+//! entry, failures extend its back-off window.
+void
+recordFetchResult(const std::string &mxc_url, mtx::http::RequestErr err)
+{
+        std::lock_guard<std::mutex> lock(downloadsMutex_);
+
+        if (!err) {
+                failedFetches_.erase(mxc_url);
+                return;
+        }
+
+        auto &entry = failedFetches_[mxc_url];
+        entry.failures += 1;
+        entry.error      = *err;
+        entry.retryAfter = std::chrono::steady_clock::now() + negativeTtl(entry.failures);
+}
+
+//! Payload bytes & completed requests per metrics::Endpoint.
+std::array<std::atomic<uint64_t>, 3> transferBytes_{};
+std::array<std::atomic<uint64_t>, 3> transferCount_{};
+
+void
+dispatchDownloads()
+{
+        while (true) {
+                ScheduledDownload job;
+
+                {
+                        std::lock_guard<std::mutex> lock(downloadsMutex_);
+
+                        if (activeDownloads_ >= MAX_CONCURRENT_DOWNLOADS)
+                                return;
+
+                        auto queue =
+                          std::find_if(downloadQueues_.begin(),
+                                       downloadQueues_.end(),
+                                       [](const auto &queue) { return !queue.empty(); });
+
+                        if (queue == downloadQueues_.end())
+                                return;
+
+                        job = std::move(queue->front());
+                        queue->pop_front();
+
+                        // The owner was destroyed while the download was queued.
+                        if (job.owner.isNull())
+                                continue;
+
+                        activeDownloads_ += 1;
+                }
+
+                // The transfer slot is released before the callback runs, so a
+                // download scheduled by the callback itself can't deadlock.
+                auto finish = []() {
+                        {
+                                std::lock_guard<std::mutex> lock(downloadsMutex_);
+                                activeDownloads_ -= 1;
+                        }
+
+                        dispatchDownloads();
+                };
+
+                if (job.isThumbnail)
+                        client_->get_thumbnail(
+                          job.thumbOpts,
+                          [callback = std::move(job.thumbnailCallback),
+                           url      = job.thumbOpts.mxc_url,
+                           finish](const std::string &res, mtx::http::RequestErr err) {
+                                  finish();
+
+                                  recordFetchResult(url, err);
+
+                                  if (!err)
+                                          http::metrics::recordTransfer(
+                                            http::metrics::Endpoint::Thumbnail, res.size());
+
+                                  callback(res, err);
+                          });
+                else
+                        client_->download(
+                          job.mxc_url,
+                          [callback = std::move(job.callback), url = job.mxc_url, finish](
+                            const std::string &data,
+                            const std::string &content_type,
+                            const std::string &original_filename,
+                            mtx::http::RequestErr err) {
+                                  finish();
+
+                                  recordFetchResult(url, err);
+
+                                  if (!err)
+                                          http::metrics::recordTransfer(
+                                            http::metrics::Endpoint::Media, data.size());
+
+                                  callback(data, content_type, original_filename, err);
+                          });
+        }
+}
+
+void
+scheduleDownload(ScheduledDownload &&job, http::DownloadPriority priority)
+{
+        const auto &url = job.isThumbnail ? job.thumbOpts.mxc_url : job.mxc_url;
+
+        // Known-bad URLs fail right away instead of burning a transfer
+        // slot on a request that just failed. Note that the callback runs
+        // on the caller's thread in this case.
+        if (auto cached = negativeCacheHit(url)) {
+                const boost::optional<mtx::http::ClientError> err = *cached;
+
+                if (job.isThumbnail)
+                        job.thumbnailCallback("", err);
+                else
+                        job.callback("", "", "", err);
+
+                return;
+        }
+
+        {
+                std::lock_guard<std::mutex> lock(downloadsMutex_);
+                downloadQueues_.at(static_cast<std::size_t>(priority))
+                  .emplace_back(std::move(job));
+        }
+
+        dispatchDownloads();
+}
 }
 
 namespace http {
@@ -20,6 +262,24 @@ is_logged_in()
         return !client_->access_token().empty();
 }
 
+void
+registerAccount(const std::string &user_id)
+{
+        clients_[user_id] = client_;
+}
+
+bool
+activateAccount(const std::string &user_id)
+{
+        auto it = clients_.find(user_id);
+        if (it == clients_.end())
+                return false;
+
+        client_ = it->second;
+
+        return true;
+}
+
 void
 init()
 {
@@ -34,6 +294,180 @@ init()
         qRegisterMetaType<std::vector<std::string>>();
         qRegisterMetaType<std::vector<QString>>();
         qRegisterMetaType<std::map<QString, bool>>("std::map<QString, bool>");
+
+        // So "is compression active?" can be answered from a field log:
+        // the client library sends no Accept-Encoding header, responses
+        // arrive unencoded.
+        nhlog::net()->info("transfer encoding: identity (no compression negotiated)");
+
+        // Periodic footprint line for long field sessions; the final
+        // numbers are logged on shutdown.
+        auto reportTimer = new QTimer(QCoreApplication::instance());
+        reportTimer->setInterval(10 * 60 * 1000);
+        QObject::connect(reportTimer, &QTimer::timeout, []() {
+                nhlog::net()->debug("{}", metrics::report().toStdString());
+        });
+        reportTimer->start();
+}
+
+void
+warmConnection()
+{
+        // The client opens a fresh connection per request and exposes no
+        // persistent pool to tune, so the best that can be done ahead of
+        // time is a throwaway request: it primes the resolver and the TLS
+        // stack and surfaces connectivity problems early.
+        const auto start = std::chrono::steady_clock::now();
+
+        client_->versions([start](const mtx::responses::Versions &, mtx::http::RequestErr err) {
+                const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                       std::chrono::steady_clock::now() - start)
+                                       .count();
+
+                if (err) {
+                        nhlog::net()->warn("connection warm-up failed after {} ms", elapsed);
+                        return;
+                }
+
+                nhlog::net()->info("connection warm-up took {} ms", elapsed);
+        });
+}
+
+void
+download(const std::string &mxc_url,
+         DownloadPriority priority,
+         QObject *owner,
+         DownloadCallback callback)
+{
+        ScheduledDownload job;
+        job.mxc_url  = mxc_url;
+        job.owner    = owner;
+        job.callback = std::move(callback);
+
+        scheduleDownload(std::move(job), priority);
+}
+
+void
+get_thumbnail(const mtx::http::ThumbOpts &opts,
+              DownloadPriority priority,
+              QObject *owner,
+              ThumbnailCallback callback)
+{
+        ScheduledDownload job;
+        job.thumbOpts         = opts;
+        job.isThumbnail       = true;
+        job.owner             = owner;
+        job.thumbnailCallback = std::move(callback);
+
+        scheduleDownload(std::move(job), priority);
+}
+
+void
+cancelDownloads(QWidget *parent)
+{
+        std::lock_guard<std::mutex> lock(downloadsMutex_);
+
+        for (auto &queue : downloadQueues_) {
+                queue.erase(std::remove_if(queue.begin(),
+                                           queue.end(),
+                                           [parent](const ScheduledDownload &job) {
+                                                   if (job.owner.isNull())
+                                                           return true;
+
+                                                   if (job.owner.data() == parent)
+                                                           return true;
+
+                                                   auto widget =
+                                                     qobject_cast<QWidget *>(job.owner.data());
+
+                                                   return widget && parent->isAncestorOf(widget);
+                                           }),
+                            queue.end());
+        }
+}
+
+void
+fetchNotifications(const std::string &from, int limit, QObject *owner, NotificationsCallback cb)
+{
+        QUrl url(QString("https://%1:%2/_matrix/client/r0/notifications")
+                   .arg(QString::fromStdString(client_->server()))
+                   .arg(client_->port()));
+
+        QUrlQuery query;
+        query.addQueryItem("limit", QString::number(limit));
+        if (!from.empty())
+                query.addQueryItem("from", QString::fromStdString(from));
+        url.setQuery(query);
+
+        QNetworkRequest request(url);
+        request.setRawHeader("Authorization",
+                             QString("Bearer %1")
+                               .arg(QString::fromStdString(client_->access_token()))
+                               .toLatin1());
+
+        auto reply = network()->get(request);
+
+        if (cb)
+                QObject::connect(
+                  reply, &QNetworkReply::finished, owner ? owner : reply, [reply, cb]() {
+                          const auto status =
+                            reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+                          mtx::responses::Notifications res;
+
+                          if (reply->error() == QNetworkReply::NoError) {
+                                  try {
+                                          res = json::parse(reply->readAll().toStdString())
+                                                  .get<mtx::responses::Notifications>();
+                                  } catch (const std::exception &e) {
+                                          nhlog::net()->warn(
+                                            "malformed notifications response: {}", e.what());
+                                  }
+                          }
+
+                          cb(res, status);
+                  });
+
+        // Runs after the callback above, so the reply outlives it even
+        // if the owner goes away mid-flight.
+        QObject::connect(reply, &QNetworkReply::finished, reply, [reply]() {
+                if (reply->error() != QNetworkReply::NoError)
+                        nhlog::net()->warn("notifications fetch failed: {}",
+                                           reply->errorString().toStdString());
+
+                reply->deleteLater();
+        });
+}
+
+namespace metrics {
+
+void
+recordTransfer(Endpoint endpoint, std::size_t bytes)
+{
+        const auto idx = static_cast<std::size_t>(endpoint);
+
+        transferBytes_.at(idx).fetch_add(bytes, std::memory_order_relaxed);
+        transferCount_.at(idx).fetch_add(1, std::memory_order_relaxed);
+}
+
+QString
+report()
+{
+        auto line = [](const char *name, Endpoint endpoint) {
+                const auto idx = static_cast<std::size_t>(endpoint);
+
+                return QString("%1 %2 in %3 requests")
+                  .arg(name)
+                  .arg(utils::humanReadableFileSize(
+                    transferBytes_.at(idx).load(std::memory_order_relaxed)))
+                  .arg(transferCount_.at(idx).load(std::memory_order_relaxed));
+        };
+
+        return QString("bandwidth: %1, %2, %3")
+          .arg(line("media", Endpoint::Media),
+               line("thumbnails", Endpoint::Thumbnail),
+               line("uploads", Endpoint::Upload));
 }
 
+} // namespace metrics
 } // namespace http
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <functional>
+
 #include <QMetaType>
 #include <QString>
 
 #include <mtx/responses.hpp>
 #include <mtxclient/http/client.hpp>
 
+class QObject;
+class QWidget;
+
 Q_DECLARE_METATYPE(mtx::responses::Login)
 Q_DECLARE_METATYPE(mtx::responses::Messages)
 Q_DECLARE_METATYPE(mtx::responses::Notifications)
@@ -18,13 +23,110 @@ Q_DECLARE_METATYPE(std::vector<std::string>)
 Q_DECLARE_METATYPE(std::vector<QString>)
 
 namespace http {
+//! The active account's connection.
 mtx::http::Client *
 client();
 
 bool
 is_logged_in();
 
+//! File the active connection under the account's user id, once it is
+//! known, so several logins can live in one process.
+void
+registerAccount(const std::string &user_id);
+
+//! Make a previously registered account's connection the active one.
+//! Must be called while no requests are in flight. Returns false if
+//! the account was never registered.
+bool
+activateAccount(const std::string &user_id);
+
 //! Initialize the http module
 void
 init();
+
+//! Warm up the connection path to the homeserver, so the first sync
+//! doesn't pay the resolver & TLS handshake latency.
+void
+warmConnection();
+
+//! Priority tiers for scheduled media downloads, in dispatch order.
+enum class DownloadPriority
+{
+        //! Media on the timeline the user is currently looking at.
+        Visible,
+        //! Media that is expected to be needed soon.
+        Prefetch,
+        //! Avatars & thumbnails of offscreen items.
+        Avatar,
+};
+
+using DownloadCallback  = std::function<void(const std::string &data,
+                                            const std::string &content_type,
+                                            const std::string &original_filename,
+                                            mtx::http::RequestErr err)>;
+using ThumbnailCallback = std::function<void(const std::string &data, mtx::http::RequestErr err)>;
+
+//! Schedule a media download.
+//!
+//! Higher tiers always dispatch first and only a handful of transfers
+//! are in flight at a time, so a backlog of offscreen media can't
+//! starve the content the user is looking at. Queued downloads whose
+//! owner has been destroyed are dropped before they are dispatched.
+void
+download(const std::string &mxc_url,
+         DownloadPriority priority,
+         QObject *owner,
+         DownloadCallback callback);
+
+//! Schedule a thumbnail download. Same semantics as download().
+void
+get_thumbnail(const mtx::http::ThumbOpts &opts,
+              DownloadPriority priority,
+              QObject *owner,
+              ThumbnailCallback callback);
+
+//! Drop the queued downloads owned by the given widget or its children,
+//! e.g. when a timeline view is switched away. Transfers already in
+//! flight are not affected.
+void
+cancelDownloads(QWidget *parent);
+
+using NotificationsCallback =
+  std::function<void(const mtx::responses::Notifications &res, int status)>;
+
+//! Fetch one page of the /notifications backlog starting at the given
+//! since token, so a deep backlog can be drained incrementally instead
+//! of in one response. The client library's endpoint takes no token;
+//! this goes to the endpoint directly. status 0 means the request
+//! failed before reaching the server. The callback is dropped if the
+//! owner is destroyed. Call from the GUI thread.
+void
+fetchNotifications(const std::string &from, int limit, QObject *owner, NotificationsCallback cb);
+
+//! Accounting of the payload bytes crossing the http layer, for
+//! quantifying the wire footprint on metered links. The client library
+//! hands back parsed responses and negotiates no transfer encoding, so
+//! the counters cover the payloads it exposes and the encoding is
+//! always identity.
+namespace metrics {
+
+//! Endpoint families tracked by the traffic counters.
+enum class Endpoint
+{
+        Media,
+        Thumbnail,
+        Upload,
+};
+
+//! Record a completed transfer of the given payload size. Safe to call
+//! from any thread.
+void
+recordTransfer(Endpoint endpoint, std::size_t bytes);
+
+//! Human-readable summary of the traffic since startup. Logged
+//! periodically and on shutdown.
+QString
+report();
+}
 }
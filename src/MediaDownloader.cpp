@@ -0,0 +1,214 @@
+/*
+ * nheko Copyright (C) 2017  Konstantinos Sideris <siderisk@auth.gr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QUrl>
+#include <QUrlQuery>
+
+#include <json.hpp>
+
+#include "Logging.h"
+#include "MatrixClient.h"
+#include "MediaDownloader.h"
+
+using json = nlohmann::json;
+
+namespace {
+QNetworkAccessManager *
+network()
+{
+        // Owned by the application object, so it is destroyed together
+        // with the event loop it depends on.
+        static auto instance = new QNetworkAccessManager(QCoreApplication::instance());
+
+        return instance;
+}
+
+QString
+partPath(const QString &dest)
+{
+        return dest + ".part";
+}
+}
+
+void
+media::preconnect(const QUrl &url)
+{
+        if (url.scheme() == "https")
+                network()->connectToHostEncrypted(url.host(),
+                                                  static_cast<quint16>(url.port(443)));
+        else
+                network()->connectToHost(url.host(), static_cast<quint16>(url.port(80)));
+}
+
+void
+media::download(const QUrl &url,
+                const QString &dest,
+                QObject *owner,
+                std::function<void(bool)> done)
+{
+        auto part = std::make_shared<QFile>(partPath(dest));
+
+        const qint64 offset = part->exists() ? part->size() : 0;
+
+        if (!part->open(QIODevice::WriteOnly | QIODevice::Append)) {
+                nhlog::net()->warn("failed to open partial file {}",
+                                   partPath(dest).toStdString());
+
+                if (done)
+                        done(false);
+
+                return;
+        }
+
+        QNetworkRequest request(url);
+        if (offset > 0)
+                request.setRawHeader("Range", QString("bytes=%1-").arg(offset).toLatin1());
+
+        auto reply = network()->get(request);
+
+        // The body is flushed to disk as it arrives, so the transfer
+        // never occupies more than a socket buffer of memory.
+        auto rangeChecked = std::make_shared<bool>(offset == 0);
+        QObject::connect(reply, &QNetworkReply::readyRead, reply, [reply, part, rangeChecked]() {
+                if (!*rangeChecked) {
+                        const auto status =
+                          reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+                        // A server that ignores the range replies with 200
+                        // and resends the file from its first byte.
+                        if (status == 200)
+                                part->resize(0);
+
+                        *rangeChecked = true;
+                }
+
+                part->write(reply->readAll());
+        });
+
+        QObject::connect(reply, &QNetworkReply::finished, reply, [reply, part, dest]() {
+                part->close();
+
+                if (reply->error() == QNetworkReply::NoError) {
+                        QFile::remove(dest);
+
+                        if (!part->rename(dest))
+                                nhlog::net()->warn("failed to move {} into place",
+                                                   dest.toStdString());
+                } else {
+                        // The partial file is kept; the next attempt picks
+                        // up where this one stopped.
+                        nhlog::net()->warn("download interrupted at {} byte(s): {}",
+                                           part->size(),
+                                           reply->errorString().toStdString());
+                }
+
+                reply->deleteLater();
+        });
+
+        if (done)
+                QObject::connect(
+                  reply, &QNetworkReply::finished, owner ? owner : reply, [reply, done]() {
+                          done(reply->error() == QNetworkReply::NoError);
+                  });
+}
+
+void
+media::upload(const QString &path,
+              const QString &mimeType,
+              const QString &filename,
+              QObject *owner,
+              std::function<void(QString content_uri, int status)> done,
+              std::function<void(qint64 sent, qint64 total)> progress)
+{
+        auto file = std::make_shared<QFile>(path);
+
+        if (!file->open(QIODevice::ReadOnly)) {
+                nhlog::net()->warn("failed to open upload source {}", path.toStdString());
+
+                if (done)
+                        done(QString(), 0);
+
+                return;
+        }
+
+        QUrl url(QString("https://%1:%2/_matrix/media/r0/upload")
+                   .arg(QString::fromStdString(http::client()->server()))
+                   .arg(http::client()->port()));
+
+        QUrlQuery query;
+        query.addQueryItem("filename", filename);
+        url.setQuery(query);
+
+        QNetworkRequest request(url);
+        request.setHeader(QNetworkRequest::ContentTypeHeader, mimeType);
+        request.setRawHeader("Authorization",
+                             QString("Bearer %1")
+                               .arg(QString::fromStdString(http::client()->access_token()))
+                               .toLatin1());
+
+        // The body is read from the file in bounded chunks as the socket
+        // drains; the attachment never sits in memory as a whole.
+        auto reply = network()->post(request, file.get());
+
+        if (progress)
+                QObject::connect(reply,
+                                 &QNetworkReply::uploadProgress,
+                                 owner ? owner : reply,
+                                 std::move(progress));
+
+        if (done)
+                QObject::connect(
+                  reply, &QNetworkReply::finished, owner ? owner : reply, [reply, done]() {
+                          const auto status =
+                            reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+                          QString content_uri;
+
+                          if (reply->error() == QNetworkReply::NoError) {
+                                  try {
+                                          const auto body = json::parse(
+                                            reply->readAll().toStdString());
+                                          content_uri = QString::fromStdString(
+                                            body.value("content_uri", ""));
+                                  } catch (const json::exception &e) {
+                                          nhlog::net()->warn(
+                                            "malformed upload response: {}", e.what());
+                                  }
+                          }
+
+                          done(content_uri, status);
+                  });
+
+        // Runs after the callback above; keeps the source open until the
+        // transfer is over even if the owner goes away mid-flight.
+        QObject::connect(reply, &QNetworkReply::finished, reply, [reply, file]() {
+                if (reply->error() != QNetworkReply::NoError)
+                        nhlog::net()->warn("upload of {} failed: {}",
+                                           file->fileName().toStdString(),
+                                           reply->errorString().toStdString());
+
+                file->close();
+                reply->deleteLater();
+        });
+}
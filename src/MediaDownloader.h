@@ -0,0 +1,63 @@
+/*
+ * nheko Copyright (C) 2017  Konstantinos Sideris <siderisk@auth.gr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <functional>
+
+#include <QtGlobal>
+
+class QObject;
+class QString;
+class QUrl;
+
+//! Resumable media downloads.
+//!
+//! Large attachments are streamed straight to disk instead of being
+//! buffered whole in memory. Partial data is kept in a sibling ".part"
+//! file, so an interrupted transfer continues from its last byte with
+//! an HTTP range request instead of starting over.
+namespace media {
+
+//! Open the TCP/TLS connection to the host ahead of time, e.g. while
+//! the user is hovering a download button, so the eventual request
+//! skips the handshake round trips. Must be called from the GUI thread.
+void
+preconnect(const QUrl &url);
+
+//! Download @p url into @p dest, resuming from an existing partial
+//! file if there is one. @p done is invoked on the GUI thread with
+//! whether the file was fully retrieved; it is dropped if @p owner is
+//! destroyed first. Must be called from the GUI thread.
+void
+download(const QUrl &url, const QString &dest, QObject *owner, std::function<void(bool)> done);
+
+//! Upload the file at @p path to the content repository, streamed from
+//! disk in bounded chunks so memory usage is constant regardless of the
+//! attachment's size. @p done is invoked on the GUI thread with the mxc
+//! URI (empty on failure) and the HTTP status code (0 for transport
+//! errors); @p progress, if given, reports the stream position. Both
+//! are dropped if @p owner is destroyed first. Must be called from the
+//! GUI thread.
+void
+upload(const QString &path,
+       const QString &mimeType,
+       const QString &filename,
+       QObject *owner,
+       std::function<void(QString content_uri, int status)> done,
+       std::function<void(qint64 sent, qint64 total)> progress = nullptr);
+}
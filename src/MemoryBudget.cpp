@@ -0,0 +1,130 @@
+/*
+ * nheko Copyright (C) 2017  Konstantinos Sideris <siderisk@auth.gr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QPointer>
+#include <QSettings>
+#include <QTimer>
+
+#if defined(Q_OS_LINUX)
+#include <fstream>
+#include <unistd.h>
+#endif
+
+#include "Logging.h"
+#include "MemoryBudget.h"
+
+namespace {
+struct Hook
+{
+        int priority;
+        const char *name;
+        //! Distinguishes a destroyed owner from no owner at all.
+        bool hasOwner;
+        QPointer<QObject> owner;
+        std::function<void()> fn;
+};
+
+std::vector<Hook> hooks_;
+
+//! How often the resident size is sampled.
+constexpr int PRESSURE_INTERVAL_MS = 30 * 1000;
+
+constexpr size_t MB = 1024 * 1024;
+
+//! The configured ceiling in bytes; zero disables the monitor.
+size_t
+ceilingBytes()
+{
+        QSettings settings;
+        return settings.value("user/memory/max_resident_mb", 0).toULongLong() * MB;
+}
+
+void
+checkPressure()
+{
+        const auto ceiling = ceilingBytes();
+        if (ceiling == 0)
+                return;
+
+        auto resident = mem::residentBytes();
+        if (resident == 0 || resident <= ceiling)
+                return;
+
+        nhlog::ui()->info(
+          "memory pressure: resident {} MB, ceiling {} MB", resident / MB, ceiling / MB);
+
+        std::stable_sort(hooks_.begin(), hooks_.end(), [](const Hook &a, const Hook &b) {
+                return a.priority < b.priority;
+        });
+
+        for (auto it = hooks_.begin(); it != hooks_.end();) {
+                if (it->hasOwner && it->owner.isNull()) {
+                        it = hooks_.erase(it);
+                        continue;
+                }
+
+                it->fn();
+
+                // The allocator may hold on to freed pages for a while; a
+                // sample that hasn't moved simply means the next tick
+                // continues from here.
+                resident = mem::residentBytes();
+                nhlog::ui()->info(
+                  "memory pressure: released '{}', resident {} MB", it->name, resident / MB);
+
+                if (resident <= ceiling)
+                        break;
+
+                ++it;
+        }
+}
+}
+
+void
+mem::init()
+{
+        auto timer = new QTimer(QCoreApplication::instance());
+        timer->setInterval(PRESSURE_INTERVAL_MS);
+        QObject::connect(timer, &QTimer::timeout, checkPressure);
+        timer->start();
+}
+
+void
+mem::onPressure(int priority, const char *name, QObject *owner, std::function<void()> hook)
+{
+        hooks_.push_back(Hook{priority, name, owner != nullptr, owner, std::move(hook)});
+}
+
+size_t
+mem::residentBytes()
+{
+#if defined(Q_OS_LINUX)
+        std::ifstream statm("/proc/self/statm");
+
+        size_t total    = 0;
+        size_t resident = 0;
+        statm >> total >> resident;
+
+        return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+        return 0;
+#endif
+}
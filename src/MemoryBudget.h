@@ -0,0 +1,47 @@
+/*
+ * nheko Copyright (C) 2017  Konstantinos Sideris <siderisk@auth.gr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <functional>
+
+class QObject;
+
+//! Process-wide memory ceiling with prioritized release hooks.
+//!
+//! Subsystems register the memory they can give back — memoized
+//! caches, widget pools, inactive timeline views. A periodic monitor
+//! samples the resident set size and, once it crosses the configured
+//! ceiling, runs the hooks in ascending priority order until the
+//! process is back under it.
+namespace mem {
+
+//! Install the pressure monitor. Called once after QApplication is up.
+void
+init();
+
+//! Register a release hook. Lower priorities are asked to release
+//! first. The hook is dropped once @p owner is destroyed; a null owner
+//! means the hook lives for the whole process. Must be called from the
+//! GUI thread; hooks run on the GUI thread.
+void
+onPressure(int priority, const char *name, QObject *owner, std::function<void()> hook);
+
+//! Resident set size of the process in bytes, or 0 when unknown.
+size_t
+residentBytes();
+}
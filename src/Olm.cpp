@@ -1,3 +1,9 @@
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <set>
+
 #include <boost/variant.hpp>
 
 #include "Olm.h"
@@ -12,8 +18,235 @@ using namespace mtx::crypto;
 static const std::string STORAGE_SECRET_KEY("secret");
 constexpr auto MEGOLM_ALGO = "m.megolm.v1.aes-sha2";
 
+//! Upper bound for concurrent /keys/claim requests. Sharing a megolm
+//! session with a big room queues one claim per member.
+constexpr int MAX_CONCURRENT_CLAIMS = 4;
+//! How long a user that had no one-time keys available is skipped
+//! before being asked again.
+constexpr std::chrono::minutes EXHAUSTED_KEYS_TIMEOUT{5};
+//! Delay before an m.room_key_request for the same megolm session may
+//! be re-sent. Doubles with every attempt up to the ceiling below, so
+//! a device that will never answer is asked less and less often.
+constexpr std::chrono::minutes KEY_REQUEST_RETRY_BASE{1};
+constexpr std::chrono::minutes KEY_REQUEST_RETRY_MAX{60};
+
 namespace {
 auto client_ = std::make_unique<mtx::crypto::OlmClient>();
+
+using ClaimCallback =
+  std::function<void(const mtx::responses::ClaimKeys &res, mtx::http::RequestErr err)>;
+using QueryCallback =
+  std::function<void(const mtx::responses::QueryKeys &res, mtx::http::RequestErr err)>;
+
+struct ClaimJob
+{
+        std::string user_id;
+        std::vector<std::string> devices;
+        ClaimCallback callback;
+};
+
+std::mutex keySchedulerMutex_;
+//! Claims waiting for a free slot.
+std::deque<ClaimJob> claimQueue_;
+int activeClaims_ = 0;
+//! Users whose devices ran out of one-time keys and when we may ask
+//! them again.
+std::map<std::string, std::chrono::steady_clock::time_point> exhaustedUsers_;
+//! Callbacks waiting on an identical /keys/query that is in flight.
+std::map<std::string, std::vector<QueryCallback>> inflightQueries_;
+//! Retry state for a megolm session we asked keys for.
+struct KeyRequestState
+{
+        int attempts = 0;
+        //! Before this point a request for the same session is dropped.
+        std::chrono::steady_clock::time_point nextAttempt;
+};
+
+//! A single session request waiting to be packed into a to-device call.
+struct PendingKeyRequest
+{
+        std::string user_id;
+        std::string device_id;
+        json payload;
+};
+
+//! Megolm sessions we've already sent an m.room_key_request for,
+//! keyed by room id & session id.
+std::map<std::string, KeyRequestState> sentKeyRequests_;
+//! Session requests accumulated while a send is in flight. Paging
+//! through history without keys queues hundreds of these; packing
+//! them into one to-device call each keeps the request count low.
+std::deque<PendingKeyRequest> keyRequestQueue_;
+bool keyRequestInFlight_ = false;
+
+//! Users flagged by the sync's device-list notifications, waiting for
+//! the merged /keys/query. Accumulates while a refresh is in flight.
+std::set<std::string> pendingDeviceListUsers_;
+bool deviceListRefreshInFlight_ = false;
+
+void
+refreshDeviceLists()
+{
+        mtx::requests::QueryKeys req;
+
+        {
+                std::lock_guard<std::mutex> lock(keySchedulerMutex_);
+
+                if (deviceListRefreshInFlight_ || pendingDeviceListUsers_.empty())
+                        return;
+
+                // An empty device selection asks for all of the user's
+                // devices; every pending user shares the one request.
+                for (const auto &user : pendingDeviceListUsers_)
+                        req.device_keys[user] = {};
+                pendingDeviceListUsers_.clear();
+
+                deviceListRefreshInFlight_ = true;
+        }
+
+        http::client()->query_keys(
+          req, [](const mtx::responses::QueryKeys &res, mtx::http::RequestErr err) {
+                  {
+                          std::lock_guard<std::mutex> lock(keySchedulerMutex_);
+                          deviceListRefreshInFlight_ = false;
+                  }
+
+                  if (err) {
+                          nhlog::crypto()->warn("failed to refresh device lists: {} {}",
+                                                err->matrix_error.error,
+                                                static_cast<int>(err->status_code));
+                  } else {
+                          std::map<std::string, std::vector<std::string>> lists;
+                          for (const auto &user : res.device_keys) {
+                                  auto &devices = lists[user.first];
+                                  for (const auto &device : user.second)
+                                          devices.push_back(device.first);
+                          }
+
+                          try {
+                                  // One transaction for the whole batch; users
+                                  // whose list didn't actually change keep
+                                  // their record as is.
+                                  const auto changed =
+                                    cache::client()->updateDeviceLists(lists);
+
+                                  nhlog::crypto()->info(
+                                    "device lists refreshed: {}/{} user(s) changed",
+                                    changed.size(),
+                                    lists.size());
+                          } catch (const lmdb::error &e) {
+                                  nhlog::db()->critical("failed to save device lists: {}",
+                                                        e.what());
+                          }
+                  }
+
+                  // Users flagged while the query was in flight form the
+                  // next merged request.
+                  refreshDeviceLists();
+          });
+}
+
+void
+dispatchClaims()
+{
+        std::unique_lock<std::mutex> lock(keySchedulerMutex_);
+
+        while (activeClaims_ < MAX_CONCURRENT_CLAIMS && !claimQueue_.empty()) {
+                auto job = std::move(claimQueue_.front());
+                claimQueue_.pop_front();
+
+                // Users without available one-time keys are skipped for a
+                // while; asking again right away can't succeed.
+                auto it = exhaustedUsers_.find(job.user_id);
+                if (it != exhaustedUsers_.end()) {
+                        if (std::chrono::steady_clock::now() < it->second) {
+                                nhlog::crypto()->info(
+                                  "skipping claim for {}: no one-time keys available",
+                                  job.user_id);
+                                continue;
+                        }
+
+                        exhaustedUsers_.erase(it);
+                }
+
+                activeClaims_ += 1;
+
+                lock.unlock();
+                http::client()->claim_keys(
+                  job.user_id,
+                  job.devices,
+                  [user_id = job.user_id, callback = std::move(job.callback)](
+                    const mtx::responses::ClaimKeys &res, mtx::http::RequestErr err) {
+                          {
+                                  std::lock_guard<std::mutex> guard(keySchedulerMutex_);
+
+                                  activeClaims_ -= 1;
+
+                                  const auto keys = res.one_time_keys.find(user_id);
+                                  if (!err &&
+                                      (keys == res.one_time_keys.end() || keys->second.empty()))
+                                          exhaustedUsers_[user_id] =
+                                            std::chrono::steady_clock::now() +
+                                            EXHAUSTED_KEYS_TIMEOUT;
+                          }
+
+                          // The slot is released before the callback runs, so
+                          // a claim scheduled by the callback can't deadlock.
+                          dispatchClaims();
+
+                          callback(res, err);
+                  });
+                lock.lock();
+        }
+}
+
+void
+flushPendingKeyRequests()
+{
+        json body;
+        std::size_t packed = 0;
+
+        {
+                std::lock_guard<std::mutex> guard(keySchedulerMutex_);
+
+                if (keyRequestInFlight_ || keyRequestQueue_.empty())
+                        return;
+
+                // A device can carry only one event per to-device call, so
+                // packing stops at the first repeated recipient; the rest
+                // goes out with the next flush.
+                while (!keyRequestQueue_.empty()) {
+                        auto &req = keyRequestQueue_.front();
+
+                        if (body.count("messages") && body["messages"].count(req.user_id) &&
+                            body["messages"][req.user_id].count(req.device_id))
+                                break;
+
+                        body["messages"][req.user_id][req.device_id] = std::move(req.payload);
+                        keyRequestQueue_.pop_front();
+                        packed += 1;
+                }
+
+                keyRequestInFlight_ = true;
+        }
+
+        nhlog::crypto()->debug("sending m.room_key_request for {} session(s)", packed);
+
+        http::client()->send_to_device("m.room_key_request", body, [](mtx::http::RequestErr err) {
+                {
+                        std::lock_guard<std::mutex> guard(keySchedulerMutex_);
+                        keyRequestInFlight_ = false;
+                }
+
+                if (err)
+                        nhlog::net()->warn("failed to send "
+                                           "send_to_device "
+                                           "message: {}",
+                                           err->matrix_error.error);
+
+                flushPendingKeyRequests();
+        });
+}
 }
 
 namespace olm {
@@ -24,6 +257,63 @@ client()
         return client_.get();
 }
 
+void
+claim_keys(const std::string &user_id,
+           const std::vector<std::string> &devices,
+           std::function<void(const mtx::responses::ClaimKeys &res, mtx::http::RequestErr err)> cb)
+{
+        {
+                std::lock_guard<std::mutex> lock(keySchedulerMutex_);
+                claimQueue_.push_back({user_id, devices, std::move(cb)});
+        }
+
+        dispatchClaims();
+}
+
+void
+query_keys(const mtx::requests::QueryKeys &req,
+           std::function<void(const mtx::responses::QueryKeys &res, mtx::http::RequestErr err)> cb)
+{
+        // device_keys is ordered, so equal queries produce equal keys.
+        std::string queryKey;
+        for (const auto &user : req.device_keys) {
+                queryKey += user.first + ":";
+                for (const auto &device : user.second)
+                        queryKey += device + ",";
+                queryKey += "|";
+        }
+
+        {
+                std::lock_guard<std::mutex> lock(keySchedulerMutex_);
+
+                auto it = inflightQueries_.find(queryKey);
+                if (it != inflightQueries_.end()) {
+                        it->second.push_back(std::move(cb));
+                        return;
+                }
+
+                inflightQueries_[queryKey].push_back(std::move(cb));
+        }
+
+        http::client()->query_keys(
+          req, [queryKey](const mtx::responses::QueryKeys &res, mtx::http::RequestErr err) {
+                  std::vector<QueryCallback> callbacks;
+
+                  {
+                          std::lock_guard<std::mutex> lock(keySchedulerMutex_);
+
+                          auto it = inflightQueries_.find(queryKey);
+                          if (it != inflightQueries_.end()) {
+                                  callbacks = std::move(it->second);
+                                  inflightQueries_.erase(it);
+                          }
+                  }
+
+                  for (const auto &callback : callbacks)
+                          callback(res, err);
+          });
+}
+
 void
 handle_to_device_messages(const std::vector<nlohmann::json> &msgs)
 {
@@ -75,6 +365,20 @@ handle_to_device_messages(const std::vector<nlohmann::json> &msgs)
         }
 }
 
+void
+handle_device_list_changes(const std::vector<std::string> &changed)
+{
+        if (changed.empty())
+                return;
+
+        {
+                std::lock_guard<std::mutex> lock(keySchedulerMutex_);
+                pendingDeviceListUsers_.insert(changed.begin(), changed.end());
+        }
+
+        refreshDeviceLists();
+}
+
 void
 handle_olm_message(const OlmMessage &msg)
 {
@@ -307,33 +611,48 @@ send_key_request_for(const std::string &room_id,
 {
         using namespace mtx::events;
 
-        nhlog::crypto()->debug("sending key request: {}", json(e).dump(2));
-        auto payload = json{{"action", "request"},
-                            {"request_id", http::client()->generate_txn_id()},
-                            {"requesting_device_id", http::client()->device_id()},
-                            {"body",
-                             {{"algorithm", MEGOLM_ALGO},
-                              {"room_id", room_id},
-                              {"sender_key", e.content.sender_key},
-                              {"session_id", e.content.session_id}}}};
-
-        json body;
-        body["messages"][e.sender]                      = json::object();
-        body["messages"][e.sender][e.content.device_id] = payload;
+        // Devices answer a given request at most once; sending it again for
+        // every undecryptable event of the same session floods the server.
+        const auto requestKey = room_id + ":" + e.content.session_id;
+        {
+                std::lock_guard<std::mutex> lock(keySchedulerMutex_);
 
-        nhlog::crypto()->debug("m.room_key_request: {}", body.dump(2));
+                const auto now = std::chrono::steady_clock::now();
 
-        http::client()->send_to_device("m.room_key_request", body, [e](mtx::http::RequestErr err) {
-                if (err) {
-                        nhlog::net()->warn("failed to send "
-                                           "send_to_device "
-                                           "message: {}",
-                                           err->matrix_error.error);
+                auto &state = sentKeyRequests_[requestKey];
+                if (state.attempts > 0 && now < state.nextAttempt) {
+                        nhlog::crypto()->debug("already requested keys for session {} in {}",
+                                               e.content.session_id,
+                                               room_id);
+                        return;
                 }
 
-                nhlog::net()->info(
-                  "m.room_key_request sent to {}:{}", e.sender, e.content.device_id);
-        });
+                auto backoff = KEY_REQUEST_RETRY_BASE * (1 << std::min(state.attempts, 6));
+                if (backoff > KEY_REQUEST_RETRY_MAX)
+                        backoff = KEY_REQUEST_RETRY_MAX;
+
+                state.attempts += 1;
+                state.nextAttempt = now + backoff;
+
+                auto payload = json{{"action", "request"},
+                                    {"request_id", http::client()->generate_txn_id()},
+                                    {"requesting_device_id", http::client()->device_id()},
+                                    {"body",
+                                     {{"algorithm", MEGOLM_ALGO},
+                                      {"room_id", room_id},
+                                      {"sender_key", e.content.sender_key},
+                                      {"session_id", e.content.session_id}}}};
+
+                nhlog::crypto()->debug(
+                  "queueing key request for session {} in {} (attempt {})",
+                  e.content.session_id,
+                  room_id,
+                  state.attempts);
+
+                keyRequestQueue_.push_back({e.sender, e.content.device_id, std::move(payload)});
+        }
+
+        flushPendingKeyRequests();
 }
 
 void
@@ -404,7 +723,7 @@ send_megolm_key_to_device(const std::string &user_id,
         mtx::requests::QueryKeys req;
         req.device_keys[user_id] = {device_id};
 
-        http::client()->query_keys(
+        olm::query_keys(
           req,
           [payload, user_id, device_id](const mtx::responses::QueryKeys &res,
                                         mtx::http::RequestErr err) {
@@ -462,7 +781,7 @@ send_megolm_key_to_device(const std::string &user_id,
                                     ->create_room_key_event(UserId(user_id), pks.ed25519, payload)
                                     .dump();
 
-                  http::client()->claim_keys(
+                  olm::claim_keys(
                     user_id,
                     {device_id},
                     [room_key, user_id, device_id, pks](const mtx::responses::ClaimKeys &res,
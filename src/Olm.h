@@ -2,9 +2,11 @@
 
 #include <boost/optional.hpp>
 
+#include <functional>
 #include <memory>
 #include <mtx.hpp>
 #include <mtxclient/crypto/client.hpp>
+#include <mtxclient/http/client.hpp>
 
 constexpr auto OLM_ALGO = "m.olm.v1.curve25519-aes-sha2";
 
@@ -38,9 +40,30 @@ from_json(const nlohmann::json &obj, OlmMessage &msg)
 mtx::crypto::OlmClient *
 client();
 
+//! Claim one-time keys for a user's devices. Claims are dispatched with
+//! bounded concurrency and users that recently had no one-time keys
+//! available are skipped for a while instead of being asked again.
+void
+claim_keys(const std::string &user_id,
+           const std::vector<std::string> &devices,
+           std::function<void(const mtx::responses::ClaimKeys &res, mtx::http::RequestErr err)> cb);
+
+//! Query device keys, coalescing identical queries that are already in
+//! flight into a single request.
+void
+query_keys(const mtx::requests::QueryKeys &req,
+           std::function<void(const mtx::responses::QueryKeys &res, mtx::http::RequestErr err)> cb);
+
 void
 handle_to_device_messages(const std::vector<nlohmann::json> &msgs);
 
+//! Refresh the device lists of the users flagged by a sync. The users
+//! are merged into a single /keys/query — users flagged while one is
+//! in flight form the next batch — and the results are applied through
+//! the cache's batched, diff-aware update.
+void
+handle_device_list_changes(const std::vector<std::string> &changed);
+
 nlohmann::json
 try_olm_decryption(const std::string &sender_key,
                    const mtx::events::msg::OlmCipherContent &content);
@@ -71,6 +94,9 @@ mark_keys_as_published();
 void
 request_keys(const std::string &room_id, const std::string &event_id);
 
+//! Ask the sending device for the megolm session of an undecryptable
+//! event. Requests are deduplicated per session with an escalating
+//! retry delay and batched into as few to-device calls as possible.
 void
 send_key_request_for(const std::string &room_id,
                      const mtx::events::EncryptedEvent<mtx::events::msg::Encrypted> &);
@@ -0,0 +1,689 @@
+/*
+ * nheko Copyright (C) 2017  Konstantinos Sideris <siderisk@auth.gr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QAbstractEventDispatcher>
+#include <QApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QPainter>
+#include <QStandardPaths>
+#include <QThread>
+#include <QTimer>
+#include <QWidget>
+
+#include <json.hpp>
+
+#include "Logging.h"
+#include "Perf.h"
+#include "version.h"
+
+using json = nlohmann::json;
+
+namespace perf {
+
+//! Interval of the frame probe. Timeouts that arrive late indicate
+//! that the GUI thread was blocked.
+constexpr int FRAME_INTERVAL = 16;
+//! Recording stops after this many spans, so a long session can't eat
+//! all the memory.
+constexpr std::size_t MAX_SPANS = 200'000;
+
+struct TraceSpan
+{
+        const char *name;
+        std::string detail;
+        //! Microseconds, relative to the start of the recording.
+        int64_t ts;
+        int64_t duration;
+        uint64_t thread;
+};
+
+static std::mutex spansMutex_;
+static std::vector<TraceSpan> spans_;
+static std::size_t droppedSpans_ = 0;
+
+//! Latest duration per span name, displayed by the overlay.
+static QHash<QString, double> latest_;
+
+//! Frame statistics over the last second.
+static double frameAvg_ = 0;
+static double frameMax_ = 0;
+
+static std::chrono::steady_clock::time_point origin_;
+
+bool
+isEnabled()
+{
+        static const bool enabled = (qgetenv("NHEKO_PERF") == "1");
+        return enabled;
+}
+
+void
+record(const char *name,
+       std::chrono::steady_clock::time_point start,
+       std::chrono::steady_clock::time_point end,
+       const std::string &detail)
+{
+        if (!isEnabled())
+                return;
+
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+
+        const auto hasher = std::hash<std::thread::id>();
+
+        TraceSpan span;
+        span.name     = name;
+        span.detail   = detail;
+        span.ts       = duration_cast<microseconds>(start - origin_).count();
+        span.duration = duration_cast<microseconds>(end - start).count();
+        span.thread   = hasher(std::this_thread::get_id());
+
+        std::lock_guard<std::mutex> lock(spansMutex_);
+
+        if (spans_.size() >= MAX_SPANS) {
+                droppedSpans_ += 1;
+                return;
+        }
+
+        latest_[QString::fromUtf8(name)] = span.duration / 1000.0;
+        spans_.push_back(std::move(span));
+}
+
+QString
+exportTrace()
+{
+        const auto path = QString("%1/nheko-trace.json")
+                            .arg(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
+
+        json trace;
+        trace["traceEvents"] = json::array();
+
+        {
+                std::lock_guard<std::mutex> lock(spansMutex_);
+
+                for (const auto &span : spans_) {
+                        json ev;
+                        ev["name"] = span.name;
+                        ev["ph"]   = "X";
+                        ev["ts"]   = span.ts;
+                        ev["dur"]  = span.duration;
+                        ev["pid"]  = 1;
+                        ev["tid"]  = span.thread;
+
+                        if (!span.detail.empty())
+                                ev["args"]["detail"] = span.detail;
+
+                        trace["traceEvents"].push_back(std::move(ev));
+                }
+
+                if (droppedSpans_ > 0)
+                        trace["otherData"]["dropped_spans"] = droppedSpans_;
+        }
+
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+                nhlog::ui()->warn("failed to write trace file: {}", path.toStdString());
+                return QString();
+        }
+
+        const auto dump = trace.dump();
+        file.write(dump.data(), dump.size());
+
+        return path;
+}
+
+//
+// Per-room ingest accounting
+//
+
+//! Rooms listed in the slow-room report.
+constexpr std::size_t ROOM_REPORT_SIZE = 10;
+
+struct RoomStats
+{
+        uint64_t events = 0;
+        //! Microseconds per ingest stage.
+        int64_t saveState = 0;
+        int64_t decrypt   = 0;
+        int64_t render    = 0;
+
+        int64_t total() const { return saveState + decrypt + render; }
+};
+
+static std::mutex roomStatsMutex_;
+static std::map<std::string, RoomStats> roomStats_;
+
+void
+accountRoomEvents(const std::string &room_id, std::size_t events)
+{
+        if (events == 0)
+                return;
+
+        std::lock_guard<std::mutex> lock(roomStatsMutex_);
+        roomStats_[room_id].events += events;
+}
+
+void
+accountRoomTime(const std::string &room_id,
+                RoomMetric metric,
+                std::chrono::steady_clock::duration elapsed)
+{
+        const auto us =
+          std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+
+        std::lock_guard<std::mutex> lock(roomStatsMutex_);
+
+        auto &stats = roomStats_[room_id];
+        switch (metric) {
+        case RoomMetric::SaveState:
+                stats.saveState += us;
+                break;
+        case RoomMetric::Decrypt:
+                stats.decrypt += us;
+                break;
+        case RoomMetric::Render:
+                stats.render += us;
+                break;
+        }
+}
+
+void
+logRoomDiagnostics()
+{
+        std::vector<std::pair<std::string, RoomStats>> rooms;
+        {
+                std::lock_guard<std::mutex> lock(roomStatsMutex_);
+                rooms.assign(roomStats_.begin(), roomStats_.end());
+        }
+
+        int64_t grandTotal = 0;
+        for (const auto &room : rooms)
+                grandTotal += room.second.total();
+
+        if (grandTotal == 0)
+                return;
+
+        std::sort(rooms.begin(), rooms.end(), [](const auto &a, const auto &b) {
+                return a.second.total() > b.second.total();
+        });
+
+        nhlog::ui()->info("per-room ingest cost, top {} of {}:",
+                          std::min(ROOM_REPORT_SIZE, rooms.size()),
+                          rooms.size());
+
+        for (std::size_t i = 0; i < rooms.size() && i < ROOM_REPORT_SIZE; i++) {
+                const auto &stats = rooms.at(i).second;
+
+                nhlog::ui()->info(
+                  "  {:<40} {:>6} events save={}ms decrypt={}ms render={}ms ({}%)",
+                  rooms.at(i).first,
+                  stats.events,
+                  stats.saveState / 1000,
+                  stats.decrypt / 1000,
+                  stats.render / 1000,
+                  stats.total() * 100 / grandTotal);
+        }
+}
+
+//
+// Sampled cache statistics
+//
+
+//! Default sampling rate: one in every N calls is counted.
+constexpr int CACHE_SAMPLE_DEFAULT = 16;
+//! Local samples accumulated before a merge into the global totals.
+constexpr uint32_t CACHE_FLUSH_THRESHOLD = 1024;
+
+static int
+cacheSampleRate()
+{
+        static const int rate = [] {
+                bool ok         = false;
+                const int value = qgetenv("NHEKO_CACHE_SAMPLE").toInt(&ok);
+
+                return ok ? value : CACHE_SAMPLE_DEFAULT;
+        }();
+
+        return rate;
+}
+
+//! Per-thread counters; saturating, so a runaway path can't wrap into
+//! nonsense between merges.
+struct LocalCacheStats
+{
+        uint32_t ops[4] = {0, 0, 0, 0};
+        uint32_t txns   = 0;
+        uint64_t txnUs  = 0;
+        //! Samples since the last merge.
+        uint32_t samples = 0;
+        //! Position on the sampling grid.
+        uint32_t tick = 0;
+};
+
+static thread_local LocalCacheStats localCache_;
+
+//! Global totals, in sample units; scaled by the rate on read.
+static std::atomic<uint64_t> cacheOps_[4];
+static std::atomic<uint64_t> cacheTxns_{0};
+static std::atomic<uint64_t> cacheTxnUs_{0};
+
+static void
+flushLocalCacheStats()
+{
+        auto &local = localCache_;
+
+        for (int i = 0; i < 4; i++) {
+                cacheOps_[i].fetch_add(local.ops[i], std::memory_order_relaxed);
+                local.ops[i] = 0;
+        }
+
+        cacheTxns_.fetch_add(local.txns, std::memory_order_relaxed);
+        cacheTxnUs_.fetch_add(local.txnUs, std::memory_order_relaxed);
+
+        local.txns    = 0;
+        local.txnUs   = 0;
+        local.samples = 0;
+}
+
+bool
+sampleCacheCall()
+{
+        const auto rate = cacheSampleRate();
+        if (rate <= 0)
+                return false;
+
+        auto &local = localCache_;
+        if (local.tick++ % static_cast<uint32_t>(rate) != 0)
+                return false;
+
+        if (++local.samples >= CACHE_FLUSH_THRESHOLD)
+                flushLocalCacheStats();
+
+        return true;
+}
+
+void
+accountCacheOp(CacheOp op)
+{
+        if (!sampleCacheCall())
+                return;
+
+        auto &counter = localCache_.ops[static_cast<int>(op)];
+        if (counter != std::numeric_limits<uint32_t>::max())
+                counter += 1;
+}
+
+void
+accountCacheTxn(std::chrono::steady_clock::duration elapsed)
+{
+        auto &local = localCache_;
+
+        if (local.txns != std::numeric_limits<uint32_t>::max())
+                local.txns += 1;
+
+        local.txnUs += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+
+CacheStats
+cacheStats()
+{
+        // Merge what this thread accumulated; the other threads'
+        // residues stay below the flush threshold and are negligible.
+        flushLocalCacheStats();
+
+        const auto rate = static_cast<uint64_t>(std::max(cacheSampleRate(), 1));
+
+        CacheStats stats;
+        stats.imageHits      = cacheOps_[0].load(std::memory_order_relaxed) * rate;
+        stats.imageMisses    = cacheOps_[1].load(std::memory_order_relaxed) * rate;
+        stats.roomInfoHits   = cacheOps_[2].load(std::memory_order_relaxed) * rate;
+        stats.roomInfoMisses = cacheOps_[3].load(std::memory_order_relaxed) * rate;
+        stats.txnCount       = cacheTxns_.load(std::memory_order_relaxed) * rate;
+        stats.txnTotalUs     = cacheTxnUs_.load(std::memory_order_relaxed) * rate;
+
+        return stats;
+}
+
+//
+// GUI-thread stall watchdog
+//
+
+//! An event-loop iteration that blocks longer than this is reported.
+constexpr int64_t STALL_THRESHOLD_MS = 200;
+//! Polling interval of the watchdog thread.
+constexpr int WATCHDOG_INTERVAL_MS = 50;
+
+//! Innermost span running on the GUI thread, sampled by the watchdog
+//! to attribute a stall to a subsystem.
+static std::atomic<const char *> guiActiveSpan_{nullptr};
+//! Id of the GUI thread, so span tagging ignores the workers.
+static std::atomic<Qt::HANDLE> guiThread_{nullptr};
+//! Microsecond timestamp of the GUI event loop's last activity.
+static std::atomic<int64_t> lastHeartbeat_{0};
+//! Whether the GUI thread is blocked waiting for new events, which
+//! looks like a missing heartbeat but isn't a stall.
+static std::atomic<bool> guiIdle_{false};
+static std::atomic<bool> watchdogRunning_{false};
+static std::thread watchdog_;
+
+static int64_t
+nowUs()
+{
+        using namespace std::chrono;
+        return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+const char *
+beginSpan(const char *name)
+{
+        if (QThread::currentThreadId() != guiThread_.load(std::memory_order_relaxed))
+                return nullptr;
+
+        return guiActiveSpan_.exchange(name, std::memory_order_relaxed);
+}
+
+void
+endSpan(const char *previous)
+{
+        if (QThread::currentThreadId() == guiThread_.load(std::memory_order_relaxed))
+                guiActiveSpan_.store(previous, std::memory_order_relaxed);
+}
+
+static void
+startWatchdog()
+{
+        guiThread_.store(QThread::currentThreadId());
+        lastHeartbeat_.store(nowUs());
+
+        // The dispatcher's activity doubles as a heartbeat: while an
+        // iteration blocks the GUI thread neither signal fires.
+        auto dispatcher = QAbstractEventDispatcher::instance();
+        QObject::connect(dispatcher, &QAbstractEventDispatcher::awake, []() {
+                guiIdle_.store(false, std::memory_order_relaxed);
+                lastHeartbeat_.store(nowUs(), std::memory_order_relaxed);
+        });
+        QObject::connect(dispatcher, &QAbstractEventDispatcher::aboutToBlock, []() {
+                guiIdle_.store(true, std::memory_order_relaxed);
+                lastHeartbeat_.store(nowUs(), std::memory_order_relaxed);
+        });
+
+        watchdogRunning_ = true;
+        watchdog_        = std::thread([]() {
+                int64_t stallStart      = 0;
+                const char *stalledSpan = nullptr;
+
+                while (watchdogRunning_) {
+                        std::this_thread::sleep_for(
+                          std::chrono::milliseconds(WATCHDOG_INTERVAL_MS));
+
+                        const auto heartbeat = lastHeartbeat_.load(std::memory_order_relaxed);
+
+                        if (stallStart == 0) {
+                                if (guiIdle_.load(std::memory_order_relaxed) ||
+                                    (nowUs() - heartbeat) / 1000 < STALL_THRESHOLD_MS)
+                                        continue;
+
+                                // Sample the operation while the thread is
+                                // still inside the stalled iteration.
+                                stallStart  = heartbeat;
+                                stalledSpan = guiActiveSpan_.load(std::memory_order_relaxed);
+                        } else if (heartbeat != stallStart) {
+                                // The event loop is running again; report
+                                // how long it was gone and what it ran.
+                                const auto duration = (heartbeat - stallStart) / 1000;
+
+                                nhlog::ui()->warn("gui stall: duration={}ms operation={}",
+                                                  duration,
+                                                  stalledSpan ? stalledSpan : "unknown");
+
+                                stallStart  = 0;
+                                stalledSpan = nullptr;
+                        }
+                }
+        });
+
+        QObject::connect(qApp, &QApplication::aboutToQuit, []() {
+                watchdogRunning_ = false;
+
+                if (watchdog_.joinable())
+                        watchdog_.join();
+        });
+}
+
+//! Launches kept in the on-disk startup history.
+constexpr std::size_t STARTUP_HISTORY_SIZE = 10;
+
+//! Taken during static initialization, so the phase timestamps
+//! approximate time since process start.
+static const std::chrono::steady_clock::time_point processStart_ =
+  std::chrono::steady_clock::now();
+
+static std::mutex startupMutex_;
+//! Phase boundaries of this launch: name -> ms since process start.
+static std::vector<std::pair<const char *, int64_t>> startupPhases_;
+static bool startupFinished_ = false;
+
+static QString
+startupHistoryPath()
+{
+        return QString("%1/startup-history.json")
+          .arg(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
+}
+
+void
+startupPhase(const char *name)
+{
+        const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now() - processStart_)
+                          .count();
+
+        std::lock_guard<std::mutex> lock(startupMutex_);
+
+        if (!startupFinished_)
+                startupPhases_.emplace_back(name, ms);
+}
+
+void
+finishStartup()
+{
+        std::lock_guard<std::mutex> lock(startupMutex_);
+
+        if (startupFinished_)
+                return;
+        startupFinished_ = true;
+
+        // The boundaries become per-phase durations.
+        json launch;
+        launch["date"]    = QDateTime::currentDateTime().toString(Qt::ISODate).toStdString();
+        launch["version"] = nheko::version;
+        launch["phases"]  = json::object();
+
+        int64_t previousBoundary = 0;
+        for (const auto &phase : startupPhases_) {
+                launch["phases"][phase.first] = phase.second - previousBoundary;
+                previousBoundary              = phase.second;
+        }
+        launch["total"] = previousBoundary;
+
+        json history = json::array();
+
+        QFile file(startupHistoryPath());
+        if (file.open(QIODevice::ReadOnly)) {
+                try {
+                        history = json::parse(file.readAll().toStdString());
+                } catch (const json::exception &) {
+                        // A corrupted history is simply restarted.
+                        history = json::array();
+                }
+                file.close();
+        }
+
+        if (!history.is_array())
+                history = json::array();
+
+        // The previous launch, for the regression comparison below.
+        json previousPhases = json::object();
+        if (!history.empty() && history.back().is_object())
+                previousPhases = history.back().value("phases", json::object());
+
+        history.push_back(launch);
+        while (history.size() > STARTUP_HISTORY_SIZE)
+                history.erase(history.begin());
+
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+                const auto dump = history.dump();
+                file.write(dump.data(), dump.size());
+                file.close();
+        } else {
+                nhlog::ui()->warn("failed to write startup history: {}",
+                                  startupHistoryPath().toStdString());
+        }
+
+        for (const auto &phase : startupPhases_) {
+                const int64_t current = launch["phases"][phase.first];
+
+                if (previousPhases.count(phase.first))
+                        nhlog::ui()->info("startup: {:<16} {:>5}ms (prev {}ms)",
+                                          phase.first,
+                                          current,
+                                          previousPhases[phase.first].get<int64_t>());
+                else
+                        nhlog::ui()->info("startup: {:<16} {:>5}ms", phase.first, current);
+        }
+
+        nhlog::ui()->info("startup: total {}ms", previousBoundary);
+}
+
+//! Frameless always-on-top window with the latest measurements.
+class Overlay : public QWidget
+{
+public:
+        Overlay()
+          : QWidget{nullptr,
+                    Qt::Tool | Qt::FramelessWindowHint | Qt::WindowStaysOnTopHint |
+                      Qt::WindowDoesNotAcceptFocus}
+        {
+                setAttribute(Qt::WA_ShowWithoutActivating);
+                setFixedSize(260, 140);
+
+                auto refresher = new QTimer(this);
+                refresher->setInterval(500);
+                connect(refresher, &QTimer::timeout, this, [this]() { update(); });
+                refresher->start();
+        }
+
+protected:
+        void paintEvent(QPaintEvent *) override
+        {
+                QPainter p(this);
+                p.fillRect(rect(), QColor(0, 0, 0, 180));
+                p.setPen(Qt::white);
+
+                QStringList lines;
+                lines << QString("frame avg %1 ms  max %2 ms")
+                           .arg(frameAvg_, 0, 'f', 1)
+                           .arg(frameMax_, 0, 'f', 1);
+
+                {
+                        std::lock_guard<std::mutex> lock(spansMutex_);
+                        for (auto it = latest_.constBegin(); it != latest_.constEnd(); ++it)
+                                lines << QString("%1 %2 ms").arg(it.key()).arg(it.value(), 0, 'f', 1);
+                }
+
+                int y = 14;
+                for (const auto &line : lines) {
+                        p.drawText(8, y, line);
+                        y += 14;
+                }
+        }
+};
+
+void
+init()
+{
+        // The watchdog is always on: jank reports have to come from
+        // regular sessions, not only from runs started with NHEKO_PERF=1.
+        startWatchdog();
+
+        // Same for the room counters; their report closes the session.
+        QObject::connect(qApp, &QApplication::aboutToQuit, []() { logRoomDiagnostics(); });
+
+        if (!isEnabled())
+                return;
+
+        origin_ = std::chrono::steady_clock::now();
+
+        // The probe measures the gap between consecutive timeouts; the
+        // amount it arrives late by is time the GUI thread spent blocked.
+        auto probe = new QTimer(qApp);
+        probe->setInterval(FRAME_INTERVAL);
+
+        auto lastFire = std::make_shared<std::chrono::steady_clock::time_point>(
+          std::chrono::steady_clock::now());
+        auto window = std::make_shared<std::vector<double>>();
+
+        QObject::connect(probe, &QTimer::timeout, qApp, [lastFire, window]() {
+                const auto now = std::chrono::steady_clock::now();
+                const auto frame =
+                  std::chrono::duration_cast<std::chrono::microseconds>(now - *lastFire);
+                *lastFire = now;
+
+                record("gui.frame", now - frame, now);
+
+                window->push_back(frame.count() / 1000.0);
+
+                // Refresh the aggregates roughly once a second.
+                if (window->size() * FRAME_INTERVAL >= 1000) {
+                        double sum = 0;
+                        double max = 0;
+                        for (const auto f : *window) {
+                                sum += f;
+                                max = std::max(max, f);
+                        }
+
+                        frameAvg_ = sum / window->size();
+                        frameMax_ = max;
+
+                        window->clear();
+                }
+        });
+        probe->start();
+
+        auto overlay = new Overlay();
+        overlay->show();
+
+        QObject::connect(qApp, &QApplication::aboutToQuit, [overlay]() {
+                overlay->deleteLater();
+
+                const auto path = exportTrace();
+                if (!path.isEmpty())
+                        nhlog::ui()->info("trace written to {}", path.toStdString());
+        });
+
+        nhlog::ui()->info("performance instrumentation enabled");
+}
+}
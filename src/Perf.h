@@ -0,0 +1,215 @@
+/*
+ * nheko Copyright (C) 2017  Konstantinos Sideris <siderisk@auth.gr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <QString>
+
+//! Opt-in instrumentation for "nheko feels slow" reports.
+//!
+//! Enabled by starting the client with NHEKO_PERF=1. It records named
+//! spans from any thread, measures the frame times of the GUI thread
+//! and shows a small overlay with the latest numbers. On exit the
+//! recorded spans are written as a chrome://tracing file that can be
+//! attached to a ticket.
+//!
+//! Independently of NHEKO_PERF, a watchdog thread observes the GUI
+//! event loop and logs a report for every iteration that blocks longer
+//! than a threshold, tagged with the span that was running.
+//!
+//! Launch time is always profiled: the startup code marks its phases
+//! and the resulting timings are kept for the last few launches, so a
+//! "startup got slower after the update" report can be pinned to the
+//! phase that regressed.
+namespace perf {
+
+//! Whether the client was started with NHEKO_PERF=1.
+bool
+isEnabled();
+
+//! Start the frame probe & the overlay and export the recorded trace
+//! when the application quits. Called once after QApplication is up.
+//! Also starts the GUI-thread stall watchdog, which is always on.
+void
+init();
+
+//! Record the completion of a startup phase, measured from process
+//! start. Safe to call from any thread.
+void
+startupPhase(const char *name);
+
+//! Close the startup recording: append the phase timings of this
+//! launch to the on-disk history of the previous ones and log a
+//! phase-by-phase comparison. Only the first call has an effect.
+void
+finishStartup();
+
+//! Mark a span as the active operation of the GUI thread, sampled by
+//! the stall watchdog to attribute a freeze to a subsystem. Returns
+//! the previously active span so nesting unwinds correctly; a no-op
+//! on worker threads.
+const char *
+beginSpan(const char *name);
+//! Restore the span returned by the matching beginSpan call.
+void
+endSpan(const char *previous);
+
+//! Record a completed span. Safe to call from any thread.
+void
+record(const char *name,
+       std::chrono::steady_clock::time_point start,
+       std::chrono::steady_clock::time_point end,
+       const std::string &detail = std::string());
+
+//! Write the recorded spans as a chrome://tracing JSON file.
+//! Returns the path of the written file or an empty string on failure.
+QString
+exportTrace();
+
+//! Stages of event ingestion that are accounted per room. Unlike the
+//! span recording these counters are always on: a bridged firehose
+//! that eats the sync budget has to show up in regular sessions.
+enum class RoomMetric
+{
+        //! Serializing & writing the room's sync batches.
+        SaveState,
+        //! Megolm decryption of the room's events.
+        Decrypt,
+        //! Building & laying out the room's timeline widgets.
+        Render,
+};
+
+//! Add ingested events to a room's counters. Safe to call from any
+//! thread.
+void
+accountRoomEvents(const std::string &room_id, std::size_t events);
+
+//! Charge the duration of an operation to a room.
+void
+accountRoomTime(const std::string &room_id,
+                RoomMetric metric,
+                std::chrono::steady_clock::duration elapsed);
+
+//! Log the rooms that consumed the most ingest time, with a per-stage
+//! breakdown and their share of the total. Written on exit.
+void
+logRoomDiagnostics();
+
+//! Storage-layer statistics cheap enough to stay on in production:
+//! only every Nth call is counted, into thread-local saturating
+//! counters that are merged into the global totals once enough samples
+//! accumulate. NHEKO_CACHE_SAMPLE sets N (default 16, 0 disables).
+enum class CacheOp
+{
+        ImageHit,
+        ImageMiss,
+        RoomInfoHit,
+        RoomInfoMiss,
+};
+
+//! Count a cache operation, subject to sampling. Any thread.
+void
+accountCacheOp(CacheOp op);
+
+//! Whether this call falls on the sampling grid; advances the
+//! per-thread tick. Lets a latency measurement skip even the clock
+//! reads on the calls that aren't sampled.
+bool
+sampleCacheCall();
+
+//! Charge the latency of a sampled read transaction. Any thread.
+void
+accountCacheTxn(std::chrono::steady_clock::duration elapsed);
+
+//! Totals merged from all threads, scaled back up by the sampling
+//! rate. txnTotalUs / txnCount approximates the mean latency.
+struct CacheStats
+{
+        std::uint64_t imageHits      = 0;
+        std::uint64_t imageMisses    = 0;
+        std::uint64_t roomInfoHits   = 0;
+        std::uint64_t roomInfoMisses = 0;
+        std::uint64_t txnCount       = 0;
+        std::uint64_t txnTotalUs     = 0;
+};
+
+//! Snapshot of the cumulative statistics.
+CacheStats
+cacheStats();
+
+//! Charges the lifetime of a scope to a room's counters.
+class RoomSpan
+{
+public:
+        RoomSpan(const std::string &room_id, RoomMetric metric)
+          : room_id_{room_id}
+          , metric_{metric}
+          , start_{std::chrono::steady_clock::now()}
+        {}
+
+        ~RoomSpan()
+        {
+                accountRoomTime(room_id_, metric_, std::chrono::steady_clock::now() - start_);
+        }
+
+        RoomSpan(const RoomSpan &) = delete;
+        RoomSpan &operator=(const RoomSpan &) = delete;
+
+private:
+        std::string room_id_;
+        RoomMetric metric_;
+        std::chrono::steady_clock::time_point start_;
+};
+
+//! Measures the lifetime of a scope. The span is dropped entirely when
+//! the instrumentation is disabled.
+class Span
+{
+public:
+        Span(const char *name, const std::string &detail = std::string())
+          : name_{name}
+          , detail_{detail}
+        {
+                if (isEnabled())
+                        start_ = std::chrono::steady_clock::now();
+
+                previous_ = beginSpan(name);
+        }
+
+        ~Span()
+        {
+                if (isEnabled())
+                        record(name_, start_, std::chrono::steady_clock::now(), detail_);
+
+                endSpan(previous_);
+        }
+
+        Span(const Span &) = delete;
+        Span &operator=(const Span &) = delete;
+
+private:
+        const char *name_;
+        std::string detail_;
+        std::chrono::steady_clock::time_point start_;
+        //! Span that was active on the GUI thread when this one started.
+        const char *previous_ = nullptr;
+};
+}
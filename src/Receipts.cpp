@@ -0,0 +1,122 @@
+/*
+ * nheko Copyright (C) 2017  Konstantinos Sideris <siderisk@auth.gr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <utility>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QHash>
+#include <QTimer>
+
+#include "Cache.h"
+#include "Logging.h"
+#include "MatrixClient.h"
+#include "Receipts.h"
+
+namespace {
+constexpr int FLUSH_INTERVAL_MS = 1000;
+
+//! Newest visible event per room since the last flush.
+QHash<QString, QString> pendingMarkers_;
+//! The marker each room last sent, so re-activating a window doesn't
+//! repeat a request the server has already seen.
+QHash<QString, QString> sentMarkers_;
+//! Own messages awaiting read receipts, queued for one cache write.
+std::vector<std::pair<QString, QString>> pendingReceipts_;
+
+QTimer *
+flushTimer()
+{
+        // Owned by the application object, so it is destroyed together
+        // with the event loop it depends on.
+        static QTimer *instance = nullptr;
+
+        if (instance == nullptr) {
+                instance = new QTimer(QCoreApplication::instance());
+                instance->setSingleShot(true);
+                instance->setInterval(FLUSH_INTERVAL_MS);
+                QObject::connect(instance, &QTimer::timeout, []() { receipts::flush(); });
+
+                // Whatever is still queued when the user quits goes out
+                // with the process.
+                QObject::connect(QCoreApplication::instance(),
+                                 &QCoreApplication::aboutToQuit,
+                                 []() { receipts::flush(); });
+        }
+
+        return instance;
+}
+
+void
+scheduleFlush()
+{
+        if (!flushTimer()->isActive())
+                flushTimer()->start();
+}
+}
+
+void
+receipts::markVisible(const QString &room_id, const QString &event_id)
+{
+        if (event_id.isEmpty())
+                return;
+
+        if (sentMarkers_.value(room_id) == event_id)
+                return;
+
+        pendingMarkers_[room_id] = event_id;
+
+        scheduleFlush();
+}
+
+void
+receipts::queuePendingReceipt(const QString &room_id, const QString &event_id)
+{
+        pendingReceipts_.emplace_back(room_id, event_id);
+
+        scheduleFlush();
+}
+
+void
+receipts::flush()
+{
+        if (!pendingReceipts_.empty()) {
+                try {
+                        cache::client()->addPendingReceipts(pendingReceipts_);
+                } catch (const lmdb::error &e) {
+                        nhlog::db()->critical("failed to save pending receipts: {}", e.what());
+                }
+
+                pendingReceipts_.clear();
+        }
+
+        for (auto it = pendingMarkers_.cbegin(); it != pendingMarkers_.cend(); ++it) {
+                const auto room_id  = it.key().toStdString();
+                const auto event_id = it.value().toStdString();
+
+                sentMarkers_[it.key()] = it.value();
+
+                http::client()->read_event(
+                  room_id, event_id, [room_id, event_id](mtx::http::RequestErr err) {
+                          if (err)
+                                  nhlog::net()->warn(
+                                    "failed to send read marker ({}, {})", room_id, event_id);
+                  });
+        }
+
+        pendingMarkers_.clear();
+}
@@ -0,0 +1,48 @@
+/*
+ * nheko Copyright (C) 2017  Konstantinos Sideris <siderisk@auth.gr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QString>
+
+//! Batching for the read-marker traffic of active reading.
+//!
+//! Scrolling through a busy room produces a stream of marker
+//! candidates: every rendered batch, window activation and delivered
+//! own message used to issue its own request and storage write. The
+//! module instead tracks only the newest visible event per room and
+//! flushes at most once per second — one network call per room and one
+//! cache write for all queued receipts per flush. All functions must be
+//! called from the GUI thread.
+namespace receipts {
+
+//! Record the newest visible event of a room. The marker goes out with
+//! the next flush, unless a newer event replaces it first; a marker the
+//! server has already seen is not repeated.
+void
+markVisible(const QString &room_id, const QString &event_id);
+
+//! Queue an own message for the pending-receipts store, which feeds the
+//! read indicators of sent messages.
+void
+queuePendingReceipt(const QString &room_id, const QString &event_id);
+
+//! Send the queued markers & persist the queued receipts now. Runs on
+//! the flush timer and right before the application quits.
+void
+flush();
+}
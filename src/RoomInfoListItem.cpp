@@ -32,14 +32,14 @@
 constexpr int MaxUnreadCountDisplayed = 99;
 
 constexpr int Padding   = 9;
-constexpr int IconSize  = 44;
+constexpr int IconSize  = RoomInfoListItem::IconSize;
 constexpr int MaxHeight = IconSize + 2 * Padding;
 
 constexpr int InviteBtnX = IconSize + 2 * Padding;
 constexpr int InviteBtnY = IconSize / 2 + Padding + Padding / 3;
 
 void
-RoomInfoListItem::init(QWidget *parent)
+RoomInfoListItem::init()
 {
         setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
         setMouseTracking(true);
@@ -47,12 +47,9 @@ RoomInfoListItem::init(QWidget *parent)
 
         setFixedHeight(MaxHeight);
 
-        QPainterPath path;
-        path.addRect(0, 0, parent->width(), height());
-
-        ripple_overlay_ = new RippleOverlay(this);
-        ripple_overlay_->setClipPath(path);
-        ripple_overlay_->setClipping(true);
+        // The ripple overlay & the context menu are created on demand;
+        // an account with hundreds of rooms interacts with only a few of
+        // the rows.
 
         font_.setPixelSize(conf::fontSize - 1);
 
@@ -72,22 +69,20 @@ RoomInfoListItem::init(QWidget *parent)
         headingFont_ = font_;
         headingFont_.setPixelSize(conf::roomlist::fonts::heading);
         headingFont_.setWeight(60);
-
-        menu_      = new Menu(this);
-        leaveRoom_ = new QAction(tr("Leave room"), this);
-        connect(leaveRoom_, &QAction::triggered, this, [this]() { emit leaveRoom(roomId_); });
-        menu_->addAction(leaveRoom_);
 }
 
-RoomInfoListItem::RoomInfoListItem(QString room_id, RoomInfo info, QWidget *parent)
+RoomInfoListItem::RoomInfoListItem(QString room_id, const RoomInfo &info, QWidget *parent)
   : QWidget(parent)
   , roomType_{info.is_invite ? RoomType::Invited : RoomType::Joined}
   , roomId_(std::move(room_id))
-  , roomName_{QString::fromStdString(std::move(info.name))}
+  , roomName_{QString::fromStdString(info.name)}
+  , roomTopic_{QString::fromStdString(info.topic)}
   , isPressed_(false)
-  , unreadMsgCount_(0)
+  , unreadMsgCount_(info.notification_count)
 {
-        init(parent);
+        avatarUrl_ = QString::fromStdString(info.avatar_url);
+
+        init();
 
         // HACK
         // We use fake message info with an old date to pin
@@ -111,8 +106,10 @@ RoomInfoListItem::resizeEvent(QResizeEvent *)
         else
                 setToolTip(roomName_);
 
-        ripple_overlay_->setClipPath(path);
-        ripple_overlay_->setClipping(true);
+        if (ripple_overlay_) {
+                ripple_overlay_->setClipPath(path);
+                ripple_overlay_->setClipping(true);
+        }
 }
 
 void
@@ -121,6 +118,36 @@ RoomInfoListItem::paintEvent(QPaintEvent *event)
         Q_UNUSED(event);
 
         QPainter p(this);
+
+        // Only the background depends on the hover state; the content is
+        // blitted from the cache.
+        if (isPressed_)
+                p.fillRect(rect(), highlightedBackgroundColor_);
+        else if (underMouse())
+                p.fillRect(rect(), hoverBackgroundColor_);
+        else
+                p.fillRect(rect(), backgroundColor_);
+
+        const auto ratio = devicePixelRatioF();
+
+        if (!isContentCacheValid_ || contentCache_.size() != size() * ratio)
+                renderContent();
+
+        p.drawPixmap(0, 0, contentCache_);
+}
+
+void
+RoomInfoListItem::renderContent()
+{
+        const auto ratio = devicePixelRatioF();
+
+        contentCache_ = QPixmap(size() * ratio);
+        contentCache_.setDevicePixelRatio(ratio);
+        contentCache_.fill(Qt::transparent);
+
+        isContentCacheValid_ = true;
+
+        QPainter p(&contentCache_);
         p.setRenderHint(QPainter::TextAntialiasing);
         p.setRenderHint(QPainter::SmoothPixmapTransform);
         p.setRenderHint(QPainter::Antialiasing);
@@ -131,13 +158,8 @@ RoomInfoListItem::paintEvent(QPaintEvent *event)
         QPen subtitlePen(subtitleColor_);
 
         if (isPressed_) {
-                p.fillRect(rect(), highlightedBackgroundColor_);
                 titlePen.setColor(highlightedTitleColor_);
                 subtitlePen.setColor(highlightedSubtitleColor_);
-        } else if (underMouse()) {
-                p.fillRect(rect(), hoverBackgroundColor_);
-        } else {
-                p.fillRect(rect(), backgroundColor_);
         }
 
         QRect avatarRegion(Padding, Padding, IconSize, IconSize);
@@ -150,7 +172,7 @@ RoomInfoListItem::paintEvent(QPaintEvent *event)
                 p.setPen(titlePen);
 
                 const int msgStampWidth =
-                  QFontMetrics(timestampFont_).width(lastMsgInfo_.timestamp) + 4;
+                  utils::textWidth(timestampFont_, lastMsgInfo_.timestamp) + 4;
 
                 // We use the full width of the widget if there is no unread msg bubble.
                 const int bottomLineWidthLimit = (unreadMsgCount_ > 0) ? msgStampWidth : 0;
@@ -160,9 +182,9 @@ RoomInfoListItem::paintEvent(QPaintEvent *event)
                 int top_y = 2 * Padding + fontNameMetrics.ascent() / 2;
 
                 const auto name =
-                  metrics.elidedText(roomName(),
-                                     Qt::ElideRight,
-                                     (width() - IconSize - 2 * Padding - msgStampWidth) * 0.8);
+                  utils::elidedText(font_,
+                                    roomName(),
+                                    (width() - IconSize - 2 * Padding - msgStampWidth) * 0.8);
                 p.drawText(QPoint(2 * Padding + IconSize, top_y), name);
 
                 if (roomType_ == RoomType::Joined) {
@@ -174,12 +196,12 @@ RoomInfoListItem::paintEvent(QPaintEvent *event)
                         int usernameLimit =
                           std::max(0, width() - 3 * Padding - msgStampWidth - IconSize - 20);
                         auto userName =
-                          metrics.elidedText(lastMsgInfo_.username, Qt::ElideRight, usernameLimit);
+                          utils::elidedText(font_, lastMsgInfo_.username, usernameLimit);
 
                         p.setFont(usernameFont_);
                         p.drawText(QPoint(2 * Padding + IconSize, bottom_y), userName);
 
-                        int nameWidth = QFontMetrics(usernameFont_).width(userName);
+                        int nameWidth = utils::textWidth(usernameFont_, userName);
 
                         p.setFont(font_);
 
@@ -189,7 +211,7 @@ RoomInfoListItem::paintEvent(QPaintEvent *event)
                           0,
                           width() - 3 * Padding - bottomLineWidthLimit - IconSize - nameWidth - 5);
                         auto description =
-                          metrics.elidedText(lastMsgInfo_.body, Qt::ElideRight, descriptionLimit);
+                          utils::elidedText(font_, lastMsgInfo_.body, descriptionLimit);
                         p.drawText(QPoint(2 * Padding + IconSize + nameWidth, bottom_y),
                                    description);
 
@@ -236,20 +258,19 @@ RoomInfoListItem::paintEvent(QPaintEvent *event)
 
         // We using the first letter of room's name.
         if (roomAvatar_.isNull()) {
-                QBrush brush;
-                brush.setStyle(Qt::SolidPattern);
-                brush.setColor(avatarBgColor());
-
-                p.setPen(Qt::NoPen);
-                p.setBrush(brush);
-
-                p.drawEllipse(avatarRegion.center(), IconSize / 2, IconSize / 2);
+                // The row is visible for the first time; ask for the real
+                // avatar and paint the letter placeholder meanwhile.
+                if (!avatarUrl_.isEmpty() && !avatarRequested_) {
+                        avatarRequested_ = true;
+                        emit requestAvatar(roomId_, avatarUrl_);
+                }
 
-                p.setFont(bubbleFont_);
-                p.setPen(avatarFgColor());
-                p.setBrush(Qt::NoBrush);
-                p.drawText(
-                  avatarRegion.translated(0, -1), Qt::AlignCenter, utils::firstChar(roomName()));
+                p.drawPixmap(avatarRegion.topLeft(),
+                             utils::letterAvatar(utils::firstChar(roomName()),
+                                                 avatarFgColor(),
+                                                 avatarBgColor(),
+                                                 IconSize,
+                                                 bubbleFont_));
         } else {
                 p.save();
 
@@ -311,6 +332,7 @@ void
 RoomInfoListItem::updateUnreadMessageCount(int count)
 {
         unreadMsgCount_ = count;
+        invalidateContentCache();
         update();
 }
 
@@ -319,6 +341,7 @@ RoomInfoListItem::setPressedState(bool state)
 {
         if (isPressed_ != state) {
                 isPressed_ = state;
+                invalidateContentCache();
                 update();
         }
 }
@@ -331,6 +354,14 @@ RoomInfoListItem::contextMenuEvent(QContextMenuEvent *event)
         if (roomType_ == RoomType::Invited)
                 return;
 
+        if (!menu_) {
+                menu_      = new Menu(this);
+                leaveRoom_ = new QAction(tr("Leave room"), this);
+                connect(
+                  leaveRoom_, &QAction::triggered, this, [this]() { emit leaveRoom(roomId_); });
+                menu_->addAction(leaveRoom_);
+        }
+
         menu_->popup(event->globalPos());
 }
 
@@ -358,6 +389,16 @@ RoomInfoListItem::mousePressEvent(QMouseEvent *event)
 
         setPressedState(true);
 
+        if (!ripple_overlay_) {
+                QPainterPath path;
+                path.addRect(0, 0, width(), height());
+
+                ripple_overlay_ = new RippleOverlay(this);
+                ripple_overlay_->setClipPath(path);
+                ripple_overlay_->setClipping(true);
+                ripple_overlay_->show();
+        }
+
         // Ripple on mouse position by default.
         QPoint pos           = event->pos();
         qreal radiusEndValue = static_cast<qreal>(width()) / 3;
@@ -376,7 +417,8 @@ RoomInfoListItem::mousePressEvent(QMouseEvent *event)
 void
 RoomInfoListItem::setAvatar(const QImage &img)
 {
-        roomAvatar_ = utils::scaleImageToPixmap(img, IconSize);
+        roomAvatar_ = utils::scaleImageToPixmap(img, IconSize, utils::screenDpr(this));
+        invalidateContentCache();
         update();
 }
 
@@ -384,5 +426,17 @@ void
 RoomInfoListItem::setDescriptionMessage(const DescInfo &info)
 {
         lastMsgInfo_ = info;
+        invalidateContentCache();
         update();
 }
+
+void
+RoomInfoListItem::warmAvatarCache()
+{
+        if (roomAvatar_.isNull())
+                utils::letterAvatar(utils::firstChar(roomName()),
+                                    avatarFgColor(),
+                                    avatarBgColor(),
+                                    IconSize,
+                                    bubbleFont_);
+}
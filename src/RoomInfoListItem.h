@@ -28,6 +28,17 @@
 class Menu;
 class RippleOverlay;
 
+//! Everything the top bar needs to render a room's header, captured
+//! from the list item's own state so a room switch is a plain struct
+//! handoff without any cache reads.
+struct RoomHeaderInfo
+{
+        QString name;
+        QString topic;
+        //! Decoded room avatar; null while only the letter avatar exists.
+        QPixmap avatar;
+};
+
 class RoomInfoListItem : public QWidget
 {
         Q_OBJECT
@@ -59,12 +70,17 @@ class RoomInfoListItem : public QWidget
         Q_PROPERTY(QColor btnTextColor READ btnTextColor WRITE setBtnTextColor)
 
 public:
-        RoomInfoListItem(QString room_id, RoomInfo info, QWidget *parent = 0);
+        //! Edge length of the room avatar, in logical pixels. Exposed so
+        //! callers can ask the cache for a prescaled variant.
+        static constexpr int IconSize = 44;
+
+        RoomInfoListItem(QString room_id, const RoomInfo &info, QWidget *parent = 0);
 
         void updateUnreadMessageCount(int count);
         void clearUnreadMessageCount() { updateUnreadMessageCount(0); };
 
         QString roomId() { return roomId_; }
+        RoomHeaderInfo headerInfo() const { return {roomName_, roomTopic_, roomAvatar_}; }
         bool isPressed() const { return isPressed_; }
         int unreadMessageCount() const { return unreadMsgCount_; }
 
@@ -72,6 +88,11 @@ public:
         void setDescriptionMessage(const DescInfo &info);
         DescInfo lastMessageInfo() const { return lastMsgInfo_; }
 
+        //! Render the letter avatar into the shared pixmap cache ahead
+        //! of the first paint, so showing a long room list doesn't
+        //! rasterize all of them in one frame.
+        void warmAvatarCache();
+
         QColor highlightedBackgroundColor() const { return highlightedBackgroundColor_; }
         QColor hoverBackgroundColor() const { return hoverBackgroundColor_; }
         QColor backgroundColor() const { return backgroundColor_; }
@@ -94,24 +115,79 @@ public:
         void setHighlightedBackgroundColor(QColor &color) { highlightedBackgroundColor_ = color; }
         void setHoverBackgroundColor(QColor &color) { hoverBackgroundColor_ = color; }
         void setBackgroundColor(QColor &color) { backgroundColor_ = color; }
-        void setTimestampColor(QColor &color) { timestampColor_ = color; }
-        void setAvatarFgColor(QColor &color) { avatarFgColor_ = color; }
-        void setAvatarBgColor(QColor &color) { avatarBgColor_ = color; }
+        void setTimestampColor(QColor &color)
+        {
+                timestampColor_ = color;
+                invalidateContentCache();
+        }
+        void setAvatarFgColor(QColor &color)
+        {
+                avatarFgColor_ = color;
+                invalidateContentCache();
+        }
+        void setAvatarBgColor(QColor &color)
+        {
+                avatarBgColor_ = color;
+                invalidateContentCache();
+        }
 
-        void setHighlightedTitleColor(QColor &color) { highlightedTitleColor_ = color; }
-        void setHighlightedSubtitleColor(QColor &color) { highlightedSubtitleColor_ = color; }
-        void setHighlightedTimestampColor(QColor &color) { highlightedTimestampColor_ = color; }
+        void setHighlightedTitleColor(QColor &color)
+        {
+                highlightedTitleColor_ = color;
+                invalidateContentCache();
+        }
+        void setHighlightedSubtitleColor(QColor &color)
+        {
+                highlightedSubtitleColor_ = color;
+                invalidateContentCache();
+        }
+        void setHighlightedTimestampColor(QColor &color)
+        {
+                highlightedTimestampColor_ = color;
+                invalidateContentCache();
+        }
 
-        void setTitleColor(QColor &color) { titleColor_ = color; }
-        void setSubtitleColor(QColor &color) { subtitleColor_ = color; }
+        void setTitleColor(QColor &color)
+        {
+                titleColor_ = color;
+                invalidateContentCache();
+        }
+        void setSubtitleColor(QColor &color)
+        {
+                subtitleColor_ = color;
+                invalidateContentCache();
+        }
 
-        void setBtnColor(QColor &color) { btnColor_ = color; }
-        void setBtnTextColor(QColor &color) { btnTextColor_ = color; }
+        void setBtnColor(QColor &color)
+        {
+                btnColor_ = color;
+                invalidateContentCache();
+        }
+        void setBtnTextColor(QColor &color)
+        {
+                btnTextColor_ = color;
+                invalidateContentCache();
+        }
 
-        void setBubbleFgColor(QColor &color) { bubbleFgColor_ = color; }
-        void setBubbleBgColor(QColor &color) { bubbleBgColor_ = color; }
+        void setBubbleFgColor(QColor &color)
+        {
+                bubbleFgColor_ = color;
+                invalidateContentCache();
+        }
+        void setBubbleBgColor(QColor &color)
+        {
+                bubbleBgColor_ = color;
+                invalidateContentCache();
+        }
 
-        void setRoomName(const QString &name) { roomName_ = name; }
+        void setRoomName(const QString &name)
+        {
+                roomName_ = name;
+                invalidateContentCache();
+        }
+        //! The topic isn't part of the rendered row; it is carried only
+        //! for the top bar's header snapshot.
+        void setRoomTopic(const QString &topic) { roomTopic_ = topic; }
         void setRoomType(bool isInvite)
         {
                 if (isInvite)
@@ -127,6 +203,10 @@ signals:
         void leaveRoom(const QString &room_id);
         void acceptInvite(const QString &room_id);
         void declineInvite(const QString &room_id);
+        //! Emitted the first time the row is actually rendered, so the
+        //! avatars of rooms that never enter the viewport are never
+        //! fetched or decoded.
+        void requestAvatar(const QString &room_id, const QString &avatar_url);
 
 public slots:
         void setPressedState(bool state);
@@ -138,10 +218,22 @@ protected:
         void contextMenuEvent(QContextMenuEvent *event) override;
 
 private:
-        void init(QWidget *parent);
+        void init();
         QString roomName() { return roomName_; }
 
-        RippleOverlay *ripple_overlay_;
+        //! Render the row's static content (avatar, name, last message,
+        //! unread badge) into the cache pixmap.
+        void renderContent();
+        //! Force a re-render of the row on the next repaint.
+        void invalidateContentCache() { isContentCacheValid_ = false; }
+
+        //! The row rendered at its current size, so hover & scroll
+        //! repaints are a blit instead of elision & text layout.
+        QPixmap contentCache_;
+        bool isContentCacheValid_ = false;
+
+        //! Created on the first click; most rows are never clicked.
+        RippleOverlay *ripple_overlay_ = nullptr;
 
         enum class RoomType
         {
@@ -156,13 +248,18 @@ private:
 
         QString roomId_;
         QString roomName_;
+        QString roomTopic_;
 
         DescInfo lastMsgInfo_;
 
         QPixmap roomAvatar_;
+        //! The room's avatar url, resolved lazily on the first render.
+        QString avatarUrl_;
+        bool avatarRequested_ = false;
 
-        Menu *menu_;
-        QAction *leaveRoom_;
+        //! Created on the first right click.
+        Menu *menu_         = nullptr;
+        QAction *leaveRoom_ = nullptr;
 
         bool isPressed_ = false;
 
@@ -15,12 +15,15 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include <QApplication>
 #include <QBuffer>
 #include <QObject>
 #include <QTimer>
 
 #include "Cache.h"
+#include "IdleScheduler.h"
 #include "Logging.h"
 #include "MainWindow.h"
 #include "MatrixClient.h"
@@ -67,7 +70,11 @@ RoomList::RoomList(QSharedPointer<UserSettings> userSettings, QWidget *parent)
 void
 RoomList::addRoom(const QString &room_id, const RoomInfo &info)
 {
-        auto room_item = new RoomInfoListItem(room_id, info, scrollArea_);
+        // One shared copy of the room id fans out to the list item and
+        // every map keyed by it.
+        const auto id = utils::intern(room_id);
+
+        auto room_item = new RoomInfoListItem(id, info, scrollArea_);
         room_item->setRoomName(QString::fromStdString(std::move(info.name)));
 
         connect(room_item, &RoomInfoListItem::clicked, this, &RoomList::highlightSelectedRoom);
@@ -75,31 +82,109 @@ RoomList::addRoom(const QString &room_id, const RoomInfo &info)
                 MainWindow::instance()->openLeaveRoomDialog(room_id);
         });
 
-        rooms_.emplace(room_id, QSharedPointer<RoomInfoListItem>(room_item));
+        rooms_.emplace(id, QSharedPointer<RoomInfoListItem>(room_item));
+        assignRoomSlot(id);
 
-        if (!info.avatar_url.empty())
-                updateAvatar(room_id, QString::fromStdString(info.avatar_url));
+        // The avatar is fetched & decoded only when the row first enters
+        // the viewport; the item asks for it from its first render. Queued,
+        // so the cache lookup doesn't run inside the item's paint.
+        connect(room_item,
+                &RoomInfoListItem::requestAvatar,
+                this,
+                &RoomList::updateAvatar,
+                Qt::QueuedConnection);
 
         int pos = contentsLayout_->count() - 1;
         contentsLayout_->insertWidget(pos, room_item);
 }
 
+void
+RoomList::clear()
+{
+        // Drop the queued population slices along with the widgets.
+        initGeneration_ += 1;
+        pendingInit_.clear();
+
+        if (initPlaceholder_) {
+                contentsLayout_->removeWidget(initPlaceholder_);
+                initPlaceholder_->deleteLater();
+                initPlaceholder_ = nullptr;
+        }
+
+        rooms_.clear();
+        roomSlot_.clear();
+        slotRoom_.clear();
+        freeSlots_.clear();
+        visible_.clear();
+        communityRooms_.clear();
+}
+
+int
+RoomList::assignRoomSlot(const QString &room_id)
+{
+        int slot;
+
+        if (!freeSlots_.empty()) {
+                slot = freeSlots_.back();
+                freeSlots_.pop_back();
+
+                slotRoom_[slot] = room_id;
+                // New rooms start out visible, like their widgets.
+                visible_[slot] = true;
+        } else {
+                slot = static_cast<int>(slotRoom_.size());
+
+                slotRoom_.push_back(room_id);
+                visible_.push_back(true);
+        }
+
+        roomSlot_.insert(room_id, slot);
+
+        return slot;
+}
+
+void
+RoomList::releaseRoomSlot(const QString &room_id)
+{
+        const auto slot = roomSlot_.value(room_id, -1);
+
+        if (slot == -1)
+                return;
+
+        roomSlot_.remove(room_id);
+        slotRoom_[slot].clear();
+        freeSlots_.push_back(slot);
+
+        // The slot will be reused by a different room; it can't keep the
+        // membership bits of the one that left.
+        for (auto &community : communityRooms_) {
+                if (static_cast<std::size_t>(slot) < community.second.size())
+                        community.second[slot] = false;
+        }
+}
+
 void
 RoomList::updateAvatar(const QString &room_id, const QString &url)
 {
         if (url.isEmpty())
                 return;
 
-        QByteArray savedImgData;
+        QImage savedImg;
 
+        // Ask for the prescaled variant; after the first launch the
+        // sidebar paints from bitmaps that are already at display size.
         if (cache::client())
-                savedImgData = cache::client()->image(url);
+                savedImg = cache::client()->scaledImage(
+                  url, utils::devicePixels(RoomInfoListItem::IconSize));
 
-        if (savedImgData.isEmpty()) {
+        if (savedImg.isNull()) {
                 mtx::http::ThumbOpts opts;
                 opts.mxc_url = url.toStdString();
-                http::client()->get_thumbnail(
-                  opts, [room_id, opts, this](const std::string &res, mtx::http::RequestErr err) {
+                http::get_thumbnail(
+                  opts,
+                  http::DownloadPriority::Avatar,
+                  this,
+                  [room_id, opts, this](const std::string &res, mtx::http::RequestErr err) {
                           if (err) {
                                   nhlog::net()->warn(
                                     "failed to download room avatar: {} {} {}",
@@ -119,18 +204,18 @@ RoomList::updateAvatar(const QString &room_id, const QString &url)
                           emit updateRoomAvatarCb(room_id, pixmap);
                   });
         } else {
-                QPixmap img;
-                img.loadFromData(savedImgData);
-
-                updateRoomAvatar(room_id, img);
+                updateRoomAvatar(room_id, QPixmap::fromImage(savedImg));
         }
 }
 
 void
 RoomList::removeRoom(const QString &room_id, bool reset)
 {
+        releaseRoomSlot(room_id);
         rooms_.erase(room_id);
 
+        calculateUnreadMessageCount();
+
         if (rooms_.empty() || !reset)
                 return;
 
@@ -152,22 +237,57 @@ RoomList::updateUnreadMessageCount(const QString &roomid, int count)
                 return;
         }
 
-        rooms_[roomid]->updateUnreadMessageCount(count);
+        auto room = rooms_[roomid];
 
-        calculateUnreadMessageCount();
+        // Adjust the running total by the delta, so the tray badge update
+        // doesn't iterate the whole room list. The total is published by
+        // flushUnreadCount, once per sync cycle.
+        totalUnreadCount_ += count - room->unreadMessageCount();
+        room->updateUnreadMessageCount(count);
+}
+
+void
+RoomList::flushUnreadCount()
+{
+        // The title & tray handlers only hear about actual changes, so a
+        // catch-up sync produces at most one update instead of one per
+        // touched room.
+        if (totalUnreadCount_ == lastFlushedUnreadCount_)
+                return;
+
+        lastFlushedUnreadCount_ = totalUnreadCount_;
+        emit totalUnreadMessageCountUpdated(totalUnreadCount_);
 }
 
 void
 RoomList::calculateUnreadMessageCount()
 {
-        int total_unread_msgs = 0;
+        totalUnreadCount_ = 0;
 
         for (const auto &room : rooms_) {
                 if (!room.second.isNull())
-                        total_unread_msgs += room.second->unreadMessageCount();
+                        totalUnreadCount_ += room.second->unreadMessageCount();
         }
 
-        emit totalUnreadMessageCountUpdated(total_unread_msgs);
+        flushUnreadCount();
+}
+
+//! Rooms materialized synchronously by initialize(); enough to cover
+//! the sidebar's viewport. The rest stream in over idle callbacks.
+constexpr int INITIAL_ROOM_BATCH = 30;
+//! Rooms materialized per idle slice while the list is populating.
+constexpr int ROOM_STREAM_CHUNK = 50;
+
+//! The streaming priority of a room: invites & unread rooms first,
+//! then the most recently active.
+static std::pair<bool, qint64>
+streamPriority(const RoomInfo &info)
+{
+        const auto ts = info.msgInfo.userid.isEmpty()
+                          ? 0
+                          : info.msgInfo.datetime.toMSecsSinceEpoch();
+
+        return {info.is_invite || info.notification_count > 0, ts};
 }
 
 void
@@ -175,26 +295,97 @@ RoomList::initialize(const QMap<QString, RoomInfo> &info)
 {
         nhlog::ui()->info("initialize room list");
 
-        rooms_.clear();
+        clear();
+
+        QVector<QPair<QString, RoomInfo>> ordered;
+        ordered.reserve(info.size());
+        for (auto it = info.begin(); it != info.end(); it++)
+                ordered.push_back({it.key(), it.value()});
+
+        std::stable_sort(ordered.begin(), ordered.end(), [](const auto &a, const auto &b) {
+                return streamPriority(a.second) > streamPriority(b.second);
+        });
+
+        // The room that was on display last session is materialized
+        // first, so the restored selection is part of the first paint.
+        QString restoredRoom;
+        try {
+                const auto restored = cache::client()->restoreSessionState("active_room");
+                if (restored)
+                        restoredRoom = QString::fromStdString(*restored);
+        } catch (const lmdb::error &e) {
+                nhlog::db()->warn("failed to restore the active room: {}", e.what());
+        }
+
+        if (!restoredRoom.isEmpty()) {
+                auto it = std::find_if(ordered.begin(), ordered.end(), [&](const auto &r) {
+                        return r.first == restoredRoom;
+                });
+
+                if (it != ordered.end())
+                        std::rotate(ordered.begin(), it, it + 1);
+        }
 
         setUpdatesEnabled(false);
 
-        for (auto it = info.begin(); it != info.end(); it++) {
-                if (it.value().is_invite)
-                        addInvitedRoom(it.key(), it.value());
+        // Only the rooms the first paint can show are materialized here;
+        // widget construction for the rest is deferred, so the window
+        // doesn't stall behind a thousand hidden rows.
+        const int syncCount = std::min(INITIAL_ROOM_BATCH, ordered.size());
+
+        for (int i = 0; i < syncCount; ++i) {
+                const auto &room = ordered.at(i);
+
+                if (room.second.is_invite)
+                        addInvitedRoom(room.first, room.second);
                 else
-                        addRoom(it.key(), it.value());
+                        addRoom(room.first, room.second);
+
+                updateRoomDescription(room.first, room.second.msgInfo);
         }
 
-        for (auto it = info.begin(); it != info.end(); it++)
-                updateRoomDescription(it.key(), it.value().msgInfo);
+        if (ordered.size() > syncCount) {
+                pendingInit_ = QSharedPointer<QVector<QPair<QString, RoomInfo>>>::create(
+                  ordered.mid(syncCount));
+
+                // Stand-in for the rooms that haven't been materialized
+                // yet, so the scrollbar range matches the final list
+                // immediately.
+                const int itemHeight = rooms_.begin()->second->minimumHeight();
+
+                initPlaceholder_ = new QWidget(scrollAreaContents_);
+                initPlaceholder_->setFixedHeight(pendingInit_->size() * itemHeight);
+                contentsLayout_->insertWidget(contentsLayout_->count() - 1, initPlaceholder_);
+
+                const auto generation = initGeneration_;
+                idle::schedule(this, [this, generation]() {
+                        if (generation == initGeneration_)
+                                streamPendingRooms();
+                });
+        }
 
         setUpdatesEnabled(true);
 
+        // Pre-render the letter avatars between the user's actions, so
+        // the first paint of the list doesn't rasterize all of them.
+        for (const auto &room : rooms_)
+                idle::schedule(room.second.data(),
+                               [item = room.second.data()]() { item->warmAvatarCache(); });
+
+        // Restore the tray badge from the persisted per-room counts.
+        calculateUnreadMessageCount();
+
         if (rooms_.empty())
                 return;
 
         auto room = firstRoom();
+
+        // Pick up where the last session stopped instead of the first
+        // room of the list.
+        if (!restoredRoom.isEmpty() && roomExists(restoredRoom) &&
+            !rooms_[restoredRoom].isNull())
+                room = {restoredRoom, rooms_[restoredRoom]};
+
         if (room.second.isNull())
                 return;
 
@@ -203,27 +394,114 @@ RoomList::initialize(const QMap<QString, RoomInfo> &info)
 }
 
 void
-RoomList::cleanupInvites(const std::map<QString, bool> &invites)
+RoomList::streamPendingRooms()
 {
-        if (invites.size() == 0)
+        if (pendingInit_.isNull())
                 return;
 
-        utils::erase_if(rooms_, [invites](auto &room) {
-                auto room_id = room.first;
-                auto item    = room.second;
+        setUpdatesEnabled(false);
 
-                if (!item)
-                        return false;
+        const int chunk = std::min(ROOM_STREAM_CHUNK, pendingInit_->size());
 
-                return item->isInvite() && (invites.find(room_id) == invites.end());
-        });
+        for (int i = 0; i < chunk; ++i) {
+                const auto &room = pendingInit_->at(i);
+
+                // A sync delta may have materialized the room already.
+                if (roomExists(room.first))
+                        continue;
+
+                if (room.second.is_invite)
+                        addInvitedRoom(room.first, room.second);
+                else
+                        addRoom(room.first, room.second);
+
+                updateRoomDescription(room.first, room.second.msgInfo);
+
+                auto item = rooms_[room.first].data();
+                idle::schedule(item, [item]() { item->warmAvatarCache(); });
+        }
+
+        pendingInit_->remove(0, chunk);
+
+        if (pendingInit_->isEmpty()) {
+                pendingInit_.clear();
+
+                contentsLayout_->removeWidget(initPlaceholder_);
+                initPlaceholder_->deleteLater();
+                initPlaceholder_ = nullptr;
+
+                // Unread rooms beyond the synchronous batch are part of
+                // the badge total only now.
+                calculateUnreadMessageCount();
+
+                // The stream prioritized unread rooms over recency;
+                // settle the final order once.
+                idle::schedule(this, [this]() { sortRoomsByLastMessage(); });
+        } else {
+                // The slice landed below the placeholder; move it back to
+                // the bottom, shrunk by the materialized rooms.
+                const int itemHeight = rooms_.begin()->second->minimumHeight();
+
+                contentsLayout_->removeWidget(initPlaceholder_);
+                initPlaceholder_->setFixedHeight(pendingInit_->size() * itemHeight);
+                contentsLayout_->insertWidget(contentsLayout_->count() - 1, initPlaceholder_);
+
+                const auto generation = initGeneration_;
+                idle::schedule(this, [this, generation]() {
+                        if (generation == initGeneration_)
+                                streamPendingRooms();
+                });
+        }
+
+        setUpdatesEnabled(true);
 }
 
 void
-RoomList::sync(const std::map<QString, RoomInfo> &info)
+RoomList::removeInvites(const std::vector<QString> &room_ids)
+{
+        // Only the items named by the delta are touched, instead of
+        // scanning every invite in the list.
+        for (const auto &room_id : room_ids) {
+                auto it = rooms_.find(room_id);
+
+                if (it == rooms_.end() || it->second.isNull() || !it->second->isInvite())
+                        continue;
 
+                removeRoom(room_id, false);
+        }
+}
+
+bool
+RoomList::isRoomVisible(const QString &room_id) const
 {
-        for (const auto &room : info)
+        auto it = rooms_.find(room_id);
+
+        if (it == rooms_.end() || it->second.isNull() || it->second->isHidden())
+                return false;
+
+        const auto viewport = scrollArea_->viewport()->rect();
+        const auto itemRect = QRect(it->second->mapTo(scrollArea_->viewport(), QPoint(0, 0)),
+                                    it->second->size());
+
+        return viewport.intersects(itemRect);
+}
+
+RoomHeaderInfo
+RoomList::headerInfo(const QString &room_id) const
+{
+        auto it = rooms_.find(room_id);
+
+        if (it == rooms_.end() || it->second.isNull())
+                return {};
+
+        return it->second->headerInfo();
+}
+
+void
+RoomList::sync(const std::map<QString, RoomUpdate> &updates)
+
+{
+        for (const auto &room : updates)
                 updateRoom(room.first, room.second);
 }
 
@@ -287,7 +565,57 @@ RoomList::updateRoomDescription(const QString &roomid, const DescInfo &info)
 
         isSortPending_ = false;
 
-        emit sortRoomsByLastMessage();
+        repositionRoom(roomid);
+}
+
+//! Timestamp used for ordering the given room. Rooms without a last
+//! message sink to the bottom of the list.
+static uint64_t
+sortTimestamp(RoomInfoListItem *room)
+{
+        if (room->lastMessageInfo().userid.isEmpty())
+                return 0;
+
+        return room->lastMessageInfo().datetime.toMSecsSinceEpoch();
+}
+
+void
+RoomList::repositionRoom(const QString &room_id)
+{
+        if (!userSettings_->isOrderingEnabled())
+                return;
+
+        if (!roomExists(room_id))
+                return;
+
+        const auto roomWidget   = rooms_[room_id].data();
+        const auto currentIndex = contentsLayout_->indexOf(roomWidget);
+
+        if (currentIndex == -1)
+                return;
+
+        const auto ts = sortTimestamp(roomWidget);
+
+        // Find the first room that should be below this one. Since the rest
+        // of the list is already ordered, this is the only widget that moves.
+        int newIndex = 0;
+        for (int ii = 0; ii < contentsLayout_->count(); ++ii) {
+                auto room = qobject_cast<RoomInfoListItem *>(contentsLayout_->itemAt(ii)->widget());
+
+                if (!room || room == roomWidget)
+                        continue;
+
+                if (sortTimestamp(room) <= ts)
+                        break;
+
+                newIndex += 1;
+        }
+
+        if (currentIndex == newIndex)
+                return;
+
+        contentsLayout_->removeWidget(roomWidget);
+        contentsLayout_->insertWidget(newIndex, roomWidget);
 }
 
 void
@@ -306,11 +634,7 @@ RoomList::sortRoomsByLastMessage()
                 if (!room)
                         continue;
 
-                // Not a room message.
-                if (room->lastMessageInfo().userid.isEmpty())
-                        times.emplace(0, room);
-                else
-                        times.emplace(room->lastMessageInfo().datetime.toMSecsSinceEpoch(), room);
+                times.emplace(sortTimestamp(room), room);
         }
 
         for (auto it = times.cbegin(); it != times.cend(); ++it) {
@@ -329,8 +653,10 @@ RoomList::sortRoomsByLastMessage()
 void
 RoomList::leaveEvent(QEvent *event)
 {
+        // The re-sort shuffles most of the list's widgets around; it can
+        // wait for the next idle gap instead of a fixed delay.
         if (isSortPending_)
-                QTimer::singleShot(700, this, &RoomList::sortRoomsByLastMessage);
+                idle::schedule(this, [this]() { sortRoomsByLastMessage(); });
 
         QWidget::leaveEvent(event);
 }
@@ -347,44 +673,69 @@ RoomList::closeJoinRoomDialog(bool isJoining, QString roomAlias)
 void
 RoomList::removeFilter()
 {
-        setUpdatesEnabled(false);
-        for (int i = 0; i < contentsLayout_->count(); i++) {
-                auto widget =
-                  qobject_cast<RoomInfoListItem *>(contentsLayout_->itemAt(i)->widget());
-                if (widget)
-                        widget->show();
+        applyVisibility(std::vector<bool>(slotRoom_.size(), true));
+}
+
+void
+RoomList::setCommunityRooms(const QString &community_id, const std::map<QString, bool> &rooms)
+{
+        auto &bits = communityRooms_[community_id];
+        bits.assign(slotRoom_.size(), false);
+
+        for (const auto &room : rooms) {
+                const auto slot = roomSlot_.value(room.first, -1);
+
+                // Rooms of the community that we haven't joined have no slot.
+                if (slot != -1)
+                        bits[slot] = true;
         }
-        setUpdatesEnabled(true);
 }
 
 void
-RoomList::applyFilter(const std::map<QString, bool> &filter)
+RoomList::applyFilter(const QString &community_id)
+{
+        const auto filter = communityRooms_.find(community_id);
+
+        // A community whose room list hasn't been retrieved yet has no
+        // visible members.
+        if (filter == communityRooms_.end())
+                applyVisibility(std::vector<bool>(slotRoom_.size(), false));
+        else
+                applyVisibility(filter->second);
+
+        // If the already selected room is part of the group, make sure it's visible.
+        const auto slot = roomSlot_.value(selectedRoom_, -1);
+        if (slot != -1 && static_cast<std::size_t>(slot) < visible_.size() && visible_[slot])
+                return;
+
+        selectFirstVisibleRoom();
+}
+
+void
+RoomList::applyVisibility(const std::vector<bool> &target)
 {
         // Disabling paint updates will resolve issues with screen flickering on big room lists.
         setUpdatesEnabled(false);
 
-        for (int i = 0; i < contentsLayout_->count(); i++) {
-                // If filter contains the room for the current RoomInfoListItem,
-                // show the list item, otherwise hide it
-                auto listitem =
-                  qobject_cast<RoomInfoListItem *>(contentsLayout_->itemAt(i)->widget());
+        for (std::size_t i = 0; i < slotRoom_.size(); i++) {
+                if (slotRoom_[i].isEmpty())
+                        continue;
+
+                // Bitsets built before the room was added don't cover its
+                // slot; the room is not a member.
+                const bool show = i < target.size() && target[i];
 
-                if (!listitem)
+                if (show == visible_[i])
                         continue;
 
-                if (filter.find(listitem->roomId()) != filter.end())
-                        listitem->show();
-                else
-                        listitem->hide();
+                auto room = rooms_.find(slotRoom_[i]);
+                if (room != rooms_.end() && !room->second.isNull())
+                        room->second->setVisible(show);
+
+                visible_[i] = show;
         }
 
         setUpdatesEnabled(true);
-
-        // If the already selected room is part of the group, make sure it's visible.
-        if (!selectedRoom_.isEmpty() && (filter.find(selectedRoom_) != filter.end()))
-                return;
-
-        selectFirstVisibleRoom();
 }
 
 void
@@ -410,35 +761,59 @@ RoomList::paintEvent(QPaintEvent *)
 }
 
 void
-RoomList::updateRoom(const QString &room_id, const RoomInfo &info)
+RoomList::updateRoom(const QString &room_id, const RoomUpdate &update)
 {
         if (!roomExists(room_id)) {
-                if (info.is_invite)
-                        addInvitedRoom(room_id, info);
-                else
-                        addRoom(room_id, info);
+                // A room that isn't in the list yet; the full info is
+                // retrieved once instead of being part of every delta.
+                try {
+                        const auto info = cache::client()->singleRoomInfo(room_id.toStdString());
+
+                        if (update.is_invite)
+                                addInvitedRoom(room_id, info);
+                        else
+                                addRoom(room_id, info);
+                } catch (const lmdb::error &e) {
+                        nhlog::db()->warn(
+                          "failed to retrieve info for new room ({}): {}",
+                          room_id.toStdString(),
+                          e.what());
+                }
 
                 return;
         }
 
         auto room = rooms_[room_id];
-        updateAvatar(room_id, QString::fromStdString(info.avatar_url));
-        room->setRoomName(QString::fromStdString(info.name));
-        room->setRoomType(info.is_invite);
+
+        if (update.avatarChanged)
+                updateAvatar(room_id, QString::fromStdString(update.avatar_url));
+        if (update.nameChanged)
+                room->setRoomName(QString::fromStdString(update.name));
+        if (update.topicChanged)
+                room->setRoomTopic(QString::fromStdString(update.topic));
+
+        room->setRoomType(update.is_invite);
         room->update();
 }
 
 void
 RoomList::addInvitedRoom(const QString &room_id, const RoomInfo &info)
 {
-        auto room_item = new RoomInfoListItem(room_id, info, scrollArea_);
+        const auto id = utils::intern(room_id);
+
+        auto room_item = new RoomInfoListItem(id, info, scrollArea_);
 
         connect(room_item, &RoomInfoListItem::acceptInvite, this, &RoomList::acceptInvite);
         connect(room_item, &RoomInfoListItem::declineInvite, this, &RoomList::declineInvite);
 
-        rooms_.emplace(room_id, QSharedPointer<RoomInfoListItem>(room_item));
+        rooms_.emplace(id, QSharedPointer<RoomInfoListItem>(room_item));
+        assignRoomSlot(id);
 
-        updateAvatar(room_id, QString::fromStdString(info.avatar_url));
+        connect(room_item,
+                &RoomInfoListItem::requestAvatar,
+                this,
+                &RoomList::updateAvatar,
+                Qt::QueuedConnection);
 
         int pos = contentsLayout_->count() - 1;
         contentsLayout_->insertWidget(pos, room_item);
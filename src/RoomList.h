@@ -17,11 +17,16 @@
 
 #pragma once
 
+#include <vector>
+
+#include <QHash>
 #include <QMetaType>
+#include <QPair>
 #include <QPushButton>
 #include <QScrollArea>
 #include <QSharedPointer>
 #include <QVBoxLayout>
+#include <QVector>
 #include <QWidget>
 
 #include <mtx.hpp>
@@ -32,6 +37,7 @@ class RoomInfoListItem;
 class Sync;
 class UserSettings;
 struct DescInfo;
+struct RoomHeaderInfo;
 struct RoomInfo;
 
 class RoomList : public QWidget
@@ -42,20 +48,34 @@ public:
         RoomList(QSharedPointer<UserSettings> userSettings, QWidget *parent = 0);
 
         void initialize(const QMap<QString, RoomInfo> &info);
-        void sync(const std::map<QString, RoomInfo> &info);
+        void sync(const std::map<QString, RoomUpdate> &updates);
 
-        void clear() { rooms_.clear(); };
+        void clear();
         void updateAvatar(const QString &room_id, const QString &url);
 
         void addRoom(const QString &room_id, const RoomInfo &info);
         void addInvitedRoom(const QString &room_id, const RoomInfo &info);
         void removeRoom(const QString &room_id, bool reset);
-        //! Hide rooms that are not present in the given filter.
-        void applyFilter(const std::map<QString, bool> &rooms);
+        //! Hide the rooms that are not members of the given community.
+        void applyFilter(const QString &community_id);
+        //! Rebuild the membership bitset of a community from its retrieved room list.
+        void setCommunityRooms(const QString &community_id, const std::map<QString, bool> &rooms);
         //! Show all the available rooms.
         void removeFilter();
-        void updateRoom(const QString &room_id, const RoomInfo &info);
-        void cleanupInvites(const std::map<QString, bool> &invites);
+        //! Apply the fields of the delta that are marked as changed.
+        void updateRoom(const QString &room_id, const RoomUpdate &update);
+        //! Remove the invite items named by the sync delta.
+        void removeInvites(const std::vector<QString> &room_ids);
+        //! Whether the item of the given room is currently on screen in
+        //! the sidebar's viewport.
+        bool isRoomVisible(const QString &room_id) const;
+        //! Snapshot of the room's header fields, taken from the list
+        //! item's state instead of the cache.
+        RoomHeaderInfo headerInfo(const QString &room_id) const;
+        bool roomExists(const QString &room_id) const
+        {
+                return rooms_.find(room_id) != rooms_.end();
+        }
 
 signals:
         void roomChanged(const QString &room_id);
@@ -70,6 +90,9 @@ public slots:
         void updateRoomAvatar(const QString &roomid, const QPixmap &img);
         void highlightSelectedRoom(const QString &room_id);
         void updateUnreadMessageCount(const QString &roomid, int count);
+        //! Publish the unread total accumulated by the per-room updates.
+        //! Called once per applied sync, and only emits on a change.
+        void flushUnreadCount();
         void updateRoomDescription(const QString &roomid, const DescInfo &info);
         void closeJoinRoomDialog(bool isJoining, QString roomAlias);
 
@@ -83,10 +106,25 @@ private slots:
 private:
         //! Return the first non-null room.
         std::pair<QString, QSharedPointer<RoomInfoListItem>> firstRoom() const;
+        //! Move only the given room to its sorted position. The rest of the
+        //! layout is already ordered and is left untouched.
+        void repositionRoom(const QString &room_id);
+        //! Rebuild the running unread total from scratch, e.g. after the
+        //! list is (re)initialized or a room is removed. Regular updates
+        //! adjust the total by deltas instead.
         void calculateUnreadMessageCount();
-        bool roomExists(const QString &room_id) { return rooms_.find(room_id) != rooms_.end(); }
         //! Select the first visible room in the room list.
         void selectFirstVisibleRoom();
+        //! Assign a stable slot to the room, used as its index in the
+        //! membership bitsets.
+        int assignRoomSlot(const QString &room_id);
+        void releaseRoomSlot(const QString &room_id);
+        //! Toggle visibility only on the rooms whose bit differs from the
+        //! currently rendered state.
+        void applyVisibility(const std::vector<bool> &target);
+        //! Materialize the next slice of the initial population and
+        //! schedule the following one.
+        void streamPendingRooms();
 
         QVBoxLayout *topLayout_;
         QVBoxLayout *contentsLayout_;
@@ -98,6 +136,32 @@ private:
         OverlayModal *joinRoomModal_;
 
         std::map<QString, QSharedPointer<RoomInfoListItem>> rooms_;
+
+        //! The slot of each room; its index in the membership bitsets.
+        QHash<QString, int> roomSlot_;
+        //! The room occupying each slot; empty for free slots.
+        std::vector<QString> slotRoom_;
+        //! Slots freed by removed rooms, reused for new ones.
+        std::vector<int> freeSlots_;
+        //! The visibility bit of each slot, as currently rendered.
+        std::vector<bool> visible_;
+        //! Membership bitset of each community.
+        std::map<QString, std::vector<bool>> communityRooms_;
+
+        //! Rooms of the initial population that aren't materialized as
+        //! widgets yet, in streaming priority order. Drained in slices
+        //! over idle callbacks.
+        QSharedPointer<QVector<QPair<QString, RoomInfo>>> pendingInit_;
+        //! Spacer standing in for the pending rooms, so the scrollbar
+        //! covers the final height of the list from the first paint.
+        QWidget *initPlaceholder_ = nullptr;
+        //! Invalidates queued population slices after a clear().
+        uint64_t initGeneration_ = 0;
+
+        //! Running total of the per-room unread counts.
+        int totalUnreadCount_ = 0;
+        //! The last total handed to the title & tray, to skip no-op flushes.
+        int lastFlushedUnreadCount_ = -1;
         QString selectedRoom_;
 
         QSharedPointer<UserSettings> userSettings_;
@@ -6,6 +6,7 @@
 #include "Config.h"
 #include "MainWindow.h"
 #include "SideBarActions.h"
+#include "Utils.h"
 #include "ui/FlatButton.h"
 #include "ui/Menu.h"
 #include "ui/OverlayModal.h"
@@ -19,14 +20,10 @@ SideBarActions::SideBarActions(QWidget *parent)
         layout_ = new QHBoxLayout(this);
         layout_->setMargin(0);
 
-        QIcon settingsIcon;
-        settingsIcon.addFile(":/icons/icons/ui/settings.png");
-
-        QIcon createRoomIcon;
-        createRoomIcon.addFile(":/icons/icons/ui/add-square-button.png");
-
-        QIcon joinRoomIcon;
-        joinRoomIcon.addFile(":/icons/icons/ui/speech-bubbles-comment-option.png");
+        auto settingsIcon   = utils::cachedIcon(":/icons/icons/ui/settings.png");
+        auto createRoomIcon = utils::cachedIcon(":/icons/icons/ui/add-square-button.png");
+        auto joinRoomIcon =
+          utils::cachedIcon(":/icons/icons/ui/speech-bubbles-comment-option.png");
 
         settingsBtn_ = new FlatButton(this);
         settingsBtn_->setToolTip(tr("User settings"));
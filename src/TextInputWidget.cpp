@@ -58,7 +58,7 @@ FilteredTextEdit::FilteredTextEdit(QWidget *parent)
                 this,
                 [this]() { emit heightChanged(document()->size().toSize().height()); });
         working_history_.push_back("");
-        connect(this, &QTextEdit::textChanged, this, &FilteredTextEdit::textChanged);
+        connect(document(), &QTextDocument::contentsChange, this, &FilteredTextEdit::trackChange);
         setAcceptRichText(false);
 
         typingTimer_ = new QTimer(this);
@@ -98,6 +98,8 @@ FilteredTextEdit::FilteredTextEdit(QWidget *parent)
         });
 
         previewDialog_.hide();
+
+        lastTyped_.start();
 }
 
 void
@@ -122,6 +124,8 @@ FilteredTextEdit::showResults(const QVector<SearchResult> &results)
 void
 FilteredTextEdit::keyPressEvent(QKeyEvent *event)
 {
+        lastTyped_.restart();
+
         const bool isModifier = (event->modifiers() != Qt::NoModifier);
 
         if (!isModifier) {
@@ -203,9 +207,12 @@ FilteredTextEdit::keyPressEvent(QKeyEvent *event)
 
                 if (textCursor() == initial_cursor && textCursor().atStart() &&
                     history_index_ + 1 < working_history_.size()) {
+                        syncWorkingHistory();
                         ++history_index_;
                         setPlainText(working_history_[history_index_]);
                         moveCursor(QTextCursor::End);
+                        // The document matches the history entry again.
+                        workingHistoryDirty_ = false;
                 } else if (textCursor() == initial_cursor) {
                         // Move to the start of the text if there aren't any lines to move up to.
                         initial_cursor.movePosition(QTextCursor::Start, QTextCursor::MoveAnchor, 1);
@@ -219,9 +226,11 @@ FilteredTextEdit::keyPressEvent(QKeyEvent *event)
                 QTextEdit::keyPressEvent(event);
 
                 if (textCursor() == initial_cursor && textCursor().atEnd() && history_index_ > 0) {
+                        syncWorkingHistory();
                         --history_index_;
                         setPlainText(working_history_[history_index_]);
                         moveCursor(QTextCursor::End);
+                        workingHistoryDirty_ = false;
                 } else if (textCursor() == initial_cursor) {
                         // Move to the end of the text if there aren't any lines to move down to.
                         initial_cursor.movePosition(QTextCursor::End, QTextCursor::MoveAnchor, 1);
@@ -284,20 +293,23 @@ FilteredTextEdit::insertFromMimeData(const QMimeData *source)
         } else if (!video.empty()) {
                 showPreview(source, video);
         } else if (source->hasUrls()) {
-                // Generic file path for any platform.
-                QString path;
+                // Generic file paths for any platform. A single file goes
+                // through the preview dialog; a multi-file drop is uploaded
+                // directly.
+                QStringList paths;
                 for (auto &&u : source->urls()) {
-                        if (u.isLocalFile()) {
-                                path = u.toLocalFile();
-                                break;
-                        }
+                        if (u.isLocalFile() && QFileInfo{u.toLocalFile()}.exists())
+                                paths.push_back(u.toLocalFile());
                 }
 
-                if (!path.isEmpty() && QFileInfo{path}.exists()) {
-                        previewDialog_.setPreview(path);
-                } else {
+                if (paths.isEmpty()) {
                         qWarning()
                           << "Clipboard does not contain any valid file paths:" << source->urls();
+                } else if (paths.size() == 1) {
+                        previewDialog_.setPreview(paths.front());
+                } else {
+                        for (const auto &path : paths)
+                                uploadPath(path);
                 }
         } else if (source->hasFormat("x-special/gnome-copied-files")) {
                 // Special case for X11 users. See "Notes for X11 Users" in source.
@@ -401,9 +413,37 @@ FilteredTextEdit::submit()
 }
 
 void
-FilteredTextEdit::textChanged()
+FilteredTextEdit::trackChange(int position, int charsRemoved, int charsAdded)
+{
+        // The document is copied into the history lazily, right before
+        // the history is read. Copying it here would make every keystroke
+        // cost a full toPlainText(), which is felt with large pasted text.
+        workingHistoryDirty_ = true;
+
+        if (!isAnchorValid())
+                return;
+
+        if (position + charsRemoved <= atTriggerPosition_ && position < atTriggerPosition_) {
+                // The edit happened entirely before the completer trigger,
+                // e.g a paste at the start of the line; shift the anchor
+                // along with the text.
+                atTriggerPosition_ += charsAdded - charsRemoved;
+        } else if (position <= atTriggerPosition_ &&
+                   position + charsRemoved > atTriggerPosition_) {
+                // The edit removed the trigger character itself.
+                resetAnchor();
+                closeSuggestions();
+        }
+}
+
+void
+FilteredTextEdit::syncWorkingHistory()
 {
+        if (!workingHistoryDirty_)
+                return;
+
         working_history_[history_index_] = toPlainText();
+        workingHistoryDirty_             = false;
 }
 
 void
@@ -424,12 +464,44 @@ FilteredTextEdit::uploadData(const QByteArray data, const QString &media, const
                 emit file(buffer, filename);
 }
 
+void
+FilteredTextEdit::uploadPath(const QString &path)
+{
+        QMimeDatabase db;
+        QMimeType mime = db.mimeTypeForFile(path, QMimeDatabase::MatchContent);
+
+        const auto format = mime.name().split("/")[0];
+
+        QSharedPointer<QFile> data{new QFile{path, this}};
+
+        emit startedUpload();
+
+        if (format == "image")
+                emit image(data, path);
+        else if (format == "audio")
+                emit audio(data, path);
+        else if (format == "video")
+                emit video(data, path);
+        else
+                emit file(data, path);
+}
+
 void
 FilteredTextEdit::showPreview(const QMimeData *source, const QStringList &formats)
 {
         // Retrieve data as MIME type.
         auto const &mime = formats.first();
-        QByteArray data  = source->data(mime);
+
+        // data() would synchronously encode a copied image into the
+        // negotiated format; for a large screenshot that blocks the
+        // composer well past a frame. Hand the implicitly shared pixels
+        // over instead and let the dialog encode them on a worker.
+        if (source->hasImage() && mime.startsWith("image/")) {
+                previewDialog_.setPreview(qvariant_cast<QImage>(source->imageData()), mime);
+                return;
+        }
+
+        QByteArray data = source->data(mime);
         previewDialog_.setPreview(data, mime);
 }
 
@@ -567,6 +639,9 @@ TextInputWidget::command(QString command, QString args)
                 sendEmoteMessage(args);
         } else if (command == "join") {
                 sendJoinRoomRequest(args);
+        } else if (command == "export") {
+                if (!args.trimmed().isEmpty())
+                        emit exportHistoryRequest(args.trimmed());
         } else if (command == "shrug") {
                 sendTextMessage("¯\\_(ツ)_/¯");
         } else if (command == "fliptable") {
@@ -577,26 +652,28 @@ TextInputWidget::command(QString command, QString args)
 void
 TextInputWidget::openFileSelection()
 {
-        const auto fileName =
-          QFileDialog::getOpenFileName(this, tr("Select a file"), "", tr("All Files (*)"));
+        const auto fileNames = QFileDialog::getOpenFileNames(
+          this, tr("Select one or more files"), "", tr("All Files (*)"));
 
-        if (fileName.isEmpty())
+        if (fileNames.isEmpty())
                 return;
 
         QMimeDatabase db;
-        QMimeType mime = db.mimeTypeForFile(fileName, QMimeDatabase::MatchContent);
-
-        const auto format = mime.name().split("/")[0];
-
-        QSharedPointer<QFile> file{new QFile{fileName, this}};
-        if (format == "image")
-                emit uploadImage(file, fileName);
-        else if (format == "audio")
-                emit uploadAudio(file, fileName);
-        else if (format == "video")
-                emit uploadVideo(file, fileName);
-        else
-                emit uploadFile(file, fileName);
+        for (const auto &fileName : fileNames) {
+                QMimeType mime = db.mimeTypeForFile(fileName, QMimeDatabase::MatchContent);
+
+                const auto format = mime.name().split("/")[0];
+
+                QSharedPointer<QFile> file{new QFile{fileName, this}};
+                if (format == "image")
+                        emit uploadImage(file, fileName);
+                else if (format == "audio")
+                        emit uploadAudio(file, fileName);
+                else if (format == "video")
+                        emit uploadVideo(file, fileName);
+                else
+                        emit uploadFile(file, fileName);
+        }
 
         showUploadSpinner();
 }
@@ -645,6 +722,16 @@ TextInputWidget::paintEvent(QPaintEvent *)
         p.drawLine(QPointF(0, 0), QPointF(width(), 0));
 }
 
+void
+TextInputWidget::setInputText(const QString &text)
+{
+        input_->setText(text);
+
+        auto cursor = input_->textCursor();
+        cursor.movePosition(QTextCursor::End);
+        input_->setTextCursor(cursor);
+}
+
 void
 TextInputWidget::addReply(const QString &username, const QString &msg)
 {
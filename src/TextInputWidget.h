@@ -23,6 +23,7 @@
 
 #include <QApplication>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QHBoxLayout>
 #include <QPaintEvent>
 #include <QTextEdit>
@@ -55,6 +56,9 @@ public:
 
         void submit();
 
+        //! Milliseconds since the last keystroke in the edit.
+        qint64 msecsSinceLastTyped() const { return lastTyped_.elapsed(); }
+
 signals:
         void heightChanged(int height);
         void startedTyping();
@@ -91,6 +95,8 @@ private:
         std::deque<QString> true_history_, working_history_;
         size_t history_index_;
         QTimer *typingTimer_;
+        //! Stamp of the last keystroke, for detecting active typing.
+        QElapsedTimer lastTyped_;
 
         SuggestionsPopup popup_;
 
@@ -123,9 +129,21 @@ private:
 
         //! Latest position of the '@' character that triggers the username completer.
         int atTriggerPosition_ = -1;
-
-        void textChanged();
+        //! Whether the document has changed since it was last copied into
+        //! the working history.
+        bool workingHistoryDirty_ = false;
+
+        //! Incremental bookkeeping for a single edit. Marks the history
+        //! snapshot stale and keeps the completer anchor in place, using
+        //! only the changed range instead of rescanning the document.
+        void trackChange(int position, int charsRemoved, int charsAdded);
+        //! Snapshot the document into the working history. Called lazily
+        //! right before the history is read, so typing and pasting stay
+        //! proportional to the change instead of the document size.
+        void syncWorkingHistory();
         void uploadData(const QByteArray data, const QString &media, const QString &filename);
+        //! Classify a local file by content and emit the matching upload signal.
+        void uploadPath(const QString &path);
         void afterCompletion(int);
         void showPreview(const QMimeData *source, const QStringList &formats);
 };
@@ -154,11 +172,18 @@ public:
                 input_->setPlaceholderText(tr("Write a message..."));
         }
 
+        //! Milliseconds since the user last typed in the input.
+        qint64 msecsSinceLastTyped() const { return input_->msecsSinceLastTyped(); }
+
 public slots:
         void openFileSelection();
         void hideUploadSpinner();
         void focusLineEdit() { input_->setFocus(); }
         void addReply(const QString &username, const QString &msg);
+        //! The composer's current text, e.g. for journaling drafts.
+        QString inputText() const { return input_->toPlainText(); }
+        //! Replace the composer's content, e.g. with a restored draft.
+        void setInputText(const QString &text);
 
 private slots:
         void addSelectedEmoji(const QString &emoji);
@@ -174,6 +199,8 @@ signals:
         void uploadVideo(const QSharedPointer<QIODevice> data, const QString &filename);
 
         void sendJoinRoomRequest(const QString &room);
+        //! Export the history of the current room to the given file.
+        void exportHistoryRequest(const QString &path);
 
         void startedTyping();
         void stoppedTyping();
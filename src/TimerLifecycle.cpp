@@ -0,0 +1,227 @@
+/*
+ * nheko Copyright (C) 2017  Konstantinos Sideris <siderisk@auth.gr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QPointer>
+#include <QSet>
+#include <QTimer>
+#include <QWidget>
+
+#include "TimerLifecycle.h"
+
+namespace {
+
+//! Stops the timer while the widget can't be seen and restarts it when
+//! it can. Parented to the timer, so a registration needs no cleanup.
+class TimerGuard : public QObject
+{
+public:
+        TimerGuard(QWidget *widget, QTimer *timer)
+          : QObject(timer)
+          , widget_{widget}
+          , timer_{timer}
+        {
+                widget_->installEventFilter(this);
+
+                // Minimizing doesn't hide the children of a window, so the
+                // window's state changes are watched separately.
+                if (widget_->window() != widget_)
+                        widget_->window()->installEventFilter(this);
+        }
+
+        bool eventFilter(QObject *watched, QEvent *event) override
+        {
+                switch (event->type()) {
+                case QEvent::Show:
+                case QEvent::Hide:
+                case QEvent::WindowStateChange:
+                        if (canAnimate())
+                                resume();
+                        else
+                                suspend();
+                        break;
+                default:
+                        break;
+                }
+
+                return QObject::eventFilter(watched, event);
+        }
+
+private:
+        bool canAnimate() const
+        {
+                return widget_->isVisible() &&
+                       !(widget_->window()->windowState() & Qt::WindowMinimized);
+        }
+
+        void suspend()
+        {
+                if (!timer_->isActive())
+                        return;
+
+                resumePending_ = true;
+                timer_->stop();
+        }
+
+        void resume()
+        {
+                if (!resumePending_)
+                        return;
+
+                resumePending_ = false;
+                timer_->start();
+        }
+
+        QWidget *widget_;
+        QTimer *timer_;
+        //! Whether the timer was running when it was suspended.
+        bool resumePending_ = false;
+};
+
+//! Deadlines are rounded up to this slot size, so callbacks due in the
+//! same slot share one wakeup.
+constexpr int WHEEL_SLOT_MS = 100;
+
+struct ScheduledTask
+{
+        quint64 id;
+        QPointer<QObject> owner;
+        std::function<void()> fn;
+};
+
+//! All one-shot deadlines, served by a single driving timer that is
+//! armed for the earliest slot and stopped while the wheel is empty.
+class TimerWheel : public QObject
+{
+public:
+        explicit TimerWheel(QObject *parent)
+          : QObject(parent)
+        {
+                clock_.start();
+
+                driver_ = new QTimer(this);
+                driver_->setSingleShot(true);
+                driver_->setTimerType(Qt::CoarseTimer);
+                connect(driver_, &QTimer::timeout, this, [this]() { fire(); });
+        }
+
+        quint64 add(int ms, QObject *owner, std::function<void()> fn)
+        {
+                const qint64 slot =
+                  (clock_.elapsed() + std::max(ms, 0) + WHEEL_SLOT_MS - 1) / WHEEL_SLOT_MS;
+
+                const auto id = ++lastId_;
+
+                slots_[slot].push_back(ScheduledTask{id, owner, std::move(fn)});
+                pending_.insert(id);
+
+                rearm();
+
+                return id;
+        }
+
+        void cancel(quint64 id)
+        {
+                // Guarded by the pending set, so a stale handle can't
+                // grow the cancellation set forever.
+                if (pending_.remove(id))
+                        cancelled_.insert(id);
+        }
+
+private:
+        void fire()
+        {
+                const qint64 current = clock_.elapsed() / WHEEL_SLOT_MS;
+
+                while (!slots_.empty() && slots_.begin()->first <= current) {
+                        // Moved out, so a callback can schedule or cancel
+                        // without invalidating the iteration.
+                        auto tasks = std::move(slots_.begin()->second);
+                        slots_.erase(slots_.begin());
+
+                        for (auto &task : tasks) {
+                                pending_.remove(task.id);
+
+                                if (cancelled_.remove(task.id))
+                                        continue;
+
+                                if (task.owner.isNull())
+                                        continue;
+
+                                task.fn();
+                        }
+                }
+
+                rearm();
+        }
+
+        void rearm()
+        {
+                if (slots_.empty()) {
+                        driver_->stop();
+                        return;
+                }
+
+                const qint64 due = slots_.begin()->first * WHEEL_SLOT_MS - clock_.elapsed();
+                driver_->start(static_cast<int>(std::max<qint64>(0, due)));
+        }
+
+        QElapsedTimer clock_;
+        QTimer *driver_;
+        //! Tasks per due slot, in insertion order within a slot.
+        std::map<qint64, std::vector<ScheduledTask>> slots_;
+        //! Handles that haven't fired or been cancelled yet.
+        QSet<quint64> pending_;
+        //! Handles cancelled before their slot came up.
+        QSet<quint64> cancelled_;
+        quint64 lastId_ = 0;
+};
+
+TimerWheel *
+wheel()
+{
+        // Owned by the application object, so it is destroyed together
+        // with the event loop it depends on.
+        static auto instance = new TimerWheel(QCoreApplication::instance());
+
+        return instance;
+}
+}
+
+void
+timers::pauseWhenHidden(QWidget *widget, QTimer *timer)
+{
+        new TimerGuard(widget, timer);
+}
+
+quint64
+timers::schedule(int ms, QObject *owner, std::function<void()> fn)
+{
+        return wheel()->add(ms, owner, std::move(fn));
+}
+
+void
+timers::cancel(quint64 id)
+{
+        wheel()->cancel(id);
+}
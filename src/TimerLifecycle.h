@@ -0,0 +1,61 @@
+/*
+ * nheko Copyright (C) 2017  Konstantinos Sideris <siderisk@auth.gr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <functional>
+
+#include <QtGlobal>
+
+class QObject;
+class QTimer;
+class QWidget;
+
+//! Lifecycle hooks for animation & periodic timers.
+//!
+//! A timer that only exists to repaint or poll for a widget has no
+//! reason to fire while that widget can't be seen. Registered timers
+//! are stopped when their widget is hidden or its window is minimized
+//! and restarted when it becomes visible again, so an idle or trayed
+//! client doesn't wake the CPU.
+//!
+//! The module also hosts the retry wheel: a single timer serving all
+//! the one-shot retry & refresh deadlines of the client, so scheduling
+//! one costs a list append instead of a QTimer registration, nearby
+//! deadlines share a wakeup, and there is one place to audit what can
+//! wake the process.
+namespace timers {
+
+//! Suspend the timer while the widget is hidden or its window is
+//! minimized. A timer that is running at that moment is restarted on
+//! the next show. The hook lives as long as the timer.
+void
+pauseWhenHidden(QWidget *widget, QTimer *timer);
+
+//! Run @p fn on the GUI thread after roughly @p ms milliseconds. The
+//! deadline is rounded up to the wheel's slot size, so retries don't
+//! need (and don't get) millisecond precision. The callback is dropped
+//! if @p owner is destroyed first. Returns a handle for cancel(). Must
+//! be called from the GUI thread.
+quint64
+schedule(int ms, QObject *owner, std::function<void()> fn);
+
+//! Drop a scheduled callback. A handle that has already fired or been
+//! cancelled is ignored.
+void
+cancel(quint64 id);
+}
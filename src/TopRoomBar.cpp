@@ -69,18 +69,14 @@ TopRoomBar::TopRoomBar(QWidget *parent)
         settingsBtn_->setFixedSize(buttonSize_, buttonSize_);
         settingsBtn_->setCornerRadius(buttonSize_ / 2);
 
-        QIcon settings_icon;
-        settings_icon.addFile(":/icons/icons/ui/vertical-ellipsis.png");
-        settingsBtn_->setIcon(settings_icon);
+        settingsBtn_->setIcon(utils::cachedIcon(":/icons/icons/ui/vertical-ellipsis.png"));
         settingsBtn_->setIconSize(QSize(buttonSize_ / 2, buttonSize_ / 2));
 
         backBtn_ = new FlatButton(this);
         backBtn_->setFixedSize(buttonSize_, buttonSize_);
         backBtn_->setCornerRadius(buttonSize_ / 2);
 
-        QIcon backIcon;
-        backIcon.addFile(":/icons/icons/ui/angle-pointing-to-left.png");
-        backBtn_->setIcon(backIcon);
+        backBtn_->setIcon(utils::cachedIcon(":/icons/icons/ui/angle-pointing-to-left.png"));
         backBtn_->setIconSize(QSize(buttonSize_ / 2, buttonSize_ / 2));
         backBtn_->hide();
 
@@ -5,6 +5,7 @@
 
 #include "Config.h"
 #include "TypingDisplay.h"
+#include "Utils.h"
 #include "ui/Painter.h"
 
 constexpr int LEFT_PADDING = 24;
@@ -34,21 +35,26 @@ TypingDisplay::setUsers(const QStringList &uid)
 {
         move(0, parentWidget()->height() - offset_ - height());
 
-        text_.clear();
-
         if (uid.isEmpty()) {
+                text_.clear();
                 hide();
-                update();
 
                 return;
         }
 
-        text_ = uid.join(", ");
+        auto text = uid.join(", ");
 
         if (uid.size() == 1)
-                text_ += tr(" is typing");
-        else if (uid.size() > 1)
-                text_ += tr(" are typing");
+                text += tr(" is typing");
+        else
+                text += tr(" are typing");
+
+        // The membership changed but the rendered string didn't; don't
+        // invalidate the widget for it.
+        if (text == text_ && isVisible())
+                return;
+
+        text_ = text;
 
         show();
         update();
@@ -66,12 +72,15 @@ TypingDisplay::paintEvent(QPaintEvent *)
         QRect region = rect();
         region.translate(LEFT_PADDING, 0);
 
-        QFontMetrics fm(font());
-        text_ = fm.elidedText(text_, Qt::ElideRight, (double)(width() * 0.75));
+        // Memoized text metrics; the same string is painted many times
+        // while the typing state lasts. text_ itself is left intact so the
+        // unchanged-string check in setUsers keeps working.
+        const auto elided = utils::elidedText(font(), text_, (double)(width() * 0.75));
 
         QPainterPath path;
-        path.addRoundedRect(QRectF(0, 0, fm.width(text_) + 2 * LEFT_PADDING, height()), 3, 3);
+        path.addRoundedRect(
+          QRectF(0, 0, utils::textWidth(font(), elided) + 2 * LEFT_PADDING, height()), 3, 3);
 
         p.fillPath(path, backgroundColor());
-        p.drawText(region, Qt::AlignVCenter, text_);
+        p.drawText(region, Qt::AlignVCenter, elided);
 }
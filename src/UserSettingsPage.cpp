@@ -18,6 +18,8 @@
 #include <QApplication>
 #include <QComboBox>
 #include <QDebug>
+#include <QFile>
+#include <QHash>
 #include <QLabel>
 #include <QPushButton>
 #include <QScrollArea>
@@ -26,6 +28,7 @@
 #include "Config.h"
 #include "MatrixClient.h"
 #include "Olm.h"
+#include "Utils.h"
 #include "UserSettingsPage.h"
 #include "Utils.h"
 #include "ui/FlatButton.h"
@@ -33,7 +36,21 @@
 
 #include "version.h"
 
-UserSettings::UserSettings() { load(); }
+UserSettings::UserSettings()
+{
+        load();
+
+        flushTimer_ = new QTimer(this);
+        flushTimer_->setSingleShot(true);
+        flushTimer_->setInterval(1000);
+        connect(flushTimer_, &QTimer::timeout, this, &UserSettings::flush);
+
+        // Whatever the timer hasn't written yet goes out with the process.
+        connect(QCoreApplication::instance(),
+                &QCoreApplication::aboutToQuit,
+                this,
+                &UserSettings::flush);
+}
 
 void
 UserSettings::load()
@@ -47,6 +64,8 @@ UserSettings::load()
         isTypingNotificationsEnabled_ = settings.value("user/typing_notifications", true).toBool();
         isReadReceiptsEnabled_        = settings.value("user/read_receipts", true).toBool();
         theme_                        = settings.value("user/theme", "light").toString();
+        uploadImageQuality_           = settings.value("user/uploads/image_quality", 85).toInt();
+        uploadImageMaxDimension_ = settings.value("user/uploads/image_max_dimension", 2048).toInt();
 
         applyTheme();
 }
@@ -62,29 +81,68 @@ UserSettings::setTheme(QString theme)
 void
 UserSettings::applyTheme()
 {
-        QFile stylefile;
+        // Setting the application stylesheet repolishes every widget in
+        // the process, so a redundant reapplication is far from free.
+        static QString appliedTheme;
+
+        if (theme() == appliedTheme)
+                return;
+
+        appliedTheme = theme();
+
+        QString stylepath;
         QPalette pal;
 
         if (theme() == "light") {
-                stylefile.setFileName(":/styles/styles/nheko.qss");
+                stylepath = ":/styles/styles/nheko.qss";
                 pal.setColor(QPalette::Link, QColor("#333"));
         } else if (theme() == "dark") {
-                stylefile.setFileName(":/styles/styles/nheko-dark.qss");
+                stylepath = ":/styles/styles/nheko-dark.qss";
                 pal.setColor(QPalette::Link, QColor("#d7d9dc"));
         } else {
-                stylefile.setFileName(":/styles/styles/system.qss");
+                stylepath = ":/styles/styles/system.qss";
         }
 
-        stylefile.open(QFile::ReadOnly);
-        QString stylesheet = QString(stylefile.readAll());
+        static QHash<QString, QString> stylesheets;
+
+        if (!stylesheets.contains(stylepath)) {
+                QFile stylefile{stylepath};
+                stylefile.open(QFile::ReadOnly);
+                stylesheets.insert(stylepath, QString(stylefile.readAll()));
+        }
+
+        // Each repolished widget schedules its own repaint; holding the
+        // updates back turns those into a single paint pass per window.
+        const auto windows = QApplication::topLevelWidgets();
+        for (auto *window : windows)
+                window->setUpdatesEnabled(false);
 
         QApplication::setPalette(pal);
-        qobject_cast<QApplication *>(QApplication::instance())->setStyleSheet(stylesheet);
+        qobject_cast<QApplication *>(QApplication::instance())
+          ->setStyleSheet(stylesheets.value(stylepath));
+
+        for (auto *window : windows)
+                window->setUpdatesEnabled(true);
+
+        // Cached text measurements were made with the fonts of the old theme.
+        utils::clearTextMetricsCache();
 }
 
 void
 UserSettings::save()
 {
+        isDirty_ = true;
+        flushTimer_->start();
+}
+
+void
+UserSettings::flush()
+{
+        if (!isDirty_)
+                return;
+
+        isDirty_ = false;
+
         QSettings settings;
         settings.beginGroup("user");
 
@@ -99,6 +157,12 @@ UserSettings::save()
         settings.setValue("group_view", isGroupViewEnabled_);
         settings.setValue("desktop_notifications", hasDesktopNotifications_);
         settings.setValue("theme", theme());
+
+        settings.beginGroup("uploads");
+        settings.setValue("image_quality", uploadImageQuality_);
+        settings.setValue("image_max_dimension", uploadImageMaxDimension_);
+        settings.endGroup();
+
         settings.endGroup();
 }
 
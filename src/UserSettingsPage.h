@@ -22,6 +22,7 @@
 #include <QLabel>
 #include <QLayout>
 #include <QSharedPointer>
+#include <QTimer>
 #include <QWidget>
 
 class Toggle;
@@ -37,7 +38,13 @@ class UserSettings : public QObject
 public:
         UserSettings();
 
+        //! Request persistence. The write is coalesced: a burst of
+        //! toggles hits the disk once when the flush timer fires, or at
+        //! the latest on shutdown. Reads are always served from the
+        //! in-memory mirror.
         void save();
+        //! Write the mirrored values to disk, if a save is pending.
+        void flush();
         void load();
         void applyTheme();
         void setTheme(QString theme);
@@ -87,6 +94,10 @@ public:
         }
 
         QString theme() const { return !theme_.isEmpty() ? theme_ : "light"; }
+        //! JPEG quality used when an oversized image is re-encoded before upload.
+        int uploadImageQuality() const { return uploadImageQuality_; }
+        //! Images above this dimension are scaled down before upload.
+        int uploadImageMaxDimension() const { return uploadImageMaxDimension_; }
         bool isTrayEnabled() const { return isTrayEnabled_; }
         bool isStartInTrayEnabled() const { return isStartInTrayEnabled_; }
         bool isOrderingEnabled() const { return isOrderingEnabled_; }
@@ -107,6 +118,13 @@ private:
         bool isTypingNotificationsEnabled_;
         bool isReadReceiptsEnabled_;
         bool hasDesktopNotifications_;
+        int uploadImageQuality_;
+        int uploadImageMaxDimension_;
+
+        //! Debounce between save() and the disk write.
+        QTimer *flushTimer_;
+        //! Whether the mirror has changes the disk hasn't seen yet.
+        bool isDirty_ = false;
 };
 
 class HorizontalLine : public QFrame
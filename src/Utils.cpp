@@ -1,14 +1,233 @@
+#include "Config.h"
 #include "Utils.h"
 
 #include <QApplication>
+#include <QCache>
 #include <QDesktopWidget>
+#include <QFontMetrics>
+#include <QPainter>
 #include <QSettings>
+#include <QWidget>
 #include <cmath>
 
 #include <boost/variant.hpp>
+#include <mutex>
 
 using TimelineEvent = mtx::events::collections::TimelineEvents;
 
+namespace {
+//! Canonical copies of user & room identifiers, for the session.
+QHash<QString, QString> internPool_;
+//! The pool is reached from the sync & decryption threads as well.
+std::mutex internMutex_;
+
+//! (font, width, text) -> elided string.
+QCache<QString, QString> elidedTextCache_{8192};
+//! (font, text) -> advance width.
+QCache<QString, int> textWidthCache_{8192};
+//! string -> its first grapheme, uppercased.
+QCache<QString, QString> firstCharCache_{8192};
+//! (letter, colors, size, font) -> prerendered circular letter avatar.
+QCache<QString, QPixmap> letterAvatarCache_{1024};
+//! event id -> formatted rich-text body.
+QCache<QString, QString> formattedBodyCache_{8192};
+
+//! minute bucket -> formatted timestamp. A rendered value only changes
+//! when the current day rolls over ("14:03" turns into "Yesterday" at
+//! midnight), so the cache is dropped at the first lookup of a new day
+//! and repaints in between skip the locale formatting entirely.
+QCache<qint64, QString> timestampCache_{8192};
+qint64 timestampCacheDay_ = 0;
+//! Timestamps are also formatted from the sync thread.
+std::mutex timestampMutex_;
+
+//! resource path -> shared icon. Copies of a QIcon share one engine,
+//! so the asset is decoded & rasterized once for all its widgets.
+QHash<QString, QIcon> iconCache_;
+
+//! Whether the timeline scrollbar is currently being flung.
+bool fastScrolling_ = false;
+}
+
+QString
+utils::elidedText(const QFont &font, const QString &text, int width)
+{
+        const auto key = font.key() + QChar(0x1f) + QString::number(width) + QChar(0x1f) + text;
+
+        if (auto cached = elidedTextCache_.object(key))
+                return *cached;
+
+        const auto elided = QFontMetrics(font).elidedText(text, Qt::ElideRight, width);
+        elidedTextCache_.insert(key, new QString(elided));
+
+        return elided;
+}
+
+int
+utils::textWidth(const QFont &font, const QString &text)
+{
+        const auto key = font.key() + QChar(0x1f) + text;
+
+        if (auto cached = textWidthCache_.object(key))
+                return *cached;
+
+        const int width = QFontMetrics(font).width(text);
+        textWidthCache_.insert(key, new int(width));
+
+        return width;
+}
+
+void
+utils::clearTextMetricsCache()
+{
+        elidedTextCache_.clear();
+        textWidthCache_.clear();
+        letterAvatarCache_.clear();
+}
+
+void
+utils::releaseCaches()
+{
+        elidedTextCache_.clear();
+        textWidthCache_.clear();
+        firstCharCache_.clear();
+        letterAvatarCache_.clear();
+        formattedBodyCache_.clear();
+        iconCache_.clear();
+
+        std::lock_guard<std::mutex> lock(timestampMutex_);
+        timestampCache_.clear();
+}
+
+QIcon
+utils::cachedIcon(const QString &path)
+{
+        auto it = iconCache_.find(path);
+        if (it != iconCache_.end())
+                return *it;
+
+        QIcon icon;
+        icon.addFile(path);
+        iconCache_.insert(path, icon);
+
+        return icon;
+}
+
+void
+utils::setFastScrolling(bool active)
+{
+        fastScrolling_ = active;
+}
+
+bool
+utils::isFastScrolling()
+{
+        return fastScrolling_;
+}
+
+QString
+utils::intern(const QString &id)
+{
+        std::lock_guard<std::mutex> lock(internMutex_);
+
+        auto it = internPool_.constFind(id);
+        if (it != internPool_.constEnd())
+                return *it;
+
+        internPool_.insert(id, id);
+
+        return id;
+}
+
+QString
+utils::intern(const std::string &id)
+{
+        return intern(QString::fromStdString(id));
+}
+
+QString
+utils::escapeHtml(const QString &text)
+{
+        const QChar *data = text.constData();
+        const int size    = text.size();
+
+        // Scan for the first character that needs escaping; when there is
+        // none the input is returned without copying it.
+        int first = 0;
+        while (first < size) {
+                const auto ch = data[first].unicode();
+
+                if (ch == '<' || ch == '>' || ch == '&' || ch == '"')
+                        break;
+
+                ++first;
+        }
+
+        if (first == size)
+                return text;
+
+        QString escaped;
+        escaped.reserve(size + 16);
+        escaped.append(data, first);
+
+        for (int i = first; i < size; ++i) {
+                switch (data[i].unicode()) {
+                case '<':
+                        escaped += QLatin1String("&lt;");
+                        break;
+                case '>':
+                        escaped += QLatin1String("&gt;");
+                        break;
+                case '&':
+                        escaped += QLatin1String("&amp;");
+                        break;
+                case '"':
+                        escaped += QLatin1String("&quot;");
+                        break;
+                default:
+                        escaped += data[i];
+                }
+        }
+
+        return escaped;
+}
+
+QString
+utils::formatBody(const QString &body)
+{
+        auto formatted = escapeHtml(body);
+
+        // The regex walk dominates the formatting cost; a substring probe
+        // for the only two ways a link can start skips it for the typical
+        // linkless body.
+        if (formatted.contains(QLatin1String("://")) ||
+            formatted.contains(QLatin1String("www.")))
+                formatted.replace(conf::strings::url_regex, conf::strings::url_html);
+
+        if (formatted.contains(QLatin1Char('\n')))
+                formatted.replace("\n", "<br/>");
+
+        return formatted;
+}
+
+QString
+utils::formatBody(const QString &event_id, const QString &body)
+{
+        if (auto cached = formattedBodyCache_.object(event_id))
+                return *cached;
+
+        const auto formatted = formatBody(body);
+        formattedBodyCache_.insert(event_id, new QString(formatted));
+
+        return formatted;
+}
+
+void
+utils::invalidateFormattedBody(const QString &event_id)
+{
+        formattedBodyCache_.remove(event_id);
+}
+
 QString
 utils::localUser()
 {
@@ -59,20 +278,64 @@ utils::setKeyRequestsPreference(QString roomId, bool value)
         settings.setValue("rooms/respond_to_key_requests/" + roomId, value);
 }
 
+utils::RetentionPolicy
+utils::roomRetentionPolicy(const QString &roomId)
+{
+        if (roomId.isEmpty())
+                return RetentionPolicy{};
+
+        QSettings settings;
+
+        RetentionPolicy policy;
+        policy.maxEvents  = settings.value("rooms/retention/max_events/" + roomId, 0).toInt();
+        policy.maxAgeDays = settings.value("rooms/retention/max_age_days/" + roomId, 0).toInt();
+
+        return policy;
+}
+
+void
+utils::setRoomRetentionPolicy(const QString &roomId, const RetentionPolicy &policy)
+{
+        if (roomId.isEmpty())
+                return;
+
+        QSettings settings;
+        settings.setValue("rooms/retention/max_events/" + roomId, policy.maxEvents);
+        settings.setValue("rooms/retention/max_age_days/" + roomId, policy.maxAgeDays);
+}
+
 QString
 utils::descriptiveTime(const QDateTime &then)
 {
-        const auto now  = QDateTime::currentDateTime();
+        const auto now    = QDateTime::currentDateTime();
+        const auto today  = static_cast<qint64>(now.date().toJulianDay());
+        const auto bucket = then.toMSecsSinceEpoch() / 60000;
+
+        std::lock_guard<std::mutex> lock(timestampMutex_);
+
+        if (today != timestampCacheDay_) {
+                timestampCache_.clear();
+                timestampCacheDay_ = today;
+        }
+
+        if (auto cached = timestampCache_.object(bucket))
+                return *cached;
+
         const auto days = then.daysTo(now);
 
+        QString formatted;
         if (days == 0)
-                return then.toString("HH:mm");
+                formatted = then.toString("HH:mm");
         else if (days < 2)
-                return QString("Yesterday");
+                formatted = QString("Yesterday");
         else if (days < 365)
-                return then.toString("dd/MM");
+                formatted = then.toString("dd/MM");
+        else
+                formatted = then.toString("dd/MM/yy");
 
-        return then.toString("dd/MM/yy");
+        timestampCache_.insert(bucket, new QString(formatted));
+
+        return formatted;
 }
 
 DescInfo
@@ -135,12 +398,61 @@ utils::firstChar(const QString &input)
         if (input.isEmpty())
                 return input;
 
-        for (auto const &c : input.toUcs4()) {
-                if (QString::fromUcs4(&c, 1) != QString("#"))
-                        return QString::fromUcs4(&c, 1).toUpper();
-        }
+        if (auto cached = firstCharCache_.object(input))
+                return *cached;
+
+        auto extract = [](const QString &input) {
+                for (auto const &c : input.toUcs4()) {
+                        if (QString::fromUcs4(&c, 1) != QString("#"))
+                                return QString::fromUcs4(&c, 1).toUpper();
+                }
 
-        return QString::fromUcs4(&input.toUcs4().at(0), 1).toUpper();
+                return QString::fromUcs4(&input.toUcs4().at(0), 1).toUpper();
+        };
+
+        const auto result = extract(input);
+        firstCharCache_.insert(input, new QString(result));
+
+        return result;
+}
+
+QPixmap
+utils::letterAvatar(const QString &letter,
+                    const QColor &textColor,
+                    const QColor &backgroundColor,
+                    int size,
+                    const QFont &font,
+                    qreal dpr)
+{
+        const auto key = letter + QChar(0x1f) + textColor.name() + QChar(0x1f) +
+                         backgroundColor.name() + QChar(0x1f) + QString::number(size) +
+                         QChar(0x1f) + font.key() + QChar(0x1f) + QString::number(dpr);
+
+        if (auto cached = letterAvatarCache_.object(key))
+                return *cached;
+
+        // Rendered at the pixel ratio of the requesting monitor; painting
+        // the variant at the logical size is then a 1:1 blit.
+        QPixmap pixmap(devicePixels(size, dpr), devicePixels(size, dpr));
+        pixmap.setDevicePixelRatio(dpr);
+        pixmap.fill(Qt::transparent);
+
+        QPainter painter(&pixmap);
+        painter.setRenderHint(QPainter::Antialiasing);
+
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(backgroundColor);
+        painter.drawEllipse(0, 0, size, size);
+
+        painter.setFont(font);
+        painter.setPen(textColor);
+        painter.setBrush(Qt::NoBrush);
+        painter.drawText(QRect(0, -1, size, size), Qt::AlignCenter, letter);
+        painter.end();
+
+        letterAvatarCache_.insert(key, new QPixmap(pixmap));
+
+        return pixmap;
 }
 
 QString
@@ -160,7 +472,7 @@ utils::humanReadableFileSize(uint64_t bytes)
 }
 
 int
-utils::levenshtein_distance(const std::string &s1, const std::string &s2)
+utils::levenshtein_distance(const std::string &s1, const std::string &s2, int max_distance)
 {
         const int nlen = s1.size();
         const int hlen = s2.size();
@@ -170,17 +482,31 @@ utils::levenshtein_distance(const std::string &s1, const std::string &s2)
         if (nlen == 1)
                 return s2.find(s1);
 
-        std::vector<int> row1(hlen + 1, 0);
+        // The rows are reused across calls; scoring thousands of candidates
+        // per keystroke shouldn't allocate per candidate.
+        thread_local std::vector<int> row1;
+        thread_local std::vector<int> row2;
+
+        row1.assign(hlen + 1, 0);
+        row2.resize(hlen + 1);
 
         for (int i = 0; i < nlen; ++i) {
-                std::vector<int> row2(1, i + 1);
+                row2[0] = i + 1;
 
+                // Branch-free inner loop over a flat row, so the compiler is
+                // free to vectorize it.
                 for (int j = 0; j < hlen; ++j) {
                         const int cost = s1[i] != s2[j];
-                        row2.push_back(
-                          std::min(row1[j + 1] + 1, std::min(row2[j] + 1, row1[j] + cost)));
+                        row2[j + 1] =
+                          std::min(row1[j + 1] + 1, std::min(row2[j] + 1, row1[j] + cost));
                 }
 
+                // The row minimum never decreases in later rows, so once it
+                // passes the budget the final score can't come back under it.
+                const int rowMin = *std::min_element(row2.begin(), row2.end());
+                if (rowMin > max_distance)
+                        return rowMin;
+
                 row1.swap(row2);
         }
 
@@ -214,16 +540,49 @@ utils::event_body(const mtx::events::collections::TimelineEvents &event)
         return QString();
 }
 
+int
+utils::devicePixels(int size)
+{
+        return devicePixels(size, QApplication::desktop()->screen()->devicePixelRatioF());
+}
+
+int
+utils::devicePixels(int size, qreal dpr)
+{
+        return static_cast<int>(std::ceil(dpr * (double)size));
+}
+
+qreal
+utils::screenDpr(const QWidget *widget)
+{
+        if (!widget)
+                return QApplication::desktop()->screen()->devicePixelRatioF();
+
+        // Tracks the screen under the window, so a move to another
+        // monitor is picked up on the next paint.
+        return widget->window()->devicePixelRatioF();
+}
+
 QPixmap
 utils::scaleImageToPixmap(const QImage &img, int size)
+{
+        return scaleImageToPixmap(
+          img, size, QApplication::desktop()->screen()->devicePixelRatioF());
+}
+
+QPixmap
+utils::scaleImageToPixmap(const QImage &img, int size, qreal dpr)
 {
         if (img.isNull())
                 return QPixmap();
 
-        const double sz =
-          std::ceil(QApplication::desktop()->screen()->devicePixelRatioF() * (double)size);
-        return QPixmap::fromImage(
+        const int sz = devicePixels(size, dpr);
+
+        auto pixmap = QPixmap::fromImage(
           img.scaled(sz, sz, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+        pixmap.setDevicePixelRatio(dpr);
+
+        return pixmap;
 }
 
 QPixmap
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <limits>
+
 #include <boost/variant.hpp>
 
 #include "Cache.h"
@@ -9,7 +11,10 @@
 #include "timeline/widgets/ImageItem.h"
 #include "timeline/widgets/VideoItem.h"
 
+#include <QColor>
 #include <QDateTime>
+#include <QFont>
+#include <QIcon>
 #include <QPixmap>
 #include <mtx/events/collections.hpp>
 
@@ -35,6 +40,20 @@ respondsToKeyRequests(const std::string &roomId);
 void
 setKeyRequestsPreference(QString roomId, bool value);
 
+//! Retention limits for the locally cached messages of a room,
+//! enforced while new events are ingested. Zero disables a limit.
+struct RetentionPolicy
+{
+        int maxEvents  = 0;
+        int maxAgeDays = 0;
+};
+
+RetentionPolicy
+roomRetentionPolicy(const QString &roomId);
+
+void
+setRoomRetentionPolicy(const QString &roomId, const RetentionPolicy &policy);
+
 //! Human friendly timestamp representation.
 QString
 descriptiveTime(const QDateTime &then);
@@ -53,6 +72,86 @@ firstChar(const QString &input);
 QString
 humanReadableFileSize(uint64_t bytes);
 
+//! Memoized version of QFontMetrics::elidedText. The sidebar & timeline
+//! measure the same unchanging strings on every paint; repeated results
+//! are served from a process-wide cache instead.
+QString
+elidedText(const QFont &font, const QString &text, int width);
+
+//! Memoized version of QFontMetrics::width.
+int
+textWidth(const QFont &font, const QString &text);
+
+//! Prerendered circular letter avatar, shared across all the items with
+//! the same initial, colors, size and pixel ratio.
+QPixmap
+letterAvatar(const QString &letter,
+             const QColor &textColor,
+             const QColor &backgroundColor,
+             int size,
+             const QFont &font,
+             qreal dpr = 1.0);
+
+//! Session-wide shared icon for a QRC asset. The room bar, sidebar and
+//! every timeline item recreate the same icons on construction; sharing
+//! one QIcon per path means each asset is decoded once. GUI thread only.
+QIcon
+cachedIcon(const QString &path);
+
+//! Drop all memoized text measurements e.g after a theme or font change.
+void
+clearTextMetricsCache();
+
+//! Drop every memoized string, icon & pixmap this module can rebuild
+//! on demand. Wired to the memory-pressure monitor.
+void
+releaseCaches();
+
+//! Paint-quality hint for the timeline's media widgets. While the
+//! scrollbar is being flung, a widget is often visible for a single
+//! frame, so the widgets paint their cached pixmaps as is instead of
+//! the antialiased rounded-corner variant. Full quality is restored
+//! when the scrolling settles.
+void
+setFastScrolling(bool active);
+bool
+isFastScrolling();
+
+//! Return the session-wide shared copy of a user or room identifier.
+//!
+//! The same "@user:server" id is stored thousands of times across
+//! timeline items, member maps and receipts; interning makes them all
+//! share one allocation and lets equality checks between them short
+//! circuit on the implicit-sharing pointer comparison.
+QString
+intern(const QString &id);
+QString
+intern(const std::string &id);
+
+//! HTML-escape a message body in a single pass over the raw character
+//! data. Bodies with nothing to escape — the vast majority — are
+//! returned as is, sharing the input's buffer.
+QString
+escapeHtml(const QString &text);
+
+//! Escape, linkify and convert the newlines of a message body to rich
+//! text. The result is memoized by event id: the timeline is rebuilt
+//! from the cache on every room switch while an event's body rarely
+//! changes, so the formatting cost is paid once per event. A body can
+//! change — redaction replaces it — so every mutation site must evict
+//! the entry with invalidateFormattedBody() before the event is
+//! rebound.
+QString
+formatBody(const QString &event_id, const QString &body);
+//! Evict an event's memoized formatted body, e.g. after a redaction
+//! replaced the content stored under its event id.
+void
+invalidateFormattedBody(const QString &event_id);
+//! Uncached variant, for local echoes and bodies that embed mutable
+//! state such as display names.
+QString
+formatBody(const QString &body);
+
 QString
 event_body(const mtx::events::collections::TimelineEvents &event);
 
@@ -179,12 +278,37 @@ message_body(const mtx::events::collections::TimelineEvents &event)
 }
 
 //! Calculate the Levenshtein distance between two strings with character skipping.
+//! Gives up and returns a score above @p max_distance as soon as the
+//! result can't come back under it, so a caller scoring many candidates
+//! against a running best pays only for the plausible ones.
+int
+levenshtein_distance(const std::string &s1,
+                     const std::string &s2,
+                     int max_distance = std::numeric_limits<int>::max());
+
+//! Edge length in device pixels of a square asset displayed at the
+//! given logical size. Uses the primary screen's pixel ratio.
+int
+devicePixels(int size);
+
+//! Same, for an explicit pixel ratio, e.g of the monitor the widget is
+//! currently on.
 int
-levenshtein_distance(const std::string &s1, const std::string &s2);
+devicePixels(int size, qreal dpr);
+
+//! Pixel ratio of the screen the widget's window is currently on, so
+//! assets can be rendered for the right monitor on mixed-DPI setups.
+qreal
+screenDpr(const QWidget *widget);
 
 QPixmap
 scaleImageToPixmap(const QImage &img, int size);
 
+//! Scale for an explicit pixel ratio. The pixmap carries the ratio, so
+//! painting it at the logical size is a 1:1 blit.
+QPixmap
+scaleImageToPixmap(const QImage &img, int size, qreal dpr);
+
 //! Convert a Content Matrix URI to an HTTP link.
 QString
 mxcToHttp(const QUrl &url, const QString &server, int port);
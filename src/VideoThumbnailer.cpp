@@ -0,0 +1,165 @@
+/*
+ * nheko Copyright (C) 2017  Konstantinos Sideris <siderisk@auth.gr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QBuffer>
+#include <QHash>
+#include <QMediaContent>
+#include <QMediaPlayer>
+#include <QPointer>
+#include <utility>
+#include <vector>
+
+#include "VideoThumbnailer.h"
+
+#include "Cache.h"
+#include "Logging.h"
+
+VideoFrameGrabber::VideoFrameGrabber(QObject *parent)
+  : QAbstractVideoSurface(parent)
+{}
+
+QList<QVideoFrame::PixelFormat>
+VideoFrameGrabber::supportedPixelFormats(QAbstractVideoBuffer::HandleType type) const
+{
+        if (type != QAbstractVideoBuffer::NoHandle)
+                return {};
+
+        return {QVideoFrame::Format_RGB32,
+                QVideoFrame::Format_ARGB32,
+                QVideoFrame::Format_ARGB32_Premultiplied,
+                QVideoFrame::Format_RGB565,
+                QVideoFrame::Format_RGB555};
+}
+
+bool
+VideoFrameGrabber::present(const QVideoFrame &frame)
+{
+        if (gotFrame_ || !frame.isValid())
+                return true;
+
+        QVideoFrame copy(frame);
+
+        if (!copy.map(QAbstractVideoBuffer::ReadOnly))
+                return true;
+
+        const auto format = QVideoFrame::imageFormatFromPixelFormat(copy.pixelFormat());
+
+        if (format != QImage::Format_Invalid) {
+                gotFrame_ = true;
+
+                // The frame buffer is only valid while mapped; make a deep copy.
+                emit frameAvailable(
+                  QImage(copy.bits(), copy.width(), copy.height(), copy.bytesPerLine(), format)
+                    .copy());
+        }
+
+        copy.unmap();
+
+        return true;
+}
+
+namespace VideoThumbnailer {
+
+//! An extraction currently in flight and the widgets waiting for it.
+struct PendingThumbnail
+{
+        std::vector<std::pair<QPointer<QObject>, ThumbnailCallback>> receivers;
+};
+
+//! In-flight extractions by cache key, so e.g the upload path and the
+//! local echo of the same video share a single decode.
+static QHash<QString, PendingThumbnail> pending_;
+
+//! Answer everyone waiting for the given extraction.
+static void
+finish(const QString &cacheKey, const QImage &img)
+{
+        auto pending = pending_.take(cacheKey);
+
+        for (auto &receiver : pending.receivers) {
+                if (receiver.first)
+                        receiver.second(img);
+        }
+}
+
+void
+extract(const QUrl &source, const QString &cacheKey, QObject *receiver, ThumbnailCallback cb)
+{
+        try {
+                const auto img = cache::client()->image(cacheKey);
+
+                if (!img.isNull()) {
+                        cb(img);
+                        return;
+                }
+        } catch (const lmdb::error &e) {
+                nhlog::db()->warn("failed to check the poster cache: {}", e.what());
+        }
+
+        if (pending_.contains(cacheKey)) {
+                pending_[cacheKey].receivers.emplace_back(receiver, cb);
+                return;
+        }
+
+        pending_[cacheKey].receivers.emplace_back(receiver, cb);
+
+        auto player  = new QMediaPlayer;
+        auto grabber = new VideoFrameGrabber(player);
+
+        player->setVideoOutput(grabber);
+        player->setMuted(true);
+
+        QObject::connect(grabber,
+                         &VideoFrameGrabber::frameAvailable,
+                         player,
+                         [player, cacheKey](const QImage &img) {
+                                 player->stop();
+                                 player->deleteLater();
+
+                                 if (!img.isNull()) {
+                                         QByteArray data;
+                                         QBuffer buffer(&data);
+                                         buffer.open(QIODevice::WriteOnly);
+                                         img.save(&buffer, "PNG");
+
+                                         try {
+                                                 cache::client()->saveImage(cacheKey, data);
+                                         } catch (const lmdb::error &e) {
+                                                 nhlog::db()->warn(
+                                                   "failed to save poster frame: {}", e.what());
+                                         }
+                                 }
+
+                                 finish(cacheKey, img);
+                         });
+
+        QObject::connect(
+          player,
+          static_cast<void (QMediaPlayer::*)(QMediaPlayer::Error)>(&QMediaPlayer::error),
+          player,
+          [player, cacheKey](QMediaPlayer::Error err) {
+                  nhlog::ui()->warn("failed to extract poster frame: {}", static_cast<int>(err));
+
+                  player->deleteLater();
+                  finish(cacheKey, QImage());
+          });
+
+        player->setMedia(QMediaContent(source));
+        player->play();
+}
+
+} // namespace VideoThumbnailer
@@ -0,0 +1,55 @@
+/*
+ * nheko Copyright (C) 2017  Konstantinos Sideris <siderisk@auth.gr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QAbstractVideoSurface>
+#include <QImage>
+#include <QUrl>
+#include <QVideoFrame>
+#include <functional>
+
+//! Captures the first decoded frame the media backend delivers.
+class VideoFrameGrabber : public QAbstractVideoSurface
+{
+        Q_OBJECT
+
+public:
+        explicit VideoFrameGrabber(QObject *parent = nullptr);
+
+        QList<QVideoFrame::PixelFormat> supportedPixelFormats(
+          QAbstractVideoBuffer::HandleType type) const override;
+        bool present(const QVideoFrame &frame) override;
+
+signals:
+        void frameAvailable(const QImage &frame);
+
+private:
+        bool gotFrame_ = false;
+};
+
+using ThumbnailCallback = std::function<void(QImage)>;
+
+namespace VideoThumbnailer {
+//! Extract asynchronously a poster frame for the given video and hand it
+//! to the receiver. The decoding is done by the platform's multimedia
+//! backend, off the GUI thread and hardware accelerated where the platform
+//! provides it. Extracted posters are stored in the media cache under the
+//! given key; subsequent requests are served from there.
+void
+extract(const QUrl &source, const QString &cacheKey, QObject *receiver, ThumbnailCallback cb);
+}
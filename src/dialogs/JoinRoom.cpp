@@ -1,10 +1,13 @@
 #include <QLabel>
 #include <QStyleOption>
 #include <QVBoxLayout>
+#include <QtConcurrent>
 
 #include "dialogs/JoinRoom.h"
 
+#include "Cache.h"
 #include "Config.h"
+#include "Logging.h"
 #include "ui/FlatButton.h"
 #include "ui/TextField.h"
 #include "ui/Theme.h"
@@ -14,6 +17,8 @@ using namespace dialogs;
 JoinRoom::JoinRoom(QWidget *parent)
   : QFrame(parent)
 {
+        qRegisterMetaType<std::vector<RoomSearchResult>>();
+
         setMinimumWidth(conf::modals::MIN_WIDGET_WIDTH);
         setSizePolicy(QSizePolicy::Maximum, QSizePolicy::Maximum);
 
@@ -45,9 +50,50 @@ JoinRoom::JoinRoom(QWidget *parent)
         layout->addLayout(buttonLayout);
         layout->addStretch(1);
 
+        // The rooms known locally are searched by name & topic as the
+        // user types; repeat queries never leave the client.
+        connect(this,
+                &JoinRoom::queryResults,
+                this,
+                [this](const std::vector<RoomSearchResult> &rooms) {
+                        auto pos = mapToGlobal(roomInput_->geometry().bottomLeft());
+
+                        popup_.setFixedWidth(roomInput_->width());
+                        popup_.addRooms(rooms);
+                        popup_.move(pos.x(), pos.y());
+                        popup_.show();
+                });
+
+        connect(roomInput_, &QLineEdit::textEdited, this, [this](const QString &query) {
+                // Ids and aliases are meant for the join request itself.
+                if (query.isEmpty() || query.startsWith("!") || query.startsWith("#")) {
+                        popup_.hide();
+                        return;
+                }
+
+                QtConcurrent::run([this, query = query.toLower()]() {
+                        try {
+                                emit queryResults(
+                                  cache::client()->searchRooms(query.toStdString()));
+                        } catch (const lmdb::error &e) {
+                                nhlog::db()->warn("room search failed: {}", e.what());
+                        }
+                });
+        });
+
+        connect(&popup_, &SuggestionsPopup::itemSelected, this, [this](const QString &room_id) {
+                popup_.hide();
+                roomInput_->clear();
+
+                emit closing(true, room_id);
+        });
+
         connect(roomInput_, &QLineEdit::returnPressed, this, &JoinRoom::handleInput);
         connect(confirmBtn_, &QPushButton::clicked, this, &JoinRoom::handleInput);
-        connect(cancelBtn_, &QPushButton::clicked, [this]() { emit closing(false, ""); });
+        connect(cancelBtn_, &QPushButton::clicked, [this]() {
+                popup_.hide();
+                emit closing(false, "");
+        });
 }
 
 void
@@ -56,8 +102,27 @@ JoinRoom::handleInput()
         if (roomInput_->text().isEmpty())
                 return;
 
+        popup_.hide();
+
+        auto room = roomInput_->text();
+
+        // A canonical alias of a joined room resolves locally; the join
+        // request then carries the room id and the server skips the
+        // directory lookup.
+        if (room.startsWith("#")) {
+                try {
+                        const auto room_id =
+                          cache::client()->roomIdFromAlias(room.toStdString());
+
+                        if (room_id)
+                                room = QString::fromStdString(*room_id);
+                } catch (const lmdb::error &e) {
+                        nhlog::db()->warn("alias lookup failed: {}", e.what());
+                }
+        }
+
         // TODO: input validation with error messages.
-        emit closing(true, roomInput_->text());
+        emit closing(true, room);
         roomInput_->clear();
 }
 
@@ -77,3 +142,11 @@ JoinRoom::showEvent(QShowEvent *event)
 
         QFrame::showEvent(event);
 }
+
+void
+JoinRoom::hideEvent(QHideEvent *event)
+{
+        popup_.hide();
+
+        QFrame::hideEvent(event);
+}
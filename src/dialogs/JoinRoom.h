@@ -1,9 +1,14 @@
 #pragma once
 
+#include <vector>
+
 #include <QFrame>
 
+#include "SuggestionsPopup.h"
+
 class FlatButton;
 class TextField;
+struct RoomSearchResult;
 
 namespace dialogs {
 
@@ -15,10 +20,13 @@ public:
 
 signals:
         void closing(bool isJoining, const QString &room);
+        //! Matches of the local room search for the typed query.
+        void queryResults(const std::vector<RoomSearchResult> &rooms);
 
 protected:
         void paintEvent(QPaintEvent *event) override;
         void showEvent(QShowEvent *event) override;
+        void hideEvent(QHideEvent *event) override;
 
 private slots:
         void handleInput();
@@ -28,6 +36,10 @@ private:
         FlatButton *cancelBtn_;
 
         TextField *roomInput_;
+
+        //! Popup with the rooms already known locally that match the
+        //! query, so discovery doesn't need a round trip.
+        SuggestionsPopup popup_;
 };
 
 } // dialogs
@@ -1,5 +1,7 @@
-#include <QListWidgetItem>
+#include <QLabel>
+#include <QListView>
 #include <QPainter>
+#include <QPainterPath>
 #include <QStyleOption>
 #include <QVBoxLayout>
 
@@ -7,48 +9,174 @@
 
 #include "AvatarProvider.h"
 #include "Cache.h"
-#include "ChatPage.h"
 #include "Config.h"
 #include "Utils.h"
-#include "ui/Avatar.h"
-#include "ui/FlatButton.h"
 
 using namespace dialogs;
 
-MemberItem::MemberItem(const RoomMember &member, QWidget *parent)
-  : QWidget(parent)
+constexpr std::size_t MEMBERS_PER_PAGE = 30;
+
+constexpr int AVATAR_SIZE  = 44;
+constexpr int ITEM_PADDING = 5;
+
+MemberListModel::MemberListModel(const QString &room_id, QObject *parent)
+  : QAbstractListModel(parent)
+  , room_id_{room_id}
+{}
+
+int
+MemberListModel::rowCount(const QModelIndex &parent) const
+{
+        if (parent.isValid())
+                return 0;
+
+        return static_cast<int>(members_.size());
+}
+
+QVariant
+MemberListModel::data(const QModelIndex &index, int role) const
 {
-        topLayout_ = new QHBoxLayout(this);
-        topLayout_->setMargin(0);
+        if (!index.isValid() || index.row() >= static_cast<int>(members_.size()))
+                return QVariant();
+
+        const auto &member = members_.at(index.row());
+
+        switch (role) {
+        case UserId:
+                return member.user_id;
+        case DisplayName:
+                return member.display_name.isEmpty() ? member.user_id : member.display_name;
+        case AvatarImage:
+                return member.avatar;
+        default:
+                return QVariant();
+        }
+}
 
-        textLayout_ = new QVBoxLayout;
-        textLayout_->setMargin(0);
-        textLayout_->setSpacing(0);
+bool
+MemberListModel::canFetchMore(const QModelIndex &parent) const
+{
+        if (parent.isValid())
+                return false;
 
-        avatar_ = new Avatar(this);
-        avatar_->setSize(44);
-        avatar_->setLetter(utils::firstChar(member.display_name));
+        return !endReached_;
+}
 
-        if (!member.avatar.isNull())
-                avatar_->setImage(member.avatar);
-        else
-                AvatarProvider::resolve(ChatPage::instance()->currentRoom(),
-                                        member.user_id,
-                                        this,
-                                        [this](const QImage &img) { avatar_->setImage(img); });
+void
+MemberListModel::fetchMore(const QModelIndex &)
+{
+        std::vector<RoomMember> page;
+
+        try {
+                const auto after =
+                  members_.empty() ? std::string() : members_.back().user_id.toStdString();
+                page = cache::client()->getMembersAfter(
+                  room_id_.toStdString(), after, MEMBERS_PER_PAGE);
+        } catch (const lmdb::error &e) {
+                qCritical() << e.what();
+                endReached_ = true;
+                return;
+        }
+
+        if (page.size() < MEMBERS_PER_PAGE)
+                endReached_ = true;
+
+        if (page.empty())
+                return;
+
+        const auto first = static_cast<int>(members_.size());
+
+        beginInsertRows(QModelIndex(), first, first + static_cast<int>(page.size()) - 1);
+        members_.insert(members_.end(), page.begin(), page.end());
+        endInsertRows();
+
+        for (auto i = first; i < static_cast<int>(members_.size()); i++) {
+                if (!members_.at(i).avatar.isNull())
+                        continue;
+
+                AvatarProvider::resolve(
+                  room_id_, members_.at(i).user_id, this, [this, i](const QImage &img) {
+                          members_.at(i).avatar = img;
+                          emit dataChanged(index(i), index(i), {AvatarImage});
+                  });
+        }
+}
+
+MemberItemDelegate::MemberItemDelegate(QObject *parent)
+  : QStyledItemDelegate(parent)
+{}
+
+void
+MemberItemDelegate::paint(QPainter *painter,
+                          const QStyleOptionViewItem &option,
+                          const QModelIndex &index) const
+{
+        const auto name   = index.data(MemberListModel::DisplayName).toString();
+        const auto userId = index.data(MemberListModel::UserId).toString();
+        const auto avatar = index.data(MemberListModel::AvatarImage).value<QImage>();
+
+        painter->save();
+        painter->setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
+
+        const auto rect = option.rect;
+        const QRect avatarRect(rect.left() + ITEM_PADDING,
+                               rect.top() + (rect.height() - AVATAR_SIZE) / 2,
+                               AVATAR_SIZE,
+                               AVATAR_SIZE);
+
+        QPainterPath path;
+        path.addEllipse(avatarRect);
+
+        if (!avatar.isNull()) {
+                painter->setClipPath(path);
+                painter->drawImage(avatarRect,
+                                   avatar.scaled(AVATAR_SIZE,
+                                                 AVATAR_SIZE,
+                                                 Qt::KeepAspectRatioByExpanding,
+                                                 Qt::SmoothTransformation));
+                painter->setClipping(false);
+        } else {
+                QFont letterFont;
+                letterFont.setPointSizeF(letterFont.pointSizeF() * 1.3);
+
+                painter->drawPixmap(avatarRect.topLeft(),
+                                    utils::letterAvatar(utils::firstChar(name),
+                                                        option.palette.color(QPalette::Text),
+                                                        option.palette.mid().color(),
+                                                        AVATAR_SIZE,
+                                                        letterFont));
+        }
 
         QFont nameFont;
         nameFont.setPointSizeF(nameFont.pointSizeF() * 1.1);
 
-        userId_   = new QLabel(member.user_id, this);
-        userName_ = new QLabel(member.display_name, this);
-        userName_->setFont(nameFont);
+        const int textLeft  = avatarRect.right() + 2 * ITEM_PADDING;
+        const int textWidth = rect.right() - textLeft - ITEM_PADDING;
+
+        const QRect nameRect(
+          textLeft, rect.top() + ITEM_PADDING, textWidth, rect.height() / 2 - ITEM_PADDING);
+        const QRect idRect(
+          textLeft, rect.top() + rect.height() / 2, textWidth, rect.height() / 2 - ITEM_PADDING);
+
+        painter->setPen(option.palette.color(QPalette::Text));
+        painter->setFont(nameFont);
+        painter->drawText(nameRect,
+                          Qt::AlignLeft | Qt::AlignVCenter,
+                          QFontMetrics(nameFont).elidedText(name, Qt::ElideRight, textWidth));
 
-        textLayout_->addWidget(userName_);
-        textLayout_->addWidget(userId_);
+        QFont idFont;
+        painter->setFont(idFont);
+        painter->drawText(idRect,
+                          Qt::AlignLeft | Qt::AlignVCenter,
+                          QFontMetrics(idFont).elidedText(userId, Qt::ElideRight, textWidth));
 
-        topLayout_->addWidget(avatar_);
-        topLayout_->addLayout(textLayout_, 1);
+        painter->restore();
+}
+
+QSize
+MemberItemDelegate::sizeHint(const QStyleOptionViewItem &, const QModelIndex &) const
+{
+        return QSize(AVATAR_SIZE + 4 * ITEM_PADDING, AVATAR_SIZE + 2 * ITEM_PADDING);
 }
 
 MemberList::MemberList(const QString &room_id, QWidget *parent)
@@ -61,11 +189,17 @@ MemberList::MemberList(const QString &room_id, QWidget *parent)
         layout->setSpacing(conf::modals::WIDGET_SPACING);
         layout->setMargin(conf::modals::WIDGET_MARGIN);
 
-        list_ = new QListWidget;
+        list_ = new QListView(this);
         list_->setFrameStyle(QFrame::NoFrame);
         list_->setSelectionMode(QAbstractItemView::NoSelection);
         list_->setAttribute(Qt::WA_MacShowFocusRect, 0);
         list_->setSpacing(5);
+        list_->setUniformItemSizes(true);
+        list_->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+
+        model_ = new MemberListModel(room_id_, this);
+        list_->setModel(model_);
+        list_->setItemDelegate(new MemberItemDelegate(list_));
 
         QFont doubleFont;
         doubleFont.setPointSizeF(doubleFont.pointSizeF() * 2);
@@ -86,62 +220,9 @@ MemberList::MemberList(const QString &room_id, QWidget *parent)
         layout->addWidget(topLabel_);
         layout->addWidget(list_);
 
-        list_->clear();
-
-        // Add button at the bottom.
-        moreBtn_  = new FlatButton(tr("SHOW MORE"), this);
-        auto item = new QListWidgetItem;
-        item->setSizeHint(moreBtn_->minimumSizeHint());
-        item->setFlags(Qt::NoItemFlags);
-        item->setTextAlignment(Qt::AlignCenter);
-        list_->insertItem(0, item);
-        list_->setItemWidget(item, moreBtn_);
-
-        connect(moreBtn_, &FlatButton::clicked, this, [this]() {
-                const size_t numMembers = list_->count() - 1;
-
-                if (numMembers > 0)
-                        addUsers(cache::client()->getMembers(room_id_.toStdString(), numMembers));
-        });
-
-        try {
-                addUsers(cache::client()->getMembers(room_id_.toStdString()));
-        } catch (const lmdb::error &e) {
-                qCritical() << e.what();
-        }
-}
-
-void
-MemberList::moveButtonToBottom()
-{
-        auto item = new QListWidgetItem(list_);
-        item->setSizeHint(moreBtn_->minimumSizeHint());
-        item->setFlags(Qt::NoItemFlags);
-        item->setTextAlignment(Qt::AlignCenter);
-        list_->setItemWidget(item, moreBtn_);
-        list_->addItem(item);
-}
-
-void
-MemberList::addUsers(const std::vector<RoomMember> &members)
-{
-        if (members.size() == 0) {
-                moreBtn_->hide();
-        } else {
-                moreBtn_->show();
-        }
-
-        for (const auto &member : members) {
-                auto user = new MemberItem(member, this);
-                auto item = new QListWidgetItem;
-
-                item->setSizeHint(user->minimumSizeHint());
-                item->setFlags(Qt::NoItemFlags);
-                item->setTextAlignment(Qt::AlignCenter);
-
-                list_->insertItem(list_->count() - 1, item);
-                list_->setItemWidget(item, user);
-        }
+        // Populate the first page; the view will request the rest as the
+        // user scrolls towards the end of the list.
+        model_->fetchMore(QModelIndex());
 }
 
 void
@@ -1,36 +1,56 @@
 #pragma once
 
+#include <QAbstractListModel>
 #include <QFrame>
-#include <QListWidget>
+#include <QStyledItemDelegate>
 
-class Avatar;
-class FlatButton;
-class QHBoxLayout;
-class QLabel;
-class QVBoxLayout;
-
-struct RoomMember;
+#include "Cache.h"
 
-template<class T>
-class QSharedPointer;
+class QLabel;
+class QListView;
 
 namespace dialogs {
 
-class MemberItem : public QWidget
+//! Lazily populated model over the members of a room. Pages are fetched
+//! from the cache as the view scrolls towards the end of the list.
+class MemberListModel : public QAbstractListModel
 {
         Q_OBJECT
 
 public:
-        MemberItem(const RoomMember &member, QWidget *parent);
+        enum Roles
+        {
+                UserId = Qt::UserRole,
+                DisplayName,
+                AvatarImage,
+        };
+
+        MemberListModel(const QString &room_id, QObject *parent = nullptr);
+
+        int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+        QVariant data(const QModelIndex &index, int role) const override;
+
+        bool canFetchMore(const QModelIndex &parent) const override;
+        void fetchMore(const QModelIndex &parent) override;
 
 private:
-        QHBoxLayout *topLayout_;
-        QVBoxLayout *textLayout_;
+        QString room_id_;
+        std::vector<RoomMember> members_;
+        bool endReached_ = false;
+};
+
+class MemberItemDelegate : public QStyledItemDelegate
+{
+        Q_OBJECT
 
-        Avatar *avatar_;
+public:
+        explicit MemberItemDelegate(QObject *parent = nullptr);
 
-        QLabel *userName_;
-        QLabel *userId_;
+        void paint(QPainter *painter,
+                   const QStyleOptionViewItem &option,
+                   const QModelIndex &index) const override;
+        QSize sizeHint(const QStyleOptionViewItem &option,
+                       const QModelIndex &index) const override;
 };
 
 class MemberList : public QFrame
@@ -39,23 +59,13 @@ class MemberList : public QFrame
 public:
         MemberList(const QString &room_id, QWidget *parent = nullptr);
 
-public slots:
-        void addUsers(const std::vector<RoomMember> &users);
-
 protected:
         void paintEvent(QPaintEvent *event) override;
-        void hideEvent(QHideEvent *event) override
-        {
-                list_->clear();
-                QFrame::hideEvent(event);
-        }
 
 private:
-        void moveButtonToBottom();
-
         QString room_id_;
         QLabel *topLabel_;
-        QListWidget *list_;
-        FlatButton *moreBtn_;
+        QListView *list_;
+        MemberListModel *model_;
 };
 } // dialogs
@@ -20,8 +20,11 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QHBoxLayout>
+#include <QImageReader>
 #include <QMimeDatabase>
+#include <QPointer>
 #include <QVBoxLayout>
+#include <QtConcurrent>
 
 #include "dialogs/PreviewUploadOverlay.h"
 
@@ -29,6 +32,7 @@
 #include "Logging.h"
 #include "MainWindow.h"
 #include "Utils.h"
+#include "ui/LoadingIndicator.h"
 
 using namespace dialogs;
 
@@ -49,8 +53,20 @@ PreviewUploadOverlay::PreviewUploadOverlay(QWidget *parent)
         hlayout->setSpacing(0);
         hlayout->setMargin(0);
 
+        spinner_ = new LoadingIndicator(this);
+        spinner_->setFixedHeight(40);
+        spinner_->setFixedWidth(40);
+        spinner_->hide();
+
+        auto spinnerLayout = new QVBoxLayout;
+        spinnerLayout->addWidget(spinner_);
+        spinnerLayout->setAlignment(Qt::AlignCenter);
+        spinnerLayout->setMargin(0);
+        spinnerLayout->setSpacing(0);
+
         auto vlayout = new QVBoxLayout{this};
         vlayout->addWidget(&titleLabel_);
+        vlayout->addLayout(spinnerLayout);
         vlayout->addWidget(&infoLabel_);
         vlayout->addWidget(&fileName_);
         vlayout->addLayout(hlayout);
@@ -62,6 +78,11 @@ PreviewUploadOverlay::PreviewUploadOverlay(QWidget *parent)
                 close();
         });
         connect(&cancel_, &QPushButton::clicked, this, &PreviewUploadOverlay::close);
+
+        // Emitted from the worker thread, so both connections end up
+        // queued and the widget is only touched from the GUI thread.
+        connect(this, &PreviewUploadOverlay::previewReady, this, &PreviewUploadOverlay::showPreview);
+        connect(this, &PreviewUploadOverlay::mediaRead, this, &PreviewUploadOverlay::setMedia);
 }
 
 void
@@ -104,30 +125,27 @@ PreviewUploadOverlay::init()
         if (isImage_) {
                 infoLabel_.setAlignment(Qt::AlignCenter);
 
-                const auto maxWidth  = winsize.width() * 0.8;
-                const auto maxHeight = winsize.height() * 0.8;
+                maxPreviewSize_ = QSize(winsize.width() * 0.8, winsize.height() * 0.8);
 
-                // Scale image preview to fit into the application window.
-                infoLabel_.setPixmap(utils::scaleDown(maxWidth, maxHeight, image_));
-                move(center.x() - (width() * 0.5), center.y() - (height() * 0.5));
+                // The preview decodes on a worker thread; the spinner
+                // holds its place so the dialog shows up immediately.
+                spinner_->start();
+                spinner_->show();
         } else {
                 infoLabel_.setAlignment(Qt::AlignLeft);
         }
         infoLabel_.setScaledContents(false);
 
+        move(center.x() - (width() * 0.5), center.y() - (height() * 0.5));
+
         show();
 }
 
 void
-PreviewUploadOverlay::setLabels(const QString &type, const QString &mime, uint64_t upload_size)
+PreviewUploadOverlay::setLabels(const QString &mime, uint64_t upload_size)
 {
-        if (mediaType_ == "image") {
-                if (!image_.loadFromData(data_)) {
-                        titleLabel_.setText(QString{tr(ERR_MSG)}.arg(type));
-                } else {
-                        titleLabel_.setText(QString{tr(DEFAULT)}.arg(mediaType_));
-                }
-                isImage_ = true;
+        if (isImage_) {
+                titleLabel_.setText(QString{tr(DEFAULT)}.arg(mediaType_));
         } else {
                 auto const info = QString{tr("Media type: %1\n"
                                              "Media size: %2\n")}
@@ -139,6 +157,75 @@ PreviewUploadOverlay::setLabels(const QString &type, const QString &mime, uint64
         }
 }
 
+void
+PreviewUploadOverlay::loadPreview(const QByteArray &data, QSize bounds)
+{
+        QBuffer buffer;
+        buffer.setData(data);
+        buffer.open(QIODevice::ReadOnly);
+
+        QImageReader reader(&buffer);
+        reader.setAutoTransform(true);
+
+        const auto original = reader.size();
+
+        // Without dimensions in the header the format needs a full
+        // decode anyway.
+        if (!original.isValid()) {
+                emit previewReady(reader.read());
+                return;
+        }
+
+        auto display = original;
+        if (original.width() > bounds.width() || original.height() > bounds.height())
+                display = original.scaled(bounds, Qt::KeepAspectRatio);
+
+        // Serve a rough placeholder right away; JPEGs decode it almost
+        // for free through DCT scaling.
+        reader.setScaledSize(display / 8);
+        emit previewReady(reader.read());
+
+        buffer.seek(0);
+
+        QImageReader displayReader(&buffer);
+        displayReader.setAutoTransform(true);
+        displayReader.setScaledSize(display);
+
+        emit previewReady(displayReader.read());
+}
+
+void
+PreviewUploadOverlay::showPreview(const QImage &image)
+{
+        spinner_->stop();
+        spinner_->hide();
+
+        if (image.isNull()) {
+                titleLabel_.setText(QString{tr(ERR_MSG)}.arg(QFileInfo{filePath_}.suffix()));
+                return;
+        }
+
+        infoLabel_.setPixmap(QPixmap::fromImage(image));
+        adjustSize();
+
+        if (auto window = MainWindow::instance()) {
+                const auto center = window->frameGeometry().center();
+                move(center.x() - (width() * 0.5), center.y() - (height() * 0.5));
+        }
+}
+
+void
+PreviewUploadOverlay::setMedia(const QByteArray &data)
+{
+        if (data.isEmpty()) {
+                close();
+                return;
+        }
+
+        data_ = data;
+        upload_.setEnabled(true);
+}
+
 void
 PreviewUploadOverlay::setPreview(const QByteArray data, const QString &mime)
 {
@@ -148,40 +235,120 @@ PreviewUploadOverlay::setPreview(const QByteArray data, const QString &mime)
         data_      = data;
         mediaType_ = split[0];
         filePath_  = "clipboard." + type;
-        isImage_   = false;
+        isImage_   = mediaType_ == "image";
 
-        setLabels(type, mime, data_.size());
+        setLabels(mime, data_.size());
         init();
+
+        if (!isImage_)
+                return;
+
+        const auto bounds = maxPreviewSize_;
+        QPointer<PreviewUploadOverlay> self(this);
+        QtConcurrent::run([self, data = data_, bounds]() {
+                if (self)
+                        self->loadPreview(data, bounds);
+        });
 }
 
 void
-PreviewUploadOverlay::setPreview(const QString &path)
+PreviewUploadOverlay::setPreview(const QImage &image, const QString &mime)
 {
-        QFile file{path};
+        auto const &split = mime.split('/');
+        auto const &type  = split[1];
 
-        if (!file.open(QIODevice::ReadOnly)) {
-                nhlog::ui()->warn("Failed to open file ({}): {}",
-                                  path.toStdString(),
-                                  file.errorString().toStdString());
-                close();
-                return;
-        }
+        data_      = QByteArray();
+        mediaType_ = split[0];
+        filePath_  = "clipboard." + type;
+        isImage_   = true;
 
-        QMimeDatabase db;
-        auto mime = db.mimeTypeForFileNameAndData(path, &file);
+        setLabels(mime, 0);
 
-        if ((data_ = file.readAll()).isEmpty()) {
-                nhlog::ui()->warn("Failed to read media: {}", file.errorString().toStdString());
-                close();
-                return;
-        }
+        // The encoded bytes don't exist yet; uploading before the worker
+        // has produced them would send nothing.
+        upload_.setEnabled(false);
+        init();
+
+        // The clipboard hands the pixels over implicitly shared, so the
+        // echo costs a scale, not a decode. An oversized image shows a
+        // rough scale first; the worker follows with the smooth one.
+        const auto bounds    = maxPreviewSize_;
+        const bool oversized =
+          image.width() > bounds.width() || image.height() > bounds.height();
+
+        showPreview(oversized ? image.scaled(bounds, Qt::KeepAspectRatio, Qt::FastTransformation)
+                              : image);
+
+        QPointer<PreviewUploadOverlay> self(this);
+        QtConcurrent::run([self, image, bounds, oversized, type]() {
+                if (!self)
+                        return;
+
+                if (oversized)
+                        emit self->previewReady(
+                          image.scaled(bounds, Qt::KeepAspectRatio, Qt::SmoothTransformation));
 
+                QByteArray data;
+                QBuffer buffer{&data};
+                buffer.open(QIODevice::WriteOnly);
+
+                if (!image.save(&buffer, type.toUpper().toLatin1().constData())) {
+                        // Fall back to PNG for clipboard formats
+                        // QImageWriter can't produce.
+                        data.clear();
+                        buffer.seek(0);
+
+                        if (!image.save(&buffer, "PNG"))
+                                nhlog::ui()->warn("failed to encode the pasted image ({})",
+                                                  type.toStdString());
+                }
+
+                if (self)
+                        emit self->mediaRead(data);
+        });
+}
+
+void
+PreviewUploadOverlay::setPreview(const QString &path)
+{
+        QMimeDatabase db;
+        auto const mime  = db.mimeTypeForFile(path);
         auto const &split = mime.name().split('/');
 
         mediaType_ = split[0];
-        filePath_  = file.fileName();
-        isImage_   = false;
+        filePath_  = path;
+        isImage_   = mediaType_ == "image";
+
+        setLabels(mime.name(), QFileInfo{path}.size());
 
-        setLabels(split[1], mime.name(), data_.size());
+        // The bytes are still on disk; uploading before they are in
+        // memory would send nothing.
+        upload_.setEnabled(false);
         init();
+
+        const auto bounds = maxPreviewSize_;
+        QPointer<PreviewUploadOverlay> self(this);
+        QtConcurrent::run([self, path, bounds]() {
+                if (!self)
+                        return;
+
+                QByteArray data;
+
+                QFile file{path};
+                if (file.open(QIODevice::ReadOnly))
+                        data = file.readAll();
+
+                if (data.isEmpty())
+                        nhlog::ui()->warn("Failed to read media ({}): {}",
+                                          path.toStdString(),
+                                          file.errorString().toStdString());
+
+                if (!self)
+                        return;
+
+                emit self->mediaRead(data);
+
+                if (!data.isEmpty() && self->isImage_)
+                        self->loadPreview(data, bounds);
+        });
 }
@@ -17,14 +17,15 @@
 
 #pragma once
 
+#include <QImage>
 #include <QLabel>
 #include <QLineEdit>
-#include <QPixmap>
 #include <QWidget>
 
 #include "ui/FlatButton.h"
 
 class QMimeData;
+class LoadingIndicator;
 
 namespace dialogs {
 
@@ -35,26 +36,45 @@ public:
         PreviewUploadOverlay(QWidget *parent = nullptr);
 
         void setPreview(const QByteArray data, const QString &mime);
+        //! Preview a pasted image straight from its pixels. The image is
+        //! shown immediately and encoded on a worker thread; the upload
+        //! button unlocks when the bytes are ready.
+        void setPreview(const QImage &image, const QString &mime);
         void setPreview(const QString &path);
 
 signals:
         void confirmUpload(const QByteArray data, const QString &media, const QString &filename);
 
+        //! Delivered from the decode thread; a reduced-resolution
+        //! placeholder arrives first, the proper decode after it.
+        void previewReady(const QImage &image);
+        //! Delivered from the worker thread once the media bytes are in
+        //! memory.
+        void mediaRead(const QByteArray &data);
+
 private:
         void init();
-        void setLabels(const QString &type, const QString &mime, uint64_t upload_size);
+        void setLabels(const QString &mime, uint64_t upload_size);
+        //! Decode & scale the preview. Runs on a worker thread.
+        void loadPreview(const QByteArray &data, QSize bounds);
+        void showPreview(const QImage &image);
+        void setMedia(const QByteArray &data);
 
         bool isImage_;
-        QPixmap image_;
 
         QByteArray data_;
         QString filePath_;
         QString mediaType_;
+        //! The preview is scaled to fit the application window; computed
+        //! on show, used by the decode thread.
+        QSize maxPreviewSize_;
 
         QLabel titleLabel_;
         QLabel infoLabel_;
         QLineEdit fileName_;
 
+        LoadingIndicator *spinner_;
+
         FlatButton upload_;
         FlatButton cancel_;
 };
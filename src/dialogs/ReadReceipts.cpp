@@ -17,6 +17,10 @@
 
 using namespace dialogs;
 
+//! Receipt rows built per iteration of the event loop. One chunk covers
+//! more than a screenful; the rest arrive while the user reads.
+static constexpr int RECEIPT_BATCH_SIZE = 50;
+
 ReceiptItem::ReceiptItem(QWidget *parent,
                          const QString &user_id,
                          uint64_t timestamp,
@@ -107,15 +111,35 @@ ReadReceipts::ReadReceipts(QWidget *parent)
 
         layout->addWidget(topLabel_);
         layout->addWidget(userList_);
+
+        populateTimer_ = new QTimer(this);
+        populateTimer_->setSingleShot(true);
+        connect(populateTimer_, &QTimer::timeout, this, &ReadReceipts::addNextBatch);
 }
 
 void
 ReadReceipts::addUsers(const std::multimap<uint64_t, std::string, std::greater<uint64_t>> &receipts)
 {
         // We want to remove any previous items that have been set.
+        populateTimer_->stop();
+        pendingReceipts_.clear();
         userList_->clear();
 
-        for (const auto &receipt : receipts) {
+        for (const auto &receipt : receipts)
+                pendingReceipts_.emplace_back(receipt.first, receipt.second);
+
+        // The first chunk is built synchronously so the dialog never
+        // opens empty; the avatars fill in through the provider's queue.
+        addNextBatch();
+}
+
+void
+ReadReceipts::addNextBatch()
+{
+        for (int i = 0; i < RECEIPT_BATCH_SIZE && !pendingReceipts_.empty(); i++) {
+                const auto receipt = pendingReceipts_.front();
+                pendingReceipts_.pop_front();
+
                 auto user = new ReceiptItem(this,
                                             QString::fromStdString(receipt.second),
                                             receipt.first,
@@ -128,6 +152,9 @@ ReadReceipts::addUsers(const std::multimap<uint64_t, std::string, std::greater<u
 
                 userList_->setItemWidget(item, user);
         }
+
+        if (!pendingReceipts_.empty())
+                populateTimer_->start(0);
 }
 
 void
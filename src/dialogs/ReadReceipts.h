@@ -1,10 +1,13 @@
 #pragma once
 
+#include <deque>
+
 #include <QDateTime>
 #include <QFrame>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QListWidget>
+#include <QTimer>
 #include <QVBoxLayout>
 
 class Avatar;
@@ -46,13 +49,25 @@ protected:
         void paintEvent(QPaintEvent *event) override;
         void hideEvent(QHideEvent *event) override
         {
+                populateTimer_->stop();
+                pendingReceipts_.clear();
                 userList_->clear();
                 QFrame::hideEvent(event);
         }
 
 private:
+        //! Build the next chunk of receipt rows and reschedule until the
+        //! queue is drained, so a large room fills the list progressively
+        //! instead of blocking the dialog on open.
+        void addNextBatch();
+
         QLabel *topLabel_;
 
         QListWidget *userList_;
+
+        //! Receipts that still need a row, newest first.
+        std::deque<std::pair<uint64_t, std::string>> pendingReceipts_;
+        //! Schedules the construction of the next chunk of rows.
+        QTimer *populateTimer_;
 };
 } // dialogs
@@ -10,6 +10,7 @@
 #include <QShowEvent>
 #include <QStyleOption>
 #include <QVBoxLayout>
+#include <QtConcurrent>
 
 #include "dialogs/RoomSettings.h"
 
@@ -37,6 +38,10 @@ constexpr int WIDGET_SPACING    = 15;
 constexpr int TEXT_SPACING      = 4;
 constexpr int BUTTON_SPACING    = 2 * TEXT_SPACING;
 
+//! Values behind the retention combo boxes; zero disables a limit.
+constexpr int RETENTION_AGE_DAYS[]   = {0, 30, 7, 1};
+constexpr int RETENTION_MAX_EVENTS[] = {0, 10000, 1000, 100};
+
 EditModal::EditModal(const QString &roomId, QWidget *parent)
   : QWidget(parent)
   , roomId_{roomId}
@@ -228,8 +233,7 @@ RoomSettings::RoomSettings(const QString &room_id, QWidget *parent)
         accessCombo->addItem(tr("Anyone and guests"));
         accessCombo->addItem(tr("Anyone"));
         accessCombo->addItem(tr("Invited users"));
-        accessCombo->setDisabled(
-          !canChangeJoinRules(room_id_.toStdString(), utils::localUser().toStdString()));
+        accessCombo->setDisabled(!canChangeJoinRules_);
         connect(accessCombo, QOverload<int>::of(&QComboBox::activated), [this](int index) {
                 using namespace mtx::events::state;
 
@@ -277,6 +281,62 @@ RoomSettings::RoomSettings(const QString &room_id, QWidget *parent)
         accessOptionLayout->addWidget(accessLabel, Qt::AlignBottom | Qt::AlignLeft);
         accessOptionLayout->addWidget(accessCombo, 0, Qt::AlignBottom | Qt::AlignRight);
 
+        // Local cache retention. Takes effect as new events are ingested;
+        // no restart needed.
+        const auto retention = utils::roomRetentionPolicy(room_id_);
+
+        auto indexOf = [](const int (&values)[4], int value) {
+                for (int i = 0; i < 4; i++)
+                        if (values[i] == value)
+                                return i;
+                return 0;
+        };
+
+        auto retentionAgeLabel = new QLabel(tr("Expire cached messages"), this);
+        retentionAgeLabel->setToolTipDuration(6000);
+        retentionAgeLabel->setToolTip(
+          tr("Only affects this device's cache. Older messages can still\n"
+             "be fetched from the server by scrolling back."));
+        auto retentionAgeCombo = new QComboBox(this);
+        retentionAgeCombo->addItem(tr("Never"));
+        retentionAgeCombo->addItem(tr("After a month"));
+        retentionAgeCombo->addItem(tr("After a week"));
+        retentionAgeCombo->addItem(tr("After a day"));
+        retentionAgeCombo->setCurrentIndex(indexOf(RETENTION_AGE_DAYS, retention.maxAgeDays));
+        connect(retentionAgeCombo, QOverload<int>::of(&QComboBox::activated), [this](int index) {
+                auto policy       = utils::roomRetentionPolicy(room_id_);
+                policy.maxAgeDays = RETENTION_AGE_DAYS[index];
+                utils::setRoomRetentionPolicy(room_id_, policy);
+        });
+
+        auto retentionAgeLayout = new QHBoxLayout;
+        retentionAgeLayout->setMargin(0);
+        retentionAgeLayout->addWidget(retentionAgeLabel, Qt::AlignBottom | Qt::AlignLeft);
+        retentionAgeLayout->addWidget(retentionAgeCombo, 0, Qt::AlignBottom | Qt::AlignRight);
+
+        auto retentionCountLabel = new QLabel(tr("Cached message limit"), this);
+        retentionCountLabel->setToolTipDuration(6000);
+        retentionCountLabel->setToolTip(
+          tr("Only affects this device's cache. Useful for noisy bridged\n"
+             "rooms that are never scrolled back through."));
+        auto retentionCountCombo = new QComboBox(this);
+        retentionCountCombo->addItem(tr("No limit"));
+        retentionCountCombo->addItem(tr("10000"));
+        retentionCountCombo->addItem(tr("1000"));
+        retentionCountCombo->addItem(tr("100"));
+        retentionCountCombo->setCurrentIndex(indexOf(RETENTION_MAX_EVENTS, retention.maxEvents));
+        connect(
+          retentionCountCombo, QOverload<int>::of(&QComboBox::activated), [this](int index) {
+                  auto policy      = utils::roomRetentionPolicy(room_id_);
+                  policy.maxEvents = RETENTION_MAX_EVENTS[index];
+                  utils::setRoomRetentionPolicy(room_id_, policy);
+          });
+
+        auto retentionCountLayout = new QHBoxLayout;
+        retentionCountLayout->setMargin(0);
+        retentionCountLayout->addWidget(retentionCountLabel, Qt::AlignBottom | Qt::AlignLeft);
+        retentionCountLayout->addWidget(retentionCountCombo, 0, Qt::AlignBottom | Qt::AlignRight);
+
         auto encryptionLabel = new QLabel(tr("Encryption"), this);
         encryptionToggle_    = new Toggle(this);
         connect(encryptionToggle_, &Toggle::toggled, this, [this](bool isOn) {
@@ -359,7 +419,7 @@ RoomSettings::RoomSettings(const QString &room_id, QWidget *parent)
         else
                 avatar_->setImage(avatarImg_);
 
-        if (canChangeAvatar(room_id_.toStdString(), utils::localUser().toStdString())) {
+        if (canChangeAvatar_) {
                 auto filter = new ClickableFilter(this);
                 avatar_->installEventFilter(filter);
                 avatar_->setCursor(Qt::PointingHandCursor);
@@ -401,6 +461,8 @@ RoomSettings::RoomSettings(const QString &room_id, QWidget *parent)
         layout->addWidget(settingsLabel, Qt::AlignLeft);
         layout->addLayout(notifOptionLayout_);
         layout->addLayout(accessOptionLayout);
+        layout->addLayout(retentionAgeLayout);
+        layout->addLayout(retentionCountLayout);
         layout->addLayout(encryptionOptionLayout);
         layout->addLayout(keyRequestsLayout);
         layout->addWidget(infoLabel, Qt::AlignLeft);
@@ -439,7 +501,7 @@ RoomSettings::setupEditButton()
         btnLayout_->setSpacing(BUTTON_SPACING);
         btnLayout_->setMargin(0);
 
-        if (!canChangeNameAndTopic(room_id_.toStdString(), utils::localUser().toStdString()))
+        if (!canChangeNameTopic_)
                 return;
 
         QIcon editIcon;
@@ -472,9 +534,16 @@ void
 RoomSettings::retrieveRoomInfo()
 {
         try {
-                usesEncryption_ = cache::client()->isRoomEncrypted(room_id_.toStdString());
-                info_           = cache::client()->singleRoomInfo(room_id_.toStdString());
-                setAvatar(QImage::fromData(cache::client()->image(info_.avatar_url)));
+                const auto snapshot = cache::client()->roomStateSnapshot(
+                  room_id_.toStdString(), utils::localUser().toStdString());
+
+                usesEncryption_     = snapshot.is_encrypted;
+                info_               = snapshot.info;
+                canChangeJoinRules_ = snapshot.can_change_join_rules;
+                canChangeNameTopic_ = snapshot.can_change_name_topic;
+                canChangeAvatar_    = snapshot.can_change_avatar;
+
+                setAvatar(snapshot.avatar);
         } catch (const lmdb::error &e) {
                 nhlog::db()->warn("failed to retrieve room info from cache: {}",
                                   room_id_.toStdString());
@@ -521,45 +590,6 @@ RoomSettings::paintEvent(QPaintEvent *)
         style()->drawPrimitive(QStyle::PE_Widget, &opt, &p, this);
 }
 
-bool
-RoomSettings::canChangeJoinRules(const std::string &room_id, const std::string &user_id) const
-{
-        try {
-                return cache::client()->hasEnoughPowerLevel(
-                  {EventType::RoomJoinRules}, room_id, user_id);
-        } catch (const lmdb::error &e) {
-                nhlog::db()->warn("lmdb error: {}", e.what());
-        }
-
-        return false;
-}
-
-bool
-RoomSettings::canChangeNameAndTopic(const std::string &room_id, const std::string &user_id) const
-{
-        try {
-                return cache::client()->hasEnoughPowerLevel(
-                  {EventType::RoomName, EventType::RoomTopic}, room_id, user_id);
-        } catch (const lmdb::error &e) {
-                nhlog::db()->warn("lmdb error: {}", e.what());
-        }
-
-        return false;
-}
-
-bool
-RoomSettings::canChangeAvatar(const std::string &room_id, const std::string &user_id) const
-{
-        try {
-                return cache::client()->hasEnoughPowerLevel(
-                  {EventType::RoomAvatar}, room_id, user_id);
-        } catch (const lmdb::error &e) {
-                nhlog::db()->warn("lmdb error: {}", e.what());
-        }
-
-        return false;
-}
-
 void
 RoomSettings::updateAccessRules(const std::string &room_id,
                                 const mtx::events::state::JoinRules &join_rule,
@@ -657,79 +687,114 @@ RoomSettings::updateAvatar()
         if (fileName.isEmpty())
                 return;
 
-        QMimeDatabase db;
-        QMimeType mime = db.mimeTypeForFile(fileName, QMimeDatabase::MatchContent);
-
-        const auto format = mime.name().split("/")[0];
-
-        QFile file{fileName, this};
-        if (format != "image") {
-                displayErrorMessage(tr("The selected media is not an image"));
-                return;
-        }
-
-        if (!file.open(QIODevice::ReadOnly)) {
-                displayErrorMessage(tr("Error while reading media: %1").arg(file.errorString()));
-                return;
-        }
-
         if (spinner_) {
                 startLoadingSpinner();
                 resetErrorLabel();
         }
 
-        // Events emitted from the http callbacks (different threads) will
-        // be queued back into the UI thread through this proxy object.
+        // Events emitted from the worker & http callbacks (different
+        // threads) will be queued back into the UI thread through this
+        // proxy object.
         auto proxy = std::make_shared<ThreadProxy>();
         connect(proxy.get(), &ThreadProxy::error, this, &RoomSettings::displayErrorMessage);
         connect(proxy.get(), &ThreadProxy::avatarChanged, this, &RoomSettings::setAvatar);
+        // The preview only updates the widget; the spinner keeps running
+        // until the upload has actually gone through.
+        connect(proxy.get(), &ThreadProxy::preview, this, [this](const QImage &img) {
+                if (avatar_)
+                        avatar_->setImage(img);
+        });
 
-        const auto bin        = file.peek(file.size());
-        const auto payload    = std::string(bin.data(), bin.size());
-        const auto dimensions = QImageReader(&file).size();
-
-        // First we need to create a new mxc URI
-        // (i.e upload media to the Matrix content repository) for the new avatar.
-        http::client()->upload(
-          payload,
-          mime.name().toStdString(),
-          QFileInfo(fileName).fileName().toStdString(),
-          [proxy = std::move(proxy),
-           dimensions,
-           payload,
-           mimetype = mime.name().toStdString(),
-           size     = payload.size(),
-           room_id  = room_id_.toStdString(),
-           content  = std::move(bin)](const mtx::responses::ContentURI &res,
-                                     mtx::http::RequestErr err) {
-                  if (err) {
-                          emit proxy->error(
-                            tr("Failed to upload image: %s")
-                              .arg(QString::fromStdString(err->matrix_error.error)));
-                          return;
-                  }
+        // Reading & decoding a camera-sized image takes longer than a
+        // frame, so everything up to the upload request runs on a worker.
+        QtConcurrent::run([proxy = std::move(proxy),
+                           fileName,
+                           room_id = room_id_.toStdString()]() {
+                QMimeDatabase db;
+                QMimeType mime = db.mimeTypeForFile(fileName, QMimeDatabase::MatchContent);
+
+                if (mime.name().split("/")[0] != "image") {
+                        emit proxy->error(tr("The selected media is not an image"));
+                        return;
+                }
 
-                  using namespace mtx::events;
-                  state::Avatar avatar_event;
-                  avatar_event.image_info.w        = dimensions.width();
-                  avatar_event.image_info.h        = dimensions.height();
-                  avatar_event.image_info.mimetype = mimetype;
-                  avatar_event.image_info.size     = size;
-                  avatar_event.url                 = res.content_uri;
+                QFile file{fileName};
+                if (!file.open(QIODevice::ReadOnly)) {
+                        emit proxy->error(
+                          tr("Error while reading media: %1").arg(file.errorString()));
+                        return;
+                }
 
-                  http::client()->send_state_event<state::Avatar, EventType::RoomAvatar>(
-                    room_id,
-                    avatar_event,
-                    [content = std::move(content), proxy = std::move(proxy)](
-                      const mtx::responses::EventId &, mtx::http::RequestErr err) {
-                            if (err) {
-                                    emit proxy->error(
-                                      tr("Failed to upload image: %s")
-                                        .arg(QString::fromStdString(err->matrix_error.error)));
-                                    return;
-                            }
+                auto payload = std::string(file.size(), '\0');
+                if (file.read(&payload[0], payload.size()) !=
+                    static_cast<qint64>(payload.size())) {
+                        emit proxy->error(
+                          tr("Error while reading media: %1").arg(file.errorString()));
+                        return;
+                }
+                file.seek(0);
+
+                QImageReader reader(&file);
+                const auto dimensions = reader.size();
+
+                // Decode the preview at display size instead of the full
+                // frame; formats with scaled decoding (e.g. jpeg) never
+                // materialize the 50 MP image.
+                if (dimensions.width() > 256 || dimensions.height() > 256) {
+                        QSize scaled = dimensions;
+                        scaled.scale(256, 256, Qt::KeepAspectRatio);
+                        reader.setScaledSize(scaled);
+                }
 
-                            emit proxy->avatarChanged(QImage::fromData(content));
-                    });
-          });
+                const auto preview = reader.read();
+                if (!preview.isNull())
+                        emit proxy->preview(preview);
+
+                // First we need to create a new mxc URI
+                // (i.e upload media to the Matrix content repository) for the new avatar.
+                http::client()->upload(
+                  payload,
+                  mime.name().toStdString(),
+                  QFileInfo(fileName).fileName().toStdString(),
+                  [proxy,
+                   dimensions,
+                   preview,
+                   mimetype = mime.name().toStdString(),
+                   size     = payload.size(),
+                   room_id](const mtx::responses::ContentURI &res, mtx::http::RequestErr err) {
+                          if (err) {
+                                  emit proxy->error(
+                                    tr("Failed to upload image: %s")
+                                      .arg(QString::fromStdString(err->matrix_error.error)));
+                                  return;
+                          }
+
+                          using namespace mtx::events;
+                          state::Avatar avatar_event;
+                          avatar_event.image_info.w        = dimensions.width();
+                          avatar_event.image_info.h        = dimensions.height();
+                          avatar_event.image_info.mimetype = mimetype;
+                          avatar_event.image_info.size     = size;
+                          avatar_event.url                 = res.content_uri;
+
+                          http::client()->send_state_event<state::Avatar, EventType::RoomAvatar>(
+                            room_id,
+                            avatar_event,
+                            [preview, proxy](const mtx::responses::EventId &,
+                                             mtx::http::RequestErr err) {
+                                    if (err) {
+                                            emit proxy->error(
+                                              tr("Failed to upload image: %s")
+                                                .arg(QString::fromStdString(
+                                                  err->matrix_error.error)));
+                                            return;
+                                    }
+
+                                    // The scaled decode is all the widget
+                                    // renders; the full image is never
+                                    // decoded on this side.
+                                    emit proxy->avatarChanged(preview);
+                            });
+                  });
+        });
 }
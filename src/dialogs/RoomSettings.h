@@ -53,6 +53,9 @@ class ThreadProxy : public QObject
 signals:
         void error(const QString &msg);
         void avatarChanged(const QImage &img);
+        //! A scaled-down decode of the selected image, shown while the
+        //! upload is still running.
+        void preview(const QImage &img);
 };
 
 class EditModal : public QWidget
@@ -107,12 +110,6 @@ private slots:
         void updateAvatar();
 
 private:
-        //! Whether the user has enough power level to send m.room.join_rules events.
-        bool canChangeJoinRules(const std::string &room_id, const std::string &user_id) const;
-        //! Whether the user has enough power level to send m.room.name & m.room.topic events.
-        bool canChangeNameAndTopic(const std::string &room_id, const std::string &user_id) const;
-        //! Whether the user has enough power level to send m.room.avatar event.
-        bool canChangeAvatar(const std::string &room_id, const std::string &user_id) const;
         void updateAccessRules(const std::string &room_id,
                                const mtx::events::state::JoinRules &,
                                const mtx::events::state::GuestAccess &);
@@ -123,13 +120,18 @@ private:
 
         void setAvatar(const QImage &img);
         void setupEditButton();
-        //! Retrieve the current room information from cache.
+        //! Retrieve the current room information from cache, in one
+        //! consistent snapshot.
         void retrieveRoomInfo();
         void enableEncryption();
 
         Avatar *avatar_ = nullptr;
 
         bool usesEncryption_ = false;
+        //! Power level checks from the room snapshot.
+        bool canChangeJoinRules_ = false;
+        bool canChangeNameTopic_ = false;
+        bool canChangeAvatar_    = false;
         QHBoxLayout *btnLayout_;
 
         FlatButton *editFieldsBtn_ = nullptr;
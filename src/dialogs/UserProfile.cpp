@@ -200,11 +200,12 @@ UserProfile::init(const QString &userId, const QString &roomId)
         auto localUser = utils::localUser();
 
         try {
-                bool hasMemberRights =
-                  cache::client()->hasEnoughPowerLevel({mtx::events::EventType::RoomMember},
-                                                       roomId.toStdString(),
-                                                       localUser.toStdString());
-                if (!hasMemberRights) {
+                // One consistent snapshot instead of separate getters that
+                // could race with a sync write in between.
+                const auto snapshot = cache::client()->roomStateSnapshot(
+                  roomId.toStdString(), localUser.toStdString());
+
+                if (!snapshot.can_kick_members) {
                         kickBtn_->hide();
                         banBtn_->hide();
                 } else {
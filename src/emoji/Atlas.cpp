@@ -0,0 +1,162 @@
+#include <cstring>
+
+#include <QDir>
+#include <QPainter>
+#include <QStandardPaths>
+
+#include "emoji/Atlas.h"
+
+#include "Config.h"
+#include "Logging.h"
+
+using namespace emoji;
+
+//! Bumped when the cell layout changes; a mismatch discards the file.
+constexpr quint32 ATLAS_VERSION = 1;
+constexpr char ATLAS_MAGIC[4]   = {'N', 'H', 'E', 'A'};
+//! magic + version + cell size.
+constexpr qint64 HEADER_SIZE = 12;
+
+//! Padding around the glyph inside its cell, so antialiased edges
+//! aren't clipped.
+constexpr int CELL_PADDING = 2;
+
+Atlas &
+Atlas::instance()
+{
+        static Atlas atlas;
+        return atlas;
+}
+
+Atlas::Atlas()
+  : cellSize_{conf::emojiSize + 2 * CELL_PADDING}
+{
+        const auto dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+        QDir().mkpath(dir);
+
+        path_ = dir + "/emoji-atlas.bin";
+
+        load();
+}
+
+void
+Atlas::load()
+{
+        file_.setFileName(path_);
+
+        if (!file_.exists() || !file_.open(QIODevice::ReadOnly))
+                return;
+
+        const auto recordSize = 4 + cellSize_ * cellSize_ * 4;
+
+        quint32 version  = 0;
+        quint32 cellSize = 0;
+        char magic[4]    = {0, 0, 0, 0};
+
+        // A short, torn or incompatible file is simply discarded; the
+        // atlas refills itself.
+        bool valid = file_.size() >= HEADER_SIZE &&
+                     (file_.size() - HEADER_SIZE) % recordSize == 0;
+
+        if (valid) {
+                file_.read(magic, 4);
+                file_.read(reinterpret_cast<char *>(&version), 4);
+                file_.read(reinterpret_cast<char *>(&cellSize), 4);
+
+                valid = std::memcmp(magic, ATLAS_MAGIC, 4) == 0 &&
+                        version == ATLAS_VERSION &&
+                        cellSize == static_cast<quint32>(cellSize_);
+        }
+
+        if (!valid) {
+                nhlog::ui()->info("discarding incompatible emoji atlas");
+                file_.close();
+                file_.remove();
+                return;
+        }
+
+        auto mapped = file_.map(0, file_.size());
+        if (!mapped) {
+                nhlog::ui()->warn("failed to map emoji atlas: {}", path_.toStdString());
+                file_.close();
+                return;
+        }
+
+        const auto count = (file_.size() - HEADER_SIZE) / recordSize;
+        for (qint64 i = 0; i < count; i++) {
+                const uchar *record = mapped + HEADER_SIZE + i * recordSize;
+
+                quint32 codepoint;
+                std::memcpy(&codepoint, record, 4);
+
+                mappedCells_.insert(codepoint, record + 4);
+        }
+
+        nhlog::ui()->debug("emoji atlas: {} glyph(s) mapped", mappedCells_.size());
+}
+
+QImage
+Atlas::glyph(uint codepoint)
+{
+        auto fresh = freshCells_.constFind(codepoint);
+        if (fresh != freshCells_.constEnd())
+                return fresh.value();
+
+        auto mapped = mappedCells_.constFind(codepoint);
+        if (mapped != mappedCells_.constEnd())
+                // Wraps the mapped pixels without copying; the mapping
+                // lives as long as the atlas.
+                return QImage(mapped.value(),
+                              cellSize_,
+                              cellSize_,
+                              cellSize_ * 4,
+                              QImage::Format_ARGB32_Premultiplied);
+
+        auto cell = render(codepoint);
+        append(codepoint, cell);
+        freshCells_.insert(codepoint, cell);
+
+        return cell;
+}
+
+QImage
+Atlas::render(uint codepoint) const
+{
+        QImage cell(cellSize_, cellSize_, QImage::Format_ARGB32_Premultiplied);
+        cell.fill(Qt::transparent);
+
+        QFont font("Emoji One");
+        font.setPixelSize(conf::emojiSize);
+
+        QPainter painter(&cell);
+        painter.setFont(font);
+        painter.drawText(cell.rect(), Qt::AlignCenter, QString::fromUcs4(&codepoint, 1));
+
+        return cell;
+}
+
+void
+Atlas::append(uint codepoint, const QImage &cell)
+{
+        QFile file(path_);
+
+        const bool fresh = !file.exists() || file.size() == 0;
+
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+                nhlog::ui()->warn("failed to append to emoji atlas: {}", path_.toStdString());
+                return;
+        }
+
+        if (fresh) {
+                const quint32 version  = ATLAS_VERSION;
+                const quint32 cellSize = cellSize_;
+
+                file.write(ATLAS_MAGIC, 4);
+                file.write(reinterpret_cast<const char *>(&version), 4);
+                file.write(reinterpret_cast<const char *>(&cellSize), 4);
+        }
+
+        const quint32 code = codepoint;
+        file.write(reinterpret_cast<const char *>(&code), 4);
+        file.write(reinterpret_cast<const char *>(cell.constBits()), cell.byteCount());
+}
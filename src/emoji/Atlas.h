@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QFile>
+#include <QHash>
+#include <QImage>
+
+namespace emoji {
+
+//! Persistent atlas of rasterized emoji glyphs.
+//!
+//! Color glyphs are expensive to rasterize and the font engine drops
+//! them from its cache under memory pressure, so emoji-dense history
+//! pays the cost again every time it scrolls into view. The atlas
+//! renders each glyph once into a fixed-size cell, appends the cell to
+//! a file in the cache directory and serves later displays - including
+//! later runs - straight from the memory-mapped file, making an emoji
+//! a blit instead of a font engine round trip.
+//!
+//! Only used from the GUI thread.
+class Atlas
+{
+public:
+        static Atlas &instance();
+
+        //! The rendered cell of a codepoint. Rasterizes & persists the
+        //! glyph on the first request.
+        QImage glyph(uint codepoint);
+
+        //! Edge length of a glyph cell, in pixels.
+        int cellSize() const { return cellSize_; }
+
+private:
+        Atlas();
+
+        void load();
+        QImage render(uint codepoint) const;
+        void append(uint codepoint, const QImage &cell);
+
+        QString path_;
+        int cellSize_;
+
+        //! The cells of previous runs; keeps the mapping alive.
+        QFile file_;
+        //! codepoint -> cell pixels inside the mapping.
+        QHash<uint, const uchar *> mappedCells_;
+        //! Cells rendered in this run. They are appended to the file
+        //! right away but only enter the mapping on the next start.
+        QHash<uint, QImage> freshCells_;
+};
+}
@@ -50,22 +50,14 @@ Category::Category(QString category, std::vector<Emoji> emoji, QWidget *parent)
         const int rows = emoji.size() / 7;
 
         // TODO: Be precise here. Take the parent into consideration.
+        // The size is fixed up front so the scroll geometry is correct
+        // before the items exist.
         emojiListView_->setFixedSize(cols * 50 + 20, rows * 50 + 20);
         emojiListView_->setGridSize(QSize(50, 50));
         emojiListView_->setDragEnabled(false);
         emojiListView_->setEditTriggers(QAbstractItemView::NoEditTriggers);
 
-        for (const auto &e : emoji) {
-                data_->unicode = e.unicode;
-
-                auto item = new QStandardItem;
-                item->setSizeHint(QSize(24, 24));
-
-                QVariant unicode(data_->unicode);
-                item->setData(unicode.toString(), Qt::UserRole);
-
-                itemModel_->appendRow(item);
-        }
+        emoji_ = std::move(emoji);
 
         QFont font("Open Sans SemiBold");
         font.setPixelSize(conf::fontSize);
@@ -80,6 +72,28 @@ Category::Category(QString category, std::vector<Emoji> emoji, QWidget *parent)
         connect(emojiListView_, &QListView::clicked, this, &Category::clickIndex);
 }
 
+void
+Category::populate()
+{
+        if (populated_)
+                return;
+        populated_ = true;
+
+        for (const auto &e : emoji_) {
+                data_->unicode = e.unicode;
+
+                auto item = new QStandardItem;
+                item->setSizeHint(QSize(24, 24));
+
+                QVariant unicode(data_->unicode);
+                item->setData(unicode.toString(), Qt::UserRole);
+
+                itemModel_->appendRow(item);
+        }
+
+        emoji_.clear();
+}
+
 void
 Category::paintEvent(QPaintEvent *)
 {
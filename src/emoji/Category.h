@@ -33,6 +33,11 @@ class Category : public QWidget
 public:
         Category(QString category, std::vector<Emoji> emoji, QWidget *parent = nullptr);
 
+        //! Fill the list with the emoji of the category. The constructor
+        //! only reserves the space; the items are built here, when the
+        //! category first scrolls into view. The first call does the work.
+        void populate();
+
 signals:
         void emojiSelected(const QString &emoji);
 
@@ -55,5 +60,9 @@ private:
         emoji::ItemDelegate *delegate_;
 
         QLabel *category_;
+
+        //! Emoji waiting to be turned into model items.
+        std::vector<Emoji> emoji_;
+        bool populated_ = false;
 };
 } // namespace emoji
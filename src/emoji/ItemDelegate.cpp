@@ -35,15 +35,30 @@ ItemDelegate::paint(QPainter *painter,
                     const QStyleOptionViewItem &option,
                     const QModelIndex &index) const
 {
-        Q_UNUSED(index);
-
         QStyleOptionViewItem viewOption(option);
 
-        auto emoji = index.data(Qt::UserRole).toString();
+        const auto emoji = index.data(Qt::UserRole).toString();
+
+        static const QFont font = []() {
+                QFont f("Emoji One");
+                f.setPixelSize(19);
+                return f;
+        }();
+
+        auto it = glyphCache_.find(emoji);
+        if (it == glyphCache_.end()) {
+                QStaticText text(emoji);
+                text.setTextFormat(Qt::PlainText);
+                text.prepare(QTransform(), font);
+
+                it = glyphCache_.insert(emoji, text);
+        }
 
-        QFont font("Emoji One");
-        font.setPixelSize(19);
+        const auto size = it->size();
 
         painter->setFont(font);
-        painter->drawText(viewOption.rect, Qt::AlignCenter, emoji);
+        painter->drawStaticText(
+          QPointF(viewOption.rect.x() + (viewOption.rect.width() - size.width()) / 2,
+                  viewOption.rect.y() + (viewOption.rect.height() - size.height()) / 2),
+          *it);
 }
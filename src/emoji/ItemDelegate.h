@@ -17,8 +17,10 @@
 
 #pragma once
 
+#include <QHash>
 #include <QModelIndex>
 #include <QStandardItemModel>
+#include <QStaticText>
 #include <QStyledItemDelegate>
 
 #include "Provider.h"
@@ -39,5 +41,9 @@ public:
 
 private:
         Emoji *data_;
+
+        //! Laid-out glyph runs keyed by the emoji string, so scrolling
+        //! replays them instead of re-shaping every visible glyph.
+        mutable QHash<QString, QStaticText> glyphCache_;
 };
 } // namespace emoji
@@ -122,35 +122,48 @@ Panel::Panel(QWidget *parent)
         scrollArea_->setWidget(scrollWidget);
 
         auto peopleEmoji =
-          new Category(tr("Smileys & People"), emoji_provider_.people, scrollWidget);
+          new Category(tr("Smileys & People"), emoji_provider_.people(), scrollWidget);
         scrollLayout->addWidget(peopleEmoji);
 
         auto natureEmoji =
-          new Category(tr("Animals & Nature"), emoji_provider_.nature, scrollWidget);
+          new Category(tr("Animals & Nature"), emoji_provider_.nature(), scrollWidget);
         scrollLayout->addWidget(natureEmoji);
 
-        auto foodEmoji = new Category(tr("Food & Drink"), emoji_provider_.food, scrollWidget);
+        auto foodEmoji = new Category(tr("Food & Drink"), emoji_provider_.food(), scrollWidget);
         scrollLayout->addWidget(foodEmoji);
 
-        auto activityEmoji = new Category(tr("Activity"), emoji_provider_.activity, scrollWidget);
+        auto activityEmoji = new Category(tr("Activity"), emoji_provider_.activity(), scrollWidget);
         scrollLayout->addWidget(activityEmoji);
 
         auto travelEmoji =
-          new Category(tr("Travel & Places"), emoji_provider_.travel, scrollWidget);
+          new Category(tr("Travel & Places"), emoji_provider_.travel(), scrollWidget);
         scrollLayout->addWidget(travelEmoji);
 
-        auto objectsEmoji = new Category(tr("Objects"), emoji_provider_.objects, scrollWidget);
+        auto objectsEmoji = new Category(tr("Objects"), emoji_provider_.objects(), scrollWidget);
         scrollLayout->addWidget(objectsEmoji);
 
-        auto symbolsEmoji = new Category(tr("Symbols"), emoji_provider_.symbols, scrollWidget);
+        auto symbolsEmoji = new Category(tr("Symbols"), emoji_provider_.symbols(), scrollWidget);
         scrollLayout->addWidget(symbolsEmoji);
 
-        auto flagsEmoji = new Category(tr("Flags"), emoji_provider_.flags, scrollWidget);
+        auto flagsEmoji = new Category(tr("Flags"), emoji_provider_.flags(), scrollWidget);
         scrollLayout->addWidget(flagsEmoji);
 
+        categories_ = {peopleEmoji,
+                       natureEmoji,
+                       foodEmoji,
+                       activityEmoji,
+                       travelEmoji,
+                       objectsEmoji,
+                       symbolsEmoji,
+                       flagsEmoji};
+
         contentLayout->addWidget(scrollArea_);
         contentLayout->addWidget(emojiCategories);
 
+        connect(scrollArea_->verticalScrollBar(), &QScrollBar::valueChanged, this, [this](int) {
+                populateVisibleCategories();
+        });
+
         connect(peopleEmoji, &Category::emojiSelected, this, &Panel::emojiSelected);
         connect(peopleCategory, &QPushButton::clicked, [this, peopleEmoji]() {
                 this->showCategory(peopleEmoji);
@@ -192,6 +205,29 @@ Panel::Panel(QWidget *parent)
         });
 }
 
+void
+Panel::showEvent(QShowEvent *event)
+{
+        populateVisibleCategories();
+        QWidget::showEvent(event);
+}
+
+void
+Panel::populateVisibleCategories()
+{
+        // One viewport of margin on each side, so the rows about to be
+        // scrolled in are ready before they reach the screen.
+        const auto margin  = scrollArea_->viewport()->height();
+        const QRect nearby = scrollArea_->viewport()->rect().adjusted(0, -margin, 0, margin);
+
+        for (auto category : categories_) {
+                const auto pos = category->mapTo(scrollArea_->viewport(), QPoint());
+
+                if (nearby.intersects(QRect(pos, category->size())))
+                        category->populate();
+        }
+}
+
 void
 Panel::showCategory(const Category *category)
 {
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <QScrollArea>
 
 #include "Provider.h"
@@ -44,15 +46,22 @@ protected:
         }
 
         void paintEvent(QPaintEvent *event) override;
+        void showEvent(QShowEvent *event) override;
 
 signals:
         void leaving();
 
 private:
         void showCategory(const Category *category);
+        //! Build the items of the categories that are in or near the
+        //! viewport, so a category is ready by the time it is reached.
+        void populateVisibleCategories();
 
         Provider emoji_provider_;
 
+        //! The categories in their scroll order.
+        std::vector<Category *> categories_;
+
         QScrollArea *scrollArea_;
 
         int shadowMargin_;
@@ -33,13 +33,15 @@ struct Emoji
 class Provider
 {
 public:
-        static const std::vector<Emoji> people;
-        static const std::vector<Emoji> nature;
-        static const std::vector<Emoji> food;
-        static const std::vector<Emoji> activity;
-        static const std::vector<Emoji> travel;
-        static const std::vector<Emoji> objects;
-        static const std::vector<Emoji> symbols;
-        static const std::vector<Emoji> flags;
+        //! Each category is built on first use from compile-time tables,
+        //! so no QStrings are constructed before main().
+        static const std::vector<Emoji> &people();
+        static const std::vector<Emoji> &nature();
+        static const std::vector<Emoji> &food();
+        static const std::vector<Emoji> &activity();
+        static const std::vector<Emoji> &travel();
+        static const std::vector<Emoji> &objects();
+        static const std::vector<Emoji> &symbols();
+        static const std::vector<Emoji> &flags();
 };
 } // namespace emoji
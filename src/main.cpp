@@ -25,17 +25,23 @@
 #include <QLayout>
 #include <QLibraryInfo>
 #include <QMessageBox>
+#include <QPixmapCache>
 #include <QPoint>
 #include <QSettings>
 #include <QStandardPaths>
 #include <QTranslator>
+#include <QtConcurrent>
 
 #include "Config.h"
+#include "IdleScheduler.h"
 #include "Logging.h"
 #include "MainWindow.h"
 #include "MatrixClient.h"
+#include "MemoryBudget.h"
+#include "Perf.h"
 #include "RunGuard.h"
 #include "Utils.h"
+#include "timeline/TimelineItem.h"
 #include "version.h"
 
 #if defined(Q_OS_LINUX)
@@ -123,11 +129,28 @@ main(int argc, char *argv[])
         parser.addVersionOption();
         parser.process(app);
 
-        QFontDatabase::addApplicationFont(":/fonts/fonts/OpenSans/OpenSans-Regular.ttf");
-        QFontDatabase::addApplicationFont(":/fonts/fonts/OpenSans/OpenSans-Italic.ttf");
-        QFontDatabase::addApplicationFont(":/fonts/fonts/OpenSans/OpenSans-Bold.ttf");
-        QFontDatabase::addApplicationFont(":/fonts/fonts/OpenSans/OpenSans-Semibold.ttf");
-        QFontDatabase::addApplicationFont(":/fonts/fonts/EmojiOne/emojione-android.ttf");
+        // Read the bundled fonts on a worker thread, overlapping the QRC
+        // decompression with the rest of the startup sequence. Registration
+        // has to happen on the GUI thread and is deferred until right
+        // before the application font is resolved.
+        auto fontData = QtConcurrent::run([]() {
+                const QStringList paths = {
+                  ":/fonts/fonts/OpenSans/OpenSans-Regular.ttf",
+                  ":/fonts/fonts/OpenSans/OpenSans-Italic.ttf",
+                  ":/fonts/fonts/OpenSans/OpenSans-Bold.ttf",
+                  ":/fonts/fonts/OpenSans/OpenSans-Semibold.ttf",
+                  ":/fonts/fonts/EmojiOne/emojione-android.ttf",
+                };
+
+                std::vector<QByteArray> fonts;
+                for (const auto &path : paths) {
+                        QFile font(path);
+                        font.open(QIODevice::ReadOnly);
+                        fonts.push_back(font.readAll());
+                }
+
+                return fonts;
+        });
 
         app.setWindowIcon(QIcon(":/logos/nheko.png"));
 
@@ -152,6 +175,13 @@ main(int argc, char *argv[])
         if (settings.value("font/size").toInt() == 0)
                 settings.setValue("font/size", 12);
 
+        // First point where the fonts must be resolvable; by now the worker
+        // has usually finished reading them.
+        for (const auto &data : fontData.result())
+                QFontDatabase::addApplicationFontFromData(data);
+
+        perf::startupPhase("fonts");
+
         QFont font("Open Sans", settings.value("font/size").toInt());
         app.setFont(font);
 
@@ -165,8 +195,20 @@ main(int argc, char *argv[])
         appTranslator.load("nheko_" + lang, ":/translations");
         app.installTranslator(&appTranslator);
 
+        perf::init();
+        idle::init();
+        mem::init();
+
+        // Release hooks for the process-lifetime caches, cheapest to
+        // rebuild first. The timeline views register their own hook.
+        mem::onPressure(0, "render caches", nullptr, []() { utils::releaseCaches(); });
+        mem::onPressure(1, "qt pixmap cache", nullptr, []() { QPixmapCache::clear(); });
+        mem::onPressure(2, "timeline widget pool", nullptr, []() { TimelineItem::drainPool(); });
+
         MainWindow w;
 
+        perf::startupPhase("mainwindow");
+
         // Move the MainWindow to the center
         w.move(screenCenter(w.width(), w.height()));
 
@@ -177,6 +219,7 @@ main(int argc, char *argv[])
         QObject::connect(&app, &QApplication::aboutToQuit, &w, [&w]() {
                 w.saveCurrentWindowSize();
                 if (http::client() != nullptr) {
+                        nhlog::net()->info("{}", http::metrics::report().toStdString());
                         nhlog::net()->debug("shutting down all I/O threads & open connections");
                         http::client()->close(true);
                         nhlog::net()->debug("bye");
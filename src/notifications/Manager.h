@@ -5,8 +5,11 @@
 #include <QString>
 
 #if defined(Q_OS_LINUX) || defined(Q_OS_FREEBSD)
+#include <QMap>
 #include <QtDBus/QDBusArgument>
 #include <QtDBus/QDBusInterface>
+
+class QTimer;
 #endif
 
 struct roomEventId
@@ -33,11 +36,35 @@ signals:
 
 #if defined(Q_OS_LINUX) || defined(Q_OS_FREEBSD)
 private:
+        //! A room's notifications collected during the coalescing window.
+        struct PendingNotification
+        {
+                QString eventId;
+                QString roomName;
+                QString senderName;
+                QString text;
+                QImage icon;
+                int count = 0;
+        };
+
         QDBusInterface dbus;
-        uint showNotification(const QString summary, const QString text, const QImage image);
+        uint showNotification(const QString summary,
+                              const QString text,
+                              const QImage image,
+                              uint replace_id);
+        //! Dispatch the queued notifications, one per room.
+        void flushNotifications();
 
         // notification ID to (room ID, event ID)
         QMap<uint, roomEventId> notificationIds;
+        //! The active notification of each room, replaced in place when
+        //! more messages arrive instead of stacking a new one.
+        QMap<QString, uint> roomNotificationIds_;
+        //! Per-room queue of the coalescing window.
+        QMap<QString, PendingNotification> pendingNotifications_;
+        //! Rate-limits dispatch, so catching up after a long offline
+        //! period doesn't flood the bus.
+        QTimer *flushTimer_;
 #endif
 
         // these slots are platform specific (D-Bus only)
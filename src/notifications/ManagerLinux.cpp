@@ -2,10 +2,14 @@
 
 #include <QDebug>
 #include <QImage>
+#include <QTimer>
 #include <QtDBus/QDBusConnection>
 #include <QtDBus/QDBusMessage>
 #include <QtDBus/QDBusMetaType>
 
+//! How long notifications are collected before they are dispatched.
+constexpr int NOTIFICATION_FLUSH_INTERVAL = 1000;
+
 NotificationsManager::NotificationsManager(QObject *parent)
   : QObject(parent)
   , dbus("org.freedesktop.Notifications",
@@ -28,6 +32,11 @@ NotificationsManager::NotificationsManager(QObject *parent)
                                               "NotificationClosed",
                                               this,
                                               SLOT(notificationClosed(uint, uint)));
+
+        flushTimer_ = new QTimer(this);
+        flushTimer_->setSingleShot(true);
+        flushTimer_->setInterval(NOTIFICATION_FLUSH_INTERVAL);
+        connect(flushTimer_, &QTimer::timeout, this, [this]() { flushNotifications(); });
 }
 
 void
@@ -38,8 +47,47 @@ NotificationsManager::postNotification(const QString &roomid,
                                        const QString &text,
                                        const QImage &icon)
 {
-        uint id             = showNotification(roomname, sender + ": " + text, icon);
-        notificationIds[id] = roomEventId{roomid, eventid};
+        // The notifications of each room are coalesced, so catching up on
+        // a busy room produces a single notification instead of a flood.
+        auto &pending = pendingNotifications_[roomid];
+
+        pending.eventId    = eventid;
+        pending.roomName   = roomname;
+        pending.senderName = sender;
+        pending.text       = text;
+        pending.count += 1;
+
+        if (pending.icon.isNull())
+                pending.icon = icon;
+
+        if (!flushTimer_->isActive())
+                flushTimer_->start();
+}
+
+void
+NotificationsManager::flushNotifications()
+{
+        for (auto it = pendingNotifications_.constBegin();
+             it != pendingNotifications_.constEnd();
+             ++it) {
+                const auto &n = it.value();
+
+                const auto body = n.count == 1 ? n.senderName + ": " + n.text
+                                               : tr("%1 new messages").arg(n.count);
+
+                // Posting with the room's previous notification id replaces
+                // the stale notification in place.
+                const uint replace_id = roomNotificationIds_.value(it.key(), 0);
+
+                const uint id = showNotification(n.roomName, body, n.icon, replace_id);
+
+                if (id != 0) {
+                        notificationIds[id]            = roomEventId{it.key(), n.eventId};
+                        roomNotificationIds_[it.key()] = id;
+                }
+        }
+
+        pendingNotifications_.clear();
 }
 /**
  * This function is based on code from
@@ -50,13 +98,14 @@ NotificationsManager::postNotification(const QString &roomid,
 uint
 NotificationsManager::showNotification(const QString summary,
                                        const QString text,
-                                       const QImage image)
+                                       const QImage image,
+                                       uint replace_id)
 {
         QVariantMap hints;
         hints["image-data"] = image;
         QList<QVariant> argumentList;
         argumentList << "nheko";                             // app_name
-        argumentList << (uint)0;                             // replace_id
+        argumentList << replace_id;                          // replace_id
         argumentList << "";                                  // app_icon
         argumentList << summary;                             // summary
         argumentList << text;                                // body
@@ -92,6 +141,15 @@ NotificationsManager::notificationClosed(uint id, uint reason)
 {
         Q_UNUSED(reason);
         notificationIds.remove(id);
+
+        // The room's next notification shouldn't try to replace a
+        // notification that is already gone.
+        for (auto it = roomNotificationIds_.begin(); it != roomNotificationIds_.end(); ++it) {
+                if (it.value() == id) {
+                        roomNotificationIds_.erase(it);
+                        break;
+                }
+        }
 }
 
 /**
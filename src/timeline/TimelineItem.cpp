@@ -15,9 +15,13 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <deque>
+
+#include <QCache>
 #include <QContextMenuEvent>
 #include <QFontDatabase>
 #include <QMenu>
+#include <QTextDocument>
 #include <QTimer>
 
 #include "ChatPage.h"
@@ -25,6 +29,8 @@
 #include "Logging.h"
 #include "MainWindow.h"
 #include "Olm.h"
+#include "Receipts.h"
+#include "emoji/Atlas.h"
 #include "ui/Avatar.h"
 #include "ui/Painter.h"
 
@@ -63,13 +69,30 @@ TextLabel::TextLabel(const QString &text, QWidget *parent)
         setFixedHeight(0);
 }
 
+QVariant
+TextLabel::loadResource(int type, const QUrl &name)
+{
+        if (type == QTextDocument::ImageResource && name.scheme() == "emoji") {
+                bool ok         = false;
+                const auto code = name.path().toUInt(&ok, 16);
+
+                if (ok)
+                        return emoji::Atlas::instance().glyph(code);
+        }
+
+        return QTextBrowser::loadResource(type, name);
+}
+
 StatusIndicator::StatusIndicator(QWidget *parent)
   : QWidget(parent)
 {
-        lockIcon_.addFile(":/icons/icons/ui/lock.png");
-        clockIcon_.addFile(":/icons/icons/ui/clock.png");
-        checkmarkIcon_.addFile(":/icons/icons/ui/checkmark.png");
-        doubleCheckmarkIcon_.addFile(":/icons/icons/ui/double-tick-indicator.png");
+        // Every timeline item carries an indicator; the icons are shared
+        // so the assets aren't re-decoded per item.
+        lockIcon_            = utils::cachedIcon(":/icons/icons/ui/lock.png");
+        clockIcon_           = utils::cachedIcon(":/icons/icons/ui/clock.png");
+        checkmarkIcon_       = utils::cachedIcon(":/icons/icons/ui/checkmark.png");
+        doubleCheckmarkIcon_ = utils::cachedIcon(":/icons/icons/ui/double-tick-indicator.png");
+        failedIcon_          = utils::cachedIcon(":/icons/icons/ui/do-not-disturb-rounded-sign.png");
 }
 
 void
@@ -111,6 +134,11 @@ StatusIndicator::paintEvent(QPaintEvent *)
                 paintIcon(p, doubleCheckmarkIcon_);
                 break;
         }
+        case StatusIndicatorState::Failed: {
+                p.setPen(QColor("#cc3333"));
+                paintIcon(p, failedIcon_);
+                break;
+        }
         case StatusIndicatorState::Empty:
                 break;
         }
@@ -134,6 +162,9 @@ StatusIndicator::setState(StatusIndicatorState state)
         case StatusIndicatorState::Sent:
                 setToolTip(tr("Sent"));
                 break;
+        case StatusIndicatorState::Failed:
+                setToolTip(tr("Failed to send, retrying"));
+                break;
         case StatusIndicatorState::Empty:
                 setToolTip("");
                 break;
@@ -261,25 +292,28 @@ TimelineItem::TimelineItem(mtx::events::MessageType ty,
         init();
         addReplyAction();
 
-        auto displayName = Cache::displayName(room_id_, userid);
-        auto timestamp   = QDateTime::currentDateTime();
+        // The matching PendingMessage keeps a pointer to the widget.
+        isRecyclable_ = false;
+
+        const auto senderInfo = Cache::senderInfo(room_id_, userid);
+        auto timestamp        = QDateTime::currentDateTime();
 
         if (ty == mtx::events::MessageType::Emote) {
-                body            = QString("* %1 %2").arg(displayName).arg(body);
-                descriptionMsg_ = {"", userid, body, utils::descriptiveTime(timestamp), timestamp};
+                body          = QString("* %1 %2").arg(senderInfo.display_name).arg(body);
+                descUsername_ = "";
         } else {
-                descriptionMsg_ = {
-                  "You: ", userid, body, utils::descriptiveTime(timestamp), timestamp};
+                descUsername_ = "You: ";
         }
+        descUserid_    = userid;
+        descBody_      = body;
+        descTimestamp_ = timestamp;
 
-        body = body.toHtmlEscaped();
-        body.replace(conf::strings::url_regex, conf::strings::url_html);
-        body.replace("\n", "<br/>");
+        body = utils::formatBody(body);
         generateTimestamp(timestamp);
 
         if (withSender) {
-                generateBody(userid, displayName, body);
-                setupAvatarLayout(displayName);
+                generateBody(userid, senderInfo, body);
+                setupAvatarLayout(senderInfo.display_name);
 
                 AvatarProvider::resolve(
                   room_id_, userid, this, [this](const QImage &img) { setUserAvatar(img); });
@@ -428,42 +462,8 @@ TimelineItem::TimelineItem(const mtx::events::RoomEvent<mtx::events::msg::Notice
   : QWidget(parent)
   , room_id_{room_id}
 {
-        init();
-        addReplyAction();
-
-        markOwnMessagesAsReceived(event.sender);
-
-        event_id_            = QString::fromStdString(event.event_id);
-        const auto sender    = QString::fromStdString(event.sender);
-        const auto timestamp = QDateTime::fromMSecsSinceEpoch(event.origin_server_ts);
-        auto body            = QString::fromStdString(event.content.body).trimmed().toHtmlEscaped();
-
-        descriptionMsg_ = {Cache::displayName(room_id_, sender),
-                           sender,
-                           " sent a notification",
-                           utils::descriptiveTime(timestamp),
-                           timestamp};
-
-        generateTimestamp(timestamp);
-
-        body.replace(conf::strings::url_regex, conf::strings::url_html);
-        body.replace("\n", "<br/>");
-        body = "<i>" + body + "</i>";
-
-        if (with_sender) {
-                auto displayName = Cache::displayName(room_id_, sender);
-
-                generateBody(sender, displayName, body);
-                setupAvatarLayout(displayName);
-
-                AvatarProvider::resolve(
-                  room_id_, sender, this, [this](const QImage &img) { setUserAvatar(img); });
-        } else {
-                generateBody(body);
-                setupSimpleLayout();
-        }
-
-        adjustMessageLayout();
+        buildTextShape(utils::intern(event.sender), with_sender);
+        bind(event);
 }
 
 /*
@@ -476,87 +476,173 @@ TimelineItem::TimelineItem(const mtx::events::RoomEvent<mtx::events::msg::Emote>
   : QWidget(parent)
   , room_id_{room_id}
 {
-        init();
-        addReplyAction();
+        buildTextShape(utils::intern(event.sender), with_sender);
+        bind(event);
+}
 
-        markOwnMessagesAsReceived(event.sender);
+/*
+ * Used to display remote text messages.
+ */
+TimelineItem::TimelineItem(const mtx::events::RoomEvent<mtx::events::msg::Text> &event,
+                           bool with_sender,
+                           const QString &room_id,
+                           QWidget *parent)
+  : QWidget(parent)
+  , room_id_{room_id}
+{
+        buildTextShape(utils::intern(event.sender), with_sender);
+        bind(event);
+}
 
-        event_id_         = QString::fromStdString(event.event_id);
-        const auto sender = QString::fromStdString(event.sender);
+void
+TimelineItem::buildTextShape(const QString &sender, bool withSender)
+{
+        init();
+        addReplyAction();
 
-        auto body        = QString::fromStdString(event.content.body).trimmed();
-        auto timestamp   = QDateTime::fromMSecsSinceEpoch(event.origin_server_ts);
-        auto displayName = Cache::displayName(room_id_, sender);
-        auto emoteMsg    = QString("* %1 %2").arg(displayName).arg(body);
+        generateTimestamp(QDateTime::currentDateTime());
 
-        descriptionMsg_ = {"", sender, emoteMsg, utils::descriptiveTime(timestamp), timestamp};
+        // The empty body is filled in by bind().
+        body_ = new TextLabel(QString(), this);
+        body_->setFont(font_);
+        body_->setTextInteractionFlags(Qt::TextSelectableByMouse | Qt::TextBrowserInteraction);
 
-        generateTimestamp(timestamp);
-        emoteMsg = emoteMsg.toHtmlEscaped();
-        emoteMsg.replace(conf::strings::url_regex, conf::strings::url_html);
-        emoteMsg.replace("\n", "<br/>");
+        if (withSender) {
+                const auto senderInfo = Cache::senderInfo(room_id_, sender);
 
-        if (with_sender) {
-                generateBody(sender, displayName, emoteMsg);
-                setupAvatarLayout(displayName);
+                generateUserName(sender, senderInfo);
+                setupAvatarLayout(senderInfo.display_name);
 
                 AvatarProvider::resolve(
                   room_id_, sender, this, [this](const QImage &img) { setUserAvatar(img); });
         } else {
-                generateBody(emoteMsg);
                 setupSimpleLayout();
         }
 
         adjustMessageLayout();
 }
 
-/*
- * Used to display remote text messages.
- */
-TimelineItem::TimelineItem(const mtx::events::RoomEvent<mtx::events::msg::Text> &event,
-                           bool with_sender,
-                           const QString &room_id,
-                           QWidget *parent)
-  : QWidget(parent)
-  , room_id_{room_id}
+void
+TimelineItem::bind(const mtx::events::RoomEvent<mtx::events::msg::Notice> &event)
 {
-        init();
-        addReplyAction();
+        markOwnMessagesAsReceived(event.sender);
+
+        event_id_            = QString::fromStdString(event.event_id);
+        const auto sender    = utils::intern(event.sender);
+        const auto timestamp = QDateTime::fromMSecsSinceEpoch(event.origin_server_ts);
+        const auto body      = QString::fromStdString(event.content.body).trimmed();
 
+        descUsername_  = Cache::senderInfo(room_id_, sender).display_name;
+        descUserid_    = sender;
+        descBody_      = " sent a notification";
+        descTimestamp_ = timestamp;
+
+        setTimestamp(timestamp);
+        setBodyHtml("<i>" + utils::formatBody(event_id_, body) + "</i>");
+}
+
+void
+TimelineItem::bind(const mtx::events::RoomEvent<mtx::events::msg::Emote> &event)
+{
         markOwnMessagesAsReceived(event.sender);
 
-        event_id_         = QString::fromStdString(event.event_id);
-        const auto sender = QString::fromStdString(event.sender);
+        event_id_            = QString::fromStdString(event.event_id);
+        const auto sender    = utils::intern(event.sender);
+        const auto timestamp = QDateTime::fromMSecsSinceEpoch(event.origin_server_ts);
+        const auto body      = QString::fromStdString(event.content.body).trimmed();
+
+        const auto senderInfo = Cache::senderInfo(room_id_, sender);
+        const auto emoteMsg   = QString("* %1 %2").arg(senderInfo.display_name).arg(body);
+
+        descUsername_  = "";
+        descUserid_    = sender;
+        descBody_      = emoteMsg;
+        descTimestamp_ = timestamp;
 
-        auto body        = QString::fromStdString(event.content.body).trimmed();
-        auto timestamp   = QDateTime::fromMSecsSinceEpoch(event.origin_server_ts);
-        auto displayName = Cache::displayName(room_id_, sender);
+        setTimestamp(timestamp);
+        // The formatted emote embeds the sender's display name, which can
+        // change, so it doesn't go through the per-event cache.
+        setBodyHtml(utils::formatBody(emoteMsg));
+}
+
+void
+TimelineItem::bind(const mtx::events::RoomEvent<mtx::events::msg::Text> &event)
+{
+        markOwnMessagesAsReceived(event.sender);
+
+        event_id_            = QString::fromStdString(event.event_id);
+        const auto sender    = utils::intern(event.sender);
+        const auto timestamp = QDateTime::fromMSecsSinceEpoch(event.origin_server_ts);
+        const auto body      = QString::fromStdString(event.content.body).trimmed();
 
         QSettings settings;
-        descriptionMsg_ = {sender == settings.value("auth/user_id") ? "You" : displayName,
-                           sender,
-                           QString(": %1").arg(body),
-                           utils::descriptiveTime(timestamp),
-                           timestamp};
+        descUsername_ = sender == settings.value("auth/user_id")
+                          ? "You"
+                          : Cache::senderInfo(room_id_, sender).display_name;
+        descUserid_    = sender;
+        descBody_      = QString(": %1").arg(body);
+        descTimestamp_ = timestamp;
 
-        generateTimestamp(timestamp);
+        setTimestamp(timestamp);
+        setBodyHtml(utils::formatBody(event_id_, body));
+}
 
-        body = body.toHtmlEscaped();
-        body.replace(conf::strings::url_regex, conf::strings::url_html);
-        body.replace("\n", "<br/>");
+//! Fully constructed sender-less shells waiting for reuse. Rebinding one
+//! costs two setText calls instead of the allocations of the constructor
+//! chain.
+static std::deque<TimelineItem *> itemPool_;
+constexpr size_t ITEM_POOL_SIZE = 128;
 
-        if (with_sender) {
-                generateBody(sender, displayName, body);
-                setupAvatarLayout(displayName);
+TimelineItem *
+TimelineItem::takeShell(const QString &room_id, QWidget *parent)
+{
+        if (itemPool_.empty())
+                return nullptr;
 
-                AvatarProvider::resolve(
-                  room_id_, sender, this, [this](const QImage &img) { setUserAvatar(img); });
-        } else {
-                generateBody(body);
-                setupSimpleLayout();
-        }
+        auto item = itemPool_.front();
+        itemPool_.pop_front();
 
-        adjustMessageLayout();
+        item->setParent(parent);
+        item->room_id_ = room_id;
+
+        // A freshly created view may not have housed an item yet.
+        parent->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Maximum);
+
+        return item;
+}
+
+bool
+TimelineItem::isPoolable() const
+{
+        return isRecyclable_ && userAvatar_ == nullptr && userName_ == nullptr &&
+               widgetLayout_ == nullptr && body_ != nullptr;
+}
+
+void
+TimelineItem::drainPool()
+{
+        for (auto item : itemPool_)
+                item->deleteLater();
+
+        itemPool_.clear();
+}
+
+bool
+TimelineItem::recycle(TimelineItem *item)
+{
+        if (!item->isPoolable() || itemPool_.size() >= ITEM_POOL_SIZE)
+                return false;
+
+        item->hide();
+        item->setParent(nullptr);
+
+        item->event_id_.clear();
+        item->isReceived_ = false;
+        item->statusIndicator_->setState(StatusIndicatorState::Empty);
+
+        itemPool_.push_back(item);
+
+        return true;
 }
 
 void
@@ -565,6 +651,17 @@ TimelineItem::markSent()
         statusIndicator_->setState(StatusIndicatorState::Sent);
 }
 
+void
+TimelineItem::markFailed()
+{
+        // A late failure notice must not downgrade a message the server
+        // has already acknowledged.
+        if (isReceived_)
+                return;
+
+        statusIndicator_->setState(StatusIndicatorState::Failed);
+}
+
 void
 TimelineItem::markOwnMessagesAsReceived(const std::string &sender)
 {
@@ -580,6 +677,41 @@ TimelineItem::markRead()
                 statusIndicator_->setState(StatusIndicatorState::Read);
 }
 
+void
+TimelineItem::markRedacted()
+{
+        // A media row turns into a text row: the media widget goes away
+        // and a body label takes its slot in the message layout.
+        if (widgetLayout_ != nullptr) {
+                while (auto child = widgetLayout_->takeAt(0)) {
+                        if (child->widget())
+                                child->widget()->deleteLater();
+
+                        delete child;
+                }
+
+                messageLayout_->removeItem(widgetLayout_);
+                delete widgetLayout_;
+                widgetLayout_ = nullptr;
+
+                if (body_ == nullptr) {
+                        body_ = new TextLabel(QString(), this);
+                        body_->setFont(font_);
+                        body_->setTextInteractionFlags(Qt::TextSelectableByMouse |
+                                                       Qt::TextBrowserInteraction);
+                        messageLayout_->insertWidget(0, body_, 1);
+                }
+        }
+
+        setBodyHtml(QString("<i>%1</i>").arg(tr("Message removed")));
+        descBody_ = QString(" %1").arg(tr("removed a message"));
+
+        // There is nothing left to redact and the pool must not hand out
+        // a shell with a disabled action.
+        redactMsg_->setEnabled(false);
+        isRecyclable_ = false;
+}
+
 void
 TimelineItem::markReceived(bool isEncrypted)
 {
@@ -609,33 +741,23 @@ TimelineItem::generateBody(const QString &body)
 
 // The username/timestamp is displayed along with the message body.
 void
-TimelineItem::generateBody(const QString &user_id, const QString &displayname, const QString &body)
+TimelineItem::generateBody(const QString &user_id, const SenderInfo &sender, const QString &body)
 {
-        generateUserName(user_id, displayname);
+        generateUserName(user_id, sender);
         generateBody(body);
 }
 
 void
-TimelineItem::generateUserName(const QString &user_id, const QString &displayname)
+TimelineItem::generateUserName(const QString &user_id, const SenderInfo &sender)
 {
-        auto sender = displayname;
-
-        if (displayname.startsWith("@")) {
-                // TODO: Fix this by using a UserId type.
-                if (displayname.split(":")[0].split("@").size() > 1)
-                        sender = displayname.split(":")[0].split("@")[1];
-        }
-
-        QFontMetrics fm(usernameFont_);
-
         userName_ = new QLabel(this);
         userName_->setFont(usernameFont_);
-        userName_->setText(fm.elidedText(sender, Qt::ElideRight, 500));
+        userName_->setText(utils::elidedText(usernameFont_, sender.timeline_name, 500));
         userName_->setToolTip(user_id);
         userName_->setToolTipDuration(1500);
         userName_->setAttribute(Qt::WA_Hover);
         userName_->setAlignment(Qt::AlignLeft | Qt::AlignTop);
-        userName_->setFixedWidth(QFontMetrics(userName_->font()).width(userName_->text()));
+        userName_->setFixedWidth(utils::textWidth(userName_->font(), userName_->text()));
 
         auto filter = new UserProfileFilter(user_id, userName_);
         userName_->installEventFilter(filter);
@@ -666,28 +788,52 @@ TimelineItem::generateTimestamp(const QDateTime &time)
 
         timestamp_ = new QLabel(this);
         timestamp_->setFont(timestampFont);
+        setTimestamp(time);
+}
+
+void
+TimelineItem::setTimestamp(const QDateTime &time)
+{
         timestamp_->setText(
           QString("<span style=\"color: #999\"> %1 </span>").arg(time.toString("HH:mm")));
 }
 
+void
+TimelineItem::setBodyHtml(const QString &html)
+{
+        body_->setText(QString("<span>%1</span>").arg(replaceEmoji(html)));
+}
+
+//! Formatted bodies are kept around so that a message which is
+//! materialized again after widget eviction doesn't pay for a second
+//! character scan.
+static QCache<QString, QString> formattedBodies_{512};
+
 QString
 TimelineItem::replaceEmoji(const QString &body)
 {
+        if (auto cached = formattedBodies_.object(body))
+                return *cached;
+
         QString fmtBody = "";
+        fmtBody.reserve(body.size());
 
         QVector<uint> utf32_string = body.toUcs4();
 
         for (auto &code : utf32_string) {
                 // TODO: Be more precise here.
                 if (code > 9000)
-                        fmtBody += QString("<span style=\"font-family: Emoji "
-                                           "One; font-size: %1px\">")
-                                     .arg(conf::emojiSize) +
-                                   QString::fromUcs4(&code, 1) + "</span>";
+                        // The glyph comes out of the atlas as a finished
+                        // cell, so painting it is a blit.
+                        fmtBody += QString("<img src=\"emoji:%1\" width=\"%2\" height=\"%2\">")
+                                     .arg(QString::number(code, 16))
+                                     .arg(emoji::Atlas::instance().cellSize());
                 else
                         fmtBody += QString::fromUcs4(&code, 1);
         }
 
+        formattedBodies_.insert(body, new QString(fmtBody));
+
         return fmtBody;
 }
 
@@ -770,7 +916,7 @@ TimelineItem::addReplyAction()
                                 return;
 
                         emit ChatPage::instance()->messageReply(
-                          Cache::displayName(room_id_, descriptionMsg_.userid),
+                          Cache::displayName(room_id_, descUserid_),
                           body_->toPlainText());
                 });
         }
@@ -779,6 +925,9 @@ TimelineItem::addReplyAction()
 void
 TimelineItem::addKeyRequestAction()
 {
+        // The extra action would survive a pooled rebind.
+        isRecyclable_ = false;
+
         if (contextMenu_) {
                 auto requestKeys = new QAction("Request encryption keys", this);
                 contextMenu_->addAction(requestKeys);
@@ -796,12 +945,12 @@ TimelineItem::addAvatar()
                 return;
 
         // TODO: should be replaced with the proper event struct.
-        auto userid      = descriptionMsg_.userid;
-        auto displayName = Cache::displayName(room_id_, userid);
+        auto userid           = descUserid_;
+        const auto senderInfo = Cache::senderInfo(room_id_, userid);
 
-        generateUserName(userid, displayName);
+        generateUserName(userid, senderInfo);
 
-        setupAvatarLayout(displayName);
+        setupAvatarLayout(senderInfo.display_name);
 
         AvatarProvider::resolve(
           room_id_, userid, this, [this](const QImage &img) { setUserAvatar(img); });
@@ -811,14 +960,5 @@ void
 TimelineItem::sendReadReceipt() const
 {
         if (!event_id_.isEmpty())
-                http::client()->read_event(room_id_.toStdString(),
-                                           event_id_.toStdString(),
-                                           [this](mtx::http::RequestErr err) {
-                                                   if (err) {
-                                                           nhlog::net()->warn(
-                                                             "failed to read_event ({}, {})",
-                                                             room_id_.toStdString(),
-                                                             event_id_.toStdString());
-                                                   }
-                                           });
+                receipts::markVisible(room_id_, event_id_);
 }
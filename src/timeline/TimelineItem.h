@@ -54,6 +54,8 @@ enum class StatusIndicatorState
         Read,
         //! The client sent the message. Not yet received.
         Sent,
+        //! Delivery keeps failing; the client is still retrying.
+        Failed,
         //! When the message is loaded from cache or backfill.
         Empty,
 };
@@ -80,6 +82,7 @@ private:
         QIcon clockIcon_;
         QIcon checkmarkIcon_;
         QIcon doubleCheckmarkIcon_;
+        QIcon failedIcon_;
 
         QColor iconColor_ = QColor("#999");
 
@@ -97,6 +100,11 @@ public:
 
         void wheelEvent(QWheelEvent *event) override { event->ignore(); }
 
+protected:
+        //! Serves emoji: urls from the persistent glyph atlas, so an
+        //! emoji paints as a blit instead of a font engine round trip.
+        QVariant loadResource(int type, const QUrl &name) override;
+
 private slots:
         void adjustHeight(const QSizeF &size) { setFixedHeight(size.height()); }
 };
@@ -211,12 +219,31 @@ public:
                      QWidget *parent);
 
         void setUserAvatar(const QImage &pixmap);
-        DescInfo descriptionMessage() const { return descriptionMsg_; }
+        //! Assembled on demand: of all the items built during a sync
+        //! only the last one per room feeds the sidebar preview, so the
+        //! relative timestamp is never rendered for the rest.
+        DescInfo descriptionMessage() const
+        {
+                return DescInfo{descUsername_,
+                                descUserid_,
+                                descBody_,
+                                utils::descriptiveTime(descTimestamp_),
+                                descTimestamp_};
+        }
+        QString descriptionUserId() const { return descUserid_; }
+        QDateTime descriptionDateTime() const { return descTimestamp_; }
         QString eventId() const { return event_id_; }
         void setEventId(const QString &event_id) { event_id_ = event_id; }
         void markReceived(bool isEncrypted);
         void markRead();
         void markSent();
+        //! Flag the optimistically rendered message as undelivered. A
+        //! no-op once the server has acknowledged the message.
+        void markFailed();
+        //! Turn the item into a redaction tombstone in place: the body is
+        //! replaced and any media widget is dropped, but the row itself
+        //! stays, so only this item's geometry is invalidated.
+        void markRedacted();
         bool isReceived() { return isReceived_; };
         void setRoomId(QString room_id) { room_id_ = room_id; }
         void sendReadReceipt() const;
@@ -225,6 +252,28 @@ public:
         void addAvatar();
         void addKeyRequestAction();
 
+        //! Take a recycled shell from the pool and rebind it to the given
+        //! event, or return nullptr when the pool is empty. Rebinding costs
+        //! a couple of setText calls instead of the constructor chain.
+        template<class Event>
+        static TimelineItem *
+        fromPool(const Event &event, const QString &room_id, QWidget *parent)
+        {
+                auto item = takeShell(room_id, parent);
+
+                if (item)
+                        item->bind(event);
+
+                return item;
+        }
+        //! Park the item's widget shell in the pool instead of destroying
+        //! it. Returns false when the item's shape can't be rebound; the
+        //! caller keeps ownership.
+        static bool recycle(TimelineItem *item);
+        //! Destroy the pooled shells, e.g under memory pressure. The pool
+        //! refills through the regular recycling path.
+        static void drainPool();
+
 signals:
         void eventRedacted(const QString &event_id);
         void redactionFailed(const QString &msg);
@@ -248,10 +297,26 @@ private:
         template<class Event, class Widget>
         void setupWidgetLayout(Widget *widget, const Event &event, bool withSender);
 
+        //! Build the widget tree of a text-like message without binding
+        //! any event data to it.
+        void buildTextShape(const QString &sender, bool withSender);
+        //! Bind event data to an already constructed widget tree.
+        void bind(const mtx::events::RoomEvent<mtx::events::msg::Notice> &event);
+        void bind(const mtx::events::RoomEvent<mtx::events::msg::Emote> &event);
+        void bind(const mtx::events::RoomEvent<mtx::events::msg::Text> &event);
+        void setTimestamp(const QDateTime &time);
+        void setBodyHtml(const QString &html);
+        //! Whether the widget tree has the one shape the pool can rebind:
+        //! sender-less, no media widget, no extra context menu actions.
+        bool isPoolable() const;
+        //! Reparent and hand out a pooled shell, or nullptr when the pool
+        //! is empty.
+        static TimelineItem *takeShell(const QString &room_id, QWidget *parent);
+
         void generateBody(const QString &body);
-        void generateBody(const QString &user_id, const QString &displayname, const QString &body);
+        void generateBody(const QString &user_id, const SenderInfo &sender, const QString &body);
         void generateTimestamp(const QDateTime &time);
-        void generateUserName(const QString &userid, const QString &displayname);
+        void generateUserName(const QString &userid, const SenderInfo &sender);
 
         void setupAvatarLayout(const QString &userName);
         void setupSimpleLayout();
@@ -262,12 +327,19 @@ private:
         //! Whether or not the event associated with the widget
         //! has been acknowledged by the server.
         bool isReceived_ = false;
+        //! Cleared when the item accumulates state that a pooled rebind
+        //! wouldn't undo, e.g. extra context menu actions.
+        bool isRecyclable_ = true;
 
         QString replaceEmoji(const QString &body);
         QString event_id_;
         QString room_id_;
 
-        DescInfo descriptionMsg_;
+        //! Raw inputs of descriptionMessage().
+        QString descUsername_;
+        QString descUserid_;
+        QString descBody_;
+        QDateTime descTimestamp_;
 
         QMenu *contextMenu_;
         QAction *showReadReceipts_;
@@ -296,14 +368,12 @@ template<class Widget>
 void
 TimelineItem::setupLocalWidgetLayout(Widget *widget, const QString &userid, bool withSender)
 {
-        auto displayName = Cache::displayName(room_id_, userid);
-        auto timestamp   = QDateTime::currentDateTime();
+        auto timestamp = QDateTime::currentDateTime();
 
-        descriptionMsg_ = {"You",
-                           userid,
-                           QString(" %1").arg(utils::messageDescription<Widget>()),
-                           utils::descriptiveTime(timestamp),
-                           timestamp};
+        descUsername_  = "You";
+        descUserid_    = userid;
+        descBody_      = QString(" %1").arg(utils::messageDescription<Widget>());
+        descTimestamp_ = timestamp;
 
         generateTimestamp(timestamp);
 
@@ -313,8 +383,10 @@ TimelineItem::setupLocalWidgetLayout(Widget *widget, const QString &userid, bool
         widgetLayout_->addStretch(1);
 
         if (withSender) {
-                generateBody(userid, displayName, "");
-                setupAvatarLayout(displayName);
+                const auto senderInfo = Cache::senderInfo(room_id_, userid);
+
+                generateBody(userid, senderInfo, "");
+                setupAvatarLayout(senderInfo.display_name);
 
                 AvatarProvider::resolve(
                   room_id_, userid, this, [this](const QImage &img) { setUserAvatar(img); });
@@ -332,17 +404,17 @@ TimelineItem::setupWidgetLayout(Widget *widget, const Event &event, bool withSen
         init();
 
         event_id_         = QString::fromStdString(event.event_id);
-        const auto sender = QString::fromStdString(event.sender);
+        const auto sender = utils::intern(event.sender);
 
-        auto timestamp   = QDateTime::fromMSecsSinceEpoch(event.origin_server_ts);
-        auto displayName = Cache::displayName(room_id_, sender);
+        auto timestamp        = QDateTime::fromMSecsSinceEpoch(event.origin_server_ts);
+        const auto senderInfo = Cache::senderInfo(room_id_, sender);
 
         QSettings settings;
-        descriptionMsg_ = {sender == settings.value("auth/user_id") ? "You" : displayName,
-                           sender,
-                           QString(" %1").arg(utils::messageDescription<Widget>()),
-                           utils::descriptiveTime(timestamp),
-                           timestamp};
+        descUsername_ =
+          sender == settings.value("auth/user_id") ? "You" : senderInfo.display_name;
+        descUserid_    = sender;
+        descBody_      = QString(" %1").arg(utils::messageDescription<Widget>());
+        descTimestamp_ = timestamp;
 
         generateTimestamp(timestamp);
 
@@ -352,8 +424,8 @@ TimelineItem::setupWidgetLayout(Widget *widget, const Event &event, bool withSen
         widgetLayout_->addStretch(1);
 
         if (withSender) {
-                generateBody(sender, displayName, "");
-                setupAvatarLayout(displayName);
+                generateBody(sender, senderInfo, "");
+                setupAvatarLayout(senderInfo.display_name);
 
                 AvatarProvider::resolve(
                   room_id_, sender, this, [this](const QImage &img) { setUserAvatar(img); });
@@ -0,0 +1,135 @@
+/*
+ * nheko Copyright (C) 2017  Konstantinos Sideris <siderisk@auth.gr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Utils.h"
+#include "timeline/TimelineModel.h"
+
+bool
+TimelineModel::addBottom(const TimelineEvent &event)
+{
+        const auto event_id = utils::eventId(event);
+
+        if (!event_id.isEmpty() && ids_.contains(event_id))
+                return false;
+
+        events_.push_back(event);
+        ids_.insert(event_id);
+
+        return true;
+}
+
+bool
+TimelineModel::addTop(const TimelineEvent &event)
+{
+        const auto event_id = utils::eventId(event);
+
+        if (!event_id.isEmpty() && ids_.contains(event_id))
+                return false;
+
+        // Events from /messages arrive in reverse chronological order, so
+        // prepending them one by one restores the timeline order.
+        events_.push_front(event);
+        ids_.insert(event_id);
+
+        // Pagination through the network is only done when the model has no
+        // more events to materialize, so the new events are part of the
+        // materialized window.
+        return true;
+}
+
+std::vector<TimelineModel::TimelineEvent>
+TimelineModel::materializeTop(std::size_t max)
+{
+        const auto from =
+          materializedStart_ > max ? materializedStart_ - max : static_cast<std::size_t>(0);
+
+        std::vector<TimelineEvent> events(events_.begin() + from,
+                                          events_.begin() + materializedStart_);
+
+        materializedStart_ = from;
+
+        return events;
+}
+
+void
+TimelineModel::retireThrough(const QString &event_id)
+{
+        for (auto i = materializedStart_; i < events_.size(); ++i) {
+                if (utils::eventId(events_.at(i)) == event_id) {
+                        materializedStart_ = i + 1;
+                        return;
+                }
+        }
+}
+
+bool
+TimelineModel::redact(const QString &event_id)
+{
+        if (!ids_.contains(event_id))
+                return false;
+
+        for (auto &event : events_) {
+                if (utils::eventId(event) != event_id)
+                        continue;
+
+                // A notice renders as italic text, which is exactly the
+                // tombstone presentation, so the record can reuse the
+                // regular rendering path.
+                mtx::events::RoomEvent<mtx::events::msg::Notice> tombstone;
+                tombstone.event_id         = event_id.toStdString();
+                tombstone.sender           = utils::event_sender(event).toStdString();
+                tombstone.origin_server_ts = utils::event_timestamp(event);
+                tombstone.type             = mtx::events::EventType::RoomMessage;
+                tombstone.content.msgtype  = "m.notice";
+                tombstone.content.body     = "Message removed";
+
+                // The memoized formatted body still holds the original
+                // content; evict it so rebinding the tombstone after the
+                // widget was trimmed can't resurrect the removed message.
+                utils::invalidateFormattedBody(event_id);
+
+                event = tombstone;
+
+                return true;
+        }
+
+        return false;
+}
+
+void
+TimelineModel::saveWidgetHeight(const QString &event_id, int height)
+{
+        if (!event_id.isEmpty())
+                savedHeights_[event_id] += height;
+}
+
+int
+TimelineModel::takeWidgetHeight(const QString &event_id)
+{
+        return savedHeights_.take(event_id);
+}
+
+void
+TimelineModel::clear()
+{
+        events_.clear();
+        ids_.clear();
+        materializedStart_ = 0;
+        savedHeights_.clear();
+        topBoundary_    = Boundary{};
+        bottomBoundary_ = Boundary{};
+}
@@ -0,0 +1,120 @@
+/*
+ * nheko Copyright (C) 2017  Konstantinos Sideris <siderisk@auth.gr>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+
+#include <mtx/events.hpp>
+
+//! In-memory store of a room's timeline events.
+//!
+//! The view only materializes widgets for a window at the bottom of the
+//! model. Older events are kept as plain records, so the memory used by
+//! live widgets stays independent of the scrollback length.
+class TimelineModel
+{
+public:
+        using TimelineEvent = mtx::events::collections::TimelineEvents;
+
+        //! The two ends of the timeline.
+        enum class Edge
+        {
+                Top,
+                Bottom,
+        };
+
+        //! Sender & timestamp of the message at one end of the timeline.
+        //! Queried to decide whether the next message needs its own sender
+        //! header, without walking the view's widgets. The timestamp is
+        //! kept as raw milliseconds so the per-event comparisons stay
+        //! integer arithmetic.
+        struct Boundary
+        {
+                QString sender;
+                uint64_t timestamp = 0;
+        };
+
+        //! Append an event that arrived through /sync.
+        //! Returns false if the event is already part of the model.
+        bool addBottom(const TimelineEvent &event);
+        //! Prepend an event that arrived through /messages.
+        //! Returns false if the event is already part of the model.
+        bool addTop(const TimelineEvent &event);
+
+        //! Whether there are events above the materialized window that can
+        //! be rendered without hitting the /messages endpoint.
+        bool canMaterializeTop() const { return materializedStart_ > 0; }
+        //! Retrieve at most @p max events above the materialized window, in
+        //! timeline order, expanding the window upwards.
+        std::vector<TimelineEvent> materializeTop(std::size_t max);
+        //! Shrink the materialized window from the top. All events up to and
+        //! including @p event_id will be kept only as records.
+        void retireThrough(const QString &event_id);
+
+        //! Mutate the record of the given event in place into a redaction
+        //! tombstone, so a retired event that is materialized again is
+        //! rendered redacted. Returns false if the event is not part of
+        //! the model.
+        bool redact(const QString &event_id);
+
+        //! Save the on-screen height of the widget that represented the
+        //! given event, so an equal amount of space can be reserved after
+        //! the widget is deleted.
+        void saveWidgetHeight(const QString &event_id, int height);
+        //! Retrieve & discard the saved height for the given event.
+        //! Returns 0 if no height was saved.
+        int takeWidgetHeight(const QString &event_id);
+
+        //! Record the message last rendered at the given end. Locally sent
+        //! messages are recorded before they have an event id, hence the
+        //! explicit call instead of being part of addBottom.
+        void setBoundary(Edge edge, const QString &sender, uint64_t timestamp)
+        {
+                boundaryAt(edge) = Boundary{sender, timestamp};
+        }
+        void clearBoundary(Edge edge) { boundaryAt(edge) = Boundary{}; }
+        const Boundary &boundary(Edge edge) const
+        {
+                return edge == Edge::Top ? topBoundary_ : bottomBoundary_;
+        }
+
+        std::size_t size() const { return events_.size(); }
+        void clear();
+
+private:
+        Boundary &boundaryAt(Edge edge)
+        {
+                return edge == Edge::Top ? topBoundary_ : bottomBoundary_;
+        }
+
+        std::deque<TimelineEvent> events_;
+        //! Event ids present in the model. Used for duplicate detection.
+        QSet<QString> ids_;
+        //! Index of the first event that is backed by a live widget.
+        std::size_t materializedStart_ = 0;
+        //! Heights of the deleted widgets of retired events.
+        QHash<QString, int> savedHeights_;
+        //! The oldest & newest rendered messages.
+        Boundary topBoundary_;
+        Boundary bottomBoundary_;
+};
@@ -15,10 +15,15 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <mutex>
+
 #include <boost/variant.hpp>
 
 #include <QApplication>
 #include <QFileInfo>
+#include <QOpenGLWidget>
+#include <QPointer>
+#include <QSettings>
 #include <QTimer>
 #include <QtConcurrent>
 
@@ -27,6 +32,9 @@
 #include "Config.h"
 #include "Logging.h"
 #include "Olm.h"
+#include "Perf.h"
+#include "Receipts.h"
+#include "TimerLifecycle.h"
 #include "UserSettingsPage.h"
 #include "Utils.h"
 #include "ui/FloatingButton.h"
@@ -43,30 +51,73 @@ using TimelineEvent = mtx::events::collections::TimelineEvents;
 //! Maximum number of widgets to keep in the timeline layout.
 constexpr int MAX_RETAINED_WIDGETS = 100;
 constexpr int MIN_SCROLLBAR_HANDLE = 60;
-
-//! Retrieve the timestamp of the event represented by the given widget.
-QDateTime
-getDate(QWidget *widget)
+//! Number of events to materialize from the model per pagination step.
+constexpr int SCROLLBACK_CHUNK = 30;
+//! Number of events next to the viewport that are decrypted & delivered
+//! ahead of the rest of a paginated batch.
+constexpr std::size_t VIEWPORT_DECRYPT_CHUNK = 10;
+//! Scroll speed, in pixels per millisecond, above which the media
+//! widgets degrade to their cheap paint path.
+constexpr double FAST_SCROLL_VELOCITY = 3.0;
+//! How long the scrollbar has to stay still before the viewport is
+//! repainted at full quality.
+constexpr int SCROLL_SETTLE_MS = 150;
+//! Maximum number of unacknowledged send requests per room. Kept small
+//! because requests on separate connections may reach the server out of
+//! order; the window trades a bounded amount of that risk for not paying
+//! a full round trip per message.
+constexpr int MAX_INFLIGHT_MESSAGES = 4;
+//! Failed delivery attempts before the message is flagged in the
+//! timeline. Retries continue past this; only the indicator changes.
+constexpr int MESSAGE_RETRY_WARNING = 3;
+
+//! Retrieve the timestamp, in milliseconds since the epoch, of the
+//! event represented by the given widget. Returns 0 for widgets that
+//! don't carry one.
+uint64_t
+getTimestampMs(QWidget *widget)
 {
         auto item = qobject_cast<TimelineItem *>(widget);
         if (item)
-                return item->descriptionMessage().datetime;
+                return static_cast<uint64_t>(item->descriptionDateTime().toMSecsSinceEpoch());
 
         auto infoMsg = qobject_cast<InfoMessage *>(widget);
         if (infoMsg)
-                return infoMsg->datetime();
+                return static_cast<uint64_t>(infoMsg->datetime().toMSecsSinceEpoch());
+
+        return 0;
+}
+
+constexpr qint64 MS_PER_DAY = 24 * 60 * 60 * 1000;
+
+//! Local UTC offset applied when bucketing timestamps into days.
+//! Refreshed once per rendered batch instead of consulting the system
+//! timezone through QDateTime for every event.
+qint64 localUtcOffsetMs = 0;
+
+void
+refreshLocalUtcOffset()
+{
+        localUtcOffsetMs = qint64(QDateTime::currentDateTime().offsetFromUtc()) * 1000;
+}
 
-        return QDateTime();
+//! The local calendar day a timestamp falls on, as days since the
+//! epoch. Two timestamps need a date separator iff their indexes differ.
+qint64
+localDayIndex(uint64_t ts)
+{
+        return (qint64(ts) + localUtcOffsetMs) / MS_PER_DAY;
 }
 
-TimelineView::TimelineView(const mtx::responses::Timeline &timeline,
+TimelineView::TimelineView(mtx::responses::Timeline timeline,
                            const QString &room_id,
                            QWidget *parent)
   : QWidget(parent)
   , room_id_{room_id}
 {
         init();
-        addEvents(timeline);
+        addEvents(std::move(timeline));
+        restorePendingMessages();
 }
 
 TimelineView::TimelineView(const QString &room_id, QWidget *parent)
@@ -75,6 +126,7 @@ TimelineView::TimelineView(const QString &room_id, QWidget *parent)
 {
         init();
         getMessages();
+        restorePendingMessages();
 }
 
 void
@@ -113,6 +165,13 @@ TimelineView::fetchHistory()
                 if (!isVisible())
                         return;
 
+                // Render the retained records before hitting the network.
+                if (model_.canMaterializeTop()) {
+                        rehydrateTopEvents();
+                        paginationTimer_->start(2000);
+                        return;
+                }
+
                 isPaginationInProgress_ = true;
                 getMessages();
                 paginationTimer_->start(2000);
@@ -129,10 +188,14 @@ TimelineView::scrollDown()
         int current = scroll_area_->verticalScrollBar()->value();
         int max     = scroll_area_->verticalScrollBar()->maximum();
 
-        // The first time we enter the room move the scroll bar to the bottom.
+        // The first time we enter the room restore the position of the
+        // last session, or move the scroll bar to the bottom.
         if (!isInitialized) {
-                scroll_area_->verticalScrollBar()->setValue(max);
                 isInitialized = true;
+
+                if (!restoreScrollAnchor())
+                        scroll_area_->verticalScrollBar()->setValue(max);
+
                 return;
         }
 
@@ -148,10 +211,31 @@ TimelineView::sliderMoved(int position)
         if (!scroll_area_->verticalScrollBar()->isVisible())
                 return;
 
+        measureScrollVelocity(position);
+
         toggleScrollDownButton();
 
-        // The scrollbar is high enough so we can start retrieving old events.
-        if (position < SCROLL_BAR_GAP) {
+        // Persist the position once the scrolling settles.
+        scrollAnchorTimer_->start();
+
+        // Delete any widgets that ended up far above the visible area while
+        // the user was scrolling back down.
+        trimOffscreenWidgets();
+
+        // The viewport is approaching the area reserved for evicted widgets,
+        // so they have to be materialized again before the user reaches it.
+        if (position < topPlaceholderHeight_ + SCROLL_BAR_GAP && model_.canMaterializeTop()) {
+                rehydrateTopEvents();
+                return;
+        }
+
+        // Start the next request while a fifth of the scrollback is still
+        // above the viewport, so the history usually arrives before the
+        // user reaches the top.
+        const int prefetchEdge =
+          std::max(SCROLL_BAR_GAP, scroll_area_->verticalScrollBar()->maximum() / 5);
+
+        if (position < prefetchEdge) {
                 if (isTimelineFinished)
                         return;
 
@@ -166,6 +250,38 @@ TimelineView::sliderMoved(int position)
         }
 }
 
+void
+TimelineView::measureScrollVelocity(int position)
+{
+        if (!scrollVelocityTimer_.isValid()) {
+                scrollVelocityTimer_.start();
+                lastScrollPosition_ = position;
+                return;
+        }
+
+        const auto elapsed  = std::max<qint64>(scrollVelocityTimer_.restart(), 1);
+        const auto delta    = std::abs(position - lastScrollPosition_);
+        lastScrollPosition_ = position;
+
+        if (delta / static_cast<double>(elapsed) < FAST_SCROLL_VELOCITY)
+                return;
+
+        utils::setFastScrolling(true);
+        scrollSettleTimer_->start();
+}
+
+bool
+TimelineView::prefetchHistory()
+{
+        if (model_.size() > 0 || isPaginationInProgress_ || isTimelineFinished)
+                return false;
+
+        isPaginationInProgress_ = true;
+        getMessages();
+
+        return true;
+}
+
 bool
 TimelineView::isStartOfTimeline(const mtx::responses::Messages &msgs)
 {
@@ -173,7 +289,7 @@ TimelineView::isStartOfTimeline(const mtx::responses::Messages &msgs)
 }
 
 void
-TimelineView::addBackwardsEvents(const mtx::responses::Messages &msgs)
+TimelineView::addBackwardsEvents(mtx::responses::Messages msgs)
 {
         // We've reached the start of the timline and there're no more messages.
         if (isStartOfTimeline(msgs)) {
@@ -185,98 +301,84 @@ TimelineView::addBackwardsEvents(const mtx::responses::Messages &msgs)
 
         isTimelineFinished = false;
 
-        // Queue incoming messages to be rendered later.
-        topMessages_.insert(topMessages_.end(),
-                            std::make_move_iterator(msgs.chunk.begin()),
-                            std::make_move_iterator(msgs.chunk.end()));
-
-        // The RoomList message preview will be updated only if this
-        // is the first batch of messages received through /messages
-        // i.e there are no other messages currently present.
-        if (!topMessages_.empty() && scroll_layout_->count() == 0)
-                notifyForLastEvent(findFirstViewableEvent(topMessages_));
-
-        if (isVisible()) {
-                renderTopEvents(topMessages_);
+        // Keep a record of each event so it can be materialized again after
+        // its widget is evicted.
+        for (const auto &e : msgs.chunk)
+                model_.addTop(e);
 
-                // Free up space for new messages.
-                topMessages_.clear();
-
-                // Send a read receipt for the last event.
-                if (isActiveWindow())
-                        readLastEvent();
-        }
+        prev_batch_token_ = QString::fromStdString(msgs.end);
 
-        prev_batch_token_       = QString::fromStdString(msgs.end);
-        isPaginationInProgress_ = false;
+        // Decrypt any encrypted events on the thread pool before the batch
+        // is added to the timeline.
+        queueBatch(std::move(msgs.chunk), TimelineDirection::Top);
 }
 
-QWidget *
-TimelineView::parseMessageEvent(const mtx::events::collections::TimelineEvents &event,
-                                TimelineDirection direction)
+//! Compile-time dispatch table over the timeline event variant.
+//!
+//! Each renderable type maps to its widget with an overload, so the
+//! per-event dispatch is the variant's indexed jump instead of a chain
+//! of runtime type checks. Adding a type is one more overload; anything
+//! without one falls through to the catch-all and renders nothing.
+struct EventWidgetVisitor : public boost::static_visitor<QWidget *>
 {
-        using namespace mtx::events;
-
-        using AudioEvent  = RoomEvent<msg::Audio>;
-        using EmoteEvent  = RoomEvent<msg::Emote>;
-        using FileEvent   = RoomEvent<msg::File>;
-        using ImageEvent  = RoomEvent<msg::Image>;
-        using NoticeEvent = RoomEvent<msg::Notice>;
-        using TextEvent   = RoomEvent<msg::Text>;
-        using VideoEvent  = RoomEvent<msg::Video>;
-
-        if (boost::get<RedactionEvent<msg::Redaction>>(&event) != nullptr) {
-                auto redaction_event = boost::get<RedactionEvent<msg::Redaction>>(event);
-                const auto event_id  = QString::fromStdString(redaction_event.redacts);
-
-                QTimer::singleShot(0, this, [event_id, this]() {
-                        if (eventIds_.contains(event_id))
-                                removeEvent(event_id);
+        using AudioEvent      = mtx::events::RoomEvent<mtx::events::msg::Audio>;
+        using EmoteEvent      = mtx::events::RoomEvent<mtx::events::msg::Emote>;
+        using FileEvent       = mtx::events::RoomEvent<mtx::events::msg::File>;
+        using ImageEvent      = mtx::events::RoomEvent<mtx::events::msg::Image>;
+        using NoticeEvent     = mtx::events::RoomEvent<mtx::events::msg::Notice>;
+        using TextEvent       = mtx::events::RoomEvent<mtx::events::msg::Text>;
+        using VideoEvent      = mtx::events::RoomEvent<mtx::events::msg::Video>;
+        using StickerEvent    = mtx::events::Sticker;
+        using EncryptedEvent  = mtx::events::EncryptedEvent<mtx::events::msg::Encrypted>;
+        using RedactionEvent  = mtx::events::RedactionEvent<mtx::events::msg::Redaction>;
+        using EncryptionEvent = mtx::events::StateEvent<mtx::events::state::Encryption>;
+
+        EventWidgetVisitor(TimelineView *view, TimelineDirection direction)
+          : view{view}
+          , direction{direction}
+        {}
+
+        QWidget *operator()(const RedactionEvent &e) const
+        {
+                const auto event_id = QString::fromStdString(e.redacts);
+
+                // Routed unconditionally: events without a live widget
+                // still have their model record mutated.
+                QTimer::singleShot(0, view, [event_id, view = view]() {
+                        view->removeEvent(event_id);
                 });
 
                 return nullptr;
-        } else if (boost::get<StateEvent<state::Encryption>>(&event) != nullptr) {
-                auto msg      = boost::get<StateEvent<state::Encryption>>(event);
-                auto event_id = QString::fromStdString(msg.event_id);
+        }
 
-                if (eventIds_.contains(event_id))
+        QWidget *operator()(const EncryptionEvent &e) const
+        {
+                auto event_id = QString::fromStdString(e.event_id);
+
+                if (view->isDuplicate(event_id))
                         return nullptr;
 
-                auto item = new InfoMessage(tr("Encryption is enabled"), this);
-                item->saveDatetime(QDateTime::fromMSecsSinceEpoch(msg.origin_server_ts));
-                eventIds_[event_id] = item;
+                auto item = new InfoMessage(TimelineView::tr("Encryption is enabled"), view);
+                item->saveDatetime(QDateTime::fromMSecsSinceEpoch(e.origin_server_ts));
+                view->seenEventIds_.insert(event_id);
+                view->eventIds_[event_id] = item;
 
                 // Force the next message to have avatar by not providing the current username.
-                saveMessageInfo("", msg.origin_server_ts, direction);
+                view->saveMessageInfo("", e.origin_server_ts, direction);
 
                 return item;
-        } else if (boost::get<RoomEvent<msg::Audio>>(&event) != nullptr) {
-                auto audio = boost::get<RoomEvent<msg::Audio>>(event);
-                return processMessageEvent<AudioEvent, AudioItem>(audio, direction);
-        } else if (boost::get<RoomEvent<msg::Emote>>(&event) != nullptr) {
-                auto emote = boost::get<RoomEvent<msg::Emote>>(event);
-                return processMessageEvent<EmoteEvent>(emote, direction);
-        } else if (boost::get<RoomEvent<msg::File>>(&event) != nullptr) {
-                auto file = boost::get<RoomEvent<msg::File>>(event);
-                return processMessageEvent<FileEvent, FileItem>(file, direction);
-        } else if (boost::get<RoomEvent<msg::Image>>(&event) != nullptr) {
-                auto image = boost::get<RoomEvent<msg::Image>>(event);
-                return processMessageEvent<ImageEvent, ImageItem>(image, direction);
-        } else if (boost::get<RoomEvent<msg::Notice>>(&event) != nullptr) {
-                auto notice = boost::get<RoomEvent<msg::Notice>>(event);
-                return processMessageEvent<NoticeEvent>(notice, direction);
-        } else if (boost::get<RoomEvent<msg::Text>>(&event) != nullptr) {
-                auto text = boost::get<RoomEvent<msg::Text>>(event);
-                return processMessageEvent<TextEvent>(text, direction);
-        } else if (boost::get<RoomEvent<msg::Video>>(&event) != nullptr) {
-                auto video = boost::get<RoomEvent<msg::Video>>(event);
-                return processMessageEvent<VideoEvent, VideoItem>(video, direction);
-        } else if (boost::get<Sticker>(&event) != nullptr) {
-                return processMessageEvent<Sticker, StickerItem>(boost::get<Sticker>(event),
-                                                                 direction);
-        } else if (boost::get<EncryptedEvent<msg::Encrypted>>(&event) != nullptr) {
-                auto res = parseEncryptedEvent(boost::get<EncryptedEvent<msg::Encrypted>>(event));
-                auto widget = parseMessageEvent(res.event, direction);
+        }
+
+        QWidget *operator()(const EncryptedEvent &e) const
+        {
+                auto event_id = QString::fromStdString(e.event_id);
+
+                // Use the result of the decryption tasks if available,
+                // otherwise fall back to decrypting on the spot.
+                auto res = view->decryptedEvents_.contains(event_id)
+                             ? view->decryptedEvents_.value(event_id)
+                             : view->parseEncryptedEvent(e);
+                auto widget = view->parseMessageEvent(res.event, direction);
 
                 if (widget == nullptr)
                         return nullptr;
@@ -291,17 +393,99 @@ TimelineView::parseMessageEvent(const mtx::events::collections::TimelineEvents &
                 return widget;
         }
 
-        return nullptr;
+        QWidget *operator()(const AudioEvent &e) const
+        {
+                return process<AudioEvent, AudioItem>(e);
+        }
+        QWidget *operator()(const EmoteEvent &e) const { return process<EmoteEvent>(e); }
+        QWidget *operator()(const FileEvent &e) const { return process<FileEvent, FileItem>(e); }
+        QWidget *operator()(const ImageEvent &e) const
+        {
+                return process<ImageEvent, ImageItem>(e);
+        }
+        QWidget *operator()(const NoticeEvent &e) const { return process<NoticeEvent>(e); }
+        QWidget *operator()(const TextEvent &e) const { return process<TextEvent>(e); }
+        QWidget *operator()(const VideoEvent &e) const
+        {
+                return process<VideoEvent, VideoItem>(e);
+        }
+        QWidget *operator()(const StickerEvent &e) const
+        {
+                return process<StickerEvent, StickerItem>(e);
+        }
+
+        //! Events without a widget representation.
+        template<class Event>
+        QWidget *operator()(const Event &) const
+        {
+                return nullptr;
+        }
+
+private:
+        template<class Event, class Widget>
+        QWidget *process(const Event &e) const
+        {
+                return view->processMessageEvent<Event, Widget>(e, direction);
+        }
+
+        template<class Event>
+        QWidget *process(const Event &e) const
+        {
+                return view->processMessageEvent<Event>(e, direction);
+        }
+
+        TimelineView *view;
+        TimelineDirection direction;
+};
+
+QWidget *
+TimelineView::parseMessageEvent(const mtx::events::collections::TimelineEvents &event,
+                                TimelineDirection direction)
+{
+        return boost::apply_visitor(EventWidgetVisitor(this, direction), event);
+}
+
+//! Reconstruct a timeline event from a decrypted payload.
+static boost::optional<mtx::events::collections::TimelineEvents>
+toTimelineEvent(const json &body)
+{
+        json event_array = json::array();
+        event_array.push_back(body);
+
+        std::vector<mtx::events::collections::TimelineEvents> events;
+        mtx::responses::utils::parse_timeline_events(event_array, events);
+
+        if (events.size() == 1)
+                return events.at(0);
+
+        return boost::none;
 }
 
 DecryptionResult
 TimelineView::parseEncryptedEvent(const mtx::events::EncryptedEvent<mtx::events::msg::Encrypted> &e)
 {
+        perf::RoomSpan perfSpan(room_id_.toStdString(), perf::RoomMetric::Decrypt);
+
         MegolmSessionIndex index;
         index.room_id    = room_id_.toStdString();
         index.session_id = e.content.session_id;
         index.sender_key = e.content.sender_key;
 
+        // Payloads decrypted in a previous run are served from the cache,
+        // so redisplay is a lookup instead of repeated megolm work.
+        try {
+                auto payload = cache::client()->getDecryptedEvent(index.room_id, e.event_id);
+
+                if (payload) {
+                        auto event = toTimelineEvent(json::parse(*payload));
+                        if (event)
+                                return {*event, true};
+                }
+        } catch (const std::exception &ex) {
+                nhlog::db()->warn(
+                  "failed to restore decrypted event {}: {}", e.event_id, ex.what());
+        }
+
         mtx::events::RoomEvent<mtx::events::msg::Notice> dummy;
         dummy.origin_server_ts = e.origin_server_ts;
         dummy.event_id         = e.event_id;
@@ -326,8 +510,21 @@ TimelineView::parseEncryptedEvent(const mtx::events::EncryptedEvent<mtx::events:
         std::string msg_str;
         try {
                 auto session = cache::client()->getInboundMegolmSession(index);
-                auto res     = olm::client()->decrypt_group_message(session, e.content.ciphertext);
-                msg_str      = std::string((char *)res.data.data(), res.data.size());
+
+                if (!session.session) {
+                        dummy.content.body =
+                          "-- Decryption Error (failed to retrieve megolm keys from db) --";
+                        return {dummy, false};
+                }
+
+                // libolm advances the session's ratchet state in place, so
+                // two events of the same session must not decrypt
+                // concurrently on the pool.
+                std::lock_guard<std::mutex> sessionLock(*session.mutex);
+
+                auto res = olm::client()->decrypt_group_message(session.session.get(),
+                                                                e.content.ciphertext);
+                msg_str  = std::string((char *)res.data.data(), res.data.size());
         } catch (const lmdb::error &e) {
                 nhlog::db()->critical("failed to retrieve megolm session with index ({}, {}, {})",
                                       index.room_id,
@@ -357,19 +554,49 @@ TimelineView::parseEncryptedEvent(const mtx::events::EncryptedEvent<mtx::events:
         nhlog::crypto()->info("decrypted event: {}", e.event_id);
         nhlog::crypto()->debug("decrypted data: \n {}", body.dump(2));
 
-        json event_array = json::array();
-        event_array.push_back(body);
+        auto event = toTimelineEvent(body);
 
-        std::vector<TimelineEvent> events;
-        mtx::responses::utils::parse_timeline_events(event_array, events);
+        if (event) {
+                try {
+                        cache::client()->saveDecryptedEvent(
+                          index.room_id, e.event_id, body.dump());
+                } catch (const lmdb::error &err) {
+                        nhlog::db()->warn(
+                          "failed to save decrypted event {}: {}", e.event_id, err.what());
+                }
 
-        if (events.size() == 1)
-                return {events.at(0), true};
+                return {*event, true};
+        }
 
         dummy.content.body = "-- Encrypted Event (Unknown event type) --";
         return {dummy, false};
 }
 
+bool
+TimelineView::restoreDecryptedEvent(
+  const mtx::events::EncryptedEvent<mtx::events::msg::Encrypted> &e,
+  const std::map<std::string, std::string> &payloads)
+{
+        auto it = payloads.find(e.event_id);
+        if (it == payloads.end())
+                return false;
+
+        try {
+                auto event = toTimelineEvent(json::parse(it->second));
+                if (!event)
+                        return false;
+
+                decryptedEvents_[QString::fromStdString(e.event_id)] = {*event, true};
+
+                return true;
+        } catch (const json::exception &ex) {
+                nhlog::db()->warn(
+                  "failed to restore decrypted event {}: {}", e.event_id, ex.what());
+
+                return false;
+        }
+}
+
 void
 TimelineView::displayReadReceipts(std::vector<TimelineEvent> events)
 {
@@ -394,38 +621,54 @@ TimelineView::displayReadReceipts(std::vector<TimelineEvent> events)
 void
 TimelineView::renderBottomEvents(const std::vector<TimelineEvent> &events)
 {
-        int counter = 0;
+        perf::RoomSpan perfSpan(room_id_.toStdString(), perf::RoomMetric::Render);
+
+        refreshLocalUtcOffset();
+
+        std::vector<QWidget *> items;
 
         for (const auto &event : events) {
                 QWidget *item = parseMessageEvent(event, TimelineDirection::Bottom);
 
-                if (item != nullptr) {
-                        addTimelineItem(item, TimelineDirection::Bottom);
-                        counter++;
-
-                        // Prevent blocking of the event-loop
-                        // by calling processEvents every 10 items we render.
-                        if (counter % 4 == 0)
-                                QApplication::processEvents();
-                }
+                if (item != nullptr)
+                        items.push_back(item);
         }
 
+        // Suspend updates so the whole batch is measured & inserted with a
+        // single layout pass instead of a visible relayout per widget.
+        scroll_widget_->setUpdatesEnabled(false);
+
+        for (const auto &item : items)
+                addTimelineItem(item, TimelineDirection::Bottom);
+
         lastMessageDirection_ = TimelineDirection::Bottom;
 
-        displayReadReceipts(events);
+        // Flush the batched layout pass, so the scrollbar range & the
+        // bottom anchoring are adjusted once for the whole batch.
+        scroll_layout_->activate();
+        scroll_widget_->resize(scroll_widget_->width(), scroll_layout_->sizeHint().height());
+
+        scroll_widget_->setUpdatesEnabled(true);
 
         QApplication::processEvents();
+
+        displayReadReceipts(events);
+
+        trimOffscreenWidgets();
 }
 
 void
 TimelineView::renderTopEvents(const std::vector<TimelineEvent> &events)
 {
+        perf::RoomSpan perfSpan(room_id_.toStdString(), perf::RoomMetric::Render);
+
+        refreshLocalUtcOffset();
+
         std::vector<QWidget *> items;
 
         // Reset the sender of the first message in the timeline
         // cause we're about to insert a new one.
-        firstSender_.clear();
-        firstMsgTimestamp_ = QDateTime();
+        model_.clearBoundary(TimelineModel::Edge::Top);
 
         // Parse in reverse order to determine where we should not show sender's name.
         for (auto it = events.rbegin(); it != events.rend(); ++it) {
@@ -438,26 +681,51 @@ TimelineView::renderTopEvents(const std::vector<TimelineEvent> &events)
         // Reverse again to render them.
         std::reverse(items.begin(), items.end());
 
+        // The first widget of the timeline is the anchor; its offset from
+        // the top of the viewport is restored exactly after the insertion.
+        QWidget *anchor  = nullptr;
+        int anchorOffset = 0;
+
+        if (scroll_layout_->count() > 1) {
+                anchor       = scroll_layout_->itemAt(1)->widget();
+                anchorOffset = anchor->y() - scroll_area_->verticalScrollBar()->value();
+        }
+
         oldPosition_ = scroll_area_->verticalScrollBar()->value();
         oldHeight_   = scroll_widget_->size().height();
 
+        // Suspend updates so the whole batch is measured & inserted with a
+        // single layout pass instead of a visible relayout per widget.
+        scroll_widget_->setUpdatesEnabled(false);
+
         for (const auto &item : items)
                 addTimelineItem(item, TimelineDirection::Top);
 
         lastMessageDirection_ = TimelineDirection::Top;
 
+        // Flush the batched layout pass and bring the scroll geometry up to
+        // date, so the anchor is back in place before anything is painted.
+        scroll_layout_->activate();
+        scroll_widget_->resize(scroll_widget_->width(), scroll_layout_->sizeHint().height());
+
+        if (anchor)
+                scroll_area_->verticalScrollBar()->setValue(anchor->y() - anchorOffset);
+
+        scroll_widget_->setUpdatesEnabled(true);
+
         QApplication::processEvents();
 
         displayReadReceipts(events);
 
         // If this batch is the first being rendered (i.e the first and the last
         // events originate from this batch), set the last sender.
-        if (lastSender_.isEmpty() && !items.empty()) {
+        if (model_.boundary(TimelineModel::Edge::Bottom).sender.isEmpty() && !items.empty()) {
                 for (const auto &w : items) {
                         auto timelineItem = qobject_cast<TimelineItem *>(w);
                         if (timelineItem) {
-                                saveLastMessageInfo(timelineItem->descriptionMessage().userid,
-                                                    timelineItem->descriptionMessage().datetime);
+                                saveLastMessageInfo(
+                                  timelineItem->descriptionUserId(),
+                                  timelineItem->descriptionDateTime().toMSecsSinceEpoch());
                                 break;
                         }
                 }
@@ -465,30 +733,183 @@ TimelineView::renderTopEvents(const std::vector<TimelineEvent> &events)
 }
 
 void
-TimelineView::addEvents(const mtx::responses::Timeline &timeline)
+TimelineView::addEvents(mtx::responses::Timeline timeline)
 {
+        perf::Span span("timeline.addEvents", room_id_.toStdString());
+
         if (isInitialSync) {
                 prev_batch_token_ = QString::fromStdString(timeline.prev_batch);
                 isInitialSync     = false;
         }
 
-        bottomMessages_.insert(bottomMessages_.end(),
-                               std::make_move_iterator(timeline.events.begin()),
-                               std::make_move_iterator(timeline.events.end()));
+        for (const auto &e : timeline.events)
+                model_.addBottom(e);
 
-        if (!bottomMessages_.empty())
-                notifyForLastEvent(findLastViewableEvent(bottomMessages_));
+        // Decrypt any encrypted events on the thread pool before the batch
+        // is added to the timeline.
+        queueBatch(std::move(timeline.events), TimelineDirection::Bottom);
+}
 
-        // If the current timeline is open and there are messages to be rendered.
-        if (isVisible() && !bottomMessages_.empty()) {
-                renderBottomEvents(bottomMessages_);
+void
+TimelineView::queueBatch(std::vector<TimelineEvent> events, TimelineDirection direction)
+{
+        // Paginated chunks attach right above the viewport and arrive
+        // newest-first, so their front is what the user is about to see.
+        // Splitting the chunk makes the on-screen part readable after a
+        // few decryptions instead of after the whole batch; the queue
+        // keeps the delivery order intact.
+        if (direction == TimelineDirection::Top && events.size() > VIEWPORT_DECRYPT_CHUNK) {
+                const auto cut = events.begin() + VIEWPORT_DECRYPT_CHUNK;
+
+                std::vector<TimelineEvent> visible(std::make_move_iterator(events.begin()),
+                                                   std::make_move_iterator(cut));
+                events.erase(events.begin(), cut);
+
+                enqueueBatch(std::move(visible), direction);
+        }
 
-                // Free up space for new messages.
-                bottomMessages_.clear();
+        enqueueBatch(std::move(events), direction);
+}
 
-                // Send a read receipt for the last event.
-                if (isActiveWindow())
-                        readLastEvent();
+void
+TimelineView::enqueueBatch(std::vector<TimelineEvent> events, TimelineDirection direction)
+{
+        using EncryptedEvent = mtx::events::EncryptedEvent<mtx::events::msg::Encrypted>;
+
+        PendingDecryptionBatch batch;
+        batch.id        = nextDecryptionBatchId_++;
+        batch.direction = direction;
+        batch.remaining = 0;
+
+        std::vector<EncryptedEvent> encrypted;
+        for (const auto &event : events) {
+                auto e = boost::get<EncryptedEvent>(&event);
+
+                if (e && !decryptedEvents_.contains(QString::fromStdString(e->event_id)))
+                        encrypted.push_back(*e);
+        }
+
+        // Plaintext persisted by an earlier session is restored in bulk
+        // up front, so entering a room with warm history renders right
+        // away instead of waiting for the thread pool to rediscover the
+        // stored payloads one event at a time.
+        if (!encrypted.empty()) {
+                std::vector<std::string> ids;
+                ids.reserve(encrypted.size());
+                for (const auto &e : encrypted)
+                        ids.push_back(e.event_id);
+
+                const auto cached =
+                  cache::client()->getDecryptedEvents(room_id_.toStdString(), ids);
+
+                encrypted.erase(std::remove_if(encrypted.begin(),
+                                               encrypted.end(),
+                                               [this, &cached](const EncryptedEvent &e) {
+                                                       return restoreDecryptedEvent(e, cached);
+                                               }),
+                                encrypted.end());
+        }
+
+        batch.events    = std::move(events);
+        batch.remaining = encrypted.size();
+
+        decryptionQueue_.push_back(std::move(batch));
+
+        // One task per event so the decryption is spread across the pool's
+        // threads. The results are delivered back through a queued signal.
+        const auto batch_id = decryptionQueue_.back().id;
+        QPointer<TimelineView> self(this);
+        for (const auto &e : encrypted)
+                QtConcurrent::run([self, e, batch_id]() {
+                        // The view budget anchors views with in-flight
+                        // batches, but a logout can still tear the view
+                        // down while the task waits in the pool.
+                        if (!self)
+                                return;
+
+                        emit self->eventDecrypted(QString::fromStdString(e.event_id),
+                                                  self->parseEncryptedEvent(e),
+                                                  batch_id);
+                });
+
+        flushDecryptedBatches();
+}
+
+void
+TimelineView::handleDecryptedEvent(const QString &event_id,
+                                   const DecryptionResult &res,
+                                   uint64_t batch_id)
+{
+        decryptedEvents_[event_id] = res;
+
+        for (auto &batch : decryptionQueue_) {
+                if (batch.id == batch_id) {
+                        batch.remaining -= 1;
+                        break;
+                }
+        }
+
+        flushDecryptedBatches();
+}
+
+void
+TimelineView::flushDecryptedBatches()
+{
+        // Batches are always delivered in arrival order, even if their
+        // decryption tasks finish out of order.
+        while (!decryptionQueue_.empty() && decryptionQueue_.front().remaining == 0) {
+                auto batch = std::move(decryptionQueue_.front());
+                decryptionQueue_.pop_front();
+
+                deliverBatch(batch);
+        }
+}
+
+void
+TimelineView::deliverBatch(PendingDecryptionBatch &batch)
+{
+        if (batch.direction == TimelineDirection::Top) {
+                topMessages_.insert(topMessages_.end(),
+                                    std::make_move_iterator(batch.events.begin()),
+                                    std::make_move_iterator(batch.events.end()));
+
+                // The RoomList message preview will be updated only if this
+                // is the first batch of messages received through /messages
+                // i.e there are no other messages currently present.
+                if (!topMessages_.empty() && scroll_layout_->count() == 1)
+                        notifyForLastEvent(findFirstViewableEvent(topMessages_));
+
+                if (isVisible()) {
+                        renderTopEvents(topMessages_);
+
+                        // Free up space for new messages.
+                        topMessages_.clear();
+
+                        // Send a read receipt for the last event.
+                        if (isActiveWindow())
+                                readLastEvent();
+                }
+
+                isPaginationInProgress_ = false;
+        } else {
+                bottomMessages_.insert(bottomMessages_.end(),
+                                       std::make_move_iterator(batch.events.begin()),
+                                       std::make_move_iterator(batch.events.end()));
+
+                if (!bottomMessages_.empty())
+                        notifyForLastEvent(findLastViewableEvent(bottomMessages_));
+
+                // If the current timeline is open and there are messages to be rendered.
+                if (isVisible() && !bottomMessages_.empty()) {
+                        renderBottomEvents(bottomMessages_);
+
+                        // Free up space for new messages.
+                        bottomMessages_.clear();
+
+                        // Send a read receipt for the last event.
+                        if (isActiveWindow())
+                                readLastEvent();
+                }
         }
 }
 
@@ -497,6 +918,10 @@ TimelineView::init()
 {
         local_user_ = utils::localUser();
 
+        // Day bucketing needs a valid offset before the first batch, e.g
+        // for a message sent right after the room is opened.
+        refreshLocalUtcOffset();
+
         QIcon icon;
         icon.addFile(":/icons/icons/ui/angle-arrow-down.png");
         scrollDownBtn_ = new FloatingButton(icon, this);
@@ -514,6 +939,21 @@ TimelineView::init()
         scroll_area_->setWidgetResizable(true);
         scroll_area_->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
 
+        // Optionally composite the timeline through a GL viewport. The
+        // widgets then paint into a texture-backed surface: a scroll tick
+        // translates the surface on the GPU and only the exposed strip is
+        // rasterized, instead of flushing the whole viewport through the
+        // raster engine — which is what drops frames on 4K displays.
+        // Opt-in because the win depends on the driver.
+        QSettings settings;
+        if (settings.value("user/timeline/gpu_compositing", false).toBool()) {
+                auto glViewport = new QOpenGLWidget(this);
+                // Keep the backbuffer between frames so the scroll blit
+                // has something to translate.
+                glViewport->setUpdateBehavior(QOpenGLWidget::PartialUpdate);
+                scroll_area_->setViewport(glViewport);
+        }
+
         scroll_widget_ = new QWidget(this);
         scroll_widget_->setObjectName("scroll_widget");
 
@@ -527,6 +967,12 @@ TimelineView::init()
         scroll_layout_->setSpacing(0);
         scroll_layout_->setObjectName("timelinescrollarea");
 
+        // Reserves the space of the evicted widgets, so the scrollbar
+        // geometry is preserved no matter how deep the scrollback is.
+        topPlaceholder_ = new QWidget(scroll_widget_);
+        topPlaceholder_->setFixedHeight(0);
+        scroll_layout_->addWidget(topPlaceholder_);
+
         scroll_area_->setWidget(scroll_widget_);
         scroll_area_->setAlignment(Qt::AlignBottom);
 
@@ -535,28 +981,60 @@ TimelineView::init()
         setLayout(top_layout_);
 
         paginationTimer_ = new QTimer(this);
+        paginationTimer_->setInterval(2000);
         connect(paginationTimer_, &QTimer::timeout, this, &TimelineView::fetchHistory);
+        // fetchHistory bails out while the view is hidden anyway; don't
+        // even wake up for it.
+        timers::pauseWhenHidden(this, paginationTimer_);
+
+        // While the scrollbar moves quickly the media widgets paint a cheap
+        // variant of themselves; once it settles, bring the viewport back
+        // to full quality with a single repaint.
+        scrollSettleTimer_ = new QTimer(this);
+        scrollSettleTimer_->setSingleShot(true);
+        scrollSettleTimer_->setInterval(SCROLL_SETTLE_MS);
+        connect(scrollSettleTimer_, &QTimer::timeout, this, [this]() {
+                if (!utils::isFastScrolling())
+                        return;
+
+                utils::setFastScrolling(false);
+                scroll_widget_->update();
+        });
+
+        scrollAnchorTimer_ = new QTimer(this);
+        scrollAnchorTimer_->setSingleShot(true);
+        scrollAnchorTimer_->setInterval(1000);
+        connect(scrollAnchorTimer_, &QTimer::timeout, this, &TimelineView::saveScrollAnchor);
 
         connect(this, &TimelineView::messagesRetrieved, this, &TimelineView::addBackwardsEvents);
 
+        qRegisterMetaType<DecryptionResult>();
+        qRegisterMetaType<uint64_t>("uint64_t");
+        connect(this, &TimelineView::eventDecrypted, this, &TimelineView::handleDecryptedEvent);
+
         connect(this, &TimelineView::messageFailed, this, &TimelineView::handleFailedMessage);
         connect(this, &TimelineView::messageSent, this, &TimelineView::updatePendingMessage);
 
         connect(
           this, &TimelineView::markReadEvents, this, [this](const std::vector<QString> &event_ids) {
+                  // Suspend updates so the whole batch is repainted at once.
+                  scroll_widget_->setUpdatesEnabled(false);
+
                   for (const auto &event : event_ids) {
                           if (eventIds_.contains(event)) {
                                   auto widget = eventIds_[event];
                                   if (!widget)
-                                          return;
+                                          continue;
 
                                   auto item = qobject_cast<TimelineItem *>(widget);
                                   if (!item)
-                                          return;
+                                          continue;
 
                                   item->markRead();
                           }
                   }
+
+                  scroll_widget_->setUpdatesEnabled(true);
           });
 
         connect(scroll_area_->verticalScrollBar(),
@@ -590,35 +1068,23 @@ TimelineView::getMessages()
           });
 }
 
-void
-TimelineView::updateLastSender(const QString &user_id, TimelineDirection direction)
-{
-        if (direction == TimelineDirection::Bottom)
-                lastSender_ = user_id;
-        else
-                firstSender_ = user_id;
-}
-
 bool
 TimelineView::isSenderRendered(const QString &user_id,
                                uint64_t origin_server_ts,
                                TimelineDirection direction)
 {
-        if (direction == TimelineDirection::Bottom) {
-                return (lastSender_ != user_id) ||
-                       isDateDifference(lastMsgTimestamp_,
-                                        QDateTime::fromMSecsSinceEpoch(origin_server_ts));
-        } else {
-                return (firstSender_ != user_id) ||
-                       isDateDifference(firstMsgTimestamp_,
-                                        QDateTime::fromMSecsSinceEpoch(origin_server_ts));
-        }
+        const auto &boundary = model_.boundary(direction == TimelineDirection::Bottom
+                                                 ? TimelineModel::Edge::Bottom
+                                                 : TimelineModel::Edge::Top);
+
+        return (boundary.sender != user_id) ||
+               isDateDifference(boundary.timestamp, origin_server_ts);
 }
 
 void
 TimelineView::addTimelineItem(QWidget *item, TimelineDirection direction)
 {
-        const auto newDate = getDate(item);
+        const auto newTs = getTimestampMs(item);
 
         if (direction == TimelineDirection::Bottom) {
                 QWidget *lastItem    = nullptr;
@@ -630,10 +1096,13 @@ TimelineView::addTimelineItem(QWidget *item, TimelineDirection direction)
                 }
 
                 if (lastItem) {
-                        const auto oldDate = getDate(lastItem);
+                        const auto oldTs = getTimestampMs(lastItem);
 
-                        if (oldDate.daysTo(newDate) != 0) {
-                                auto separator = new DateSeparator(newDate, this);
+                        // A QDateTime is only built when a separator is
+                        // actually inserted, i.e once per day boundary.
+                        if (localDayIndex(oldTs) != localDayIndex(newTs)) {
+                                auto separator = new DateSeparator(
+                                  QDateTime::fromMSecsSinceEpoch(newTs), this);
 
                                 if (separator)
                                         pushTimelineItem(separator, direction);
@@ -642,14 +1111,16 @@ TimelineView::addTimelineItem(QWidget *item, TimelineDirection direction)
 
                 pushTimelineItem(item, direction);
         } else {
-                if (scroll_layout_->count() > 0) {
-                        const auto firstItem = scroll_layout_->itemAt(0)->widget();
+                // Index 0 is always the eviction placeholder.
+                if (scroll_layout_->count() > 1) {
+                        const auto firstItem = scroll_layout_->itemAt(1)->widget();
 
                         if (firstItem) {
-                                const auto oldDate = getDate(firstItem);
+                                const auto oldTs = getTimestampMs(firstItem);
 
-                                if (newDate.daysTo(oldDate) != 0) {
-                                        auto separator = new DateSeparator(oldDate);
+                                if (localDayIndex(newTs) != localDayIndex(oldTs)) {
+                                        auto separator = new DateSeparator(
+                                          QDateTime::fromMSecsSinceEpoch(oldTs));
 
                                         if (separator)
                                                 pushTimelineItem(separator, direction);
@@ -667,33 +1138,65 @@ TimelineView::updatePendingMessage(const std::string &txn_id, const QString &eve
         nhlog::ui()->info("[{}] message was received by the server", txn_id);
         if (!pending_msgs_.isEmpty() &&
             pending_msgs_.head().txn_id == txn_id) { // We haven't received it yet
-                auto msg     = pending_msgs_.dequeue();
-                msg.event_id = event_id;
-
-                if (msg.widget) {
-                        msg.widget->setEventId(event_id);
-                        eventIds_[event_id] = msg.widget;
-
-                        // If the response comes after we have received the event from sync
-                        // we've already marked the widget as received.
-                        if (!msg.widget->isReceived()) {
-                                msg.widget->markReceived(msg.is_encrypted);
-                                cache::client()->addPendingReceipt(room_id_, event_id);
-                                pending_sent_msgs_.append(msg);
-                        }
-                } else {
-                        nhlog::ui()->warn("[{}] received message response for invalid widget",
-                                          txn_id);
+                completePendingMessage(pending_msgs_.dequeue(), event_id);
+
+                // Complete any pipelined messages whose responses arrived
+                // while an earlier message was still unacknowledged.
+                while (!pending_msgs_.isEmpty()) {
+                        auto ack = earlyAcks_.find(pending_msgs_.head().txn_id);
+                        if (ack == earlyAcks_.end())
+                                break;
+
+                        completePendingMessage(pending_msgs_.dequeue(), ack->second);
+                        earlyAcks_.erase(ack);
                 }
+        } else {
+                // A response for a message that is not at the head of the
+                // queue; hold on to it until the queue catches up.
+                auto match_txnid = [&txn_id](const auto &msg) { return msg.txn_id == txn_id; };
+
+                if (std::any_of(pending_msgs_.cbegin(), pending_msgs_.cend(), match_txnid))
+                        earlyAcks_[txn_id] = event_id;
         }
 
         sendNextPendingMessage();
 }
 
+void
+TimelineView::completePendingMessage(PendingMessage msg, const QString &event_id)
+{
+        msg.event_id = event_id;
+
+        try {
+                cache::client()->removePendingMessage(room_id_.toStdString(), msg.txn_id);
+        } catch (const lmdb::error &e) {
+                nhlog::db()->critical(
+                  "[{}] failed to remove message from the outbox: {}", msg.txn_id, e.what());
+        }
+
+        if (msg.widget) {
+                msg.widget->setEventId(event_id);
+                seenEventIds_.insert(event_id);
+                eventIds_[event_id] = msg.widget;
+
+                // If the response comes after we have received the event from sync
+                // we've already marked the widget as received.
+                if (!msg.widget->isReceived()) {
+                        msg.widget->markReceived(msg.is_encrypted);
+                        receipts::queuePendingReceipt(room_id_, event_id);
+                        pending_sent_msgs_.append(msg);
+                }
+        } else {
+                nhlog::ui()->warn("[{}] received message response for invalid widget",
+                                  msg.txn_id);
+        }
+}
+
 void
 TimelineView::addUserMessage(mtx::events::MessageType ty, const QString &body)
 {
-        auto with_sender = (lastSender_ != local_user_) || isDateDifference(lastMsgTimestamp_);
+        const auto &last = model_.boundary(TimelineModel::Edge::Bottom);
+        auto with_sender = (last.sender != local_user_) || isDateDifference(last.timestamp);
 
         TimelineItem *view_item =
           new TimelineItem(ty, local_user_, body, with_sender, room_id_, scroll_widget_);
@@ -719,38 +1222,153 @@ TimelineView::addUserMessage(mtx::events::MessageType ty, const QString &body)
 
         lastMessageDirection_ = TimelineDirection::Bottom;
 
-        saveLastMessageInfo(local_user_, QDateTime::currentDateTime());
+        saveLastMessageInfo(local_user_, QDateTime::currentMSecsSinceEpoch());
         handleNewUserMessage(message);
 }
 
+static std::string
+serializePendingMessage(const PendingMessage &msg)
+{
+        json obj;
+
+        obj["ty"]           = static_cast<int>(msg.ty);
+        obj["txn_id"]       = msg.txn_id;
+        obj["body"]         = msg.body.toStdString();
+        obj["filename"]     = msg.filename.toStdString();
+        obj["mime"]         = msg.mime.toStdString();
+        obj["media_size"]   = msg.media_size;
+        obj["is_encrypted"] = msg.is_encrypted;
+        obj["width"]        = msg.dimensions.width();
+        obj["height"]       = msg.dimensions.height();
+
+        return obj.dump();
+}
+
+static PendingMessage
+parsePendingMessage(const std::string &data)
+{
+        const auto obj = json::parse(data);
+
+        PendingMessage msg;
+        msg.ty           = static_cast<mtx::events::MessageType>(obj.at("ty").get<int>());
+        msg.txn_id       = obj.at("txn_id").get<std::string>();
+        msg.body         = QString::fromStdString(obj.at("body").get<std::string>());
+        msg.filename     = QString::fromStdString(obj.at("filename").get<std::string>());
+        msg.mime         = QString::fromStdString(obj.at("mime").get<std::string>());
+        msg.media_size   = obj.at("media_size").get<uint64_t>();
+        msg.is_encrypted = obj.at("is_encrypted").get<bool>();
+        msg.widget       = nullptr;
+        msg.dimensions   = QSize(obj.at("width").get<int>(), obj.at("height").get<int>());
+
+        return msg;
+}
+
 void
 TimelineView::handleNewUserMessage(PendingMessage msg)
 {
         pending_msgs_.enqueue(msg);
-        if (pending_msgs_.size() == 1 && pending_sent_msgs_.isEmpty())
-                sendNextPendingMessage();
+
+        try {
+                cache::client()->savePendingMessage(
+                  room_id_.toStdString(), msg.txn_id, serializePendingMessage(msg));
+        } catch (const lmdb::error &e) {
+                nhlog::db()->critical(
+                  "[{}] failed to save message to the outbox: {}", msg.txn_id, e.what());
+        }
+
+        sendNextPendingMessage();
 }
 
 void
-TimelineView::sendNextPendingMessage()
+TimelineView::restorePendingMessages()
 {
-        if (pending_msgs_.size() == 0)
+        std::vector<std::string> stored;
+
+        try {
+                stored = cache::client()->pendingMessages(room_id_.toStdString());
+        } catch (const lmdb::error &e) {
+                nhlog::db()->critical("failed to read the outbox ({}): {}",
+                                      room_id_.toStdString(),
+                                      e.what());
                 return;
+        }
 
-        using namespace mtx::events;
+        if (stored.empty())
+                return;
 
-        PendingMessage &m = pending_msgs_.head();
+        nhlog::ui()->info(
+          "restoring {} unsent messages ({})", stored.size(), room_id_.toStdString());
 
-        nhlog::ui()->info("[{}] sending next queued message", m.txn_id);
+        // The original transaction ids are kept, so a message that was
+        // received by the server right before a crash is deduplicated
+        // instead of being delivered twice.
+        for (const auto &data : stored) {
+                try {
+                        pending_msgs_.enqueue(parsePendingMessage(data));
+                } catch (const json::exception &e) {
+                        nhlog::db()->warn("failed to parse stored message: {}", e.what());
+                }
+        }
 
-        if (m.widget)
-                m.widget->markSent();
+        sendNextPendingMessage();
+}
 
-        if (m.is_encrypted) {
-                nhlog::ui()->info("[{}] sending encrypted event", m.txn_id);
-                prepareEncryptedMessage(std::move(m));
-                return;
+void
+TimelineView::sendNextPendingMessage()
+{
+        int in_flight = std::count_if(pending_msgs_.cbegin(),
+                                      pending_msgs_.cend(),
+                                      [](const auto &msg) { return msg.in_flight; });
+
+        // Fill the window with queued messages instead of waiting for the
+        // round trip of each one; throughput is then bound by bandwidth
+        // instead of latency. Out-of-order responses are held in
+        // earlyAcks_, so the messages still complete in queue order.
+        for (auto &m : pending_msgs_) {
+                if (in_flight >= MAX_INFLIGHT_MESSAGES)
+                        break;
+
+                if (m.in_flight) {
+                        // Nothing is pipelined behind an in-flight encrypted
+                        // message either; see below.
+                        if (m.is_encrypted)
+                                break;
+
+                        continue;
+                }
+
+                if (m.is_encrypted) {
+                        // Encrypted messages stay strictly serialized so the
+                        // megolm ratchet advances in the order the events
+                        // reach the server.
+                        if (in_flight > 0)
+                                break;
+
+                        nhlog::ui()->info("[{}] sending encrypted event", m.txn_id);
+
+                        m.in_flight = true;
+                        if (m.widget)
+                                m.widget->markSent();
+
+                        prepareEncryptedMessage(m);
+                        break;
+                }
+
+                nhlog::ui()->info("[{}] sending queued message", m.txn_id);
+
+                m.in_flight = true;
+                if (m.widget)
+                        m.widget->markSent();
+
+                sendPendingMessage(m);
+                ++in_flight;
         }
+}
+
+void
+TimelineView::sendPendingMessage(const PendingMessage &m)
+{
+        using namespace mtx::events;
 
         switch (m.ty) {
         case mtx::events::MessageType::Audio: {
@@ -839,7 +1457,7 @@ TimelineView::sendNextPendingMessage()
 void
 TimelineView::notifyForLastEvent()
 {
-        if (scroll_layout_->count() == 0) {
+        if (scroll_layout_->count() <= 1) {
                 nhlog::ui()->error("notifyForLastEvent called with empty timeline");
                 return;
         }
@@ -904,7 +1522,17 @@ TimelineView::removePendingMessage(const std::string &txn_id)
 
                                 // TODO: update when a solution for encrypted messages is available.
                                 if (!it->is_encrypted)
-                                        cache::client()->addPendingReceipt(room_id_, it->event_id);
+                                        receipts::queuePendingReceipt(room_id_, it->event_id);
+                        }
+
+                        try {
+                                cache::client()->removePendingMessage(room_id_.toStdString(),
+                                                                      txn_id);
+                        } catch (const lmdb::error &e) {
+                                nhlog::db()->critical(
+                                  "[{}] failed to remove message from the outbox: {}",
+                                  txn_id,
+                                  e.what());
                         }
 
                         nhlog::ui()->info("[{}] received sync before message response", txn_id);
@@ -916,9 +1544,25 @@ TimelineView::removePendingMessage(const std::string &txn_id)
 void
 TimelineView::handleFailedMessage(const std::string &txn_id)
 {
-        Q_UNUSED(txn_id);
+        // The other in-flight requests are unaffected; only the failed
+        // message is marked for a retry.
+        for (auto &msg : pending_msgs_) {
+                if (msg.txn_id == txn_id) {
+                        msg.in_flight = false;
+                        msg.failures += 1;
+
+                        // The message was painted optimistically; after a
+                        // few failed attempts the optimism is corrected in
+                        // place while the retries continue.
+                        if (msg.failures >= MESSAGE_RETRY_WARNING && msg.widget)
+                                msg.widget->markFailed();
+
+                        break;
+                }
+        }
+
         // Note: We do this even if the message has already been echoed.
-        QTimer::singleShot(2000, this, SLOT(sendNextPendingMessage()));
+        timers::schedule(2000, this, [this]() { sendNextPendingMessage(); });
 }
 
 void
@@ -936,19 +1580,7 @@ TimelineView::readLastEvent() const
         if (!ChatPage::instance()->userSettings()->isReadReceiptsEnabled())
                 return;
 
-        const auto eventId = getLastEventId();
-
-        if (!eventId.isEmpty())
-                http::client()->read_event(room_id_.toStdString(),
-                                           eventId.toStdString(),
-                                           [this, eventId](mtx::http::RequestErr err) {
-                                                   if (err) {
-                                                           nhlog::net()->warn(
-                                                             "failed to read event ({}, {})",
-                                                             room_id_.toStdString(),
-                                                             eventId.toStdString());
-                                                   }
-                                           });
+        receipts::markVisible(room_id_, getLastEventId());
 }
 
 QString
@@ -988,6 +1620,8 @@ TimelineView::showEvent(QShowEvent *event)
 
         readLastEvent();
 
+        prepareOutboundSessionIfNeeded();
+
         QWidget::showEvent(event);
 }
 
@@ -1013,26 +1647,149 @@ TimelineView::event(QEvent *event)
         return QWidget::event(event);
 }
 
+QString
+TimelineView::removeSavedEventIds(QWidget *widget)
+{
+        QString removed;
+
+        for (auto it = eventIds_.begin(); it != eventIds_.end();) {
+                if (it.value() == widget) {
+                        removed = it.key();
+                        it      = eventIds_.erase(it);
+                } else {
+                        ++it;
+                }
+        }
+
+        return removed;
+}
+
+void
+TimelineView::trimOffscreenWidgets()
+{
+        if (scroll_layout_->count() - 1 <= MAX_RETAINED_WIDGETS)
+                return;
+
+        // Keep a viewport's worth of widgets above the visible area, so
+        // small scroll movements don't materialize them right back.
+        const int evictionEdge =
+          scroll_area_->verticalScrollBar()->value() - scroll_area_->viewport()->height();
+
+        QString lastEvicted;
+        int evictedHeight = 0;
+        // Heights of widgets without an event id (e.g date separators) are
+        // attributed to the event that follows them.
+        int carriedHeight = 0;
+
+        while (scroll_layout_->count() - 1 > MAX_RETAINED_WIDGETS) {
+                auto item = scroll_layout_->itemAt(1);
+
+                if (!item || !item->widget())
+                        break;
+
+                auto widget = item->widget();
+
+                // Don't touch widgets that are close to the visible area.
+                if (widget->y() + widget->height() > evictionEdge)
+                        break;
+
+                scroll_layout_->takeAt(1);
+
+                const auto event_id = removeSavedEventIds(widget);
+                const auto height   = widget->height();
+
+                if (event_id.isEmpty()) {
+                        carriedHeight += height;
+                } else {
+                        model_.saveWidgetHeight(event_id, height + carriedHeight);
+                        carriedHeight = 0;
+                        lastEvicted   = event_id;
+                }
+
+                evictedHeight += height;
+
+                auto timelineItem = qobject_cast<TimelineItem *>(widget);
+                if (!timelineItem || !TimelineItem::recycle(timelineItem))
+                        delete widget;
+                delete item;
+        }
+
+        if (lastEvicted.isEmpty())
+                return;
+
+        // Any trailing separator space will be released along with the last
+        // evicted event.
+        if (carriedHeight > 0)
+                model_.saveWidgetHeight(lastEvicted, carriedHeight);
+
+        // The placeholder takes up exactly the space of the deleted widgets,
+        // so neither the scroll geometry nor the current position change.
+        adjustTopPlaceholder(evictedHeight);
+
+        // The evicted events are kept as records only.
+        model_.retireThrough(lastEvicted);
+}
+
+void
+TimelineView::rehydrateTopEvents()
+{
+        const auto events = model_.materializeTop(SCROLLBACK_CHUNK);
+
+        int reservedHeight = 0;
+        for (const auto &event : events)
+                reservedHeight += model_.takeWidgetHeight(utils::eventId(event));
+
+        // Release the space that was reserved when the widgets were deleted.
+        // The re-created widgets will take up roughly the same area, so the
+        // viewport doesn't move underneath the user.
+        oldPosition_          = scroll_area_->verticalScrollBar()->value();
+        oldHeight_            = scroll_widget_->size().height();
+        lastMessageDirection_ = TimelineDirection::Top;
+
+        // The last reserved block also drops any residue left by widgets
+        // that resized after they were measured.
+        if (!model_.canMaterializeTop())
+                reservedHeight = topPlaceholderHeight_;
+
+        adjustTopPlaceholder(-reservedHeight);
+
+        renderTopEvents(events);
+}
+
+void
+TimelineView::adjustTopPlaceholder(int delta)
+{
+        topPlaceholderHeight_ = std::max(0, topPlaceholderHeight_ + delta);
+        topPlaceholder_->setFixedHeight(topPlaceholderHeight_);
+}
+
 void
 TimelineView::clearTimeline()
 {
-        // Delete all widgets.
+        // Delete all widgets, except for the eviction placeholder which is
+        // simply collapsed.
         QLayoutItem *item;
-        while ((item = scroll_layout_->takeAt(0)) != nullptr) {
-                delete item->widget();
+        while (scroll_layout_->count() > 1 && (item = scroll_layout_->takeAt(1)) != nullptr) {
+                auto timelineItem = qobject_cast<TimelineItem *>(item->widget());
+                if (!timelineItem || !TimelineItem::recycle(timelineItem))
+                        delete item->widget();
                 delete item;
         }
 
+        topPlaceholderHeight_ = 0;
+        topPlaceholder_->setFixedHeight(0);
+
         // The next call to /messages will be without a prev token.
         prev_batch_token_.clear();
         eventIds_.clear();
+        seenEventIds_.clear();
+        model_.clear();
 
         // Clear queues with pending messages to be rendered.
         bottomMessages_.clear();
         topMessages_.clear();
-
-        firstSender_.clear();
-        lastSender_.clear();
+        decryptionQueue_.clear();
+        decryptedEvents_.clear();
 }
 
 void
@@ -1049,17 +1806,114 @@ TimelineView::toggleScrollDownButton()
         }
 }
 
+void
+TimelineView::saveScrollAnchor()
+{
+        const auto bar = scroll_area_->verticalScrollBar();
+        const auto key = "scroll/" + room_id_.toStdString();
+
+        try {
+                // At the bottom there is nothing to restore; a cleared
+                // anchor makes the next launch start at the newest message.
+                if (bar->maximum() - bar->value() < SCROLL_BAR_GAP) {
+                        cache::client()->saveSessionState(key, "");
+                        return;
+                }
+
+                const int viewportTop = bar->value();
+
+                // Index 0 is the placeholder that reserves the space of
+                // the evicted widgets.
+                for (int i = 1; i < scroll_layout_->count(); ++i) {
+                        const auto widget = scroll_layout_->itemAt(i)->widget();
+
+                        auto item = qobject_cast<TimelineItem *>(widget);
+                        if (!item || item->eventId().isEmpty())
+                                continue;
+
+                        // The first item that reaches into the viewport.
+                        if (widget->y() + widget->height() <= viewportTop)
+                                continue;
+
+                        cache::client()->saveSessionState(key,
+                                                          QString("%1 %2")
+                                                            .arg(item->eventId())
+                                                            .arg(viewportTop - widget->y())
+                                                            .toStdString());
+                        return;
+                }
+        } catch (const lmdb::error &e) {
+                nhlog::db()->warn("failed to save the scroll anchor of {}: {}",
+                                  room_id_.toStdString(),
+                                  e.what());
+        }
+}
+
+bool
+TimelineView::restoreScrollAnchor()
+{
+        boost::optional<std::string> state;
+
+        try {
+                state = cache::client()->restoreSessionState("scroll/" + room_id_.toStdString());
+        } catch (const lmdb::error &e) {
+                nhlog::db()->warn("failed to restore the scroll anchor of {}: {}",
+                                  room_id_.toStdString(),
+                                  e.what());
+                return false;
+        }
+
+        if (!state)
+                return false;
+
+        const auto parts = QString::fromStdString(*state).split(' ');
+
+        if (parts.size() != 2)
+                return false;
+
+        // The anchored event may be above the batch the view starts with;
+        // falling back to the bottom beats paginating through history
+        // just to rebuild a pixel offset.
+        if (!eventIds_.contains(parts.at(0)))
+                return false;
+
+        const auto widget = eventIds_[parts.at(0)];
+
+        scroll_layout_->activate();
+        scroll_area_->verticalScrollBar()->setValue(widget->y() + parts.at(1).toInt());
+
+        return true;
+}
+
 void
 TimelineView::removeEvent(const QString &event_id)
 {
+        // Mutate the record first, so an event whose widget was retired
+        // is rendered redacted when it is materialized again.
+        const bool recordRedacted = model_.redact(event_id);
+
         if (!eventIds_.contains(event_id)) {
-                nhlog::ui()->warn("cannot remove widget with unknown event_id: {}",
-                                  event_id.toStdString());
+                if (!recordRedacted)
+                        nhlog::ui()->warn("cannot redact unknown event_id: {}",
+                                          event_id.toStdString());
                 return;
         }
 
         auto removedItem = eventIds_[event_id];
 
+        // Regular items are redacted in place: the row stays as a
+        // tombstone and only its own geometry is invalidated, so a wave
+        // of redactions doesn't relayout everything below every removed
+        // row, and none of the neighbour fixups below are needed.
+        if (auto item = qobject_cast<TimelineItem *>(removedItem)) {
+                item->markRedacted();
+
+                // The room list may have been describing this event.
+                QTimer::singleShot(0, this, [this]() { notifyForLastEvent(); });
+
+                return;
+        }
+
         // Find the next and the previous widgets in the timeline
         auto prevWidget = relativeWidget(removedItem, -1);
         auto nextWidget = relativeWidget(removedItem, 1);
@@ -1086,24 +1940,27 @@ TimelineView::removeEvent(const QString &event_id)
 
         // If we deleted the last item in the timeline...
         if (!nextItem && prevItem)
-                saveLastMessageInfo(prevItem->descriptionMessage().userid,
-                                    prevItem->descriptionMessage().datetime);
+                saveLastMessageInfo(prevItem->descriptionUserId(),
+                                    prevItem->descriptionDateTime().toMSecsSinceEpoch());
 
         // If we deleted the first item in the timeline...
         if (!prevItem && nextItem)
-                saveFirstMessageInfo(nextItem->descriptionMessage().userid,
-                                     nextItem->descriptionMessage().datetime);
+                saveFirstMessageInfo(nextItem->descriptionUserId(),
+                                     nextItem->descriptionDateTime().toMSecsSinceEpoch());
 
         // If we deleted the only item in the timeline...
         if (!prevItem && !nextItem) {
-                firstSender_.clear();
-                firstMsgTimestamp_ = QDateTime();
-                lastSender_.clear();
-                lastMsgTimestamp_ = QDateTime();
+                model_.clearBoundary(TimelineModel::Edge::Top);
+                model_.clearBoundary(TimelineModel::Edge::Bottom);
         }
 
         // Finally remove the event.
-        removedItem->deleteLater();
+        scroll_layout_->removeWidget(removedItem);
+
+        auto recyclable = qobject_cast<TimelineItem *>(removedItem);
+        if (!recyclable || !TimelineItem::recycle(recyclable))
+                removedItem->deleteLater();
+
         eventIds_.remove(event_id);
 
         // Update the room list with a view of the last message after
@@ -1152,23 +2009,22 @@ TimelineView::saveMessageInfo(const QString &sender,
                               uint64_t origin_server_ts,
                               TimelineDirection direction)
 {
-        updateLastSender(sender, direction);
+        const auto edge = direction == TimelineDirection::Bottom ? TimelineModel::Edge::Bottom
+                                                                 : TimelineModel::Edge::Top;
 
-        if (direction == TimelineDirection::Bottom)
-                lastMsgTimestamp_ = QDateTime::fromMSecsSinceEpoch(origin_server_ts);
-        else
-                firstMsgTimestamp_ = QDateTime::fromMSecsSinceEpoch(origin_server_ts);
+        model_.setBoundary(edge, sender, origin_server_ts);
 }
 
 bool
-TimelineView::isDateDifference(const QDateTime &first, const QDateTime &second) const
+TimelineView::isDateDifference(uint64_t first_ts, uint64_t second_ts) const
 {
-        // Check if the dates are in a different day.
-        if (std::abs(first.daysTo(second)) != 0)
+        // Check if the timestamps are in a different local day.
+        if (localDayIndex(first_ts) != localDayIndex(second_ts))
                 return true;
 
-        const uint64_t diffInSeconds   = std::abs(first.msecsTo(second)) / 1000;
-        constexpr uint64_t fifteenMins = 15 * 60;
+        const qint64 diffInSeconds =
+          std::abs(qint64(second_ts) - qint64(first_ts)) / 1000;
+        constexpr qint64 fifteenMins = 15 * 60;
 
         return diffInSeconds > fifteenMins;
 }
@@ -1318,7 +2174,48 @@ TimelineView::prepareEncryptedMessage(const PendingMessage &msg)
                                     std::placeholders::_2));
                         return;
                 }
+        } catch (const lmdb::error &e) {
+                nhlog::db()->critical(
+                  "failed to open outbound megolm session ({}): {}", room_id, e.what());
+                return;
+        } catch (const mtx::crypto::olm_exception &e) {
+                nhlog::crypto()->critical(
+                  "failed to open outbound megolm session ({}): {}", room_id, e.what());
+                return;
+        }
+
+        // No session has been prepared yet, so the message is sent as soon
+        // as the new session has been shared with the room.
+        prepareOutboundSession([room_id, doc, txn_id = msg.txn_id, this]() {
+                try {
+                        auto data =
+                          olm::encrypt_group_message(room_id, http::client()->device_id(), doc.dump());
 
+                        http::client()->send_room_message<msg::Encrypted, EventType::RoomEncrypted>(
+                          room_id,
+                          txn_id,
+                          data,
+                          std::bind(&TimelineView::sendRoomMessageHandler,
+                                    this,
+                                    txn_id,
+                                    std::placeholders::_1,
+                                    std::placeholders::_2));
+                } catch (const lmdb::error &e) {
+                        nhlog::db()->critical("failed to save megolm outbound session: {}",
+                                              e.what());
+                }
+        });
+}
+
+void
+TimelineView::prepareOutboundSession(std::function<void()> callback)
+{
+        const auto room_id = room_id_.toStdString();
+
+        using namespace mtx::events;
+        using namespace mtx::identifiers;
+
+        try {
                 nhlog::ui()->info("creating new outbound megolm session");
 
                 // Create a new outbound megolm session.
@@ -1344,34 +2241,14 @@ TimelineView::prepareEncryptedMessage(const PendingMessage &msg)
                 const auto members = cache::client()->roomMembers(room_id);
                 nhlog::ui()->info("retrieved {} members for {}", members.size(), room_id);
 
-                auto keeper = std::make_shared<StateKeeper>(
-                  [megolm_payload, room_id, doc, txn_id = msg.txn_id, this]() {
-                          try {
-                                  auto data = olm::encrypt_group_message(
-                                    room_id, http::client()->device_id(), doc.dump());
-
-                                  http::client()
-                                    ->send_room_message<msg::Encrypted, EventType::RoomEncrypted>(
-                                      room_id,
-                                      txn_id,
-                                      data,
-                                      std::bind(&TimelineView::sendRoomMessageHandler,
-                                                this,
-                                                txn_id,
-                                                std::placeholders::_1,
-                                                std::placeholders::_2));
-
-                          } catch (const lmdb::error &e) {
-                                  nhlog::db()->critical(
-                                    "failed to save megolm outbound session: {}", e.what());
-                          }
-                  });
+                // Runs after every claimed device has been sent the keys.
+                auto keeper = std::make_shared<StateKeeper>(std::move(callback));
 
                 mtx::requests::QueryKeys req;
                 for (const auto &member : members)
                         req.device_keys[member] = {};
 
-                http::client()->query_keys(
+                olm::query_keys(
                   req,
                   [keeper = std::move(keeper), megolm_payload, this](
                     const mtx::responses::QueryKeys &res, mtx::http::RequestErr err) {
@@ -1458,7 +2335,10 @@ TimelineView::prepareEncryptedMessage(const PendingMessage &msg)
                                     user.first,
                                     valid_devices.size());
 
-                                  http::client()->claim_keys(
+                                  // The claim scheduler bounds the number of
+                                  // concurrent requests, so the users can be
+                                  // queued back to back.
+                                  olm::claim_keys(
                                     user.first,
                                     valid_devices,
                                     std::bind(&TimelineView::handleClaimedKeys,
@@ -1469,20 +2349,39 @@ TimelineView::prepareEncryptedMessage(const PendingMessage &msg)
                                               user.first,
                                               std::placeholders::_1,
                                               std::placeholders::_2));
-
-                                  // TODO: Wait before sending the next batch of requests.
-                                  std::this_thread::sleep_for(std::chrono::milliseconds(500));
                           }
                   });
 
                 // TODO: Let the user know about the errors.
         } catch (const lmdb::error &e) {
                 nhlog::db()->critical(
-                  "failed to open outbound megolm session ({}): {}", room_id, e.what());
+                  "failed to create outbound megolm session ({}): {}", room_id, e.what());
         } catch (const mtx::crypto::olm_exception &e) {
                 nhlog::crypto()->critical(
-                  "failed to open outbound megolm session ({}): {}", room_id, e.what());
+                  "failed to create outbound megolm session ({}): {}", room_id, e.what());
+        }
+}
+
+void
+TimelineView::prepareOutboundSessionIfNeeded()
+{
+        const auto room_id = room_id_.toStdString();
+
+        try {
+                if (!cache::client()->isRoomEncrypted(room_id) ||
+                    cache::client()->outboundMegolmSessionExists(room_id))
+                        return;
+        } catch (const lmdb::error &e) {
+                nhlog::db()->critical("failed to check encryption status of room {}", e.what());
+                return;
         }
+
+        // Claim the one-time keys and share the session ahead of the first
+        // message, so sending it is just a ratchet step instead of paying
+        // the key exchange for every member device inline.
+        prepareOutboundSession([room_id]() {
+                nhlog::crypto()->info("outbound megolm session ready for {}", room_id);
+        });
 }
 
 void
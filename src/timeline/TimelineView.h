@@ -17,11 +17,18 @@
 
 #pragma once
 
+#include <deque>
+#include <map>
+
 #include <QApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QLayout>
 #include <QList>
 #include <QQueue>
 #include <QScrollArea>
+#include <QSet>
 #include <QStyle>
 #include <QStyleOption>
 #include <QTimer>
@@ -31,6 +38,7 @@
 
 #include "MatrixClient.h"
 #include "timeline/TimelineItem.h"
+#include "timeline/TimelineModel.h"
 #include "ui/ScrollBar.h"
 
 class StateKeeper
@@ -54,6 +62,8 @@ struct DecryptionResult
         bool isDecrypted = false;
 };
 
+Q_DECLARE_METATYPE(DecryptionResult)
+
 class FloatingButton;
 struct DescInfo;
 
@@ -66,11 +76,16 @@ struct PendingMessage
         QString body;
         QString filename;
         QString mime;
-        uint64_t media_size;
+        uint64_t media_size = 0;
         QString event_id;
-        TimelineItem *widget;
+        TimelineItem *widget = nullptr;
         QSize dimensions;
         bool is_encrypted = false;
+        //! Whether the send request is currently on the wire. Runtime
+        //! state only; it is not persisted in the outbox.
+        bool in_flight = false;
+        //! Consecutive failed delivery attempts. Runtime state only.
+        int failures = 0;
 };
 
 template<class MessageT>
@@ -108,18 +123,22 @@ enum class TimelineDirection
         Bottom,
 };
 
+//! Maps each renderable event type of the timeline variant to its widget.
+struct EventWidgetVisitor;
+
 class TimelineView : public QWidget
 {
         Q_OBJECT
 
 public:
-        TimelineView(const mtx::responses::Timeline &timeline,
+        TimelineView(mtx::responses::Timeline timeline,
                      const QString &room_id,
                      QWidget *parent = 0);
         TimelineView(const QString &room_id, QWidget *parent = 0);
 
-        // Add new events at the end of the timeline.
-        void addEvents(const mtx::responses::Timeline &timeline);
+        // Add new events at the end of the timeline. The batch is passed by
+        // value so its events can be moved all the way to the render queue.
+        void addEvents(mtx::responses::Timeline timeline);
         void addUserMessage(mtx::events::MessageType ty, const QString &msg);
 
         template<class Widget, mtx::events::MessageType MsgType>
@@ -131,9 +150,24 @@ public:
         void updatePendingMessage(const std::string &txn_id, const QString &event_id);
         void scrollDown();
 
-        //! Remove an item from the timeline with the given Event ID.
+        //! Apply a redaction to the item with the given Event ID. Regular
+        //! items become in-place tombstones instead of being deleted, so
+        //! the rows below them don't move.
         void removeEvent(const QString &event_id);
         void setPrevBatchToken(const QString &token) { prev_batch_token_ = token; }
+        //! Fetch the first page of messages for a room that doesn't have
+        //! any yet, regardless of visibility, so the view is already warm
+        //! when the user opens it. Returns whether a request was made.
+        bool prefetchHistory();
+        //! Whether there are messages not yet confirmed by the homeserver.
+        //! Views with unconfirmed messages shouldn't be destroyed.
+        bool hasPendingMessages() const
+        {
+                return !pending_msgs_.isEmpty() || !pending_sent_msgs_.isEmpty();
+        }
+        //! Whether decryption tasks of this view are still on the thread
+        //! pool. Such views shouldn't be destroyed either.
+        bool hasPendingDecryptions() const { return !decryptionQueue_.empty(); }
 
 public slots:
         void sliderRangeChanged(int min, int max);
@@ -141,15 +175,19 @@ public slots:
         void fetchHistory();
 
         // Add old events at the top of the timeline.
-        void addBackwardsEvents(const mtx::responses::Messages &msgs);
+        void addBackwardsEvents(mtx::responses::Messages msgs);
 
-        // Whether or not the initial batch has been loaded.
-        bool hasLoaded() { return scroll_layout_->count() > 0 || isTimelineFinished; }
+        // Whether or not the initial batch has been loaded. The layout
+        // always contains the eviction placeholder.
+        bool hasLoaded() { return scroll_layout_->count() > 1 || isTimelineFinished; }
 
         void handleFailedMessage(const std::string &txn_id);
 
 private slots:
         void sendNextPendingMessage();
+        void handleDecryptedEvent(const QString &event_id,
+                                  const DecryptionResult &res,
+                                  uint64_t batch_id);
 
 signals:
         void updateLastTimelineMessage(const QString &user, const DescInfo &info);
@@ -157,6 +195,9 @@ signals:
         void messageFailed(const std::string &txn_id);
         void messageSent(const std::string &txn_id, const QString &event_id);
         void markReadEvents(const std::vector<QString> &event_ids);
+        void eventDecrypted(const QString &event_id,
+                            const DecryptionResult &res,
+                            uint64_t batch_id);
 
 protected:
         void paintEvent(QPaintEvent *event) override;
@@ -167,6 +208,8 @@ protected:
 private:
         using TimelineEvent = mtx::events::collections::TimelineEvents;
 
+        friend struct EventWidgetVisitor;
+
         //! Mark our own widgets as read if they have more than one receipt.
         void displayReadReceipts(std::vector<TimelineEvent> events);
         //! Determine if the start of the timeline is reached from the response of /messages.
@@ -176,6 +219,11 @@ private:
 
         DecryptionResult parseEncryptedEvent(
           const mtx::events::EncryptedEvent<mtx::events::msg::Encrypted> &e);
+        //! Restore the event's plaintext from the bulk-fetched payloads
+        //! into decryptedEvents_. Returns whether the event was restored.
+        bool restoreDecryptedEvent(
+          const mtx::events::EncryptedEvent<mtx::events::msg::Encrypted> &e,
+          const std::map<std::string, std::string> &payloads);
 
         void handleClaimedKeys(std::shared_ptr<StateKeeper> keeper,
                                const std::map<std::string, std::string> &room_key,
@@ -189,6 +237,13 @@ private:
                                     const mtx::responses::EventId &res,
                                     mtx::http::RequestErr err);
         void prepareEncryptedMessage(const PendingMessage &msg);
+        //! Create a new outbound megolm session for the room and share it
+        //! with all member devices. @p callback runs after every claimed
+        //! device has been sent the session keys.
+        void prepareOutboundSession(std::function<void()> callback);
+        //! Set up the outbound session ahead of the first message, so the
+        //! send doesn't pay the key exchange inline.
+        void prepareOutboundSessionIfNeeded();
 
         //! Call the /messages endpoint to fill the timeline.
         void getMessages();
@@ -200,35 +255,41 @@ private:
                 item->hide();
 
                 if (dir == TimelineDirection::Top)
-                        scroll_layout_->insertWidget(0, item);
+                        // Index 0 is always the eviction placeholder.
+                        scroll_layout_->insertWidget(1, item);
                 else
                         scroll_layout_->addWidget(item);
 
                 QTimer::singleShot(0, this, [item, this]() {
-                        item->show();
-                        item->adjustSize();
+                        // The item may have been recycled into the pool in
+                        // the meantime, e.g. by clearTimeline.
+                        if (item->parentWidget() == scroll_widget_) {
+                                item->show();
+                                item->adjustSize();
+                        }
+
                         setUpdatesEnabled(true);
                 });
         }
 
         //! Decides whether or not to show or hide the scroll down button.
         void toggleScrollDownButton();
+        //! Track the scroll speed and degrade the paint quality of the
+        //! media widgets while the scrollbar is being flung.
+        void measureScrollVelocity(int position);
         void init();
         void addTimelineItem(QWidget *item,
                              TimelineDirection direction = TimelineDirection::Bottom);
-        void updateLastSender(const QString &user_id, TimelineDirection direction);
         void notifyForLastEvent();
         void notifyForLastEvent(const TimelineEvent &event);
         //! Keep track of the sender and the timestamp of the current message.
-        void saveLastMessageInfo(const QString &sender, const QDateTime &datetime)
+        void saveLastMessageInfo(const QString &sender, uint64_t origin_server_ts)
         {
-                lastSender_       = sender;
-                lastMsgTimestamp_ = datetime;
+                model_.setBoundary(TimelineModel::Edge::Bottom, sender, origin_server_ts);
         }
-        void saveFirstMessageInfo(const QString &sender, const QDateTime &datetime)
+        void saveFirstMessageInfo(const QString &sender, uint64_t origin_server_ts)
         {
-                firstSender_       = sender;
-                firstMsgTimestamp_ = datetime;
+                model_.setBoundary(TimelineModel::Edge::Top, sender, origin_server_ts);
         }
         //! Keep track of the sender and the timestamp of the current message.
         void saveMessageInfo(const QString &sender,
@@ -271,12 +332,25 @@ private:
                               const QString &sender,
                               const QString &userid);
         void removePendingMessage(const std::string &txn_id);
+        //! Issue the HTTP request for a queued plaintext message.
+        void sendPendingMessage(const PendingMessage &msg);
+        //! Finalize a message acknowledged by the server: drop it from the
+        //! outbox and hand the event id to its widget.
+        void completePendingMessage(PendingMessage msg, const QString &event_id);
 
-        bool isDuplicate(const QString &event_id) { return eventIds_.contains(event_id); }
+        //! O(1) membership test against everything the view has rendered,
+        //! not only the widgets still alive.
+        bool isDuplicate(const QString &event_id) { return seenEventIds_.contains(event_id); }
 
         void handleNewUserMessage(PendingMessage msg);
-        bool isDateDifference(const QDateTime &first,
-                              const QDateTime &second = QDateTime::currentDateTime()) const;
+        //! Load unsent messages of the room from the persistent outbox.
+        void restorePendingMessages();
+        //! Whether two timestamps (ms since epoch) fall on different local
+        //! days or are more than a few minutes apart. Pure integer
+        //! arithmetic; no QDateTime is constructed per event.
+        bool isDateDifference(
+          uint64_t first_ts,
+          uint64_t second_ts = static_cast<uint64_t>(QDateTime::currentMSecsSinceEpoch())) const;
 
         // Return nullptr if the event couldn't be parsed.
         QWidget *parseMessageEvent(const mtx::events::collections::TimelineEvents &event,
@@ -286,6 +360,26 @@ private:
         void saveEventId(QWidget *widget);
         //! Remove all widgets from the timeline layout.
         void clearTimeline();
+        //! Delete widgets that are far above the viewport, keeping only
+        //! their records in the model. The space they took up is reserved
+        //! by the placeholder, so the scrollbar geometry is not affected.
+        void trimOffscreenWidgets();
+        //! Materialize records above the widget window and release the
+        //! space reserved for them by the placeholder.
+        void rehydrateTopEvents();
+        //! Grow or shrink the placeholder by the given amount of pixels.
+        void adjustTopPlaceholder(int delta);
+        //! Persist the first visible event & the offset of the viewport
+        //! within it, so the next launch can restore the position without
+        //! pixel geometry. An anchor at the bottom is cleared instead.
+        void saveScrollAnchor();
+        //! Scroll to the persisted anchor. Returns false when no anchor
+        //! is stored or the anchored event isn't part of the rendered
+        //! window.
+        bool restoreScrollAnchor();
+        //! Remove any saved event ids that point to the given widget.
+        //! Returns the last event id removed, if any.
+        QString removeSavedEventIds(QWidget *widget);
 
         QVBoxLayout *top_layout_;
         QVBoxLayout *scroll_layout_;
@@ -293,11 +387,10 @@ private:
         QScrollArea *scroll_area_;
         ScrollBar *scrollbar_;
         QWidget *scroll_widget_;
-
-        QString firstSender_;
-        QDateTime firstMsgTimestamp_;
-        QString lastSender_;
-        QDateTime lastMsgTimestamp_;
+        //! Fixed-height spacer at the top of the layout, standing in for
+        //! the evicted widgets above the materialized window.
+        QWidget *topPlaceholder_;
+        int topPlaceholderHeight_ = 0;
 
         QString room_id_;
         QString prev_batch_token_;
@@ -313,6 +406,14 @@ private:
         const int SCROLL_BAR_GAP = 200;
 
         QTimer *paginationTimer_;
+        //! Restores full paint quality once the scrollbar settles.
+        QTimer *scrollSettleTimer_;
+        //! Debounce between scrolling and persisting the scroll anchor.
+        QTimer *scrollAnchorTimer_;
+        //! Measures the time between scrollbar movements, for the scroll
+        //! velocity estimate.
+        QElapsedTimer scrollVelocityTimer_;
+        int lastScrollPosition_ = 0;
 
         int scroll_height_       = 0;
         int previous_max_height_ = 0;
@@ -324,6 +425,35 @@ private:
 
         TimelineDirection lastMessageDirection_;
 
+        //! A batch of events waiting for its encrypted events to be
+        //! decrypted before it can be added to the timeline.
+        struct PendingDecryptionBatch
+        {
+                uint64_t id;
+                std::vector<TimelineEvent> events;
+                TimelineDirection direction;
+                //! Number of encrypted events still being decrypted.
+                size_t remaining;
+        };
+
+        //! Schedule the decryption of a batch's encrypted events on the
+        //! thread pool and deliver the batch when they're done. Paginated
+        //! batches are split so the part next to the viewport is decrypted
+        //! and delivered first.
+        void queueBatch(std::vector<TimelineEvent> events, TimelineDirection direction);
+        //! Enqueue a single pending batch and schedule its decryption tasks.
+        void enqueueBatch(std::vector<TimelineEvent> events, TimelineDirection direction);
+        //! Deliver, in order, the batches that are no longer waiting on decryption.
+        void flushDecryptedBatches();
+        //! Add a fully decrypted batch to the timeline.
+        void deliverBatch(PendingDecryptionBatch &batch);
+
+        //! Batches waiting to be added to the timeline, in arrival order.
+        std::deque<PendingDecryptionBatch> decryptionQueue_;
+        uint64_t nextDecryptionBatchId_ = 0;
+        //! Plaintext events produced by the decryption tasks, by event id.
+        QMap<QString, DecryptionResult> decryptedEvents_;
+
         //! Messages received by sync not added to the timeline.
         std::vector<TimelineEvent> bottomMessages_;
         //! Messages received by /messages not added to the timeline.
@@ -334,10 +464,24 @@ private:
         //! Render the given timeline events to the top of the timeline.
         void renderTopEvents(const std::vector<TimelineEvent> &events);
 
+        //! Record store for all the events of the room. Only a window at
+        //! the bottom of the model is backed by live widgets.
+        TimelineModel model_;
+
         // The events currently rendered. Used for duplicate detection.
-        QMap<QString, QWidget *> eventIds_;
+        //! Widget lookup by event id, so redactions & edits don't have to
+        //! scan the timeline's children.
+        QHash<QString, QWidget *> eventIds_;
+        //! Every event id the view has ever rendered. Entries survive the
+        //! pruning of old widgets, so an overlapping pagination response
+        //! can't re-render an event whose widget was already dropped.
+        QSet<QString> seenEventIds_;
         QQueue<PendingMessage> pending_msgs_;
         QList<PendingMessage> pending_sent_msgs_;
+        //! Responses of pipelined sends that arrived before the responses
+        //! of earlier messages. Applied once the message reaches the head
+        //! of the queue, so messages always complete in order.
+        std::map<std::string, QString> earlyAcks_;
 };
 
 template<class Widget, mtx::events::MessageType MsgType>
@@ -348,7 +492,8 @@ TimelineView::addUserMessage(const QString &url,
                              uint64_t size,
                              const QSize &dimensions)
 {
-        auto with_sender = (lastSender_ != local_user_) || isDateDifference(lastMsgTimestamp_);
+        const auto &last = model_.boundary(TimelineModel::Edge::Bottom);
+        auto with_sender = (last.sender != local_user_) || isDateDifference(last.timestamp);
         auto trimmed     = QFileInfo{filename}.fileName(); // Trim file path.
 
         auto widget = new Widget(url, trimmed, size, this);
@@ -361,7 +506,7 @@ TimelineView::addUserMessage(const QString &url,
         lastMessageDirection_ = TimelineDirection::Bottom;
 
         // Keep track of the sender and the timestamp of the current message.
-        saveLastMessageInfo(local_user_, QDateTime::currentDateTime());
+        saveLastMessageInfo(local_user_, QDateTime::currentMSecsSinceEpoch());
 
         PendingMessage message;
         message.ty         = MsgType;
@@ -380,6 +525,12 @@ template<class Event>
 TimelineItem *
 TimelineView::createTimelineItem(const Event &event, bool withSender)
 {
+        // The common sender-less shape can reuse a recycled widget shell.
+        if (!withSender) {
+                if (auto item = TimelineItem::fromPool(event, room_id_, scroll_widget_))
+                        return item;
+        }
+
         TimelineItem *item = new TimelineItem(event, withSender, room_id_, scroll_widget_);
         return item;
 }
@@ -399,7 +550,7 @@ TimelineItem *
 TimelineView::processMessageEvent(const Event &event, TimelineDirection direction)
 {
         const auto event_id = QString::fromStdString(event.event_id);
-        const auto sender   = QString::fromStdString(event.sender);
+        const auto sender   = utils::intern(event.sender);
 
         const auto txn_id = event.unsigned_data.transaction_id;
         if ((!txn_id.empty() && isPendingMessage(txn_id, sender, local_user_)) ||
@@ -414,6 +565,7 @@ TimelineView::processMessageEvent(const Event &event, TimelineDirection directio
 
         auto item = createTimelineItem<Event>(event, with_sender);
 
+        seenEventIds_.insert(event_id);
         eventIds_[event_id] = item;
 
         return item;
@@ -424,7 +576,7 @@ TimelineItem *
 TimelineView::processMessageEvent(const Event &event, TimelineDirection direction)
 {
         const auto event_id = QString::fromStdString(event.event_id);
-        const auto sender   = QString::fromStdString(event.sender);
+        const auto sender   = utils::intern(event.sender);
 
         const auto txn_id = event.unsigned_data.transaction_id;
         if ((!txn_id.empty() && isPendingMessage(txn_id, sender, local_user_)) ||
@@ -439,6 +591,7 @@ TimelineView::processMessageEvent(const Event &event, TimelineDirection directio
 
         auto item = createTimelineItem<Event, Widget>(event, with_sender);
 
+        seenEventIds_.insert(event_id);
         eventIds_[event_id] = item;
 
         return item;
@@ -18,11 +18,16 @@
 #include <random>
 
 #include <QApplication>
+#include <QElapsedTimer>
 #include <QFileInfo>
 #include <QSettings>
+#include <QTimer>
 
 #include "Cache.h"
+#include "IdleScheduler.h"
 #include "Logging.h"
+#include "MatrixClient.h"
+#include "MemoryBudget.h"
 #include "timeline/TimelineView.h"
 #include "timeline/TimelineViewManager.h"
 #include "timeline/widgets/AudioItem.h"
@@ -32,7 +37,11 @@
 
 TimelineViewManager::TimelineViewManager(QWidget *parent)
   : QStackedWidget(parent)
-{}
+{
+        // The live views are the heaviest thing the process can give back
+        // under memory pressure; whatever they drop is rebuilt on demand.
+        mem::onPressure(3, "timeline views", this, [this]() { enforceViewBudget(1); });
+}
 
 void
 TimelineViewManager::updateReadReceipts(const QString &room_id,
@@ -48,7 +57,10 @@ TimelineViewManager::updateReadReceipts(const QString &room_id,
 void
 TimelineViewManager::removeTimelineEvent(const QString &room_id, const QString &event_id)
 {
-        auto view = views_[room_id];
+        if (!timelineViewExists(room_id))
+                return;
+
+        auto view = views_.at(room_id);
 
         if (view)
                 view->removeEvent(event_id);
@@ -149,13 +161,9 @@ TimelineViewManager::queueVideoMessage(const QString &roomid,
 }
 
 void
-TimelineViewManager::initialize(const mtx::responses::Rooms &rooms)
+TimelineViewManager::initialize(mtx::responses::Rooms rooms)
 {
-        for (auto it = rooms.join.cbegin(); it != rooms.join.cend(); ++it) {
-                addRoom(it->second, QString::fromStdString(it->first));
-        }
-
-        sync(rooms);
+        sync(std::move(rooms));
 }
 
 void
@@ -187,13 +195,13 @@ TimelineViewManager::initialize(const std::vector<std::string> &rooms)
 }
 
 void
-TimelineViewManager::addRoom(const mtx::responses::JoinedRoom &room, const QString &room_id)
+TimelineViewManager::addRoom(mtx::responses::JoinedRoom room, const QString &room_id)
 {
         if (timelineViewExists(room_id))
                 return;
 
         // Create a history view with the room events.
-        TimelineView *view = new TimelineView(room.timeline, room_id);
+        TimelineView *view = new TimelineView(std::move(room.timeline), room_id);
         views_.emplace(room_id, QSharedPointer<TimelineView>(view));
 
         connect(view,
@@ -224,31 +232,207 @@ TimelineViewManager::addRoom(const QString &room_id)
         addWidget(view);
 }
 
+//! How long a single wakeup may spend applying room updates before
+//! yielding back to the event loop.
+constexpr qint64 SYNC_FRAME_BUDGET_MS = 8;
+
+void
+TimelineViewManager::sync(mtx::responses::Rooms rooms)
+{
+        // The room currently open is applied first and the rooms visible in
+        // the sidebar right after it, so what the user is looking at updates
+        // before the whole response has been processed. Offscreen rooms are
+        // amortized over idle gaps.
+        for (auto &room : rooms.join) {
+                const auto room_id = QString::fromStdString(room.first);
+
+                markRoomActive(room_id);
+
+                if (room_id == active_room_)
+                        syncQueue_.emplace_front(room.first, std::move(room.second));
+                else if (roomVisibleFn_ && roomVisibleFn_(room_id))
+                        syncQueue_.emplace_back(room.first, std::move(room.second));
+                else
+                        backgroundQueue_.emplace_back(room.first, std::move(room.second));
+        }
+
+        if (!isSyncInProgress_ && !(syncQueue_.empty() && backgroundQueue_.empty())) {
+                isSyncInProgress_ = true;
+                QTimer::singleShot(0, this, [this]() { syncNextRoom(); });
+        }
+}
+
+void
+TimelineViewManager::applyRoom(std::pair<std::string, mtx::responses::JoinedRoom> room)
+{
+        const auto room_id = QString::fromStdString(room.first);
+
+        if (!timelineViewExists(room_id))
+                addRoom(std::move(room.second), room_id);
+        else
+                views_.at(room_id)->addEvents(std::move(room.second.timeline));
+}
+
+void
+TimelineViewManager::syncNextRoom()
+{
+        QElapsedTimer frame;
+        frame.start();
+
+        while (!syncQueue_.empty() && frame.elapsed() < SYNC_FRAME_BUDGET_MS) {
+                auto room = std::move(syncQueue_.front());
+                syncQueue_.pop_front();
+
+                applyRoom(std::move(room));
+        }
+
+        if (!syncQueue_.empty()) {
+                QTimer::singleShot(0, this, [this]() { syncNextRoom(); });
+                return;
+        }
+
+        if (!backgroundQueue_.empty()) {
+                idle::schedule(this, [this]() { syncBackgroundRoom(); });
+                return;
+        }
+
+        isSyncInProgress_ = false;
+        enforceViewBudget();
+        prefetchTimelines();
+}
+
+void
+TimelineViewManager::syncBackgroundRoom()
+{
+        // A sync may have arrived in the meantime; drain the priority queue
+        // first so the visible rooms never wait behind offscreen ones.
+        if (!syncQueue_.empty()) {
+                syncNextRoom();
+                return;
+        }
+
+        QElapsedTimer frame;
+        frame.start();
+
+        while (!backgroundQueue_.empty() && frame.elapsed() < SYNC_FRAME_BUDGET_MS) {
+                auto room = std::move(backgroundQueue_.front());
+                backgroundQueue_.pop_front();
+
+                applyRoom(std::move(room));
+        }
+
+        if (!backgroundQueue_.empty()) {
+                idle::schedule(this, [this]() { syncBackgroundRoom(); });
+                return;
+        }
+
+        isSyncInProgress_ = false;
+        enforceViewBudget();
+        prefetchTimelines();
+}
+
+//! Upper bound of history requests issued after a sync is applied.
+constexpr int MAX_PREFETCHED_ROOMS = 5;
+//! How many rooms are tracked for prefetching.
+constexpr size_t MAX_TRACKED_ROOMS = 30;
+
+void
+TimelineViewManager::markRoomActive(const QString &room_id)
+{
+        auto it = std::find(recentlyActive_.begin(), recentlyActive_.end(), room_id);
+        if (it != recentlyActive_.end())
+                recentlyActive_.erase(it);
+
+        recentlyActive_.push_front(room_id);
+
+        if (recentlyActive_.size() > MAX_TRACKED_ROOMS)
+                recentlyActive_.pop_back();
+}
+
+void
+TimelineViewManager::prefetchTimelines()
+{
+        int prefetched = 0;
+
+        for (const auto &room_id : recentlyActive_) {
+                if (prefetched == MAX_PREFETCHED_ROOMS)
+                        break;
+
+                if (!timelineViewExists(room_id))
+                        continue;
+
+                if (views_.at(room_id)->prefetchHistory())
+                        prefetched += 1;
+        }
+}
+
+void
+TimelineViewManager::enforceViewBudget()
+{
+        QSettings settings;
+        enforceViewBudget(settings.value("user/timeline/max_live_views", 20).toULongLong());
+}
+
 void
-TimelineViewManager::sync(const mtx::responses::Rooms &rooms)
+TimelineViewManager::enforceViewBudget(size_t budget)
 {
-        for (const auto &room : rooms.join) {
-                auto roomid = QString::fromStdString(room.first);
+        if (budget == 0 || views_.size() <= budget)
+                return;
+
+        // Evict rooms that haven't appeared in a sync recently first, then
+        // walk the recently active list from the least recent end.
+        std::deque<QString> evictionOrder;
+        for (const auto &view : views_) {
+                if (std::find(recentlyActive_.begin(), recentlyActive_.end(), view.first) ==
+                    recentlyActive_.end())
+                        evictionOrder.push_back(view.first);
+        }
+        for (auto it = recentlyActive_.rbegin(); it != recentlyActive_.rend(); ++it)
+                evictionOrder.push_back(*it);
 
-                if (!timelineViewExists(roomid)) {
-                        nhlog::ui()->warn("ignoring event from unknown room: {}",
-                                          roomid.toStdString());
+        for (const auto &room_id : evictionOrder) {
+                if (views_.size() <= budget)
+                        break;
+
+                if (room_id == active_room_ || !timelineViewExists(room_id))
+                        continue;
+
+                auto view = views_.at(room_id);
+
+                // The unconfirmed messages would be lost with the widgets.
+                if (view->hasPendingMessages())
+                        continue;
+
+                // In-flight decryption tasks still reference the view.
+                if (view->hasPendingDecryptions())
                         continue;
-                }
 
-                auto view = views_.at(roomid);
+                nhlog::ui()->info("evicting inactive timeline view: {}",
+                                  room_id.toStdString());
 
-                view->addEvents(room.second.timeline);
+                http::cancelDownloads(view.data());
+                removeWidget(view.data());
+                views_.erase(room_id);
         }
 }
 
 void
 TimelineViewManager::setHistoryView(const QString &room_id)
 {
+        // The media of the view we're leaving shouldn't compete with the
+        // content of the room being opened.
+        if (!active_room_.isEmpty() && active_room_ != room_id &&
+            timelineViewExists(active_room_))
+                http::cancelDownloads(views_.at(active_room_).data());
+
+        markRoomActive(room_id);
+
+        // Rebuild rooms whose view has been evicted. The view starts empty
+        // and fetches its first page through the regular pagination path.
         if (!timelineViewExists(room_id)) {
-                nhlog::ui()->warn("room from RoomList is not present in ViewManager: {}",
+                nhlog::ui()->info("rebuilding evicted timeline view: {}",
                                   room_id.toStdString());
-                return;
+                addRoom(room_id);
         }
 
         active_room_ = room_id;
@@ -17,6 +17,9 @@
 
 #pragma once
 
+#include <deque>
+#include <functional>
+
 #include <QSharedPointer>
 #include <QStackedWidget>
 
@@ -36,16 +39,29 @@ class TimelineViewManager : public QStackedWidget
 public:
         TimelineViewManager(QWidget *parent);
 
-        // Initialize with timeline events.
-        void initialize(const mtx::responses::Rooms &rooms);
+        // Initialize with timeline events. The response is passed by value
+        // so the events can be moved into the views without being copied.
+        void initialize(mtx::responses::Rooms rooms);
         // Empty initialization.
         void initialize(const std::vector<std::string> &rooms);
 
-        void addRoom(const mtx::responses::JoinedRoom &room, const QString &room_id);
+        void addRoom(mtx::responses::JoinedRoom room, const QString &room_id);
         void addRoom(const QString &room_id);
 
-        void sync(const mtx::responses::Rooms &rooms);
-        void clearAll() { views_.clear(); }
+        void sync(mtx::responses::Rooms rooms);
+        void clearAll()
+        {
+                views_.clear();
+                syncQueue_.clear();
+                backgroundQueue_.clear();
+        }
+
+        //! Tell the dispatcher which rooms are visible in the sidebar,
+        //! so their updates are applied before the offscreen ones.
+        void setRoomVisibleCheck(std::function<bool(const QString &)> fn)
+        {
+                roomVisibleFn_ = std::move(fn);
+        }
 
         // Check if all the timelines have been loaded.
         bool hasLoaded() const;
@@ -90,6 +106,39 @@ private:
         //! Check if the given room id is managed by a TimelineView.
         bool timelineViewExists(const QString &id) { return views_.find(id) != views_.end(); }
 
+        //! Apply queued rooms until the frame budget runs out and
+        //! reschedule until both queues are empty.
+        void syncNextRoom();
+        //! Drain one frame budget worth of offscreen rooms during an
+        //! idle gap.
+        void syncBackgroundRoom();
+        //! Warm the first page of recently active rooms that have no events
+        //! yet, so switching to them doesn't wait on the network.
+        void prefetchTimelines();
+        //! Move the given room to the front of the recently active list.
+        void markRoomActive(const QString &room_id);
+        //! Destroy the least recently active views when the number of live
+        //! views exceeds the given budget. Evicted rooms are rebuilt
+        //! on demand by setHistoryView.
+        void enforceViewBudget(size_t budget);
+        //! Variant that reads the budget from the settings.
+        void enforceViewBudget();
+
         QString active_room_;
         std::map<QString, QSharedPointer<TimelineView>> views_;
+
+        //! Apply the payload of the given room to its view.
+        void applyRoom(std::pair<std::string, mtx::responses::JoinedRoom> room);
+
+        //! Payloads for the active room and the rooms visible in the
+        //! sidebar, applied as soon as the event loop allows.
+        std::deque<std::pair<std::string, mtx::responses::JoinedRoom>> syncQueue_;
+        //! Payloads for offscreen rooms, amortized over idle gaps.
+        std::deque<std::pair<std::string, mtx::responses::JoinedRoom>> backgroundQueue_;
+        bool isSyncInProgress_ = false;
+
+        std::function<bool(const QString &)> roomVisibleFn_;
+
+        //! Rooms that appeared in sync responses, most recent first.
+        std::deque<QString> recentlyActive_;
 };
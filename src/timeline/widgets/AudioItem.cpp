@@ -40,6 +40,15 @@ constexpr double VerticalPadding = Height - 2 * IconRadius;
 constexpr double IconYCenter     = Height / 2;
 constexpr double IconXCenter     = HorizontalPadding + IconRadius;
 
+namespace {
+QString
+formatDuration(uint64_t msecs)
+{
+        const uint64_t secs = msecs / 1000;
+        return QString("%1:%2").arg(secs / 60).arg(secs % 60, 2, 10, QChar('0'));
+}
+}
+
 void
 AudioItem::init()
 {
@@ -50,23 +59,36 @@ AudioItem::init()
         playIcon_.addFile(":/icons/icons/ui/play-sign.png");
         pauseIcon_.addFile(":/icons/icons/ui/pause-symbol.png");
 
-        player_ = new QMediaPlayer;
-        player_->setMedia(QUrl(url_));
-        player_->setVolume(100);
-        player_->setNotifyInterval(1000);
-
         connect(this, &AudioItem::fileDownloadedCb, this, &AudioItem::fileDownloaded);
-        connect(player_, &QMediaPlayer::stateChanged, this, [this](QMediaPlayer::State state) {
-                if (state == QMediaPlayer::StoppedState) {
-                        state_ = AudioState::Play;
-                        player_->setMedia(QUrl(url_));
-                        update();
-                }
-        });
 
         setFixedHeight(Height);
 }
 
+QMediaPlayer *
+AudioItem::mediaPlayer()
+{
+        // The player spawns a decoding pipeline, so it is created only when
+        // playback actually starts; the duration shown in the widget comes
+        // from the event metadata instead.
+        if (!player_) {
+                player_ = new QMediaPlayer(this);
+                player_->setMedia(QUrl(url_));
+                player_->setVolume(100);
+                player_->setNotifyInterval(1000);
+
+                connect(
+                  player_, &QMediaPlayer::stateChanged, this, [this](QMediaPlayer::State state) {
+                          if (state == QMediaPlayer::StoppedState) {
+                                  state_ = AudioState::Play;
+                                  player_->setMedia(QUrl(url_));
+                                  update();
+                          }
+                  });
+        }
+
+        return player_;
+}
+
 AudioItem::AudioItem(const mtx::events::RoomEvent<mtx::events::msg::Audio> &event, QWidget *parent)
   : QWidget(parent)
   , url_{QUrl(QString::fromStdString(event.content.url))}
@@ -75,6 +97,9 @@ AudioItem::AudioItem(const mtx::events::RoomEvent<mtx::events::msg::Audio> &even
 {
         readableFileSize_ = utils::humanReadableFileSize(event.content.info.size);
 
+        if (event.content.info.duration > 0)
+                durationText_ = formatDuration(event.content.info.duration);
+
         init();
 }
 
@@ -107,10 +132,10 @@ AudioItem::mousePressEvent(QMouseEvent *event)
               .contains(point)) {
                 if (state_ == AudioState::Play) {
                         state_ = AudioState::Pause;
-                        player_->play();
+                        mediaPlayer()->play();
                 } else {
                         state_ = AudioState::Play;
-                        player_->pause();
+                        mediaPlayer()->pause();
                 }
 
                 update();
@@ -222,9 +247,14 @@ AudioItem::paintEvent(QPaintEvent *event)
         painter.setPen(QPen(textColor_));
         painter.drawText(QPoint(textStartX, textStartY), elidedText);
 
-        // Draw the filesize.
+        // Draw the filesize & the duration from the event metadata.
         font.setWeight(50);
         painter.setFont(font);
         painter.setPen(QPen(textColor_));
-        painter.drawText(QPoint(textStartX, textStartY + 1.5 * fm.ascent()), readableFileSize_);
+
+        auto details = readableFileSize_;
+        if (!durationText_.isEmpty())
+                details += QString(" · %1").arg(durationText_);
+
+        painter.drawText(QPoint(textStartX, textStartY + 1.5 * fm.ascent()), details);
 }
@@ -77,6 +77,9 @@ private slots:
 
 private:
         void init();
+        //! Create the playback pipeline on first use. Merely displaying the
+        //! widget doesn't need one.
+        QMediaPlayer *mediaPlayer();
 
         enum class AudioState
         {
@@ -89,11 +92,13 @@ private:
         QUrl url_;
         QString text_;
         QString readableFileSize_;
+        //! Formatted track duration, taken from the event metadata.
+        QString durationText_;
         QString filenameToSave_;
 
         mtx::events::RoomEvent<mtx::events::msg::Audio> event_;
 
-        QMediaPlayer *player_;
+        QMediaPlayer *player_ = nullptr;
 
         QIcon playIcon_;
         QIcon pauseIcon_;
@@ -24,6 +24,7 @@
 
 #include "Logging.h"
 #include "MatrixClient.h"
+#include "MediaDownloader.h"
 #include "Utils.h"
 
 #include "timeline/widgets/FileItem.h"
@@ -50,8 +51,6 @@ FileItem::init()
         icon_.addFile(":/icons/icons/ui/arrow-pointing-down.png");
 
         setFixedHeight(Height);
-
-        connect(this, &FileItem::fileDownloadedCb, this, &FileItem::fileDownloaded);
 }
 
 FileItem::FileItem(const mtx::events::RoomEvent<mtx::events::msg::File> &event, QWidget *parent)
@@ -75,6 +74,13 @@ FileItem::FileItem(const QString &url, const QString &filename, uint64_t size, Q
         init();
 }
 
+QUrl
+FileItem::downloadUrl() const
+{
+        return QUrl(utils::mxcToHttp(
+          url_, QString::fromStdString(http::client()->server()), http::client()->port()));
+}
+
 void
 FileItem::openUrl()
 {
@@ -110,39 +116,25 @@ FileItem::mousePressEvent(QMouseEvent *event)
                 if (filenameToSave_.isEmpty())
                         return;
 
-                http::client()->download(
-                  url_.toString().toStdString(),
-                  [this](const std::string &data,
-                         const std::string &,
-                         const std::string &,
-                         mtx::http::RequestErr err) {
-                          if (err) {
-                                  nhlog::ui()->warn("failed to retrieve m.file content: {}",
-                                                    url_.toString().toStdString());
-                                  return;
-                          }
-
-                          emit fileDownloadedCb(QByteArray(data.data(), data.size()));
-                  });
+                // The transfer streams to disk and resumes from any
+                // partial file a previous attempt left behind.
+                media::download(downloadUrl(), filenameToSave_, this, [this](bool ok) {
+                        if (!ok)
+                                nhlog::ui()->warn("failed to retrieve m.file content: {}",
+                                                  url_.toString().toStdString());
+                });
         } else {
                 openUrl();
         }
 }
 
 void
-FileItem::fileDownloaded(const QByteArray &data)
+FileItem::enterEvent(QEvent *event)
 {
-        try {
-                QFile file(filenameToSave_);
-
-                if (!file.open(QIODevice::WriteOnly))
-                        return;
+        Q_UNUSED(event);
 
-                file.write(data);
-                file.close();
-        } catch (const std::exception &e) {
-                nhlog::ui()->warn("Error while saving file to: {}", e.what());
-        }
+        if (!url_.toString().isEmpty())
+                media::preconnect(downloadUrl());
 }
 
 void
@@ -52,20 +52,19 @@ public:
         QColor iconColor() const { return iconColor_; }
         QColor backgroundColor() const { return backgroundColor_; }
 
-signals:
-        void fileDownloadedCb(const QByteArray &data);
-
 protected:
         void paintEvent(QPaintEvent *event) override;
         void mousePressEvent(QMouseEvent *event) override;
         void resizeEvent(QResizeEvent *event) override;
-
-private slots:
-        void fileDownloaded(const QByteArray &data);
+        //! Open the connection to the media server while the user is
+        //! still deciding whether to click.
+        void enterEvent(QEvent *event) override;
 
 private:
         void openUrl();
         void init();
+        //! The HTTP form of the attachment's mxc url.
+        QUrl downloadUrl() const;
 
         QUrl url_;
         QString text_;
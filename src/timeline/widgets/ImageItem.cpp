@@ -16,13 +16,18 @@
  */
 
 #include <QBrush>
+#include <QBuffer>
 #include <QDesktopServices>
 #include <QFileDialog>
 #include <QFileInfo>
+#include <QImageReader>
 #include <QPainter>
 #include <QPixmap>
+#include <QPointer>
 #include <QUuid>
+#include <QtConcurrent>
 
+#include "Cache.h"
 #include "Config.h"
 #include "ImageItem.h"
 #include "Logging.h"
@@ -30,27 +35,189 @@
 #include "Utils.h"
 #include "dialogs/ImageOverlay.h"
 
+//! Scale down the original size to fit the given box, never scaling up.
+static QSize
+fitSize(const QSize &original, int max_width, int max_height)
+{
+        if (original.width() <= max_width && original.height() <= max_height)
+                return original;
+
+        return original.scaled(max_width, max_height, Qt::KeepAspectRatio);
+}
+
 void
 ImageItem::downloadMedia(const QUrl &url)
 {
-        http::client()->download(url.toString().toStdString(),
-                                 [this, url](const std::string &data,
-                                             const std::string &,
-                                             const std::string &,
-                                             mtx::http::RequestErr err) {
-                                         if (err) {
-                                                 nhlog::net()->warn(
-                                                   "failed to retrieve image {}: {} {}",
-                                                   url.toString().toStdString(),
-                                                   err->matrix_error.error,
-                                                   static_cast<int>(err->status_code));
-                                                 return;
-                                         }
-
-                                         QPixmap img;
-                                         img.loadFromData(QByteArray(data.data(), data.size()));
-                                         emit imageDownloaded(img);
-                                 });
+        http::download(url.toString().toStdString(),
+                       http::DownloadPriority::Visible,
+                       this,
+                       [this, url](const std::string &data,
+                                   const std::string &,
+                                   const std::string &,
+                                   mtx::http::RequestErr err) {
+                               if (err) {
+                                       nhlog::net()->warn("failed to retrieve image {}: {} {}",
+                                                          url.toString().toStdString(),
+                                                          err->matrix_error.error,
+                                                          static_cast<int>(err->status_code));
+                                       return;
+                               }
+
+                               emit imageDownloaded(QByteArray(data.data(), data.size()));
+                       });
+}
+
+void
+ImageItem::fetchDisplayThumbnail()
+{
+        // The event metadata carries the original dimensions, so the
+        // requested size can match exactly what the widget will show.
+        const auto &info   = event_.content.info;
+        const auto display = (info.w > 0 && info.h > 0)
+                               ? fitSize(QSize(info.w, info.h), max_width_, max_height_)
+                               : QSize(max_width_, max_height_);
+        const auto dpr     = utils::screenDpr(this);
+
+        mtx::http::ThumbOpts opts;
+        opts.width   = utils::devicePixels(display.width(), dpr);
+        opts.height  = utils::devicePixels(display.height(), dpr);
+        opts.method  = "scale";
+        opts.mxc_url = url_.toString().toStdString();
+
+        http::get_thumbnail(
+          opts,
+          http::DownloadPriority::Visible,
+          this,
+          [this, opts](const std::string &res, mtx::http::RequestErr err) {
+                  if (err) {
+                          // Not every server can thumbnail every format;
+                          // fall back to scaling the original locally.
+                          nhlog::net()->warn("failed to retrieve thumbnail {} ({} {})",
+                                             opts.mxc_url,
+                                             mtx::errors::to_string(err->matrix_error.errcode),
+                                             err->matrix_error.error);
+                          downloadMedia(url_);
+                          return;
+                  }
+
+                  const auto data = QByteArray(res.data(), res.size());
+
+                  QPointer<ImageItem> self(this);
+                  QtConcurrent::run([self, data]() {
+                          if (self)
+                                  self->processRawImage(data);
+                  });
+          });
+}
+
+void
+ImageItem::handleRawImage(const QByteArray &data)
+{
+        data_ = data;
+
+        if (overlayPending_) {
+                overlayPending_ = false;
+                showOverlay();
+        }
+
+        // A display-size variant was already served from the cache or the
+        // server; the raw bytes were only needed for the overlay.
+        if (thumbnailLoaded_ || !image_.isNull())
+                return;
+
+        QPointer<ImageItem> self(this);
+        QtConcurrent::run([self, data]() {
+                if (self)
+                        self->processRawImage(data);
+        });
+}
+
+void
+ImageItem::processRawImage(const QByteArray &data)
+{
+        QBuffer buffer;
+        buffer.setData(data);
+        buffer.open(QIODevice::ReadOnly);
+
+        QImageReader reader(&buffer);
+        reader.setAutoTransform(true);
+
+        const auto original = reader.size();
+
+        // Formats that don't store their dimensions in a header need a
+        // full decode anyway.
+        if (!original.isValid()) {
+                const auto image   = reader.read();
+                const auto display = fitSize(image.size(), max_width_, max_height_);
+
+                emit imageLoaded(image, display);
+
+                saveThumbnail(
+                  image.scaled(display, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+
+                return;
+        }
+
+        const auto display = fitSize(original, max_width_, max_height_);
+
+        // A cheap reduced-resolution decode (for JPEG through DCT scaling)
+        // provides a placeholder while the proper decode runs.
+        reader.setScaledSize(display / 8);
+        emit imageLoaded(reader.read(), display);
+
+        buffer.seek(0);
+
+        QImageReader displayReader(&buffer);
+        displayReader.setAutoTransform(true);
+        displayReader.setScaledSize(display);
+
+        const auto image = displayReader.read();
+        emit imageLoaded(image, display);
+
+        saveThumbnail(image);
+}
+
+void
+ImageItem::saveThumbnail(const QImage &image)
+{
+        if (image.isNull() || !cache::client())
+                return;
+
+        QByteArray data;
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+
+        if (image.hasAlphaChannel())
+                image.save(&buffer, "PNG");
+        else
+                image.save(&buffer, "JPEG", 85);
+
+        cache::client()->saveImageThumbnail(
+          url_.toString(), QSize(max_width_, max_height_), data);
+
+        // A heavily reduced copy doubles as an instant placeholder: scaled
+        // back up it reads as a blurred preview, and at a few hundred bytes
+        // the eviction pass can afford to keep it long after the display
+        // variant is gone.
+        const auto tiny =
+          image.scaled(placeholderBox(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+        QByteArray tinyData;
+        QBuffer tinyBuffer(&tinyData);
+        tinyBuffer.open(QIODevice::WriteOnly);
+
+        if (tiny.hasAlphaChannel())
+                tiny.save(&tinyBuffer, "PNG");
+        else
+                tiny.save(&tinyBuffer, "JPEG", 60);
+
+        cache::client()->saveImageThumbnail(url_.toString(), placeholderBox(), tinyData);
+}
+
+QSize
+ImageItem::placeholderBox() const
+{
+        return QSize(max_width_ / 8, max_height_ / 8);
 }
 
 void
@@ -76,9 +243,61 @@ ImageItem::init()
         setCursor(Qt::PointingHandCursor);
         setAttribute(Qt::WA_Hover, true);
 
-        connect(this, &ImageItem::imageDownloaded, this, &ImageItem::setImage);
+        connect(this, &ImageItem::imageDownloaded, this, &ImageItem::handleRawImage);
+        connect(this, &ImageItem::thumbnailNeeded, this, &ImageItem::fetchDisplayThumbnail);
+        connect(this, &ImageItem::imageLoaded, this, &ImageItem::setImage);
         connect(this, &ImageItem::imageSaved, this, &ImageItem::saveImage);
-        downloadMedia(url_);
+        connect(this, &ImageItem::thumbnailRetrieved, this, [this](const QImage &image) {
+                thumbnailLoaded_ = true;
+                setImage(image, image.size());
+        });
+        connect(this, &ImageItem::placeholderRetrieved, this, [this](const QImage &image) {
+                // A proper decode may have won the race with the cache read.
+                if (thumbnailLoaded_ || !image_.isNull())
+                        return;
+
+                // Upscaling the tiny variant is what produces the blur. The
+                // event metadata carries the exact final size, so the layout
+                // doesn't shift when the proper decode replaces it.
+                const auto &info = event_.content.info;
+                const auto size =
+                  (info.w > 0 && info.h > 0)
+                    ? fitSize(QSize(info.w, info.h), max_width_, max_height_)
+                    : image.size().scaled(max_width_, max_height_, Qt::KeepAspectRatio);
+
+                setImage(image, size);
+        });
+
+        // Serve the cached display-size variant, if one exists, so showing
+        // the image again doesn't decode the full-size original at all.
+        QPointer<ImageItem> self(this);
+        const auto url     = url_.toString();
+        const auto box     = QSize(max_width_, max_height_);
+        const auto tinyBox = placeholderBox();
+        QtConcurrent::run([self, url, box, tinyBox]() {
+                if (cache::client()) {
+                        const auto image = cache::client()->imageThumbnail(url, box);
+
+                        if (!image.isNull()) {
+                                if (self)
+                                        emit self->thumbnailRetrieved(image);
+                                return;
+                        }
+
+                        // The display variant may have been evicted while the
+                        // tiny placeholder survived; it bridges the gap until
+                        // the download delivers a proper decode.
+                        const auto placeholder = cache::client()->imageThumbnail(url, tinyBox);
+
+                        if (!placeholder.isNull() && self)
+                                emit self->placeholderRetrieved(placeholder);
+                }
+
+                // Nothing usable locally; have the server scale the original
+                // down instead of shipping it whole.
+                if (self)
+                        emit self->thumbnailNeeded();
+        });
 }
 
 ImageItem::ImageItem(const mtx::events::RoomEvent<mtx::events::msg::Image> &event, QWidget *parent)
@@ -123,13 +342,19 @@ ImageItem::sizeHint() const
 }
 
 void
-ImageItem::setImage(const QPixmap &image)
+ImageItem::setImage(const QImage &image, const QSize &size)
 {
-        image_        = image;
-        scaled_image_ = utils::scaleDown(max_width_, max_height_, image_);
+        image_ = image;
 
-        width_  = scaled_image_.width();
-        height_ = scaled_image_.height();
+        // The placeholder is stretched to the final size, so the layout
+        // doesn't shift when the proper decode arrives.
+        scaled_image_ = QPixmap::fromImage(
+          image.size() == size
+            ? image
+            : image.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+
+        width_  = size.width();
+        height_ = size.height();
 
         setFixedSize(width_, height_);
         update();
@@ -153,24 +378,40 @@ ImageItem::mousePressEvent(QMouseEvent *event)
 
         if (textRegion_.contains(event->pos())) {
                 openUrl();
-        } else {
-                auto imgDialog = new dialogs::ImageOverlay(image_);
-                imgDialog->show();
+        } else if (!overlayPending_) {
+                // The timeline only ever fetched a thumbnail; the original
+                // is downloaded the first time the overlay asks for it.
+                if (data_.isEmpty()) {
+                        overlayPending_ = true;
+                        downloadMedia(url_);
+                        return;
+                }
+
+                showOverlay();
         }
 }
 
 void
-ImageItem::resizeEvent(QResizeEvent *event)
+ImageItem::showOverlay()
 {
-        if (!image_)
-                return QWidget::resizeEvent(event);
+        // The overlay gets a fresh full-resolution decode; only the
+        // display-resolution image is kept in memory.
+        QPixmap original;
+        original.loadFromData(data_);
 
-        scaled_image_ = utils::scaleDown(max_width_, max_height_, image_);
+        auto imgDialog = new dialogs::ImageOverlay(original);
+        imgDialog->show();
+}
 
-        width_  = scaled_image_.width();
-        height_ = scaled_image_.height();
+void
+ImageItem::resizeEvent(QResizeEvent *event)
+{
+        if (image_.isNull())
+                return QWidget::resizeEvent(event);
 
-        setFixedSize(width_, height_);
+        // image_ may be a placeholder at a fraction of the display size;
+        // the widget keeps the size the proper decode will take.
+        setImage(image_, fitSize(QSize(width_, height_), max_width_, max_height_));
 }
 
 void
@@ -179,6 +420,16 @@ ImageItem::paintEvent(QPaintEvent *event)
         Q_UNUSED(event);
 
         QPainter painter(this);
+
+        // A fling is in progress; the widget is likely visible for a single
+        // frame, so skip the text metrics and the antialiased rounded-corner
+        // clip and blit the cached pixmap as is.
+        if (!image_.isNull() && utils::isFastScrolling()) {
+                imageRegion_ = QRectF(0, 0, width_, height_);
+                painter.drawPixmap(0, 0, scaled_image_);
+                return;
+        }
+
         painter.setRenderHint(QPainter::Antialiasing);
 
         QFont font("Open Sans");
@@ -238,6 +489,12 @@ ImageItem::saveAs()
         if (filename.isEmpty())
                 return;
 
+        // The overlay may have fetched the original already.
+        if (!data_.isEmpty()) {
+                saveImage(filename, data_);
+                return;
+        }
+
         const auto url = url_.toString().toStdString();
 
         http::client()->download(
@@ -45,12 +45,22 @@ public:
 public slots:
         //! Show a save as dialog for the image.
         void saveAs();
-        void setImage(const QPixmap &image);
+        void setImage(const QImage &image, const QSize &size);
         void saveImage(const QString &filename, const QByteArray &data);
 
 signals:
-        void imageDownloaded(const QPixmap &img);
+        void imageDownloaded(const QByteArray &data);
+        //! A decoded version of the image, at the size the widget should take.
+        void imageLoaded(const QImage &image, const QSize &size);
         void imageSaved(const QString &filename, const QByteArray &data);
+        //! A display-size variant found in the media cache.
+        void thumbnailRetrieved(const QImage &image);
+        //! No display-size variant exists locally; one has to be fetched
+        //! from the homeserver.
+        void thumbnailNeeded();
+        //! A tiny variant found in the media cache. Shown upscaled — and
+        //! therefore blurred — until a proper decode replaces it.
+        void placeholderRetrieved(const QImage &image);
 
 protected:
         void paintEvent(QPaintEvent *event) override;
@@ -63,16 +73,44 @@ protected:
 private:
         void init();
         void openUrl();
+        //! Download the full-size original. Only needed for the overlay or
+        //! when the homeserver cannot produce a thumbnail.
         void downloadMedia(const QUrl &url);
+        //! Ask the homeserver for a scaled-down variant at display
+        //! resolution, instead of shipping the original across the wire.
+        void fetchDisplayThumbnail();
+        //! Open the full-resolution overlay from the downloaded bytes.
+        void showOverlay();
+        //! Decode the image on the thread pool. Emits a fast reduced
+        //! resolution placeholder first and the proper decode after it.
+        void processRawImage(const QByteArray &data);
+        //! Store the raw bytes and schedule their decoding.
+        void handleRawImage(const QByteArray &data);
+        //! Store the display-size variant in the media cache, so the next
+        //! display of this image skips the full-size decode. A tiny copy
+        //! is stored alongside it as a placeholder.
+        void saveThumbnail(const QImage &image);
+        //! Bounding box under which the tiny placeholder variant is keyed.
+        QSize placeholderBox() const;
 
         int max_width_  = 500;
         int max_height_ = 300;
 
+        //! Whether the display-size image was served from the thumbnail
+        //! cache, making the decode of the raw bytes unnecessary.
+        bool thumbnailLoaded_ = false;
+        //! Whether the overlay is waiting for the original to download.
+        bool overlayPending_ = false;
+
         int width_;
         int height_;
 
         QPixmap scaled_image_;
-        QPixmap image_;
+        //! The latest decoded image, at display resolution.
+        QImage image_;
+        //! The raw original image, downloaded lazily the first time the
+        //! overlay is opened.
+        QByteArray data_;
 
         QUrl url_;
         QString text_;
@@ -16,18 +16,46 @@
  */
 
 #include <QLabel>
+#include <QPixmap>
 #include <QVBoxLayout>
 
 #include "Config.h"
 #include "MatrixClient.h"
 #include "Utils.h"
+#include "VideoThumbnailer.h"
 #include "timeline/widgets/VideoItem.h"
 
 void
 VideoItem::init()
 {
+        // The poster is keyed on the mxc uri, before it is turned into an
+        // http url, so the upload path can warm the cache for the local echo.
+        thumbnailKey_ = url_.toString() + "/thumbnail";
+
         url_ = utils::mxcToHttp(
           url_, QString::fromStdString(http::client()->server()), http::client()->port());
+
+        layout_ = new QVBoxLayout(this);
+        layout_->setMargin(0);
+        layout_->setSpacing(0);
+
+        thumbnail_ = new QLabel(this);
+        thumbnail_->hide();
+        layout_->addWidget(thumbnail_);
+
+        VideoThumbnailer::extract(
+          url_, thumbnailKey_, this, [this](QImage img) { setThumbnail(img); });
+}
+
+void
+VideoItem::setThumbnail(const QImage &img)
+{
+        if (img.isNull())
+                return;
+
+        thumbnail_->setPixmap(QPixmap::fromImage(
+          img.scaled(max_width_, max_height_, Qt::KeepAspectRatio, Qt::SmoothTransformation)));
+        thumbnail_->show();
 }
 
 VideoItem::VideoItem(const mtx::events::RoomEvent<mtx::events::msg::Video> &event, QWidget *parent)
@@ -40,10 +68,6 @@ VideoItem::VideoItem(const mtx::events::RoomEvent<mtx::events::msg::Video> &even
 
         init();
 
-        auto layout = new QVBoxLayout(this);
-        layout->setMargin(0);
-        layout->setSpacing(0);
-
         QString link = QString("<a href=%1>%2</a>").arg(url_.toString()).arg(text_);
 
         label_ = new QLabel(link, this);
@@ -52,7 +76,7 @@ VideoItem::VideoItem(const mtx::events::RoomEvent<mtx::events::msg::Video> &even
         label_->setOpenExternalLinks(true);
         label_->setStyleSheet(QString("font-size: %1px;").arg(conf::fontSize));
 
-        layout->addWidget(label_);
+        layout_->addWidget(label_);
 }
 
 VideoItem::VideoItem(const QString &url, const QString &filename, uint64_t size, QWidget *parent)
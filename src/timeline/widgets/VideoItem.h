@@ -25,6 +25,8 @@
 
 #include <mtx.hpp>
 
+class QVBoxLayout;
+
 class VideoItem : public QWidget
 {
         Q_OBJECT
@@ -40,12 +42,19 @@ public:
 
 private:
         void init();
+        void setThumbnail(const QImage &img);
 
         QUrl url_;
         QString text_;
         QString readableFileSize_;
+        QString thumbnailKey_;
+
+        int max_width_  = 500;
+        int max_height_ = 300;
 
-        QLabel *label_;
+        QVBoxLayout *layout_;
+        QLabel *label_ = nullptr;
+        QLabel *thumbnail_;
 
         mtx::events::RoomEvent<mtx::events::msg::Video> event_;
 };
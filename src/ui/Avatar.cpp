@@ -64,9 +64,7 @@ void
 Avatar::setSize(int size)
 {
         size_ = size;
-
-        if (!image_.isNull())
-                pixmap_ = utils::scaleImageToPixmap(image_, size_);
+        variants_.clear();
 
         QFont _font(font());
         _font.setPointSizeF(size_ * (ui::FontSize) / 40);
@@ -86,12 +84,24 @@ Avatar::setLetter(const QString &letter)
 void
 Avatar::setImage(const QImage &image)
 {
-        image_  = image;
-        type_   = ui::AvatarType::Image;
-        pixmap_ = utils::scaleImageToPixmap(image_, size_);
+        image_ = image;
+        type_  = ui::AvatarType::Image;
+        variants_.clear();
         update();
 }
 
+const QPixmap &
+Avatar::variant(qreal dpr)
+{
+        const int key = qRound(dpr * 100);
+
+        auto it = variants_.find(key);
+        if (it == variants_.end())
+                it = variants_.emplace(key, utils::scaleImageToPixmap(image_, size_, dpr)).first;
+
+        return it->second;
+}
+
 void
 Avatar::setIcon(const QIcon &icon)
 {
@@ -109,7 +119,7 @@ Avatar::paintEvent(QPaintEvent *)
         QRect r      = rect();
         const int hs = size_ / 2;
 
-        if (type_ != ui::AvatarType::Image) {
+        if (type_ == ui::AvatarType::Icon) {
                 QBrush brush;
                 brush.setStyle(Qt::SolidPattern);
                 brush.setColor(backgroundColor());
@@ -132,13 +142,21 @@ Avatar::paintEvent(QPaintEvent *)
                 ppath.addEllipse(width() / 2 - hs, height() / 2 - hs, size_, size_);
                 painter.setClipPath(ppath);
                 painter.drawPixmap(QRect(width() / 2 - hs, height() / 2 - hs, size_, size_),
-                                   pixmap_);
+                                   variant(utils::screenDpr(this)));
                 break;
         }
         case ui::AvatarType::Letter: {
-                painter.setPen(textColor());
-                painter.setBrush(Qt::NoBrush);
-                painter.drawText(r.translated(0, -1), Qt::AlignCenter, letter_);
+                // The circle & letter are rasterized once per (letter, colors,
+                // size, pixel ratio) combination and shared across all the
+                // avatars.
+                painter.drawPixmap(r.center().x() - hs,
+                                   r.center().y() - hs,
+                                   utils::letterAvatar(letter_,
+                                                       textColor(),
+                                                       backgroundColor(),
+                                                       size_,
+                                                       font(),
+                                                       utils::screenDpr(this)));
                 break;
         }
         default:
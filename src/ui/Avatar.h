@@ -1,5 +1,7 @@
 #pragma once
 
+#include <map>
+
 #include <QIcon>
 #include <QImage>
 #include <QPixmap>
@@ -35,6 +37,9 @@ protected:
 
 private:
         void init();
+        //! The scaled pixmap for the given pixel ratio, rendered lazily
+        //! the first time the avatar paints on a monitor with that ratio.
+        const QPixmap &variant(qreal dpr);
 
         ui::AvatarType type_;
         QString letter_;
@@ -42,6 +47,9 @@ private:
         QColor text_color_;
         QIcon icon_;
         QImage image_;
-        QPixmap pixmap_;
+        //! Scaled variants keyed by pixel ratio (percent), so moving the
+        //! window between mixed-DPI monitors reuses earlier renders
+        //! instead of rescaling on every switch.
+        std::map<int, QPixmap> variants_;
         int size_;
 };
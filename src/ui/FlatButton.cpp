@@ -42,6 +42,7 @@ FlatButton::init()
         base_opacity_            = 0.13;
         font_size_               = 10; // 10.5;
         use_fixed_ripple_radius_ = false;
+        style_                   = ThemeManager::instance().buttonStyle(role_, bg_mode_);
 
         setStyle(&ThemeManager::instance());
         setAttribute(Qt::WA_Hover);
@@ -101,7 +102,8 @@ FlatButton::applyPreset(ui::ButtonPreset preset)
 void
 FlatButton::setRole(ui::Role role)
 {
-        role_ = role;
+        role_  = role;
+        style_ = ThemeManager::instance().buttonStyle(role_, bg_mode_);
         state_machine_->setupProperties();
 }
 
@@ -120,21 +122,8 @@ FlatButton::setForegroundColor(const QColor &color)
 QColor
 FlatButton::foregroundColor() const
 {
-        if (!foreground_color_.isValid()) {
-                if (bg_mode_ == Qt::OpaqueMode) {
-                        return ThemeManager::instance().themeColor("BrightWhite");
-                }
-
-                switch (role_) {
-                case ui::Role::Primary:
-                        return ThemeManager::instance().themeColor("Blue");
-                case ui::Role::Secondary:
-                        return ThemeManager::instance().themeColor("Gray");
-                case ui::Role::Default:
-                default:
-                        return ThemeManager::instance().themeColor("Black");
-                }
-        }
+        if (!foreground_color_.isValid())
+                return style_->foreground;
 
         return foreground_color_;
 }
@@ -148,17 +137,8 @@ FlatButton::setBackgroundColor(const QColor &color)
 QColor
 FlatButton::backgroundColor() const
 {
-        if (!background_color_.isValid()) {
-                switch (role_) {
-                case ui::Role::Primary:
-                        return ThemeManager::instance().themeColor("Blue");
-                case ui::Role::Secondary:
-                        return ThemeManager::instance().themeColor("Gray");
-                case ui::Role::Default:
-                default:
-                        return ThemeManager::instance().themeColor("Black");
-                }
-        }
+        if (!background_color_.isValid())
+                return style_->background;
 
         return background_color_;
 }
@@ -189,9 +169,8 @@ FlatButton::setDisabledForegroundColor(const QColor &color)
 QColor
 FlatButton::disabledForegroundColor() const
 {
-        if (!disabled_color_.isValid()) {
-                return ThemeManager::instance().themeColor("FadedWhite");
-        }
+        if (!disabled_color_.isValid())
+                return style_->disabledForeground;
 
         return disabled_color_;
 }
@@ -205,9 +184,8 @@ FlatButton::setDisabledBackgroundColor(const QColor &color)
 QColor
 FlatButton::disabledBackgroundColor() const
 {
-        if (!disabled_background_color_.isValid()) {
-                return ThemeManager::instance().themeColor("FadedWhite");
-        }
+        if (!disabled_background_color_.isValid())
+                return style_->disabledBackground;
 
         return disabled_background_color_;
 }
@@ -286,6 +264,7 @@ void
 FlatButton::setBackgroundMode(Qt::BGMode mode)
 {
         bg_mode_ = mode;
+        style_   = ThemeManager::instance().buttonStyle(role_, bg_mode_);
         state_machine_->setupProperties();
 }
 
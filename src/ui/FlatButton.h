@@ -3,6 +3,7 @@
 #include <QPaintEvent>
 #include <QPainter>
 #include <QPushButton>
+#include <QSharedPointer>
 #include <QStateMachine>
 
 #include "Theme.h"
@@ -170,6 +171,11 @@ private:
 
         Qt::BGMode bg_mode_;
 
+        //! The shared style record of this button's (role, background
+        //! mode) class. The per-instance colors below stay invalid unless
+        //! a setter overrides the record.
+        QSharedPointer<const ui::ButtonStyle> style_;
+
         QColor background_color_;
         QColor foreground_color_;
         QColor overlay_color_;
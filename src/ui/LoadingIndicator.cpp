@@ -3,6 +3,8 @@
 #include <QPoint>
 #include <QtGlobal>
 
+#include "TimerLifecycle.h"
+
 LoadingIndicator::LoadingIndicator(QWidget *parent)
   : QWidget(parent)
   , interval_(70)
@@ -13,7 +15,10 @@ LoadingIndicator::LoadingIndicator(QWidget *parent)
         setFocusPolicy(Qt::NoFocus);
 
         timer_ = new QTimer(this);
+        timer_->setInterval(interval_);
         connect(timer_, SIGNAL(timeout()), this, SLOT(onTimeout()));
+
+        timers::pauseWhenHidden(this, timer_);
 }
 
 void
@@ -47,6 +47,21 @@ OverlayModal::setWidget(QWidget *widget)
         content_->setFocus();
 }
 
+void
+OverlayModal::releaseWidget()
+{
+        if (!content_)
+                return;
+
+        QLayoutItem *item;
+        while ((item = layout_->takeAt(0)) != nullptr)
+                delete item;
+
+        content_->hide();
+        content_->setParent(parentWidget());
+        content_ = nullptr;
+}
+
 void
 OverlayModal::paintEvent(QPaintEvent *event)
 {
@@ -34,6 +34,10 @@ public:
 
         void setContentAlignment(QFlags<Qt::AlignmentFlag> flag) { layout_->setAlignment(flag); }
         void setWidget(QWidget *widget);
+        QWidget *widget() const { return content_; }
+        //! Remove the current widget without deleting it, so it can be
+        //! shown again later.
+        void releaseWidget();
 
 protected:
         void paintEvent(QPaintEvent *event) override;
@@ -41,7 +45,7 @@ protected:
         void mousePressEvent(QMouseEvent *event) override;
 
 private:
-        QWidget *content_;
+        QWidget *content_ = nullptr;
         QVBoxLayout *layout_;
 
         QColor color_;
@@ -30,11 +30,20 @@ Ripple::setRadius(qreal radius)
 {
         Q_ASSERT(overlay_);
 
-        if (radius_ == radius)
+        // Sub-pixel changes aren't visible; dropping them caps the repaint
+        // rate to the frames where a pixel actually moves.
+        if (qRound(radius_) == qRound(radius)) {
+                radius_ = radius;
                 return;
+        }
 
         radius_ = radius;
-        overlay_->update();
+
+        // Only the region covered by the ripple is invalidated, instead of
+        // the whole button surface, and nothing at all when the widget
+        // isn't on screen.
+        if (overlay_->isVisible())
+                overlay_->update(boundingRect());
 }
 
 void
@@ -42,11 +51,15 @@ Ripple::setOpacity(qreal opacity)
 {
         Q_ASSERT(overlay_);
 
-        if (opacity_ == opacity)
+        if (qRound(opacity_ * 255) == qRound(opacity * 255)) {
+                opacity_ = opacity;
                 return;
+        }
 
         opacity_ = opacity;
-        overlay_->update();
+
+        if (overlay_->isVisible())
+                overlay_->update(boundingRect());
 }
 
 void
@@ -57,8 +70,8 @@ Ripple::setColor(const QColor &color)
 
         brush_.setColor(color);
 
-        if (overlay_)
-                overlay_->update();
+        if (overlay_ && overlay_->isVisible())
+                overlay_->update(boundingRect());
 }
 
 void
@@ -66,8 +79,8 @@ Ripple::setBrush(const QBrush &brush)
 {
         brush_ = brush;
 
-        if (overlay_)
-                overlay_->update();
+        if (overlay_ && overlay_->isVisible())
+                overlay_->update(boundingRect());
 }
 
 void
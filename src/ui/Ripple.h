@@ -5,6 +5,7 @@
 #include <QParallelAnimationGroup>
 #include <QPoint>
 #include <QPropertyAnimation>
+#include <QRect>
 
 class RippleOverlay;
 
@@ -31,6 +32,7 @@ public:
         inline QColor color() const;
         inline QBrush brush() const;
         inline QPoint center() const;
+        inline QRect boundingRect() const;
 
         inline QPropertyAnimation *radiusAnimation() const;
         inline QPropertyAnimation *opacityAnimation() const;
@@ -101,6 +103,16 @@ Ripple::center() const
         return center_;
 }
 
+//! The pixel region covered by the ripple, so repaints can be limited
+//! to the area that actually changes.
+inline QRect
+Ripple::boundingRect() const
+{
+        const int radius = qRound(radius_) + 1;
+
+        return QRect(center_.x() - radius, center_.y() - radius, 2 * radius, 2 * radius);
+}
+
 inline QPropertyAnimation *
 Ripple::radiusAnimation() const
 {
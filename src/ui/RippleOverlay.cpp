@@ -1,3 +1,4 @@
+#include <QPaintEvent>
 #include <QPainter>
 
 #include "Ripple.h"
@@ -30,15 +31,16 @@ RippleOverlay::addRipple(const QPoint &position, qreal radius)
 void
 RippleOverlay::removeRipple(Ripple *ripple)
 {
-        if (ripples_.removeOne(ripple))
+        if (ripples_.removeOne(ripple)) {
+                // Clear whatever the last frame left behind.
+                update(ripple->boundingRect());
                 delete ripple;
+        }
 }
 
 void
 RippleOverlay::paintEvent(QPaintEvent *event)
 {
-        Q_UNUSED(event)
-
         QPainter painter(this);
         painter.setRenderHint(QPainter::Antialiasing);
         painter.setPen(Qt::NoPen);
@@ -46,8 +48,14 @@ RippleOverlay::paintEvent(QPaintEvent *event)
         if (use_clip_)
                 painter.setClipPath(clip_path_);
 
-        for (auto it = ripples_.constBegin(); it != ripples_.constEnd(); ++it)
+        // Ripples outside the invalidated region would be clipped away
+        // anyway; skip their composition entirely.
+        for (auto it = ripples_.constBegin(); it != ripples_.constEnd(); ++it) {
+                if (!(*it)->boundingRect().intersects(event->rect()))
+                        continue;
+
                 paintRipple(&painter, *it);
+        }
 }
 
 void
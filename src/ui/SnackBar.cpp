@@ -3,6 +3,7 @@
 #include <tweeny/tweeny.h>
 
 #include "SnackBar.h"
+#include "TimerLifecycle.h"
 
 constexpr int STARTING_OFFSET         = 1;
 constexpr int ANIMATION_DURATION      = 6'000;
@@ -38,6 +39,9 @@ SnackBar::SnackBar(QWidget *parent)
 
         connect(&hideTimer_, SIGNAL(timeout()), this, SLOT(hideMessage()));
 
+        timers::pauseWhenHidden(this, &showTimer_);
+        timers::pauseWhenHidden(this, &hideTimer_);
+
         hide();
 }
 
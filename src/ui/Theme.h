@@ -56,6 +56,18 @@ enum class ButtonIconPlacement
         RightIcon
 };
 
+//! The resolved, immutable style parameters of a button class. One
+//! shared record exists per (role, background mode) pair of the active
+//! theme, so the many buttons of a class don't each resolve the palette
+//! on their own.
+struct ButtonStyle
+{
+        QColor foreground;
+        QColor background;
+        QColor disabledForeground;
+        QColor disabledBackground;
+};
+
 enum class ProgressType
 {
         DeterminateProgress,
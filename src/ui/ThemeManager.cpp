@@ -9,6 +9,44 @@ ThemeManager::setTheme(Theme *theme)
 {
         theme_ = theme;
         theme_->setParent(this);
+
+        // The records of the previous theme stay alive through the
+        // buttons that still reference them.
+        buttonStyles_.clear();
+}
+
+QSharedPointer<const ui::ButtonStyle>
+ThemeManager::buttonStyle(ui::Role role, Qt::BGMode mode) const
+{
+        const int key = (static_cast<int>(role) << 1) | (mode == Qt::OpaqueMode ? 1 : 0);
+
+        auto it = buttonStyles_.find(key);
+        if (it != buttonStyles_.end())
+                return *it;
+
+        auto style = QSharedPointer<ui::ButtonStyle>::create();
+
+        switch (role) {
+        case ui::Role::Primary:
+                style->background = themeColor("Blue");
+                break;
+        case ui::Role::Secondary:
+                style->background = themeColor("Gray");
+                break;
+        case ui::Role::Default:
+        default:
+                style->background = themeColor("Black");
+                break;
+        }
+
+        style->foreground =
+          mode == Qt::OpaqueMode ? themeColor("BrightWhite") : style->background;
+        style->disabledForeground = themeColor("FadedWhite");
+        style->disabledBackground = themeColor("FadedWhite");
+
+        buttonStyles_.insert(key, style);
+
+        return style;
 }
 
 QColor
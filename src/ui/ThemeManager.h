@@ -1,6 +1,8 @@
 #pragma once
 
 #include <QCommonStyle>
+#include <QHash>
+#include <QSharedPointer>
 
 #include "Theme.h"
 
@@ -13,6 +15,11 @@ public:
 
         void setTheme(Theme *theme);
         QColor themeColor(const QString &key) const;
+        //! The shared style record for buttons with the given role &
+        //! background mode. Resolved once per theme and handed out by
+        //! pointer, so constructing a button doesn't re-derive any
+        //! palette state.
+        QSharedPointer<const ui::ButtonStyle> buttonStyle(ui::Role role, Qt::BGMode mode) const;
 
 private:
         ThemeManager();
@@ -21,6 +28,9 @@ private:
         void operator=(ThemeManager const &);
 
         Theme *theme_;
+
+        //! Hash-consed button styles, keyed by (role, background mode).
+        mutable QHash<int, QSharedPointer<const ui::ButtonStyle>> buttonStyles_;
 };
 
 inline ThemeManager &